@@ -0,0 +1,245 @@
+#include "DataStructure/BPlusTree.h"
+#include "DataStructure/ConcurrentBPlusTree.h"
+#include "Execution/BasicExecutor.h"
+#include "Execution/TableManager.h"
+#include "Net/TcpClient.h"
+#include "Net/TcpServer.h"
+#include "Net/Socket/BasicSocketFactory.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+
+#include <Logger.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int PRELOADED_KEYS = 1000000;
+    constexpr int OPERATIONS_PER_THREAD = 500000;
+
+    /**
+     * @brief Run the same workload on a number of threads
+     * @param threadCount Number of threads
+     * @param operation Operation run with the thread index and a random number
+     * @return Throughput, in millions of operations per second
+     */
+    double measure(int threadCount, const std::function<void(int, uint32_t)>& operation)
+    {
+        std::atomic<bool> start{ false };
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                std::mt19937 rng(t);
+                while (!start)
+                    std::this_thread::yield();
+                for (int i = 0; i < OPERATIONS_PER_THREAD; ++i)
+                    operation(t, rng());
+            });
+        }
+
+        auto begin = std::chrono::steady_clock::now();
+        start = true;
+        for (auto& thread : threads)
+            thread.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        return static_cast<double>(threadCount) * OPERATIONS_PER_THREAD / seconds / 1e6;
+    }
+
+    /**
+     * @brief Workload: a search, or every writeEvery operations an insert or a removal of a key above the preloaded ones
+     */
+    template <typename TSearch, typename TInsert, typename TRemove>
+    std::function<void(int, uint32_t)> workload(int writeEvery, TSearch search, TInsert insert, TRemove remove)
+    {
+        return [=](int thread, uint32_t random) {
+            if (writeEvery > 0 && random % writeEvery == 0)
+            {
+                int key = PRELOADED_KEYS + thread + static_cast<int>((random >> 8) % 4096) * 64;
+                if (!insert(key))
+                    remove(key);
+                return;
+            }
+            search(static_cast<int>(random % PRELOADED_KEYS));
+        };
+    }
+
+    /**
+     * @brief Index throughput benchmark: global lock around a BPlusTree versus a ConcurrentBPlusTree
+     */
+    int benchmarkIndex()
+    {
+        Xale::DataStructure::BPlusTree<int, int> lockedTree(128);
+        std::mutex treeMutex;
+        Xale::DataStructure::ConcurrentBPlusTree<int, int> concurrentTree;
+
+        for (int key = 0; key < PRELOADED_KEYS; ++key)
+        {
+            lockedTree.insert(key, &key);
+            concurrentTree.insert(key, key);
+        }
+
+        unsigned int cores = std::thread::hardware_concurrency();
+        std::printf("Preloaded keys: %d, operations per thread: %d, hardware threads: %u\n", PRELOADED_KEYS, OPERATIONS_PER_THREAD, cores);
+        std::printf("%-16s %8s %16s %16s\n", "workload", "threads", "global lock", "optimistic");
+
+        for (int writeEvery : { 0, 10 })
+        {
+            auto locked = workload(writeEvery,
+                [&](int key) { std::lock_guard<std::mutex> lock(treeMutex); return lockedTree.search(key) != nullptr; },
+                [&](int key) { std::lock_guard<std::mutex> lock(treeMutex); return lockedTree.insert(key, &key); },
+                [&](int key) { std::lock_guard<std::mutex> lock(treeMutex); return lockedTree.remove(key); });
+
+            auto optimistic = workload(writeEvery,
+                [&](int key) { int value = 0; return concurrentTree.search(key, value); },
+                [&](int key) { return concurrentTree.insert(key, key); },
+                [&](int key) { return concurrentTree.remove(key); });
+
+            for (int threadCount : { 1, 2, 4, 8, 16 })
+            {
+                std::printf("%-16s %8d %13.2f M/s %13.2f M/s\n",
+                    writeEvery == 0 ? "read only" : "10% writes",
+                    threadCount,
+                    measure(threadCount, locked),
+                    measure(threadCount, optimistic));
+            }
+        }
+
+        return 0;
+    }
+
+    /**
+     * @brief Field of /proc/self/status, such as the resident memory in kB or the thread count
+     */
+    long processStatus(const std::string& field)
+    {
+        std::ifstream status("/proc/self/status");
+        std::string line;
+        while (std::getline(status, line))
+        {
+            if (line.rfind(field + ":", 0) == 0)
+                return std::stol(line.substr(field.size() + 1));
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Send a query and wait for its response
+     */
+    bool query(Xale::Net::TcpClient& client, const std::string& sql)
+    {
+        Xale::Net::Packet request(Xale::Net::CommandType::QUERY, std::vector<uint8_t>(sql.begin(), sql.end()));
+        Xale::Net::Packet response(Xale::Net::CommandType::UNKNOWN, {});
+        return client.send(&request, 0) > 0 && client.receive(&response, 4096) > 0;
+    }
+
+    /**
+     * @brief Server benchmark: threads, memory and query throughput while many idle connections are held
+     * @param idleCount Number of idle connections
+     */
+    int benchmarkConnections(int idleCount)
+    {
+        constexpr int PORT = 46768;
+        constexpr int ACTIVE_CLIENTS = 8;
+        constexpr int QUERIES_PER_CLIENT = 2000;
+
+        // Both ends of every connection live in this process
+        rlimit limit{};
+        if (::getrlimit(RLIMIT_NOFILE, &limit) == 0)
+        {
+            limit.rlim_cur = limit.rlim_max;
+            ::setrlimit(RLIMIT_NOFILE, &limit);
+        }
+
+        Xale::Logger::Logger<void>::setLogToConsole(false);
+        Xale::Logger::Logger<void>::setLogToFile(false);
+
+        std::remove("benchmark-connections.bin");
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "benchmark-connections.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager);
+
+        Xale::Net::TcpServerOptions options;
+        options.maxConnections = idleCount + ACTIVE_CLIENTS + 1;
+        Xale::Net::TcpServer server(executor, std::make_unique<Xale::Net::BasicSocketFactory>(), options);
+        std::thread loop([&]() { server.start(PORT); });
+
+        auto connect = [&]() {
+            auto client = std::make_unique<Xale::Net::TcpClient>(std::make_unique<Xale::Net::BasicSocketFactory>());
+            for (int attempt = 0; attempt < 100 && !client->connect("127.0.0.1", PORT); ++attempt)
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            return client;
+        };
+
+        auto admin = connect();
+        query(*admin, "CREATE TABLE items (id INT PRIMARY KEY, name STRING)");
+        for (int i = 0; i < 100; ++i)
+            query(*admin, "INSERT INTO items VALUES (" + std::to_string(i) + ", 'item" + std::to_string(i) + "')");
+
+        long baseMemory = processStatus("VmRSS");
+        std::vector<std::unique_ptr<Xale::Net::TcpClient>> idle;
+        for (int i = 0; i < idleCount; ++i)
+            idle.push_back(connect());
+        while (server.getConnectionCount() < static_cast<std::size_t>(idleCount) + 1)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+        std::printf("Idle connections: %d, process threads: %ld, memory of both ends: %ld kB\n",
+            idleCount, processStatus("Threads"), processStatus("VmRSS") - baseMemory);
+
+        std::atomic<int> answered{ 0 };
+        std::vector<std::thread> clients;
+        auto begin = std::chrono::steady_clock::now();
+        for (int c = 0; c < ACTIVE_CLIENTS; ++c)
+        {
+            clients.emplace_back([&, c]() {
+                auto client = connect();
+                for (int i = 0; i < QUERIES_PER_CLIENT; ++i)
+                {
+                    if (query(*client, "SELECT name FROM items WHERE id = " + std::to_string((c + i) % 100)))
+                        ++answered;
+                }
+            });
+        }
+        for (auto& client : clients)
+            client.join();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        std::printf("Active clients: %d, queries answered: %d, throughput: %.0f queries/s\n",
+            ACTIVE_CLIENTS, answered.load(), answered / seconds);
+
+        idle.clear();
+        admin.reset();
+        server.stop();
+        loop.join();
+        storage.shutdown();
+        std::remove("benchmark-connections.bin");
+        return 0;
+    }
+}
+
+/**
+ * @brief Index throughput benchmark by default, server connection benchmark with "connections [count]"
+ */
+int main(int argc, char** argv)
+{
+    if (argc > 1 && std::string(argv[1]) == "connections")
+        return benchmarkConnections(argc > 2 ? std::stoi(argv[2]) : 1000);
+
+    return benchmarkIndex();
+}
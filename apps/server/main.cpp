@@ -1,10 +1,11 @@
 #include <Logger.h>
 
 #include "Core/Setup.h"
-#include "Engine/QueryEngine.h"
 #include "Net/TcpServer.h"
 #include "Net/Socket/BasicSocketFactory.h"
 
+#include <csignal>
+
 /**
  * @brief Server entrypoint
  */
@@ -18,9 +19,17 @@ int main()
 
     std::unique_ptr<Xale::Net::ISocketFactory> socketFactory = std::move(setup.getSocketFactory());
 
+    // A client closing its connection must not end the server while a response is written
+    std::signal(SIGPIPE, SIG_IGN);
+
     // Start server
-    auto& queryEngine = setup.getQueryEngine();
-    Xale::Net::TcpServer server(queryEngine, std::move(socketFactory));
+    auto& config = Xale::Core::ConfigurationHandler::getInstance();
+    Xale::Net::TcpServerOptions options;
+    options.workerThreads = config.getServerWorkers();
+    options.maxConnections = config.getMaxConnections();
+
+    // Each client gets its own parser and results, the executor locking the tables it uses
+    Xale::Net::TcpServer server(setup.getExecutor(), std::move(socketFactory), options);
 
     if (!server.start(6767)) {
         logger.error("Failed to start the server");
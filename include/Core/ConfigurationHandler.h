@@ -26,6 +26,10 @@ namespace Xale::Core
             bool useSSL() const noexcept;
             const std::string& getServerSSLCert() const noexcept;
             const std::string& getServerSSLKey() const noexcept;
+            std::size_t getIndexMemoryLimit() const noexcept;
+            std::size_t getServerWorkers() const noexcept;
+            std::size_t getMaxConnections() const noexcept;
+            std::size_t getVacuumInterval() const noexcept;
 
         private:
             static std::unique_ptr<ConfigurationHandler> instance;
@@ -47,6 +51,10 @@ namespace Xale::Core
             bool _loaded = false;
             std::string _serverSSLCert;
             std::string _serverSSLKey;
+            std::size_t _indexMemoryLimit = 0;
+            std::size_t _serverWorkers = 0;
+            std::size_t _maxConnections = 10000;
+            std::size_t _vacuumInterval = 1000;
     };
 }
 
@@ -29,6 +29,7 @@ namespace Xale::Core
             bool initialize();
             void shutdown();
             Xale::Engine::QueryEngine& getQueryEngine();
+            Xale::Execution::IExecutor& getExecutor();
             std::unique_ptr<Xale::Net::ISocketFactory>& getSocketFactory();
             bool isInitialized() const;
         private:
@@ -40,6 +41,8 @@ namespace Xale::Core
             Xale::Logger::Logger<Setup>& _logger;
             std::unique_ptr<Xale::Storage::BinaryFileManager> _execFm;
             std::unique_ptr<Xale::Storage::FileStorageEngine> _fileStorageEngine;
+            std::unique_ptr<Xale::Storage::BinaryFileManager> _walFm;
+            std::unique_ptr<Xale::Storage::FileStorageEngine> _walStorageEngine;
             std::unique_ptr<Xale::Query::BasicTokenizer> _parserTokenizer;
             std::unique_ptr<Xale::Query::BasicParser> _parser;
             std::unique_ptr<Xale::Execution::TableManager> _tableManager;
@@ -0,0 +1,50 @@
+#ifndef CORE_SHARED_MUTEX_H
+#define CORE_SHARED_MUTEX_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+namespace Xale::Core
+{
+    /**
+     * @brief Shared mutex whose locks are not bound to the thread taking them
+     *
+     * A lock may be released by another thread than the one which took it,
+     * as the locks a transaction keeps from one statement to the next, its
+     * statements running on any worker. New shared locks are granted while
+     * an exclusive one waits, so a holder may lock it shared again.
+     * Usable through std::unique_lock and std::shared_lock.
+     */
+    class SharedMutex
+    {
+        public:
+            SharedMutex() = default;
+            SharedMutex(const SharedMutex&) = delete;
+            SharedMutex& operator=(const SharedMutex&) = delete;
+
+            void lock();
+            bool try_lock();
+
+            /**
+             * @brief Lock exclusively, waiting at most for the given time
+             * @return False if the mutex stayed locked
+             */
+            bool try_lock_for(std::chrono::milliseconds timeout);
+
+            void unlock();
+
+            void lock_shared();
+            bool try_lock_shared();
+            void unlock_shared();
+
+        private:
+            std::mutex _mutex;
+            std::condition_variable _released;
+            std::size_t _shared = 0;
+            bool _exclusive = false;
+    };
+}
+
+#endif // CORE_SHARED_MUTEX_H
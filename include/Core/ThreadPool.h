@@ -0,0 +1,59 @@
+#ifndef CORE_THREAD_POOL_H
+#define CORE_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Xale::Core
+{
+    /**
+     * @brief Fixed number of threads running submitted tasks in submission order
+     */
+    class ThreadPool
+    {
+        public:
+            /**
+             * @brief Start the threads
+             * @param threadCount Number of threads, 0 for one per hardware thread
+             */
+            explicit ThreadPool(std::size_t threadCount);
+
+            /**
+             * @brief Run the tasks still queued, then join the threads
+             */
+            ~ThreadPool();
+
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            /**
+             * @brief Queue a task, run by the first idle thread
+             * @param task Task, its exceptions are caught and dropped
+             */
+            void submit(std::function<void()> task);
+
+            /**
+             * @brief Number of threads of the pool
+             */
+            std::size_t getThreadCount() const;
+
+        private:
+            std::vector<std::thread> _threads;
+            std::deque<std::function<void()>> _tasks;
+            bool _stopping = false;
+            std::mutex _mutex;
+            std::condition_variable _taskCondition;
+
+            /**
+             * @brief Thread body, running tasks until the pool is destroyed
+             */
+            void work();
+    };
+}
+
+#endif // CORE_THREAD_POOL_H
@@ -1,30 +1,123 @@
-#ifndef DATA_STRUCTURE_PLUS_BTREE_H 
+#ifndef DATA_STRUCTURE_PLUS_BTREE_H
 #define DATA_STRUCTURE_PLUS_BTREE_H
 
 #include "DataStructure/Node.h"
+#include "DataStructure/NodePool.h"
+#include "DataStructure/NodeSearch.h"
 
 #include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
 
 namespace Xale::DataStructure
 {
     /**
 	 * @brief BPlus Tree implementation
+     *
+     * Values are only stored in the leaves, which are linked through LeafNode::next.
+     * Inner nodes hold separator keys: the subtree right of a separator holds the
+     * keys greater or equal to it. Keys are unique.
+     *
+     * Nodes store their keys inline in arrays of TNodeCapacity (+1 spare) keys and
+     * are allocated from per-tree pools, the tree owns them. Keys are searched inside a node with
+     * NodeSearch, vectorized for integer keys.
      */
-	template <typename TKey, typename TValue>
+	template <typename TKey, typename TValue, typename TCompare = std::less<TKey>, size_t TNodeCapacity = defaultNodeCapacity<TKey>()>
 	class BPlusTree
 	{
+        static_assert(TNodeCapacity >= 3, "A node must hold at least 3 keys");
+
+        using BaseNode = Node<TKey, TNodeCapacity>;
+        using Inner = InnerNode<TKey, TNodeCapacity>;
+        using Leaf = LeafNode<TKey, TValue, TNodeCapacity>;
+
 		public:
+            /**
+             * @brief Forward iterator over the entries, in key order, following the leaf chain
+             */
+            class Iterator
+            {
+                public:
+                    Iterator() : _leaf(nullptr), _index(0) {}
+
+                    /**
+                     * @brief Key of the current entry
+                     */
+                    const TKey& key() const { return _leaf->keys[_index]; }
+
+                    /**
+                     * @brief Value of the current entry
+                     */
+                    TValue& value() const { return _leaf->values[_index]; }
+
+                    /**
+                     * @brief Move to the next entry
+                     */
+                    Iterator& operator++()
+                    {
+                        ++_index;
+                        skipExhaustedLeaves();
+                        return *this;
+                    }
+
+                    bool operator==(const Iterator& other) const { return _leaf == other._leaf && _index == other._index; }
+                    bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+                private:
+                    friend class BPlusTree;
+
+                    Leaf* _leaf;
+                    size_t _index;
+
+                    Iterator(Leaf* leaf, size_t index) : _leaf(leaf), _index(index)
+                    {
+                        skipExhaustedLeaves();
+                    }
+
+                    /**
+                     * @brief Move to the first entry of the next leaves once the current one is exhausted
+                     */
+                    void skipExhaustedLeaves()
+                    {
+                        while (_leaf && _index >= _leaf->count)
+                        {
+                            _leaf = _leaf->next;
+                            _index = 0;
+                        }
+                    }
+            };
+
             /**
              * @brief Constructor
-             * @param maxKeys Maximum number of keys per node (order of the tree)
+             * @param maxKeys Minimum degree of the tree, nodes hold up to 2 * maxKeys - 1 keys,
+             *        bounded by TNodeCapacity
              */
 			BPlusTree(int maxKeys);
 
+            /**
+             * @brief Destructor, destroys every node
+             */
+            ~BPlusTree();
+
+            BPlusTree(const BPlusTree&) = delete;
+            BPlusTree& operator=(const BPlusTree&) = delete;
+
+            /**
+             * @brief Move constructor, the other tree is left empty
+             */
+            BPlusTree(BPlusTree&& other) noexcept;
+
+            /**
+             * @brief Move assignment, the nodes of this tree are destroyed and the other tree is left empty
+             */
+            BPlusTree& operator=(BPlusTree&& other) noexcept;
+
             /**
              * @brief Insert a key-value pair into the B+ Tree
              * @param key Key to insert
              * @param value Pointer to the value to insert
-             * @return True if insertion is successful, false otherwise
+             * @return True if insertion is successful, false if the key already exists
              */
             bool insert(TKey key, TValue* value);
 
@@ -41,364 +134,696 @@ namespace Xale::DataStructure
              * @return Pointer to the value if found, nullptr if not found
              */
 			TValue* search(TKey key);
+
+            /**
+             * @brief Build an empty tree bottom-up from entries sorted by key
+             *
+             * Leaves are packed in key order, then each inner level is built over
+             * the level below, without any split.
+             * @param first Forward iterator to the first (key, value) pair, move
+             *        iterators move the entries into the tree
+             * @param last Past-the-end iterator
+             * @param fillFactor Fraction of the node capacity filled, in (0, 1],
+             *        nodes still hold at least the minimum number of keys
+             * @return True if loaded, false if the tree is not empty or the keys are
+             *         not strictly increasing
+             */
+            template <typename TIterator>
+            bool bulkLoad(TIterator first, TIterator last, double fillFactor = 1.0);
+
+            /**
+             * @brief Number of keys in the tree
+             */
+            size_t size() const;
+
+            /**
+             * @brief Remove every key and free the memory of the nodes
+             */
+            void clear();
+
+            /**
+             * @brief Number of bytes allocated for the nodes of the tree
+             *
+             * Heap memory owned by the keys or values themselves (strings, vectors)
+             * is not counted.
+             */
+            size_t memoryUsage() const;
+
+            /**
+             * @brief Iterator to the smallest key
+             */
+            Iterator begin();
+
+            /**
+             * @brief Past-the-end iterator
+             */
+            Iterator end();
+
+            /**
+             * @brief Iterator to the first key not less than a key
+             * @param key Key to compare to
+             * @return Iterator to the entry, end() if there is none
+             */
+            Iterator lowerBound(const TKey& key);
+
+            /**
+             * @brief Iterator to the first key greater than a key
+             * @param key Key to compare to
+             * @return Iterator to the entry, end() if there is none
+             */
+            Iterator upperBound(const TKey& key);
+
 		private:
-            Node<TKey, TValue>* _root;
+            BaseNode* _root;
 			int _keysMax;
+            size_t _size;
+            TCompare _less;
+            NodePool<Inner> _innerPool;
+            NodePool<Leaf> _leafPool;
+
+            size_t maxNodeKeys() const { return 2 * static_cast<size_t>(_keysMax) - 1; }
+            size_t minNodeKeys() const { return static_cast<size_t>(_keysMax) - 1; }
+
+            bool equals(const TKey& a, const TKey& b) const { return !_less(a, b) && !_less(b, a); }
+
+            static Inner* asInner(BaseNode* node) { return static_cast<Inner*>(node); }
+            static Leaf* asLeaf(BaseNode* node) { return static_cast<Leaf*>(node); }
 
             /**
-             * @brief Split a child node when it is full
-             * @param parent Parent node of the child to split
-             * @param index Index of the child to split
-             * @param child Child node to split
+             * @brief Give a node back to its pool
              */
-			void splitChild(Node<TKey, TValue>* parent, int index, Node<TKey, TValue>* child);
+            void destroyNode(BaseNode* node);
 
             /**
-             * @brief Insert a key-value pair into a non-full node
-             * @param node Node to insert into
-             * @param key Key to insert
-             * @param value Pointer to the value to insert
+             * @brief Give a node and all its descendants back to their pools
              */
-			void insertNonFull(Node<TKey, TValue>* node, TKey key, TValue* value);
+            void destroySubtree(BaseNode* node);
 
             /**
-             * @brief Remove a key from a node
-             * @param node Node to remove from
-             * @param key Key to remove
+             * @brief Number of nodes to spread entries over when bulk loading
+             * @param entries Number of keys (leaves) or children (inner nodes)
+             * @param target Entries per node aimed at
+             * @param minimum Entries a node must hold
              */
-			void remove(Node<TKey, TValue>* node, TKey key);
+            static size_t bulkNodeCount(size_t entries, size_t target, size_t minimum);
 
             /**
-             * @brief Merge a child node with its sibling
-             * @param node Parent node
-             * @param index Index of the child to merge
+             * @brief Shift the entries of an array from a position one slot right
              */
-			void merge(Node<TKey, TValue>* node, int index);
+            template <typename TArray>
+            static void shiftRight(TArray& array, size_t from, size_t count);
 
             /**
-             * @brief Borrow a key from the previous sibling
-             * @param node Parent node
-             * @param index Index of the child to borrow for
+             * @brief Shift the entries of an array after a position one slot left
              */
-			void borrowFromPrev(Node<TKey, TValue>* node, int index);
+            template <typename TArray>
+            static void shiftLeft(TArray& array, size_t from, size_t count);
 
             /**
-             * @brief Borrow a key from the next sibling
-             * @param node Parent node
-             * @param index Index of the child to borrow for
+             * @brief Index of the child of an inner node covering a key
              */
-			void borrowFromNext(Node<TKey, TValue>* node, int index);
+            size_t childIndex(const BaseNode* node, const TKey& key) const;
+
+            /**
+             * @brief Index of the first key of a node not less than a key
+             */
+            size_t lowerIndex(const BaseNode* node, const TKey& key) const;
+
+            /**
+             * @brief Leaf covering a key
+             * @return The leaf, nullptr if the tree is empty
+             */
+            Leaf* findLeaf(const TKey& key) const;
+
+            /**
+             * @brief Insert into a subtree, splitting the node if it overflows
+             * @param node Root of the subtree
+             * @param key Key to insert
+             * @param value Value to insert
+             * @param inserted Output, false if the key already exists
+             * @param separator Output separator key of the new sibling
+             * @return New right sibling of node if it was split, nullptr otherwise
+             */
+			BaseNode* insertInto(
+                BaseNode* node,
+                const TKey& key,
+                const TValue& value,
+                bool& inserted,
+                TKey& separator);
+
+            /**
+             * @brief Remove a key from a subtree, rebalancing the children that underflow
+             * @param node Root of the subtree
+             * @param key Key to remove
+             * @return True if the key was found
+             */
+			bool removeFrom(BaseNode* node, const TKey& key);
+
+            /**
+             * @brief Fix a child with too few keys by borrowing from or merging with a sibling
+             * @param parent Parent node
+             * @param index Index of the child to fix
+             */
+			void rebalance(Inner* parent, size_t index);
+
+            /**
+             * @brief Merge a child node with its right sibling
+             * @param parent Parent node
+             * @param index Index of the left child
+             */
+			void merge(Inner* parent, size_t index);
 	};
 
-	template <typename TKey, typename TValue>
-	BPlusTree<TKey, TValue>::BPlusTree(int maxKeys):
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::BPlusTree(int maxKeys):
 		_root(nullptr),
-		_keysMax(maxKeys)
+		_keysMax(std::min(std::max(maxKeys, 2), static_cast<int>((TNodeCapacity + 1) / 2))),
+        _size(0)
 	{}
 
-	template <typename TKey, typename TValue>
-	bool BPlusTree<TKey, TValue>::insert(TKey key, TValue* value)
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::~BPlusTree()
+	{
+        if (_root)
+            destroySubtree(_root);
+    }
+
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::BPlusTree(BPlusTree&& other) noexcept:
+        _root(other._root),
+        _keysMax(other._keysMax),
+        _size(other._size),
+        _less(std::move(other._less)),
+        _innerPool(std::move(other._innerPool)),
+        _leafPool(std::move(other._leafPool))
+	{
+        other._root = nullptr;
+        other._size = 0;
+    }
+
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	BPlusTree<TKey, TValue, TCompare, TNodeCapacity>& BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::operator=(BPlusTree&& other) noexcept
+	{
+        if (this == &other)
+            return *this;
+
+        clear();
+
+        _root = other._root;
+        _keysMax = other._keysMax;
+        _size = other._size;
+        _less = std::move(other._less);
+        _innerPool = std::move(other._innerPool);
+        _leafPool = std::move(other._leafPool);
+
+        other._root = nullptr;
+        other._size = 0;
+
+        return *this;
+    }
+
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	bool BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::insert(TKey key, TValue* value)
 	{
         if (_root == nullptr)
+            _root = _leafPool.create();
+
+        bool inserted = false;
+        TKey separator{};
+        BaseNode* sibling = insertInto(_root, key, *value, inserted, separator);
+
+        if (sibling)
         {
-            _root = new Node<TKey, TValue>(true);
-            _root->keys.push_back(key);
-            _root->values.push_back(*value);
-            return true;
-        }
-        else {
-            if (_root->keys.size() == 2 * _keysMax - 1)
-            {
-                Node<TKey, TValue>* newRoot = new Node<TKey, TValue>(false);
-                newRoot->children.push_back(_root);
-                splitChild(newRoot, 0, _root);
-                _root = newRoot;
-            }
-            insertNonFull(_root, key, value);
-            return true;
+            Inner* newRoot = _innerPool.create();
+            newRoot->keys[0] = std::move(separator);
+            newRoot->children[0] = _root;
+            newRoot->children[1] = sibling;
+            newRoot->count = 1;
+            _root = newRoot;
         }
+
+        if (inserted)
+            ++_size;
+
+        return inserted;
 	}
 
-	template <typename TKey, typename TValue>
-	bool BPlusTree<TKey, TValue>::remove(TKey key)
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	bool BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::remove(TKey key)
 	{
-        if (_root == nullptr) {
+        if (_root == nullptr)
             return false;
+
+        bool removed = removeFrom(_root, key);
+
+        if (!_root->isLeaf && _root->count == 0)
+        {
+            BaseNode* tmp = _root;
+            _root = asInner(_root)->children[0];
+            destroyNode(tmp);
         }
-        remove(_root, key);
-        if (_root->keys.empty() && !_root->isLeaf) {
-            Node<TKey, TValue>* tmp = _root;
-            _root = _root->children[0];
-            delete tmp;
-            return true;
+        else if (_root->isLeaf && _root->count == 0)
+        {
+            destroyNode(_root);
+            _root = nullptr;
         }
-        return false;
+
+        if (removed)
+            --_size;
+
+        return removed;
 	}
 
-	template <typename TKey, typename TValue>
-	TValue* BPlusTree<TKey, TValue>::search(TKey key)
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	TValue* BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::search(TKey key)
 	{
+        Leaf* leaf = findLeaf(key);
+        if (!leaf)
+            return nullptr;
 
-        if (!_root)
+        size_t index = lowerIndex(leaf, key);
+        if (index == leaf->count || !equals(leaf->keys[index], key))
             return nullptr;
 
-        Node<TKey, TValue>* current = _root;
+        return &leaf->values[index];
+    }
+
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	template <typename TIterator>
+	bool BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::bulkLoad(TIterator first, TIterator last, double fillFactor)
+	{
+        if (_root != nullptr)
+            return false;
+
+        auto unordered = std::adjacent_find(first, last, [&](const auto& a, const auto& b) {
+            return !_less(a.first, b.first);
+        });
+        if (unordered != last)
+            return false;
+
+        size_t count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0)
+            return true;
+
+        size_t minimum = std::max<size_t>(minNodeKeys(), 1);
+        size_t filled = fillFactor < 1.0 ? static_cast<size_t>(maxNodeKeys() * std::max(fillFactor, 0.0)) : maxNodeKeys();
+        size_t target = std::max(filled, minimum);
+
+        // Leaves, chained in key order
+        std::vector<BaseNode*> level;
+        std::vector<TKey> firstKeys;
+        size_t leafCount = bulkNodeCount(count, target, minimum);
+        Leaf* previous = nullptr;
 
-        while (!current->isLeaf)
+        for (size_t i = 0; i < leafCount; ++i)
         {
-            size_t i = 0;
-            while (i < current->keys.size() && key >= current->keys[i])
-                ++i;
-            current = current->children[i];
+            Leaf* leaf = _leafPool.create();
+            leaf->count = count / leafCount + (i < count % leafCount ? 1 : 0);
+
+            for (size_t k = 0; k < leaf->count; ++k, ++first)
+            {
+                leaf->keys[k] = (*first).first;
+                leaf->values[k] = (*first).second;
+            }
+
+            if (previous)
+                previous->next = leaf;
+            previous = leaf;
+
+            level.push_back(leaf);
+            firstKeys.push_back(leaf->keys[0]);
         }
 
-        for (size_t i = 0; i < current->keys.size(); ++i)
+        // Inner levels: the separators are the first keys of the children but the first one
+        while (level.size() > 1)
         {
-            if (current->keys[i] == key)
-                return &current->values[i];
+            std::vector<BaseNode*> parents;
+            std::vector<TKey> parentFirstKeys;
+            size_t parentCount = bulkNodeCount(level.size(), target + 1, minimum + 1);
+            size_t child = 0;
+
+            for (size_t i = 0; i < parentCount; ++i)
+            {
+                Inner* inner = _innerPool.create();
+                size_t children = level.size() / parentCount + (i < level.size() % parentCount ? 1 : 0);
+
+                parentFirstKeys.push_back(std::move(firstKeys[child]));
+                inner->children[0] = level[child++];
+                for (size_t k = 1; k < children; ++k, ++child)
+                {
+                    inner->keys[k - 1] = std::move(firstKeys[child]);
+                    inner->children[k] = level[child];
+                }
+                inner->count = children - 1;
+
+                parents.push_back(inner);
+            }
+
+            level = std::move(parents);
+            firstKeys = std::move(parentFirstKeys);
         }
 
-        return nullptr;
+        _root = level[0];
+        _size = count;
+
+        return true;
+    }
+
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	size_t BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::size() const
+	{
+        return _size;
     }
 
-	template <typename TKey, typename TValue>
-	void BPlusTree<TKey, TValue>::splitChild(
-		Node<TKey, TValue>* parent, 
-		int index,
-        Node<TKey, TValue>* child)
-    {
-        Node<TKey, TValue>* newChild = new Node<TKey, TValue>(child->isLeaf);
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	void BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::clear()
+	{
+        if (_root)
+            destroySubtree(_root);
 
-        parent->children.insert(
-                parent->children.begin() + index + 1, 
-                newChild);
+        _root = nullptr;
+        _size = 0;
+        _innerPool.release();
+        _leafPool.release();
+    }
 
-        parent->keys.insert(
-                parent->keys.begin() + index,
-                child->keys[_keysMax - 1]);
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	size_t BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::memoryUsage() const
+	{
+        return _innerPool.allocatedBytes() + _leafPool.allocatedBytes();
+    }
 
-        newChild->keys.assign(
-                child->keys.begin() + _keysMax,
-                child->keys.end());
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	typename BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::Iterator BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::begin()
+	{
+        BaseNode* current = _root;
 
-        child->keys.resize(_keysMax - 1);
+        while (current && !current->isLeaf)
+            current = asInner(current)->children[0];
 
-        if (!child->isLeaf)
-        {
-            newChild->children.assign(
-                    child->children.begin() + _keysMax,
-                    child->children.end());
-            child->children.resize(_keysMax);
-        }
+        return Iterator(asLeaf(current), 0);
+    }
 
-        if (child->isLeaf)
-        {
-            newChild->next = child->next;
-            child->next = newChild;
-        }
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	typename BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::Iterator BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::end()
+	{
+        return Iterator();
     }
 
-	template <typename TKey, typename TValue>
-	void BPlusTree<TKey, TValue>::insertNonFull(
-		Node<TKey, TValue>* node, 
-		TKey key, 
-		TValue* value)
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	typename BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::Iterator BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::lowerBound(const TKey& key)
+	{
+        Leaf* leaf = findLeaf(key);
+        if (!leaf)
+            return end();
+
+        return Iterator(leaf, lowerIndex(leaf, key));
+    }
+
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	typename BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::Iterator BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::upperBound(const TKey& key)
+	{
+        Leaf* leaf = findLeaf(key);
+        if (!leaf)
+            return end();
+
+        return Iterator(leaf, childIndex(leaf, key));
+    }
+
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	void BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::destroyNode(BaseNode* node)
 	{
         if (node->isLeaf)
-        {
-            auto pos = std::upper_bound(
-                node->keys.begin(),
-                node->keys.end(),
-                key);
-            size_t index = std::distance(node->keys.begin(), pos);
-            node->keys.insert(pos, key);
-            node->values.insert(node->values.begin() + index, *value);        
-        }
+            _leafPool.destroy(asLeaf(node));
         else
+            _innerPool.destroy(asInner(node));
+    }
+
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	void BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::destroySubtree(BaseNode* node)
+	{
+        if (!node->isLeaf)
         {
-            int i = node->keys.size() - 1;
-            
-            while (i >= 0 && key < node->keys[i])
-                i--;
+            Inner* inner = asInner(node);
+            for (size_t i = 0; i <= inner->count; ++i)
+                destroySubtree(inner->children[i]);
+        }
 
-            i++;
+        destroyNode(node);
+    }
 
-            if (node->children[i]->keys.size() == 2 * _keysMax - 1)
-            {
-                splitChild(node, i, node->children[i]);
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	size_t BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::bulkNodeCount(size_t entries, size_t target, size_t minimum)
+	{
+        // As few nodes as the target allows, fewer if the entries do not fill them to the minimum
+        size_t nodes = (entries + target - 1) / target;
 
-                if (key > node->keys[i])
-                    i++;
-            }
+        while (nodes > 1 && entries / nodes < minimum)
+            --nodes;
 
-            insertNonFull(node->children[i], key, value); 
-        }
-	}
+        return nodes;
+    }
 
-	template <typename TKey, typename TValue>
-	void BPlusTree<TKey, TValue>::remove(
-		Node<TKey, TValue>* node, 
-		TKey key)
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	template <typename TArray>
+	void BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::shiftRight(TArray& array, size_t from, size_t count)
 	{
-        if (node->isLeaf)
-        {
-            auto it = std::find(
-                node->keys.begin(),
-                node->keys.end(),
-                key);
+        std::move_backward(array.begin() + from, array.begin() + count, array.begin() + count + 1);
+    }
 
-            if (it != node->keys.end())
-            {
-                size_t index = std::distance(node->keys.begin(), it);
-                node->keys.erase(it);
-                node->values.erase(node->values.begin() + index);
-            }               
-        }
-        else
-        {
-            int index = std::distance(
-                node->keys.begin(),
-                std::lower_bound(
-                    node->keys.begin(),
-                    node->keys.end(),
-                    key));
-
-            if (index < node->keys.size() && node->keys[index] == key)
-            {
-                if (node->children[index]->keys.size() >= _keysMax)
-                {
-                    Node<TKey, TValue>* predecessorNode = node->children[index];
-                    while (!predecessorNode->isLeaf)
-                        predecessorNode = predecessorNode->children.back();
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	template <typename TArray>
+	void BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::shiftLeft(TArray& array, size_t from, size_t count)
+	{
+        std::move(array.begin() + from + 1, array.begin() + count, array.begin() + from);
+    }
 
-                    TKey predecessorKey = predecessorNode->keys.back();
-                    TValue predecessorVal = predecessorNode->values.back();
-                    node->keys[index] = predecessorKey;
-                    node->values[index] = predecessorVal;
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	size_t BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::childIndex(const BaseNode* node, const TKey& key) const
+	{
+        return NodeSearch<TKey, TCompare>::upperBound(node->keys.data(), node->count, key, _less);
+    }
 
-                    remove(node->children[index], predecessorKey);
-                }
-                else if (node->children[index + 1]->keys.size() >= _keysMax)
-                {
-                    Node<TKey, TValue>* successorNode = node->children[index + 1];
-                    while(!successorNode->isLeaf)
-                        successorNode = successorNode->children.front();
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	size_t BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::lowerIndex(const BaseNode* node, const TKey& key) const
+	{
+        return NodeSearch<TKey, TCompare>::lowerBound(node->keys.data(), node->count, key, _less);
+    }
 
-                    TKey successorKey = successorNode->keys.front();
-                    TValue successorVal = successorNode->values.front();
-                    node->keys[index] = successorKey;
-                    node->values[index] = successorVal;
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	typename BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::Leaf* BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::findLeaf(const TKey& key) const
+	{
+        BaseNode* current = _root;
 
-                    remove(node->children[index + 1], successorKey);
-                }
-                else
-                {
-                    merge(node, index);
-                    remove(node->children[index], key);
-                }
-            }
-            else 
+        while (current && !current->isLeaf)
+            current = asInner(current)->children[childIndex(current, key)];
+
+        return asLeaf(current);
+    }
+
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	typename BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::BaseNode* BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::insertInto(
+		BaseNode* node,
+		const TKey& key,
+		const TValue& value,
+        bool& inserted,
+        TKey& separator)
+	{
+        if (node->isLeaf)
+        {
+            Leaf* leaf = asLeaf(node);
+            size_t index = lowerIndex(leaf, key);
+            if (index < leaf->count && equals(leaf->keys[index], key))
             {
-                if (node->children[index]->keys.size() < _keysMax)
-                {
-                    if (index > 0 && 
-                            node->children[index - 1]->keys.size() >= _keysMax)
-                        borrowFromPrev(node, index);
-                    else if (index < node->children.size() - 1 && 
-                            node->children[index + 1]->keys.size() >= _keysMax)
-                        borrowFromNext(node, index);
-                    else
-                    {
-                        if (index < node->children.size() -1)
-                            merge(node, index);
-                        else
-                            merge(node, index - 1);
-                    }
-                }
-                remove(node->children[index], key);
+                inserted = false;
+                return nullptr;
             }
+
+            shiftRight(leaf->keys, index, leaf->count);
+            shiftRight(leaf->values, index, leaf->count);
+            leaf->keys[index] = key;
+            leaf->values[index] = value;
+            ++leaf->count;
+            inserted = true;
+
+            if (leaf->count <= maxNodeKeys())
+                return nullptr;
+
+            // Leaf split: the first key of the new leaf is copied up
+            size_t middle = leaf->count / 2;
+            Leaf* sibling = _leafPool.create();
+            std::move(leaf->keys.begin() + middle, leaf->keys.begin() + leaf->count, sibling->keys.begin());
+            std::move(leaf->values.begin() + middle, leaf->values.begin() + leaf->count, sibling->values.begin());
+            sibling->count = leaf->count - middle;
+            leaf->count = middle;
+
+            sibling->next = leaf->next;
+            leaf->next = sibling;
+
+            separator = sibling->keys[0];
+            return sibling;
         }
+
+        Inner* inner = asInner(node);
+        size_t index = childIndex(inner, key);
+        TKey childSeparator{};
+        BaseNode* newChild = insertInto(inner->children[index], key, value, inserted, childSeparator);
+
+        if (!newChild)
+            return nullptr;
+
+        shiftRight(inner->keys, index, inner->count);
+        shiftRight(inner->children, index + 1, inner->count + 1);
+        inner->keys[index] = std::move(childSeparator);
+        inner->children[index + 1] = newChild;
+        ++inner->count;
+
+        if (inner->count <= maxNodeKeys())
+            return nullptr;
+
+        // Inner split: the middle key moves up
+        size_t middle = inner->count / 2;
+        Inner* sibling = _innerPool.create();
+        separator = std::move(inner->keys[middle]);
+        std::move(inner->keys.begin() + middle + 1, inner->keys.begin() + inner->count, sibling->keys.begin());
+        std::copy(inner->children.begin() + middle + 1, inner->children.begin() + inner->count + 1, sibling->children.begin());
+        sibling->count = inner->count - middle - 1;
+        inner->count = middle;
+
+        return sibling;
 	}
 
-	template <typename TKey, typename TValue>
-	void BPlusTree<TKey, TValue>::merge(
-		Node<TKey, TValue>* node, 
-		int index)
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	bool BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::removeFrom(
+		BaseNode* node,
+		const TKey& key)
 	{
-        Node<TKey, TValue>* child = node->children[index];
-        Node<TKey, TValue>* sibling = node->children[index + 1];
-
-        child->keys.push_back(node->keys[index]);
-        child->values.push_back(node->values[index]);
-
-        child->keys.insert(
-            child->keys.end(),
-            sibling->keys.begin(),
-            sibling->keys.end());
-        child->values.insert(
-            child->values.end(),
-            sibling->values.begin(),
-            sibling->values.end());
-
-        if (!child->isLeaf)
+        if (node->isLeaf)
         {
-            child->children.insert(child->children.end(),
-                sibling->children.begin(),
-                sibling->children.end());
+            Leaf* leaf = asLeaf(node);
+            size_t index = lowerIndex(leaf, key);
+            if (index == leaf->count || !equals(leaf->keys[index], key))
+                return false;
+
+            shiftLeft(leaf->keys, index, leaf->count);
+            shiftLeft(leaf->values, index, leaf->count);
+            --leaf->count;
+            return true;
         }
 
-        node->keys.erase(node->keys.begin() + index);
-        node->values.erase(node->values.begin() + index);
-        node->children.erase(node->children.begin() + index + 1);
+        // Separators may outlive their key, they still route correctly
+        Inner* inner = asInner(node);
+        size_t index = childIndex(inner, key);
+        if (!removeFrom(inner->children[index], key))
+            return false;
+
+        if (inner->children[index]->count < minNodeKeys())
+            rebalance(inner, index);
 
-        delete sibling;
+        return true;
 	}
 
-	template <typename TKey, typename TValue>
-	void BPlusTree<TKey, TValue>::borrowFromPrev(
-		Node<TKey, TValue>* node,
-		int index)
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	void BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::rebalance(
+		Inner* parent,
+		size_t index)
 	{
-        Node<TKey, TValue>* child = node->children[index];
-        Node<TKey, TValue>* sibling = node->children[index - 1];
+        BaseNode* child = parent->children[index];
 
-        child->keys.insert(child->keys.begin(), node->keys[index - 1]);
-        child->values.insert(child->values.begin(), node->values[index - 1]);
+        if (index > 0 && parent->children[index - 1]->count > minNodeKeys())
+        {
+            BaseNode* sibling = parent->children[index - 1];
+            size_t last = sibling->count - 1;
 
-        node->keys[index - 1] = sibling->keys.back();
-        node->values[index - 1] = sibling->values.back();
+            if (child->isLeaf)
+            {
+                Leaf* leaf = asLeaf(child);
+                shiftRight(leaf->keys, 0, leaf->count);
+                shiftRight(leaf->values, 0, leaf->count);
+                leaf->keys[0] = std::move(sibling->keys[last]);
+                leaf->values[0] = std::move(asLeaf(sibling)->values[last]);
+                parent->keys[index - 1] = leaf->keys[0];
+            }
+            else
+            {
+                Inner* inner = asInner(child);
+                shiftRight(inner->keys, 0, inner->count);
+                shiftRight(inner->children, 0, inner->count + 1);
+                inner->keys[0] = std::move(parent->keys[index - 1]);
+                inner->children[0] = asInner(sibling)->children[last + 1];
+                parent->keys[index - 1] = std::move(sibling->keys[last]);
+            }
 
-        sibling->keys.pop_back();
-        sibling->values.pop_back();
+            ++child->count;
+            --sibling->count;
+            return;
+        }
 
-        if (!child->isLeaf) {
-            child->children.insert(child->children.begin(), sibling->children.back());
-            sibling->children.pop_back();
+        if (index < parent->count && parent->children[index + 1]->count > minNodeKeys())
+        {
+            BaseNode* sibling = parent->children[index + 1];
+
+            if (child->isLeaf)
+            {
+                Leaf* leaf = asLeaf(child);
+                leaf->keys[leaf->count] = std::move(sibling->keys[0]);
+                leaf->values[leaf->count] = std::move(asLeaf(sibling)->values[0]);
+                shiftLeft(sibling->keys, 0, sibling->count);
+                shiftLeft(asLeaf(sibling)->values, 0, sibling->count);
+                parent->keys[index] = sibling->keys[0];
+            }
+            else
+            {
+                Inner* inner = asInner(child);
+                inner->keys[inner->count] = std::move(parent->keys[index]);
+                inner->children[inner->count + 1] = asInner(sibling)->children[0];
+                parent->keys[index] = std::move(sibling->keys[0]);
+                shiftLeft(sibling->keys, 0, sibling->count);
+                shiftLeft(asInner(sibling)->children, 0, sibling->count + 1);
+            }
+
+            ++child->count;
+            --sibling->count;
+            return;
         }
+
+        if (index > 0)
+            merge(parent, index - 1);
+        else if (index < parent->count)
+            merge(parent, index);
     }
 
-	template <typename TKey, typename TValue>
-	void BPlusTree<TKey, TValue>::borrowFromNext(
-		Node<TKey, TValue>* node,
-		int index)
+	template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+	void BPlusTree<TKey, TValue, TCompare, TNodeCapacity>::merge(
+		Inner* parent,
+		size_t index)
 	{
-        Node<TKey, TValue>* child = node->children[index];
-        Node<TKey, TValue>* sibling = node->children[index + 1];
+        BaseNode* child = parent->children[index];
+        BaseNode* sibling = parent->children[index + 1];
 
-        child->keys.push_back(node->keys[index]);
-        child->values.push_back(node->values[index]);
+        if (child->isLeaf)
+        {
+            Leaf* leaf = asLeaf(child);
+            std::move(asLeaf(sibling)->values.begin(), asLeaf(sibling)->values.begin() + sibling->count, leaf->values.begin() + leaf->count);
+            leaf->next = asLeaf(sibling)->next;
+        }
+        else
+        {
+            Inner* inner = asInner(child);
+            inner->keys[inner->count] = std::move(parent->keys[index]);
+            ++inner->count;
+            std::copy(asInner(sibling)->children.begin(), asInner(sibling)->children.begin() + sibling->count + 1, inner->children.begin() + inner->count);
+        }
 
-        node->keys[index] = sibling->keys.front();
-        node->values[index] = sibling->values.front();
+        std::move(sibling->keys.begin(), sibling->keys.begin() + sibling->count, child->keys.begin() + child->count);
+        child->count += sibling->count;
 
-        sibling->keys.erase(sibling->keys.begin());
-        sibling->values.erase(sibling->values.begin());
+        shiftLeft(parent->keys, index, parent->count);
+        shiftLeft(parent->children, index + 1, parent->count + 1);
+        --parent->count;
 
-        if (!child->isLeaf) {
-            child->children.push_back(sibling->children.front());
-            sibling->children.erase(sibling->children.begin());
-        }
-    }
+        destroyNode(sibling);
+	}
 }
 
 #endif // DATA_STRUCTURE_PLUS_BTREE_H
@@ -0,0 +1,148 @@
+#ifndef DATA_STRUCTURE_COLUMN_VECTOR_H
+#define DATA_STRUCTURE_COLUMN_VECTOR_H
+
+#include "DataStructure/DataTypes.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Xale::DataStructure
+{
+    /**
+     * @brief Physical representation of the values of a column
+     */
+    enum class ColumnKind
+    {
+        Integer, ///< Contiguous int32 values
+        Float,   ///< Contiguous double values
+        String,  ///< Offsets into a shared character heap
+        Mixed    ///< Values of different types, stored as FieldValue
+    };
+
+    /**
+     * @brief Values of one column, stored contiguously by type
+     *
+     * Non-NULL values all holding the same alternative of FieldValue are stored
+     * in a typed array; NULL values are flagged in a bitmap and take a zero (or
+     * empty string) slot in the array. Appending a value of another type turns
+     * the column into a Mixed one, so a column always gives its values back
+     * exactly as they were appended.
+     */
+    class ColumnVector
+    {
+        public:
+            /**
+             * @brief Construct an empty column
+             * @param kind Expected kind of the values, taken from the first non-NULL value when it differs
+             */
+            explicit ColumnVector(ColumnKind kind = ColumnKind::Mixed);
+
+            /**
+             * @brief Get the kind of the column
+             */
+            ColumnKind getKind() const;
+
+            /**
+             * @brief Get the number of values
+             */
+            size_t size() const;
+
+            /**
+             * @brief Get the number of NULL values
+             */
+            size_t nullCount() const;
+
+            /**
+             * @brief Check if a value is NULL
+             * @param index Position of the value
+             */
+            bool isNull(size_t index) const
+            {
+                return (_nulls[index / 64] >> (index % 64)) & 1;
+            }
+
+            /**
+             * @brief Get the NULL bitmap, bit i of word i / 64 being set when value i is NULL
+             */
+            const std::vector<uint64_t>& getNullBitmap() const;
+
+            /**
+             * @brief Get the values of an Integer column, 0 for NULL values
+             */
+            const int32_t* integers() const;
+
+            /**
+             * @brief Get the values of a Float column, 0 for NULL values
+             */
+            const double* floats() const;
+
+            /**
+             * @brief Get a value of a String column, empty for NULL values
+             * @param index Position of the value
+             * @return View into the string heap, valid until the next append
+             */
+            std::string_view stringAt(size_t index) const
+            {
+                return std::string_view(_heap.data() + _offsets[index], _offsets[index + 1] - _offsets[index]);
+            }
+
+            /**
+             * @brief Get a value, whatever the kind of the column
+             * @param index Position of the value
+             */
+            FieldValue valueAt(size_t index) const;
+
+            /**
+             * @brief Append a value
+             * @param value Value to append
+             */
+            void append(const FieldValue& value);
+
+            /**
+             * @brief Reserve room for values
+             * @param count Expected number of values
+             */
+            void reserve(size_t count);
+
+            /**
+             * @brief Memory used by the values, the string heap and the NULL bitmap
+             * @return Number of bytes
+             */
+            size_t memoryUsage() const;
+
+            /**
+             * @brief Get the kind storing a value
+             * @param value Non-NULL value
+             */
+            static ColumnKind kindOf(const FieldValue& value);
+
+        private:
+            ColumnKind _kind;
+            size_t _size = 0;
+            size_t _nullCount = 0;
+
+            std::vector<int32_t> _integers;
+            std::vector<double> _floats;
+
+            /** @brief Start of every string in the heap, followed by the end of the last one */
+            std::vector<size_t> _offsets{ 0 };
+            std::vector<char> _heap;
+
+            std::vector<FieldValue> _mixed;
+
+            std::vector<uint64_t> _nulls;
+
+            /**
+             * @brief Move the values into a Mixed column
+             */
+            void convertToMixed();
+
+            /**
+             * @brief Append the zero value of the column, for a NULL
+             */
+            void appendEmpty();
+    };
+}
+
+#endif // DATA_STRUCTURE_COLUMN_VECTOR_H
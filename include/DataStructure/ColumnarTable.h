@@ -0,0 +1,103 @@
+#ifndef DATA_STRUCTURE_COLUMNAR_TABLE_H
+#define DATA_STRUCTURE_COLUMNAR_TABLE_H
+
+#include "DataStructure/IDataTemplate.h"
+#include "DataStructure/ColumnVector.h"
+
+namespace Xale::DataStructure
+{
+    /**
+     * @brief Dataset stored column by column
+     *
+     * Every column is a typed ColumnVector, so that scans and aggregations read
+     * contiguous arrays instead of one variant per cell. Rows are still
+     * available through the IDataTemplate interface: they are rebuilt from the
+     * columns on the first call to getRows().
+     */
+    class ColumnarTable : public IDataTemplate
+    {
+        public:
+            /**
+             * @brief Construct an empty dataset
+             * @param name Name of the dataset
+             * @param schema Column definitions, giving the expected kind of each column
+             */
+            ColumnarTable(const std::string& name, const std::vector<ColumnDefinition>& schema);
+
+            /**
+             * @brief Construct a dataset holding the rows of another one
+             * @param source Dataset to copy, e.g. a Table or a ResultSet
+             */
+            explicit ColumnarTable(const IDataTemplate& source);
+
+            /** @copydoc IDataTemplate::getName */
+            const std::string& getName() const override;
+
+            /** @copydoc IDataTemplate::getSchema */
+            const std::vector<ColumnDefinition>& getSchema() const override;
+
+            /**
+             * @brief Get the rows, rebuilt from the columns on the first call
+             *
+             * Prefer getColumn() or getRow() for large datasets, which do not
+             * keep a row copy of the whole dataset.
+             * @return Rows of the dataset
+             */
+            const std::vector<Row>& getRows() const override;
+
+            /** @copydoc IDataTemplate::getRowCount */
+            size_t getRowCount() const override;
+
+            /** @copydoc IDataTemplate::getColumnCount */
+            size_t getColumnCount() const override;
+
+            /** @copydoc IDataTemplate::isEmpty */
+            bool isEmpty() const override;
+
+            /** @copydoc IDataTemplate::isMutable */
+            bool isMutable() const override;
+
+            /**
+             * @brief Get the values of a column
+             * @param index Position of the column in the schema
+             */
+            const ColumnVector& getColumn(size_t index) const;
+
+            /**
+             * @brief Rebuild a row from the columns
+             * @param index Position of the row
+             */
+            Row getRow(size_t index) const;
+
+            /**
+             * @brief Append a row
+             * @param row Row to append
+             * @return False if the row does not match the schema
+             */
+            bool appendRow(const Row& row);
+
+            /**
+             * @brief Reserve room for rows
+             * @param count Expected number of rows
+             */
+            void reserve(size_t count);
+
+            /**
+             * @brief Memory used by the columns
+             * @return Number of bytes
+             */
+            size_t memoryUsage() const;
+
+        private:
+            std::string _name;
+            std::vector<ColumnDefinition> _schema;
+            std::vector<ColumnVector> _columns;
+            size_t _rowCount = 0;
+
+            /** @brief Rows rebuilt by getRows(), dropped by appendRow() */
+            mutable std::vector<Row> _rowCache;
+            mutable bool _rowCacheValid = false;
+    };
+}
+
+#endif // DATA_STRUCTURE_COLUMNAR_TABLE_H
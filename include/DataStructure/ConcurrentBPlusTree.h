@@ -0,0 +1,434 @@
+#ifndef DATA_STRUCTURE_CONCURRENT_BPLUS_TREE_H
+#define DATA_STRUCTURE_CONCURRENT_BPLUS_TREE_H
+
+#include "DataStructure/Node.h"
+#include "DataStructure/NodeSearch.h"
+#include "DataStructure/OptimisticLock.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <type_traits>
+
+namespace Xale::DataStructure
+{
+    /**
+     * @brief Thread-safe B+ Tree using optimistic lock coupling
+     *
+     * Every node carries an OptimisticLock. Readers take no lock: they descend
+     * reading the node versions and restart from the root if a node changed
+     * under them. Writers only lock the nodes they modify, a leaf, or a node and
+     * its parent to split it. Full nodes are split on the way down, so a split
+     * never propagates upwards.
+     *
+     * Keys and values are read while writers may modify them, before being
+     * validated, so they must be trivially copyable. Removal does not merge
+     * nodes, emptied leaves stay in the tree. Nodes are only freed with the tree.
+     */
+    template <typename TKey, typename TValue, typename TCompare = std::less<TKey>, size_t TNodeCapacity = defaultNodeCapacity<TKey>()>
+    class ConcurrentBPlusTree
+    {
+        static_assert(TNodeCapacity >= 3, "A node must hold at least 3 keys");
+        static_assert(std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>,
+            "Keys and values are read optimistically, they must be trivially copyable");
+
+        /**
+         * @brief Node header and keys, shared by inner nodes and leaves
+         */
+        struct alignas(CACHE_LINE_SIZE) BaseNode
+        {
+            OptimisticLock lock;
+            const bool isLeaf;
+            std::atomic<size_t> count;
+            std::array<TKey, TNodeCapacity> keys{};
+
+            explicit BaseNode(bool leaf) : isLeaf(leaf), count(0) {}
+        };
+
+        struct Inner : public BaseNode
+        {
+            std::array<BaseNode*, TNodeCapacity + 1> children{};
+
+            Inner() : BaseNode(false) {}
+        };
+
+        struct Leaf : public BaseNode
+        {
+            std::array<TValue, TNodeCapacity> values{};
+
+            Leaf() : BaseNode(true) {}
+        };
+
+        public:
+            ConcurrentBPlusTree();
+            ~ConcurrentBPlusTree();
+
+            ConcurrentBPlusTree(const ConcurrentBPlusTree&) = delete;
+            ConcurrentBPlusTree& operator=(const ConcurrentBPlusTree&) = delete;
+
+            /**
+             * @brief Insert a key-value pair
+             * @param key Key to insert
+             * @param value Value to insert
+             * @return True if insertion is successful, false if the key already exists
+             */
+            bool insert(const TKey& key, const TValue& value);
+
+            /**
+             * @brief Remove a key
+             * @param key Key to remove
+             * @return True if removal is successful, false if key not found
+             */
+            bool remove(const TKey& key);
+
+            /**
+             * @brief Search for a key
+             * @param key Key to search for
+             * @param value Output, copy of the value if found
+             * @return True if the key was found
+             */
+            bool search(const TKey& key, TValue& value) const;
+
+            /**
+             * @brief Number of keys in the tree
+             */
+            size_t size() const;
+
+        private:
+            std::atomic<BaseNode*> _root;
+            std::atomic<size_t> _size;
+            TCompare _less;
+
+            static Inner* asInner(BaseNode* node) { return static_cast<Inner*>(node); }
+            static Leaf* asLeaf(BaseNode* node) { return static_cast<Leaf*>(node); }
+
+            /**
+             * @brief Number of keys of a node, bounded by the capacity as it may be read mid-write
+             */
+            static size_t keyCount(const BaseNode* node)
+            {
+                return std::min(node->count.load(std::memory_order_relaxed), TNodeCapacity);
+            }
+
+            /**
+             * @brief Index of the child of an inner node covering a key
+             */
+            size_t childIndex(const BaseNode* node, const TKey& key) const;
+
+            /**
+             * @brief Index of the first key of a node not less than a key
+             */
+            size_t lowerIndex(const BaseNode* node, const TKey& key) const;
+
+            /**
+             * @brief Find the leaf covering a key
+             * @param key Key to search for
+             * @param version Output, version of the leaf when it was reached
+             * @return The leaf, nullptr if a concurrent write requires to restart
+             */
+            Leaf* findLeaf(const TKey& key, uint64_t& version) const;
+
+            /**
+             * @brief Write lock a full node and its parent to split them
+             * @return True if both are locked, false if one of them changed
+             */
+            bool lockForSplit(BaseNode* node, uint64_t version, Inner* parent, uint64_t parentVersion);
+
+            /**
+             * @brief Split a full node in two, adding the separator to the parent or to a new root
+             *
+             * Both the node and its parent must be write locked, and stay so.
+             * @param node Node to split
+             * @param parent Parent of the node, nullptr if the node is the root
+             */
+            void split(BaseNode* node, Inner* parent);
+
+            /**
+             * @brief Free a subtree
+             */
+            static void destroy(BaseNode* node);
+    };
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::ConcurrentBPlusTree():
+        _root(new Leaf()),
+        _size(0)
+    {}
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::~ConcurrentBPlusTree()
+    {
+        destroy(_root.load());
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    bool ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::insert(const TKey& key, const TValue& value)
+    {
+        while (true)
+        {
+            BaseNode* node = _root.load(std::memory_order_acquire);
+            uint64_t version = node->lock.readLock();
+            if (node != _root.load(std::memory_order_acquire))
+                continue;
+
+            Inner* parent = nullptr;
+            uint64_t parentVersion = 0;
+            bool restart = false;
+
+            while (true)
+            {
+                // Split full nodes on the way down, so that the parent always has room
+                if (keyCount(node) == TNodeCapacity)
+                {
+                    if (lockForSplit(node, version, parent, parentVersion))
+                    {
+                        split(node, parent);
+                        node->lock.writeUnlock();
+                        if (parent)
+                            parent->lock.writeUnlock();
+                    }
+                    restart = true;
+                    break;
+                }
+
+                if (node->isLeaf)
+                    break;
+
+                Inner* inner = asInner(node);
+                BaseNode* child = inner->children[childIndex(inner, key)];
+                if (!inner->lock.validate(version))
+                {
+                    restart = true;
+                    break;
+                }
+
+                uint64_t childVersion = child->lock.readLock();
+                if (!inner->lock.validate(version))
+                {
+                    restart = true;
+                    break;
+                }
+
+                parent = inner;
+                parentVersion = version;
+                node = child;
+                version = childVersion;
+            }
+
+            if (restart || !node->lock.tryUpgrade(version))
+                continue;
+
+            Leaf* leaf = asLeaf(node);
+            size_t count = leaf->count.load(std::memory_order_relaxed);
+            size_t index = lowerIndex(leaf, key);
+
+            if (index < count && !_less(key, leaf->keys[index]))
+            {
+                leaf->lock.writeUnlock();
+                return false;
+            }
+
+            std::copy_backward(leaf->keys.begin() + index, leaf->keys.begin() + count, leaf->keys.begin() + count + 1);
+            std::copy_backward(leaf->values.begin() + index, leaf->values.begin() + count, leaf->values.begin() + count + 1);
+            leaf->keys[index] = key;
+            leaf->values[index] = value;
+            leaf->count.store(count + 1, std::memory_order_relaxed);
+            leaf->lock.writeUnlock();
+
+            _size.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    bool ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::remove(const TKey& key)
+    {
+        while (true)
+        {
+            uint64_t version = 0;
+            Leaf* leaf = findLeaf(key, version);
+            if (!leaf || !leaf->lock.tryUpgrade(version))
+                continue;
+
+            size_t count = leaf->count.load(std::memory_order_relaxed);
+            size_t index = lowerIndex(leaf, key);
+
+            if (index == count || _less(key, leaf->keys[index]))
+            {
+                leaf->lock.writeUnlock();
+                return false;
+            }
+
+            std::copy(leaf->keys.begin() + index + 1, leaf->keys.begin() + count, leaf->keys.begin() + index);
+            std::copy(leaf->values.begin() + index + 1, leaf->values.begin() + count, leaf->values.begin() + index);
+            leaf->count.store(count - 1, std::memory_order_relaxed);
+            leaf->lock.writeUnlock();
+
+            _size.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    bool ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::search(const TKey& key, TValue& value) const
+    {
+        while (true)
+        {
+            uint64_t version = 0;
+            Leaf* leaf = findLeaf(key, version);
+            if (!leaf)
+                continue;
+
+            size_t index = lowerIndex(leaf, key);
+            bool found = index < keyCount(leaf) && !_less(key, leaf->keys[index]);
+            TValue copy = found ? leaf->values[index] : TValue{};
+
+            if (!leaf->lock.validate(version))
+                continue;
+
+            if (found)
+                value = copy;
+            return found;
+        }
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    size_t ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::size() const
+    {
+        return _size.load(std::memory_order_relaxed);
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    size_t ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::childIndex(const BaseNode* node, const TKey& key) const
+    {
+        return NodeSearch<TKey, TCompare>::upperBound(node->keys.data(), keyCount(node), key, _less);
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    size_t ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::lowerIndex(const BaseNode* node, const TKey& key) const
+    {
+        return NodeSearch<TKey, TCompare>::lowerBound(node->keys.data(), keyCount(node), key, _less);
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    typename ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::Leaf* ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::findLeaf(
+        const TKey& key,
+        uint64_t& version) const
+    {
+        BaseNode* node = _root.load(std::memory_order_acquire);
+        version = node->lock.readLock();
+        if (node != _root.load(std::memory_order_acquire))
+            return nullptr;
+
+        while (!node->isLeaf)
+        {
+            // The child pointer is only followed once the node is known unchanged,
+            // and the node is checked again once the child version is read: the
+            // child was not split in between
+            BaseNode* child = asInner(node)->children[childIndex(node, key)];
+            if (!node->lock.validate(version))
+                return nullptr;
+
+            uint64_t childVersion = child->lock.readLock();
+            if (!node->lock.validate(version))
+                return nullptr;
+
+            node = child;
+            version = childVersion;
+        }
+
+        return asLeaf(node);
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    bool ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::lockForSplit(
+        BaseNode* node,
+        uint64_t version,
+        Inner* parent,
+        uint64_t parentVersion)
+    {
+        if (parent && !parent->lock.tryUpgrade(parentVersion))
+            return false;
+
+        if (!node->lock.tryUpgrade(version))
+        {
+            if (parent)
+                parent->lock.writeUnlock();
+            return false;
+        }
+
+        return true;
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    void ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::split(BaseNode* node, Inner* parent)
+    {
+        size_t count = node->count.load(std::memory_order_relaxed);
+        size_t middle = count / 2;
+        BaseNode* sibling = nullptr;
+        TKey separator{};
+
+        if (node->isLeaf)
+        {
+            // Leaf split: the first key of the new leaf is copied up
+            Leaf* leaf = asLeaf(node);
+            Leaf* right = new Leaf();
+            std::copy(leaf->keys.begin() + middle, leaf->keys.begin() + count, right->keys.begin());
+            std::copy(leaf->values.begin() + middle, leaf->values.begin() + count, right->values.begin());
+            right->count.store(count - middle, std::memory_order_relaxed);
+            separator = right->keys[0];
+            sibling = right;
+        }
+        else
+        {
+            // Inner split: the middle key moves up
+            Inner* inner = asInner(node);
+            Inner* right = new Inner();
+            separator = inner->keys[middle];
+            std::copy(inner->keys.begin() + middle + 1, inner->keys.begin() + count, right->keys.begin());
+            std::copy(inner->children.begin() + middle + 1, inner->children.begin() + count + 1, right->children.begin());
+            right->count.store(count - middle - 1, std::memory_order_relaxed);
+            sibling = right;
+        }
+
+        node->count.store(middle, std::memory_order_relaxed);
+
+        if (parent)
+        {
+            size_t parentCount = parent->count.load(std::memory_order_relaxed);
+            size_t index = childIndex(parent, separator);
+            std::copy_backward(parent->keys.begin() + index, parent->keys.begin() + parentCount, parent->keys.begin() + parentCount + 1);
+            std::copy_backward(parent->children.begin() + index + 1, parent->children.begin() + parentCount + 1, parent->children.begin() + parentCount + 2);
+            parent->keys[index] = separator;
+            parent->children[index + 1] = sibling;
+            parent->count.store(parentCount + 1, std::memory_order_relaxed);
+            return;
+        }
+
+        // Published before the old root is unlocked, readers still holding it see it is no longer the root
+        Inner* root = new Inner();
+        root->keys[0] = separator;
+        root->children[0] = node;
+        root->children[1] = sibling;
+        root->count.store(1, std::memory_order_relaxed);
+        _root.store(root, std::memory_order_release);
+    }
+
+    template <typename TKey, typename TValue, typename TCompare, size_t TNodeCapacity>
+    void ConcurrentBPlusTree<TKey, TValue, TCompare, TNodeCapacity>::destroy(BaseNode* node)
+    {
+        if (node->isLeaf)
+        {
+            delete asLeaf(node);
+            return;
+        }
+
+        Inner* inner = asInner(node);
+        for (size_t i = 0; i <= inner->count.load(); ++i)
+            destroy(inner->children[i]);
+        delete inner;
+    }
+}
+
+#endif // DATA_STRUCTURE_CONCURRENT_BPLUS_TREE_H
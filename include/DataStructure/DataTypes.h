@@ -24,29 +24,53 @@ namespace Xale::DataStructure
     using FieldValue = std::variant<int, double, std::string, std::monostate>;
 
     /**
-     * @brief A single field in a row
+     * @brief Strict weak ordering of field values, used as index key comparator
+     *
+     * NULL sorts first, then numbers (integers and floats compared by value),
+     * then strings.
      */
-    struct Field
+    struct FieldValueLess
     {
-        std::string name;
-        FieldType type;
-        FieldValue value;
+        bool operator()(const FieldValue& a, const FieldValue& b) const
+        {
+            const int rankA = rank(a);
+            const int rankB = rank(b);
+            if (rankA != rankB)
+                return rankA < rankB;
 
-        Field() : name(""), type(FieldType::Null), value(std::monostate{}) {}
-        Field(std::string n, FieldType t, FieldValue v)
-            : name(std::move(n)), type(t), value(std::move(v)) {
+            if (rankA == 1)
+                return toDouble(a) < toDouble(b);
+            if (rankA == 2)
+                return std::get<std::string>(a) < std::get<std::string>(b);
+            return false;
         }
+
+        private:
+            static int rank(const FieldValue& v)
+            {
+                if (std::holds_alternative<std::monostate>(v)) return 0;
+                if (std::holds_alternative<std::string>(v)) return 2;
+                return 1;
+            }
+
+            static double toDouble(const FieldValue& v)
+            {
+                return std::holds_alternative<int>(v) ? static_cast<double>(std::get<int>(v)) : std::get<double>(v);
+            }
     };
 
     /**
      * @brief A row of data
+     *
+     * Holds one value per column, in the order of the schema of its table or
+     * result set: names and types are only stored in the schema.
      */
     struct Row
     {
-        std::vector<Field> fields;
+        std::vector<FieldValue> values;
 
         Row() = default;
-        explicit Row(std::vector<Field> f) : fields(std::move(f)) {}
+        explicit Row(std::vector<FieldValue> v) : values(std::move(v)) {}
     };
 
     /**
@@ -67,6 +91,19 @@ namespace Xale::DataStructure
               refTable(std::move(refTbl)), refColumn(std::move(refCol)) {
         }
     };
+
+    /**
+     * @brief Secondary index definition
+     */
+    struct IndexDefinition
+    {
+        std::string name;
+        std::string column; ///< Indexed column
+
+        IndexDefinition(std::string n, std::string col)
+            : name(std::move(n)), column(std::move(col)) {
+        }
+    };
 }
 
 #endif // DATA_STRUCTURE_DATA_TYPES_H
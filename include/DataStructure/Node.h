@@ -1,27 +1,64 @@
 #ifndef DATA_STRUCTURE_NODE_H
 #define DATA_STRUCTURE_NODE_H
 
-#include "Core/ExceptionHandler.h"
-
-#include <vector>
-#include <exception>
-#include <string>
+#include <algorithm>
+#include <array>
+#include <cstddef>
 
 namespace Xale::DataStructure
 {
     /**
-     * @brief Node struct for B+Tree implementation
+     * @brief Size of a CPU cache line, nodes are aligned on it
      */
-    template<typename TKey, typename TValue>
-    struct Node {
-        explicit Node(bool leaf) : parent(nullptr), next(nullptr), isLeaf(leaf) {}
-
-        std::vector<TKey> keys;
-        std::vector<TValue> values;       // leaf
-        std::vector<Node*> children;      // inner
-        Node* parent;
-        Node* next;
+    constexpr size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * @brief Default maximum number of keys per node, the key array spans about 1 KiB
+     */
+    template <typename TKey>
+    constexpr size_t defaultNodeCapacity()
+    {
+        return std::max<size_t>(7, 1024 / sizeof(TKey) - 1);
+    }
+
+    /**
+     * @brief Node header and keys, shared by inner nodes and leaves of the B+Tree
+     *
+     * Keys are stored inline in a fixed-capacity array, with one spare slot
+     * holding the overflowing key before a split.
+     */
+    template <typename TKey, size_t TCapacity>
+    struct alignas(CACHE_LINE_SIZE) Node
+    {
+        size_t count;   ///< Number of keys
         bool isLeaf;
+        std::array<TKey, TCapacity + 1> keys;
+
+        protected:
+            explicit Node(bool leaf) : count(0), isLeaf(leaf) {}
+    };
+
+    /**
+     * @brief Inner node: count keys separating count + 1 children
+     */
+    template <typename TKey, size_t TCapacity>
+    struct InnerNode : public Node<TKey, TCapacity>
+    {
+        std::array<Node<TKey, TCapacity>*, TCapacity + 2> children;
+
+        InnerNode() : Node<TKey, TCapacity>(false) {}
+    };
+
+    /**
+     * @brief Leaf node: values are stored apart from the keys, leaves are chained in key order
+     */
+    template <typename TKey, typename TValue, size_t TCapacity>
+    struct LeafNode : public Node<TKey, TCapacity>
+    {
+        std::array<TValue, TCapacity + 1> values;
+        LeafNode* next;
+
+        LeafNode() : Node<TKey, TCapacity>(true), next(nullptr) {}
     };
 }
 
@@ -0,0 +1,153 @@
+#ifndef DATA_STRUCTURE_NODE_POOL_H
+#define DATA_STRUCTURE_NODE_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Xale::DataStructure
+{
+    /**
+     * @brief Arena allocating objects of a single type in fixed-size chunks
+     *
+     * Destroyed objects go to a free list and their slot is reused by the next
+     * allocation. Chunks are only released with the pool.
+     */
+    template <typename T>
+    class NodePool
+    {
+        public:
+            /**
+             * @brief Constructor
+             * @param objectsPerChunk Number of objects allocated at once
+             */
+            explicit NodePool(size_t objectsPerChunk = 64)
+                : _objectsPerChunk(objectsPerChunk == 0 ? 1 : objectsPerChunk), _chunkUsed(0), _liveCount(0)
+            {}
+
+            NodePool(const NodePool&) = delete;
+            NodePool& operator=(const NodePool&) = delete;
+
+            /**
+             * @brief Move constructor, objects keep their address and the other pool is left empty
+             */
+            NodePool(NodePool&& other) noexcept
+                : _objectsPerChunk(other._objectsPerChunk), _chunkUsed(other._chunkUsed), _liveCount(other._liveCount),
+                _chunks(std::move(other._chunks)), _freeList(std::move(other._freeList))
+            {
+                other.reset();
+            }
+
+            /**
+             * @brief Move assignment, the objects of this pool must have been destroyed
+             */
+            NodePool& operator=(NodePool&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    _objectsPerChunk = other._objectsPerChunk;
+                    _chunkUsed = other._chunkUsed;
+                    _liveCount = other._liveCount;
+                    _chunks = std::move(other._chunks);
+                    _freeList = std::move(other._freeList);
+                    other.reset();
+                }
+                return *this;
+            }
+
+            /**
+             * @brief Construct an object in a free slot
+             * @param args Constructor arguments
+             * @return Pointer to the object
+             */
+            template <typename... TArgs>
+            T* create(TArgs&&... args)
+            {
+                void* slot = nullptr;
+
+                if (!_freeList.empty())
+                {
+                    slot = _freeList.back();
+                    _freeList.pop_back();
+                }
+                else
+                {
+                    if (_chunks.empty() || _chunkUsed == _objectsPerChunk)
+                    {
+                        _chunks.push_back(std::make_unique<Slot[]>(_objectsPerChunk));
+                        _chunkUsed = 0;
+                    }
+                    slot = &_chunks.back()[_chunkUsed++];
+                }
+
+                ++_liveCount;
+                return new (slot) T(std::forward<TArgs>(args)...);
+            }
+
+            /**
+             * @brief Destroy an object and give its slot back to the pool
+             * @param object Object created by this pool
+             */
+            void destroy(T* object)
+            {
+                object->~T();
+                _freeList.push_back(object);
+                --_liveCount;
+            }
+
+            /**
+             * @brief Free every chunk, all the objects must have been destroyed
+             */
+            void release()
+            {
+                std::vector<std::unique_ptr<Slot[]>>().swap(_chunks);
+                std::vector<void*>().swap(_freeList);
+                _chunkUsed = 0;
+            }
+
+            /**
+             * @brief Number of live objects
+             */
+            size_t size() const { return _liveCount; }
+
+            /**
+             * @brief Number of bytes allocated by the pool, chunks and free list
+             */
+            size_t allocatedBytes() const
+            {
+                return _chunks.size() * _objectsPerChunk * sizeof(Slot)
+                    + _chunks.capacity() * sizeof(std::unique_ptr<Slot[]>)
+                    + _freeList.capacity() * sizeof(void*);
+            }
+
+        private:
+            /**
+             * @brief Reset the counters of a moved-from pool
+             */
+            void reset()
+            {
+                _chunks.clear();
+                _freeList.clear();
+                _chunkUsed = 0;
+                _liveCount = 0;
+            }
+
+            /**
+             * @brief Uninitialized storage for one object
+             */
+            struct alignas(T) Slot
+            {
+                unsigned char bytes[sizeof(T)];
+            };
+
+            size_t _objectsPerChunk;
+            size_t _chunkUsed;
+            size_t _liveCount;
+            std::vector<std::unique_ptr<Slot[]>> _chunks;
+            std::vector<void*> _freeList;
+    };
+}
+
+#endif // DATA_STRUCTURE_NODE_POOL_H
@@ -0,0 +1,155 @@
+#ifndef DATA_STRUCTURE_NODE_SEARCH_H
+#define DATA_STRUCTURE_NODE_SEARCH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define XALE_DB_NODE_SEARCH_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+    #define XALE_DB_NODE_SEARCH_AVX2
+    #include <immintrin.h>
+#endif
+
+namespace Xale::DataStructure
+{
+    /**
+     * @brief Number of keys under which the in-node search scans linearly instead of halving
+     */
+    constexpr size_t NODE_LINEAR_SEARCH_MAX = 32;
+
+    /**
+     * @brief Search of a key in the sorted keys of a node
+     *
+     * Generic version, a binary search with the tree comparator.
+     */
+    template <typename TKey, typename TCompare, typename = void>
+    struct NodeSearch
+    {
+        /**
+         * @brief Index of the first key not less than a key
+         */
+        static size_t lowerBound(const TKey* keys, size_t count, const TKey& key, const TCompare& less)
+        {
+            return std::lower_bound(keys, keys + count, key, less) - keys;
+        }
+
+        /**
+         * @brief Index of the first key greater than a key
+         */
+        static size_t upperBound(const TKey* keys, size_t count, const TKey& key, const TCompare& less)
+        {
+            return std::upper_bound(keys, keys + count, key, less) - keys;
+        }
+    };
+
+    /**
+     * @brief Search for 32-bit integer keys ordered with std::less
+     *
+     * Being sorted, the position of a key is the number of keys before it: the
+     * keys are compared by 8 (AVX2) or 4 (SSE2) and the comparison masks counted.
+     * Large nodes are first narrowed by a binary search. Without SSE2, the
+     * generic search is used.
+     */
+    template <typename TKey>
+    struct NodeSearch<TKey, std::less<TKey>, std::enable_if_t<std::is_integral_v<TKey> && std::is_signed_v<TKey> && sizeof(TKey) == 4>>
+    {
+        static size_t lowerBound(const TKey* keys, size_t count, const TKey& key, const std::less<TKey>&)
+        {
+            // Keys less than the key
+            return search(keys, count, key, false);
+        }
+
+        static size_t upperBound(const TKey* keys, size_t count, const TKey& key, const std::less<TKey>&)
+        {
+            // Keys less than or equal to the key
+            return search(keys, count, key, true);
+        }
+
+        private:
+            /**
+             * @brief Number of bits set in a comparison mask
+             */
+            static size_t bitCount(unsigned mask)
+            {
+                size_t bits = 0;
+                for (; mask != 0; mask &= mask - 1)
+                    ++bits;
+                return bits;
+            }
+
+            static size_t search(const TKey* keys, size_t count, TKey key, bool isInclusive)
+            {
+                size_t first = 0;
+
+                while (count > NODE_LINEAR_SEARCH_MAX)
+                {
+                    size_t half = count / 2;
+                    const TKey& middle = keys[first + half];
+
+                    if (middle < key || (isInclusive && middle == key))
+                    {
+                        first += half + 1;
+                        count -= half + 1;
+                    }
+                    else
+                    {
+                        count = half;
+                    }
+                }
+
+                return first + countBefore(keys + first, count, key, isInclusive);
+            }
+
+            /**
+             * @brief Number of keys less than (or equal to, if inclusive) a key
+             */
+            static size_t countBefore(const TKey* keys, size_t count, TKey key, bool isInclusive)
+            {
+                size_t result = 0;
+                size_t i = 0;
+
+                // k < key, or k <= key as k < key + 1 (the key cannot be the maximum if inclusive)
+                if (isInclusive)
+                {
+                    if (key == std::numeric_limits<TKey>::max())
+                        return count;
+                    ++key;
+                }
+
+#if defined(XALE_DB_NODE_SEARCH_AVX2)
+                const __m256i key8 = _mm256_set1_epi32(static_cast<int32_t>(key));
+                for (; i + 8 <= count; i += 8)
+                {
+                    __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+                    __m256i isLess = _mm256_cmpgt_epi32(key8, chunk);
+                    result += bitCount(static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(isLess))));
+                }
+#endif
+
+#if defined(XALE_DB_NODE_SEARCH_SSE2)
+                const __m128i key4 = _mm_set1_epi32(static_cast<int32_t>(key));
+                for (; i + 4 <= count; i += 4)
+                {
+                    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i));
+                    __m128i isLess = _mm_cmplt_epi32(chunk, key4);
+                    result += bitCount(static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(isLess))));
+                }
+#endif
+
+                for (; i < count; ++i)
+                    result += keys[i] < key;
+
+                return result;
+            }
+    };
+}
+
+#endif // DATA_STRUCTURE_NODE_SEARCH_H
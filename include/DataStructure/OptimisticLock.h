@@ -0,0 +1,75 @@
+#ifndef DATA_STRUCTURE_OPTIMISTIC_LOCK_H
+#define DATA_STRUCTURE_OPTIMISTIC_LOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+namespace Xale::DataStructure
+{
+    /**
+     * @brief Version lock of a node, for optimistic lock coupling
+     *
+     * Readers do not write to the lock: they read the version, read the node,
+     * then validate that the version did not change meanwhile. Writers lock by
+     * making the version odd and bump it when unlocking, so every write is seen
+     * by the readers that overlapped it.
+     */
+    class OptimisticLock
+    {
+        public:
+            /**
+             * @brief Wait until the node is not locked and return its version
+             */
+            uint64_t readLock() const
+            {
+                uint64_t version = _version.load(std::memory_order_acquire);
+
+                for (int spins = 0; isLocked(version); ++spins)
+                {
+                    if (spins > 64)
+                        std::this_thread::yield();
+                    version = _version.load(std::memory_order_acquire);
+                }
+
+                return version;
+            }
+
+            /**
+             * @brief Check that the node did not change since a version was read
+             * @param version Version returned by readLock()
+             * @return True if the reads made since are consistent
+             */
+            bool validate(uint64_t version) const
+            {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return _version.load(std::memory_order_relaxed) == version;
+            }
+
+            /**
+             * @brief Turn a read into a write lock, if the node did not change
+             * @param version Version returned by readLock()
+             * @return True if locked, false if the node changed and the operation must restart
+             */
+            bool tryUpgrade(uint64_t version)
+            {
+                return _version.compare_exchange_strong(version, version + 1, std::memory_order_acquire);
+            }
+
+            /**
+             * @brief Release the write lock, publishing a new version
+             */
+            void writeUnlock()
+            {
+                _version.fetch_add(1, std::memory_order_release);
+            }
+
+        private:
+            static bool isLocked(uint64_t version) { return (version & 1) != 0; }
+
+            /** @brief Even when unlocked, odd while a writer holds the lock */
+            std::atomic<uint64_t> _version{ 0 };
+    };
+}
+
+#endif // DATA_STRUCTURE_OPTIMISTIC_LOCK_H
@@ -0,0 +1,88 @@
+#ifndef DATA_STRUCTURE_ROW_VERSION_H
+#define DATA_STRUCTURE_ROW_VERSION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Xale::DataStructure
+{
+    /**
+     * @brief Flag of the stamps of versions written by a transaction not committed yet
+     *
+     * A pending stamp is the flag combined with the transaction id, replaced by
+     * the commit timestamp on commit.
+     */
+    constexpr uint64_t PENDING_VERSION = 1ull << 63;
+
+    /**
+     * @brief End stamp of a version not deleted
+     */
+    constexpr uint64_t INFINITE_VERSION = ~0ull;
+
+    /**
+     * @brief Highest commit timestamp, a snapshot at it seeing every committed version
+     */
+    constexpr uint64_t LATEST_VERSION = PENDING_VERSION - 1;
+
+    /**
+     * @brief Slot linking a version to no older version
+     */
+    constexpr size_t NO_VERSION = static_cast<size_t>(-1);
+
+    /**
+     * @brief Point in time from which a statement reads the rows
+     *
+     * A statement sees the versions committed at or before its timestamp and
+     * not deleted by then, plus the changes of its own transaction.
+     */
+    struct Snapshot
+    {
+        uint64_t timestamp = LATEST_VERSION;   ///< Last commit visible
+        uint64_t transaction = 0;              ///< Pending stamp of the reading transaction, 0 for none
+
+        /**
+         * @brief Check if a version is visible
+         * @param begin Stamp of the transaction which created the version
+         * @param end Stamp of the transaction which deleted the version
+         */
+        bool sees(uint64_t begin, uint64_t end) const
+        {
+            const bool isBegun = begin == transaction || (!(begin & PENDING_VERSION) && begin <= timestamp);
+            const bool isEnded = end == transaction || (!(end & PENDING_VERSION) && end <= timestamp);
+            return isBegun && !isEnded;
+        }
+    };
+
+    /**
+     * @brief Lifetime of a row version
+     *
+     * Stamps are read by concurrent statements while the writer of the table
+     * changes them, hence atomic. A version ended by a committed transaction
+     * stays until no statement may see it any more, then is reclaimed.
+     */
+    struct RowVersion
+    {
+        std::atomic<uint64_t> begin;   ///< Commit timestamp, or pending stamp, of the creating transaction
+        std::atomic<uint64_t> end;     ///< Commit timestamp, or pending stamp, of the deleting transaction
+        size_t previous;               ///< Slot of the older version of the same primary key, NO_VERSION if none
+
+        RowVersion(uint64_t begin, uint64_t end, size_t previous) noexcept
+            :begin(begin), end(end), previous(previous)
+        {}
+
+        RowVersion(const RowVersion& other) noexcept
+            :begin(other.begin.load()), end(other.end.load()), previous(other.previous)
+        {}
+
+        RowVersion& operator=(const RowVersion& other) noexcept
+        {
+            begin.store(other.begin.load());
+            end.store(other.end.load());
+            previous = other.previous;
+            return *this;
+        }
+    };
+}
+
+#endif // DATA_STRUCTURE_ROW_VERSION_H
@@ -3,17 +3,57 @@
 
 #include "DataStructure/IDataTemplate.h"
 #include "DataStructure/BPlusTree.h"
+#include "DataStructure/ColumnarTable.h"
+#include "DataStructure/RowVersion.h"
 
+#include <atomic>
 #include <unordered_map>
+#include <unordered_set>
 #include <cstdint>
 #include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 namespace Xale::DataStructure
 {
+    /**
+     * @brief Minimum degree of the primary key index tree
+     */
+    constexpr int PRIMARY_INDEX_DEGREE = 32;
+
+    /**
+     * @brief Minimum degree of the secondary index trees
+     */
+    constexpr int SECONDARY_INDEX_DEGREE = 32;
+
+    /**
+     * @brief Fill factor of the index nodes built from the rows of a table, leaving room for later inserts
+     */
+    constexpr double INDEX_BULK_FILL_FACTOR = 0.9;
+
+    /**
+     * @brief Primary key index, mapping a primary key to its row slot
+     */
+    using PrimaryIndex = BPlusTree<FieldValue, size_t, FieldValueLess, 2 * PRIMARY_INDEX_DEGREE - 1>;
+
+    /**
+     * @brief Secondary index, mapping a column value to the slots of the rows holding it
+     */
+    using SecondaryIndexTree = BPlusTree<FieldValue, std::vector<size_t>, FieldValueLess, 2 * SECONDARY_INDEX_DEGREE - 1>;
+
     /**
      * @brief Represents a mutable and persistent dataset (table)
      *
      * Provides methods for schema definition, row manipulation, and serialization.
+     *
+     * Every row slot holds a version of a row. The versioned methods never
+     * change a row that statements may be reading: an update appends a new
+     * version and ends the old one, a delete ends the version. Statements read
+     * through a Snapshot and skip the versions it does not see, so they run
+     * while a single writer changes the table. Versions no statement sees any
+     * more are reclaimed by reclaimVersions(), once no statement reads the
+     * table. The other mutators change rows in place and need exclusive access.
      */
 	class Table : public IDataTemplate
     {
@@ -31,12 +71,53 @@ namespace Xale::DataStructure
             /** @copydoc IDataTemplate::getSchema */
             const std::vector<ColumnDefinition>& getSchema() const override;
 
-            /** @copydoc IDataTemplate::getRows */
+            /**
+             * @brief Get the row of every slot, versions and removed rows included
+             *
+             * Not safe while the table is written, use getRow() from concurrent statements.
+             * @return Rows, in slot order
+             */
             const std::vector<Row>& getRows() const override;
 
-            /** @copydoc IDataTemplate::getRowCount */
+            /**
+             * @brief Get the number of row slots, versions and removed rows included
+             *
+             * Safe while the table is written: slots appended meanwhile are
+             * versions the calling statement does not see.
+             */
             size_t getRowCount() const override;
 
+            /**
+             * @brief Get the row of a slot, safe while the table is written
+             *
+             * An empty row in a table with columns is a removed row, loaded
+             * from storage and not reclaimed yet.
+             * @param slot Slot lower than a getRowCount() read by the caller
+             */
+            const Row& getRow(size_t slot) const;
+
+            /**
+             * @brief Check if a snapshot sees the version at a slot
+             * @param slot Slot lower than a getRowCount() read by the caller
+             * @param snapshot Snapshot of the reading statement
+             */
+            bool isVisible(size_t slot, const Snapshot& snapshot) const;
+
+            /**
+             * @brief Check if a snapshot may miss some of the current slots
+             *
+             * When false, every slot below a getRowCount() read before the call
+             * is visible, and scans may skip the visibility checks.
+             * @param snapshot Snapshot of the reading statement
+             */
+            bool hasHiddenVersions(const Snapshot& snapshot) const;
+
+            /**
+             * @brief Check if the last committed state of a slot holds a row, the one persisted
+             * @param slot Slot of the row
+             */
+            bool hasCommittedRow(size_t slot) const;
+
             /** @copydoc IDataTemplate::getColumnCount */
             size_t getColumnCount() const override;
 
@@ -48,17 +129,108 @@ namespace Xale::DataStructure
 
             /**
              * @brief Add a new column to the table schema
+             *
+             * The first column flagged as primary key gets a unique index.
              * @param column Column definition to add
              */
             void addColumn(const ColumnDefinition& column);
 
+            /**
+             * @brief Get the position of a column in the schema
+             * @param columnName Name of the column
+             * @return Index of the column, -1 if it does not exist
+             */
+            int getColumnIndex(const std::string& columnName) const;
+
+            /**
+             * @brief Get the position of the indexed primary key column
+             * @return Index of the column, -1 if the table has no primary key
+             */
+            int getPrimaryKeyColumn() const;
+
+            /**
+             * @brief Look up a row through the primary key index
+             * @param key Primary key value
+             * @param slot Output slot of the row
+             * @param snapshot Snapshot of the reading statement
+             * @return True if a row visible to the snapshot has this key
+             */
+            bool findSlotByPrimaryKey(const FieldValue& key, size_t& slot, const Snapshot& snapshot = Snapshot()) const;
+
+            /**
+             * @brief Create a secondary index over a column
+             *
+             * The index is built from the current rows and maintained by every
+             * row modification.
+             * @param index Index definition
+             * @return False if an index with this name exists or the column does not exist
+             */
+            bool createIndex(const IndexDefinition& index);
+
+            /**
+             * @brief Drop a secondary index
+             * @param indexName Name of the index
+             * @return False if the index does not exist
+             */
+            bool dropIndex(const std::string& indexName);
+
+            /**
+             * @brief Get the secondary index definitions
+             * @return Index definitions, in creation order
+             */
+            std::vector<IndexDefinition> getIndexes() const;
+
+            /**
+             * @brief Check if lookups on a column go through an index
+             * @param columnName Name of the column
+             * @return True if the column is the primary key or has a secondary index
+             */
+            bool isIndexed(const std::string& columnName) const;
+
+            /**
+             * @brief Memory used by the nodes of the primary key and secondary indexes
+             *
+             * Measured after each change of the indexes, so that it can be read
+             * while the writer of the table changes them.
+             * @return Number of bytes
+             */
+            size_t getIndexMemoryUsage() const;
+
+            /**
+             * @brief Get the row slots of the table stored column by column, for scans
+             *
+             * The columnar copy is built on the first call, removed rows being
+             * NULL rows. A copy is never changed once returned: any change of
+             * the rows drops it until the next call. Concurrent statements may
+             * call it, the first one building the copy, and keep the copy they
+             * got while the table changes.
+             * @return Columnar copy of the row slots
+             */
+            std::shared_ptr<const ColumnarTable> getColumnar() const;
+
+            /**
+             * @brief Free the columnar copy of the rows, if any
+             */
+            void releaseColumnar();
+
             /**
              * @brief Insert a new row into the table
              * @param row Row to insert
-             * @return True if insertion is successful, false otherwise
+             * @return True if insertion is successful, false if the row does not match
+             *         the schema or its primary key is NULL or already used
              */
             bool insertRow(const Row& row);
 
+            /**
+             * @brief Load rows into an empty table, building its indexes bottom-up
+             *
+             * Faster than inserting the rows one by one, used when loading a table.
+             * @param rows Rows to load, in slot order
+             * @return True if loaded, false if the table already has rows, a row does
+             *         not match the schema or a primary key is NULL or used twice
+             */
+            bool loadRows(std::vector<Row> rows);
+
             /**
              * @brief Update rows matching a condition
              * @param columnName Name of the column to match
@@ -71,6 +243,19 @@ namespace Xale::DataStructure
                 const FieldValue& value,
                 const std::unordered_map<std::string, FieldValue>& updates);
 
+            /**
+             * @brief Update the rows at the given slots
+             *
+             * Throws a DbException, before any change, if the primary key would
+             * become NULL or duplicated.
+             * @param slots Slots of the rows to update
+             * @param updates Map of column names to new values
+             * @return Number of rows updated
+             */
+            size_t updateRowsAt(
+                const std::vector<size_t>& slots,
+                const std::unordered_map<std::string, FieldValue>& updates);
+
             /**
              * @brief Delete rows matching a condition
              * @param columnName Name of the column to match
@@ -79,13 +264,174 @@ namespace Xale::DataStructure
              */
             size_t deleteRows(const std::string& columnName, const FieldValue& value);
 
+            /**
+             * @brief Delete the rows at the given slots
+             *
+             * Rows are removed by moving the last row into the freed slot, so
+             * the slots of the remaining rows may change.
+             * @param slots Slots of the rows to delete
+             * @return Number of rows deleted
+             */
+            size_t deleteRowsAt(std::vector<size_t> slots);
+
+            /**
+             * @brief Insert a new row version, created by a transaction
+             *
+             * The version is hidden from other statements until commitVersions().
+             * @param row Row to insert
+             * @param transaction Pending stamp of the transaction
+             * @return False if the row does not match the schema or its primary key
+             *         is NULL or used by a row the transaction sees
+             */
+            bool insertVersion(const Row& row, uint64_t transaction);
+
+            /**
+             * @brief Update the rows at the given slots by appending new versions
+             *
+             * The old versions are ended by the transaction. Throws a DbException,
+             * before any change, if the primary key would become NULL or duplicated.
+             * @param slots Slots of the versions to update, visible to the transaction
+             * @param updates Map of column names to new values
+             * @param transaction Pending stamp of the transaction
+             * @return Number of rows updated
+             */
+            size_t updateVersionsAt(
+                const std::vector<size_t>& slots,
+                const std::unordered_map<std::string, FieldValue>& updates,
+                uint64_t transaction);
+
+            /**
+             * @brief Delete the rows at the given slots by ending their versions
+             * @param slots Slots of the versions to delete, visible to the transaction
+             * @param transaction Pending stamp of the transaction
+             * @return Number of rows deleted
+             */
+            size_t deleteVersionsAt(std::vector<size_t> slots, uint64_t transaction);
+
+            /**
+             * @brief Make the versions written by a transaction visible from a commit timestamp
+             * @param transaction Pending stamp of the transaction
+             * @param timestamp Commit timestamp, greater than any snapshot taken so far
+             */
+            void commitVersions(uint64_t transaction, uint64_t timestamp);
+
+            /**
+             * @brief Undo the versions written by a transaction
+             *
+             * Its inserted versions become dead, its deleted versions live again.
+             * @param transaction Pending stamp of the transaction
+             */
+            void rollbackVersions(uint64_t transaction);
+
+            /**
+             * @brief Remove the dead versions and free the storage left by the readers
+             *
+             * Dead versions are removed like deleteRowsAt() does, so the slots of
+             * the remaining rows may change. No statement may read the table and
+             * no transaction may have pending versions in it.
+             * @return Number of versions removed
+             */
+            size_t reclaimVersions();
+
+            /**
+             * @brief Number of versions ended by committed or rolled back transactions, not reclaimed yet
+             */
+            size_t getDeadVersionCount() const;
+
+            /**
+             * @brief Find the slots of the rows matching a condition
+             *
+             * Uses the primary key index or a secondary index when the column has one.
+             * @param columnName Name of the column to match
+             * @param value Value to match in the column
+             * @param snapshot Snapshot of the reading statement
+             * @return Slots of the matching rows
+             */
+            std::vector<size_t> findSlots(const std::string& columnName, const FieldValue& value,
+                const Snapshot& snapshot = Snapshot()) const;
+
+            /**
+             * @brief Find the slots of the rows whose value in a column lies in a range
+             *
+             * Values are compared with FieldValueLess. When the column is indexed,
+             * only the leaves of its index between the bounds are walked.
+             * @param columnName Name of the column to match
+             * @param lower Lower bound, nullptr for none
+             * @param lowerInclusive Whether a value equal to the lower bound matches
+             * @param upper Upper bound, nullptr for none
+             * @param upperInclusive Whether a value equal to the upper bound matches
+             * @param snapshot Snapshot of the reading statement
+             * @return Slots of the matching rows, in ascending order
+             */
+            std::vector<size_t> findSlotsInRange(
+                const std::string& columnName,
+                const FieldValue* lower,
+                bool lowerInclusive,
+                const FieldValue* upper,
+                bool upperInclusive,
+                const Snapshot& snapshot = Snapshot()) const;
+
+            /**
+             * @brief Get the slots of the rows ordered by their value in a column
+             *
+             * Values are compared with FieldValueLess. When the column is indexed,
+             * the leaves of its index are walked, otherwise the slots are sorted.
+             * Rows with equivalent values come in ascending slot order.
+             * @param columnName Name of the column
+             * @param snapshot Snapshot of the reading statement
+             * @return Slots of every visible row, empty if the column does not exist
+             */
+            std::vector<size_t> findSlotsInKeyOrder(const std::string& columnName, const Snapshot& snapshot = Snapshot()) const;
+
             /**
              * @brief Find rows matching a condition
              * @param columnName Name of the column to match
              * @param value Value to match in the column
+             * @param snapshot Snapshot of the reading statement
              * @return Vector of matching rows
              */
-            std::vector<Row> findRows(const std::string& columnName, const FieldValue& value) const;
+            std::vector<Row> findRows(const std::string& columnName, const FieldValue& value,
+                const Snapshot& snapshot = Snapshot()) const;
+
+            /**
+             * @brief Overwrite the row at a given slot, or append it if the slot is the row count
+             *
+             * An empty row marks the slot as removed, reclaimed by reclaimVersions().
+             * @param slot Slot of the row
+             * @param row New row
+             * @return False if the slot is past the end or the row does not match the schema
+             */
+            bool setRow(size_t slot, const Row& row);
+
+            /**
+             * @brief Remove the rows past a given count
+             * @param count Number of rows to keep
+             */
+            void truncateRows(size_t count);
+
+            /**
+             * @brief Get the row slots modified since the last clearChanges()
+             *
+             * A slot greater or equal to getRowCount() was removed.
+             * @return Set of modified slots
+             */
+            const std::unordered_set<size_t>& getDirtySlots() const;
+
+            /**
+             * @brief Check if the schema changed since the last clearChanges()
+             * @return True if the schema is dirty
+             */
+            bool isSchemaDirty() const;
+
+            /**
+             * @brief Mark the schema and every row as modified
+             */
+            void markAllDirty();
+
+            /**
+             * @brief Forget tracked changes, once they have been persisted
+             */
+            void clearChanges();
 
             /**
              * @brief Serialize the table to a byte vector
@@ -100,6 +446,36 @@ namespace Xale::DataStructure
              */
             static Table deserialize(const std::vector<char>& data);
 
+            /**
+             * @brief Serialize the table name, schema and index definitions (without rows)
+             * @return Serialized data
+             */
+            std::vector<char> serializeSchema() const;
+
+            /**
+             * @brief Deserialize a table name, schema and index definitions (without rows)
+             * @param data Serialized data
+             * @param size Size of the serialized data
+             * @return Empty Table with the deserialized schema and indexes
+             */
+            static Table deserializeSchema(const char* data, size_t size);
+
+            /**
+             * @brief Serialize a single row
+             * @param row Row to serialize
+             * @return Serialized data
+             */
+            static std::vector<char> serializeRow(const Row& row);
+
+            /**
+             * @brief Deserialize a single row
+             * @param data Serialized data
+             * @param size Size of the serialized data
+             * @param schema Schema of the table owning the row
+             * @return Deserialized row
+             */
+            static Row deserializeRow(const char* data, size_t size, const std::vector<ColumnDefinition>& schema);
+
         private:
             /** @brief Table name */
             std::string _name;
@@ -107,11 +483,147 @@ namespace Xale::DataStructure
             /** @brief Table schema (column definitions) */
             std::vector<ColumnDefinition> _schema;
 
-            /** @brief Table rows (data) */
+            /** @brief Table rows (data), one version per slot */
             std::vector<Row> _rows;
 
-            /** @brief Primary index for fast row lookup */
-            std::unique_ptr<Xale::DataStructure::BPlusTree<int, Row>> _primaryIndex;
+            /** @brief Lifetime of the version of each slot */
+            std::vector<RowVersion> _versions;
+
+            /**
+             * @brief State read by concurrent statements, behind a pointer to keep tables movable
+             */
+            struct SharedState
+            {
+                std::atomic<const Row*> rows{ nullptr };              ///< Published _rows storage
+                std::atomic<const RowVersion*> versions{ nullptr };   ///< Published _versions storage
+                std::atomic<size_t> slotCount{ 0 };                   ///< Slots published, stored last
+                std::atomic<size_t> endedCount{ 0 };                  ///< Versions with an end stamp
+                std::atomic<size_t> pendingCount{ 0 };                ///< Versions begun by a pending transaction
+                std::atomic<uint64_t> lastCommit{ 0 };                ///< Timestamp of the last commit of versions
+                std::atomic<size_t> indexMemory{ 0 };                 ///< Bytes of the index nodes, measured by the writer
+                std::shared_mutex indexMutex;                         ///< Index lookups against index changes by the writer
+                std::mutex columnarMutex;                             ///< Lazy build of the columnar copy
+            };
+
+            /** @brief State read by concurrent statements */
+            std::unique_ptr<SharedState> _shared = std::make_unique<SharedState>();
+
+            /** @brief Storage replaced while statements may read it, freed by reclaimVersions() */
+            std::vector<std::vector<Row>> _retiredRows;
+            std::vector<std::vector<RowVersion>> _retiredVersions;
+
+            /** @brief Slots of the versions begun and ended by pending transactions */
+            std::vector<size_t> _pendingBegins;
+            std::vector<size_t> _pendingEnds;
+
+            /** @brief Slots of the dead versions, reclaimed by reclaimVersions() */
+            std::vector<size_t> _deadSlots;
+
+            /** @brief Columnar copy of the row slots, built by getColumnar() */
+            mutable std::shared_ptr<ColumnarTable> _columnar;
+
+            /** @brief Row slots modified since the last persisted state */
+            std::unordered_set<size_t> _dirtySlots;
+
+            /** @brief Whether the schema changed since the last persisted state */
+            bool _schemaDirty = true;
+
+            /**
+             * @brief Remove a row by moving the last row into its slot
+             * @param slot Slot of the row to remove
+             */
+            void removeRowAt(size_t slot);
+
+            /**
+             * @brief Check if a slot holds a removed row
+             */
+            bool isRemoved(size_t slot) const;
+
+            /**
+             * @brief Make the row storage and slot count visible to concurrent statements
+             */
+            void publishRows();
+
+            /**
+             * @brief Make room for one more slot without moving rows statements may read
+             */
+            void reserveSlot();
+
+            /**
+             * @brief Append a version, visible to statements once its transaction commits
+             * @param row Row of the version
+             * @param begin Stamp of the creating transaction
+             * @param previous Slot of the older version of its primary key
+             */
+            void appendVersion(const Row& row, uint64_t begin, size_t previous);
+
+            /**
+             * @brief Find the version of a primary key a snapshot sees, from the newest
+             * @param slot Slot of the newest version of the key
+             * @param snapshot Snapshot of the reader
+             * @return Slot of the version, NO_VERSION if none
+             */
+            size_t findVersion(size_t slot, const Snapshot& snapshot) const;
+
+            /**
+             * @brief Replace a slot in the version chain of a primary key
+             * @param key Primary key of the chain
+             * @param slot Slot to replace
+             * @param replacement New slot, NO_VERSION to unlink the slot
+             */
+            void relinkVersion(const FieldValue& key, size_t slot, size_t replacement);
+
+            /**
+             * @brief Rebuild the primary key index from the rows
+             * @return False if a primary key is NULL or used twice, the index is then left unchanged
+             */
+            bool rebuildPrimaryIndex();
+
+            /** @brief Position of the indexed primary key column, -1 if none */
+            int _primaryKeyColumn = -1;
+
+            /** @brief Primary index mapping a primary key to its row slot */
+            std::unique_ptr<PrimaryIndex> _primaryIndex;
+
+            /**
+             * @brief Secondary index mapping a column value to the slots of the rows holding it
+             */
+            struct SecondaryIndex
+            {
+                IndexDefinition definition;
+                size_t column;
+                std::unique_ptr<SecondaryIndexTree> tree;
+            };
+
+            /** @brief Secondary indexes, in creation order */
+            std::vector<SecondaryIndex> _secondaryIndexes;
+
+            /**
+             * @brief Find the secondary index of a column
+             * @param column Position of the column
+             * @return Pointer to the index, nullptr if the column has none
+             */
+            const SecondaryIndex* findSecondaryIndex(size_t column) const;
+
+            /**
+             * @brief Build a secondary index from the rows
+             */
+            void buildSecondaryIndex(SecondaryIndex& index);
+
+            /**
+             * @brief Add the row at a slot to a secondary index
+             */
+            void indexSlot(SecondaryIndex& index, size_t slot);
+
+            /**
+             * @brief Remove the row at a slot from a secondary index
+             */
+            void unindexSlot(SecondaryIndex& index, size_t slot);
+
+            /**
+             * @brief Measure the memory of the indexes once they changed, for getIndexMemoryUsage()
+             */
+            void measureIndexMemory();
         };
 }
 
@@ -48,6 +48,7 @@ namespace Xale::Engine
         private:
             Xale::Query::IParser* _parser;
             Xale::Execution::IExecutor* _executor;
+            std::unique_ptr<Xale::Execution::IExecutionState> _state; ///< Open transaction, kept from one query to the next
             std::unique_ptr<Xale::DataStructure::ResultSet> _results;
             Xale::Query::StatementType _lastStatementType;
             std::vector<std::string> _multiResponses; ///< Accumulated responses for multi-query
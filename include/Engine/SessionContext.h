@@ -0,0 +1,42 @@
+#ifndef ENGINE_SESSION_CONTEXT_H
+#define ENGINE_SESSION_CONTEXT_H
+
+#include "Engine/QueryEngine.h"
+#include "Execution/IExecutor.h"
+#include "Query/BasicParser.h"
+#include "Query/BasicTokenizer.h"
+
+namespace Xale::Engine
+{
+    /**
+     * @brief Execution state of a single client: its own tokenizer, parser and result buffers
+     *
+     * The tokenizer, the parser and the QueryEngine keep state from one query
+     * to the next, so each client runs its queries through its own context,
+     * one at a time. Contexts share the executor, which locks the tables of
+     * every statement.
+     */
+    class SessionContext
+    {
+        public:
+            /**
+             * @param executor Executor shared by every session, safe to call from several threads
+             */
+            explicit SessionContext(Xale::Execution::IExecutor& executor);
+
+            SessionContext(const SessionContext&) = delete;
+            SessionContext& operator=(const SessionContext&) = delete;
+
+            /**
+             * @brief Query engine of the session
+             */
+            QueryEngine& getQueryEngine();
+
+        private:
+            Xale::Query::BasicTokenizer _tokenizer;
+            Xale::Query::BasicParser _parser;
+            QueryEngine _queryEngine;
+    };
+}
+
+#endif // ENGINE_SESSION_CONTEXT_H
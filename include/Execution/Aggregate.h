@@ -0,0 +1,95 @@
+#ifndef EXECUTION_AGGREGATE_H
+#define EXECUTION_AGGREGATE_H
+
+#include "DataStructure/ColumnVector.h"
+#include "DataStructure/DataTypes.h"
+
+#include <cstdint>
+#include <string>
+
+namespace Xale::Execution
+{
+    /**
+     * @brief Aggregate function of a SELECT statement
+     */
+    enum class AggregateFunction
+    {
+        Count, ///< Number of rows, or of values that are not NULL
+        Sum,   ///< Sum of the numeric values
+        Avg,   ///< Mean of the numeric values, as a float
+        Min,   ///< Smallest value, ordered by FieldValueLess
+        Max    ///< Largest value, ordered by FieldValueLess
+    };
+
+    /**
+     * @brief Parse the name of an aggregate function
+     * @param name Name as written in the query, case-insensitive
+     * @param out Parsed function
+     * @return False if the name is not an aggregate function
+     */
+    bool parseAggregateFunction(const std::string& name, AggregateFunction& out);
+
+    /**
+     * @brief Name of an aggregate function, in upper case
+     */
+    const char* aggregateFunctionName(AggregateFunction function);
+
+    /**
+     * @brief Running state of an aggregate function over a group of rows
+     *
+     * NULL values are ignored, and SUM and AVG also ignore strings. Integers
+     * are summed exactly on 64 bits, and the sum stays an integer while no
+     * float is added and it fits one. Without any value, COUNT gives 0 and the
+     * other functions give NULL.
+     */
+    class Accumulator
+    {
+        public:
+            /**
+             * @brief Construct an empty accumulator
+             * @param function Aggregate function computed
+             */
+            explicit Accumulator(AggregateFunction function);
+
+            /**
+             * @brief Add a value
+             * @param value Value of a row
+             */
+            void add(const Xale::DataStructure::FieldValue& value);
+
+            /**
+             * @brief Count rows, for COUNT(*)
+             * @param count Number of rows
+             */
+            void addRows(size_t count);
+
+            /**
+             * @brief Add every value of a column, through tight loops over integer and float columns
+             *
+             * NULL values are stored as zeros in the columns, so sums read the
+             * arrays without looking at the NULL bitmap. Sums run over several
+             * independent lanes, which the compiler keeps in vector registers.
+             * @param column Column to add
+             */
+            void addColumn(const Xale::DataStructure::ColumnVector& column);
+
+            /**
+             * @brief Value of the function over the values added
+             */
+            Xale::DataStructure::FieldValue result() const;
+
+        private:
+            AggregateFunction _function;
+            int64_t _count = 0;        ///< Values, or rows for COUNT(*)
+            int64_t _numericCount = 0; ///< Integer and float values
+            int64_t _integerSum = 0;
+            double _floatSum = 0;
+            bool _hasFloat = false;    ///< Whether a float was summed, or the integer sum overflowed
+            Xale::DataStructure::FieldValue _extreme = std::monostate{}; ///< Smallest or largest value, NULL before the first one
+
+            void addInteger(int64_t value, int64_t count);
+            void addExtreme(const Xale::DataStructure::FieldValue& value);
+    };
+}
+
+#endif // EXECUTION_AGGREGATE_H
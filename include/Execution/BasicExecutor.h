@@ -4,6 +4,10 @@
 #include "Execution/IExecutor.h"
 #include "Core/ExceptionHandler.h"
 #include "Execution/TableManager.h"
+#include "Execution/ColumnFilter.h"
+#include "Execution/Operators.h"
+#include "Execution/PlanNode.h"
+#include "Execution/Transaction.h"
 #include "Query/Statement.h"
 #include "DataStructure/DataTypes.h"
 
@@ -13,6 +17,16 @@ namespace Xale::Execution
 {
     /**
      * @brief Basic implementation of the IExecutor interface, responsible for executing SQL statements and returning results.
+     *
+     * Statements may be executed from several threads at once: each one holds
+     * the locks of the tables it reads or writes (see TableManager::lockTables())
+     * until its result set is complete. SELECTs read the snapshot of the last
+     * commit, so they run in parallel with each other and with the write of a
+     * table, which runs in its own transaction and commits when it completes.
+     *
+     * Between BEGIN and COMMIT, the statements of a client share its
+     * Transaction instead: each one reads the last commit plus the changes of
+     * the transaction, and the changes are saved once, by COMMIT.
      */
 	class BasicExecutor : public IExecutor
     {
@@ -20,46 +34,99 @@ namespace Xale::Execution
             /**
              * @brief Constructs a BasicExecutor with a reference to the TableManager.
              * @param tableManager Reference to the TableManager for managing database tables.
+             * @param lockTimeout Longest wait of a transaction for a table written by another one.
              */
-            BasicExecutor(TableManager& tableManager);
+            BasicExecutor(TableManager& tableManager, std::chrono::milliseconds lockTimeout = DEFAULT_LOCK_TIMEOUT);
 
             /**
              * @copydoc IExecutor::execute
-             * @param statement Pointer to the SQL statement to be executed.
+             * @param statement Pointer to the SQL statement to be executed, outside of any transaction.
              * @return A unique pointer to the ResultSet containing the results of the execution.
              */
             std::unique_ptr<Xale::DataStructure::ResultSet> execute(Xale::Query::Statement* statement) override;
+
+            /**
+             * @brief Executes a SQL statement of a client, in its transaction if one is open.
+             * @param statement Pointer to the SQL statement to be executed.
+             * @param state Transaction of the client, created by createState().
+             * @return A unique pointer to the ResultSet containing the results of the execution.
+             * @throws DbException if a table or an index is created or dropped in a transaction.
+             */
+            std::unique_ptr<Xale::DataStructure::ResultSet> execute(Xale::Query::Statement* statement, IExecutionState& state) override;
+
+            /**
+             * @brief Creates the Transaction of a new client, not open yet.
+             * @return The transaction, to pass with each statement of the client.
+             */
+            std::unique_ptr<IExecutionState> createState() override;
         
         private:
             TableManager& _tableManager;
+            std::chrono::milliseconds _lockTimeout;
+
+            /**
+             * @brief Takes the locks a statement needs: the catalog alone for CREATE and DROP statements,
+             *        otherwise the tables it reads shared. Changed tables are locked by their transaction.
+             * @param statement The statement about to be executed.
+             * @return The locks, held until destroyed.
+             */
+            TableLocks lockStatement(const Xale::Query::Statement& statement);
 
             /**
-             * @brief Executes a SELECT statement and returns the result set.
+             * @brief Executes a SELECT statement through the plan of the QueryPlanner, pulling its rows into the result set.
              * @param stmt Pointer to the SELECT statement to be executed.
+             * @param snapshot The snapshot the tables are read from.
              * @return A unique pointer to the ResultSet containing the results of the SELECT execution.
              */
-            std::unique_ptr<Xale::DataStructure::ResultSet> executeSelect(Xale::Query::SelectStatement* stmt);
+            std::unique_ptr<Xale::DataStructure::ResultSet> executeSelect(Xale::Query::SelectStatement* stmt,
+                const Xale::DataStructure::Snapshot& snapshot);
+
+            /**
+             * @brief Executes an EXPLAIN statement and returns the plan of its SELECT, one line per row.
+             * @param stmt Pointer to the EXPLAIN statement to be executed.
+             * @return A unique pointer to the ResultSet holding the plan in a "plan" column.
+             */
+            std::unique_ptr<Xale::DataStructure::ResultSet> executeExplain(Xale::Query::ExplainStatement* stmt);
+
+            /**
+             * @brief Builds the operator executing a node of a query plan, and the operators of its children.
+             * @param node The node to execute.
+             * @param snapshot The snapshot the tables are read from.
+             * @return The operator producing the rows of the node, with the columns of its schema.
+             */
+            std::unique_ptr<Operator> buildOperator(const PlanNode& node, const Xale::DataStructure::Snapshot& snapshot);
+
+            /**
+             * @brief Executes an INSERT, UPDATE or DELETE statement in a transaction.
+             * @param statement The statement to be executed.
+             * @param transaction The open transaction of the client, or one of its own committed when it completes.
+             * @return A unique pointer to the ResultSet containing the results of the execution.
+             */
+            std::unique_ptr<Xale::DataStructure::ResultSet> executeChange(Xale::Query::Statement* statement, Transaction& transaction);
             
             /**
              * @brief Executes an INSERT statement and returns the result set.
              * @param stmt Pointer to the INSERT statement to be executed.
+             * @param transaction The open transaction writing the table.
              * @return A unique pointer to the ResultSet containing the results of the INSERT execution.
              */
-            std::unique_ptr<Xale::DataStructure::ResultSet> executeInsert(Xale::Query::InsertStatement* stmt);
+            std::unique_ptr<Xale::DataStructure::ResultSet> executeInsert(Xale::Query::InsertStatement* stmt, Transaction& transaction);
             
             /**
              * @brief Executes an UPDATE statement and returns the result set.
              * @param stmt Pointer to the UPDATE statement to be executed.
+             * @param transaction The open transaction writing the table.
              * @return A unique pointer to the ResultSet containing the results of the UPDATE execution.
              */
-            std::unique_ptr<Xale::DataStructure::ResultSet> executeUpdate(Xale::Query::UpdateStatement* stmt);
+            std::unique_ptr<Xale::DataStructure::ResultSet> executeUpdate(Xale::Query::UpdateStatement* stmt, Transaction& transaction);
             
             /**
              * @brief Executes a DELETE statement and returns the result set.
              * @param stmt Pointer to the DELETE statement to be executed.
+             * @param transaction The open transaction writing the table.
              * @return A unique pointer to the ResultSet containing the results of the DELETE execution.
              */
-            std::unique_ptr<Xale::DataStructure::ResultSet> executeDelete(Xale::Query::DeleteStatement* stmt);
+            std::unique_ptr<Xale::DataStructure::ResultSet> executeDelete(Xale::Query::DeleteStatement* stmt, Transaction& transaction);
             
             /**
             * @brief Executes a CREATE statement and returns the result set.
@@ -74,6 +141,20 @@ namespace Xale::Execution
              * @return A unique pointer to the ResultSet containing the results of the DROP execution.
              */
             std::unique_ptr<Xale::DataStructure::ResultSet> executeDrop(Xale::Query::DropStatement* stmt);
+
+            /**
+             * @brief Executes a CREATE INDEX statement and returns the result set.
+             * @param stmt Pointer to the CREATE INDEX statement to be executed.
+             * @return A unique pointer to the ResultSet containing the results of the CREATE INDEX execution.
+             */
+            std::unique_ptr<Xale::DataStructure::ResultSet> executeCreateIndex(Xale::Query::CreateIndexStatement* stmt);
+
+            /**
+             * @brief Executes a DROP INDEX statement and returns the result set.
+             * @param stmt Pointer to the DROP INDEX statement to be executed.
+             * @return A unique pointer to the ResultSet containing the results of the DROP INDEX execution.
+             */
+            std::unique_ptr<Xale::DataStructure::ResultSet> executeDropIndex(Xale::Query::DropIndexStatement* stmt);
             
             /**
              * @brief Executes a LIST statement and returns the result set.
@@ -82,6 +163,12 @@ namespace Xale::Execution
              */
             std::unique_ptr<Xale::DataStructure::ResultSet> executeList(Xale::Query::ListStatement* stmt);
 
+            /**
+             * @brief Refuses a change growing the indexes once they reached the memory limit.
+             * @throws DbException if the indexes use at least the limit set on the table manager.
+             */
+            void checkIndexMemoryLimit() const;
+
             /**
              * @brief Evaluates an expression and returns its value.
              * @param expr The expression to be evaluated.
@@ -89,13 +176,51 @@ namespace Xale::Execution
              */
             Xale::DataStructure::FieldValue evaluateExpression(const Xale::Query::Expression& expr);
             
+            /**
+             * @brief Finds the position of a column in a schema.
+             * @param schema The schema to search.
+             * @param columnName The column name, optionally prefixed by its table ("users.id").
+             * @return The position of the first column with this name, -1 if there is none.
+             */
+            static int findColumn(const std::vector<Xale::DataStructure::ColumnDefinition>& schema, const std::string& columnName);
+
             /**
              * @brief Evaluates a condition on a given row.
              * @param row The row to be evaluated.
-             * @param where The WHERE clause containing the condition.
+             * @param condition The condition, bound to the schema of the row.
              * @return True if the condition is met, false otherwise.
              */
-            bool evaluateCondition(const Xale::DataStructure::Row& row, const Xale::Query::WhereClause* where);
+            static bool evaluateCondition(const Xale::DataStructure::Row& row, const BoundCondition& condition);
+
+            /**
+             * @brief Finds the slots of the rows of a table matching a condition.
+             *
+             * An equality or an ordered comparison (<, <=, >, >=) on an indexed column
+             * (primary key or secondary index) is answered through the index, any
+             * other condition scans the table.
+             * @param table The table to search.
+             * @param condition The condition, bound to the schema of the table.
+             * @param scanColumns Whether a scan filters the columnar copy of the table batch by batch,
+             *        worth it for reads, instead of the rows.
+             * @param snapshot The snapshot whose visible rows are matched.
+             * @return The slots of the matching rows, in ascending order.
+             */
+            std::vector<size_t> findMatchingSlots(const Xale::DataStructure::Table& table, const BoundCondition& condition, bool scanColumns,
+                const Xale::DataStructure::Snapshot& snapshot);
+
+            /**
+             * @brief Finds the slots of the rows of a table matching a WHERE clause.
+             *
+             * The clause is compiled once and evaluated on every row, or only on the
+             * rows found through the index of a comparison joined to it by AND.
+             * @param table The table to search.
+             * @param where The WHERE clause, may be null to match every row.
+             * @param snapshot The snapshot whose visible rows are matched.
+             * @return The slots of the matching rows, in ascending order.
+             * @throws DbException if the clause is not a condition.
+             */
+            std::vector<size_t> findMatchingSlots(const Xale::DataStructure::Table& table, const Xale::Query::WhereClause* where,
+                const Xale::DataStructure::Snapshot& snapshot);
     };
 }
 
@@ -0,0 +1,93 @@
+#ifndef EXECUTION_COLUMN_FILTER_H
+#define EXECUTION_COLUMN_FILTER_H
+
+#include "DataStructure/ColumnVector.h"
+#include "DataStructure/DataTypes.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Xale::Execution
+{
+    /**
+     * @brief Number of rows filtered at once by a ColumnFilter
+     */
+    constexpr size_t FILTER_BATCH_SIZE = 2048;
+
+    /**
+     * @brief Comparison operator of a WHERE condition
+     */
+    enum class CompareOp
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual
+    };
+
+    /**
+     * @brief Parse a comparison operator
+     * @param op Operator as written in the query ("=", "!=", "<", "<=", ">", ">=")
+     * @param out Parsed operator
+     * @return False if the operator is not a comparison
+     */
+    bool parseCompareOp(const std::string& op, CompareOp& out);
+
+    /**
+     * @brief Compare a value with a literal
+     *
+     * Equality compares the values exactly, so a NULL only equals a NULL and an
+     * integer never equals a float. Ordered comparisons only match two integers
+     * or two floats.
+     * @param value Value of the row
+     * @param op Comparison operator
+     * @param literal Value to compare with
+     * @return True if the comparison holds
+     */
+    bool compareValues(const Xale::DataStructure::FieldValue& value, CompareOp op, const Xale::DataStructure::FieldValue& literal);
+
+    /**
+     * @brief Comparison of a column with a literal, evaluated a batch of values at a time
+     *
+     * The literal is matched with the kind of the column when the filter runs:
+     * integer and float columns are compared by tight loops over their arrays,
+     * the NULL bitmap being applied afterwards, and the matches are written to
+     * a selection vector. Matches are the same as compareValues() on every value.
+     */
+    class ColumnFilter
+    {
+        public:
+            /**
+             * @brief Construct a filter
+             * @param op Comparison operator
+             * @param literal Value to compare with
+             */
+            ColumnFilter(CompareOp op, Xale::DataStructure::FieldValue literal);
+
+            /**
+             * @brief Filter a batch of values of a column
+             * @param column Column to filter
+             * @param begin Position of the first value of the batch
+             * @param count Number of values, at most FILTER_BATCH_SIZE
+             * @param selection Output positions of the matching values, relative to begin
+             * @return Number of matching values
+             */
+            size_t filterBatch(const Xale::DataStructure::ColumnVector& column, size_t begin, size_t count, uint32_t* selection) const;
+
+            /**
+             * @brief Filter a whole column, batch by batch
+             * @param column Column to filter
+             * @return Positions of the matching values, in ascending order
+             */
+            std::vector<size_t> filter(const Xale::DataStructure::ColumnVector& column) const;
+
+        private:
+            CompareOp _op;
+            Xale::DataStructure::FieldValue _literal;
+    };
+}
+
+#endif // EXECUTION_COLUMN_FILTER_H
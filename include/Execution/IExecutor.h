@@ -8,6 +8,17 @@
 
 namespace Xale::Execution
 {
+    /**
+     * @brief State an executor keeps for a client from one statement to the next, such as its open transaction
+     *
+     * Obtained from IExecutor::createState(), destroyed with its client.
+     */
+    class IExecutionState
+    {
+        public:
+            virtual ~IExecutionState() = default;
+    };
+
     /**
      * @brief Interface for executing SQL statements and returning results.
      */
@@ -21,7 +32,21 @@ namespace Xale::Execution
              * @return A unique pointer to the ResultSet containing the results of the execution.
              */
             virtual std::unique_ptr<Xale::DataStructure::ResultSet> execute(Xale::Query::Statement* statement) = 0;
+
+            /**
+             * @brief Executes a SQL statement of a client, within the state of its previous statements.
+             * @param statement Pointer to the SQL statement to be executed.
+             * @param state State of the client, created by createState() of this executor.
+             * @return A unique pointer to the ResultSet containing the results of the execution.
+             */
+            virtual std::unique_ptr<Xale::DataStructure::ResultSet> execute(Xale::Query::Statement* statement, IExecutionState& state) = 0;
+
+            /**
+             * @brief Creates the state of a new client.
+             * @return The state, to pass with each statement of the client.
+             */
+            virtual std::unique_ptr<IExecutionState> createState() = 0;
     };
 }
 
-#endif // EXECUTION_I_EXECUTOR_H
\ No newline at end of file
+#endif // EXECUTION_I_EXECUTOR_H
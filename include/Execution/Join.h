@@ -0,0 +1,64 @@
+#ifndef EXECUTION_JOIN_H
+#define EXECUTION_JOIN_H
+
+#include "DataStructure/DataTypes.h"
+
+#include <cstddef>
+
+namespace Xale::Execution
+{
+    /**
+     * @brief Algorithm joining two inputs
+     */
+    enum class JoinStrategy
+    {
+        Hash,            ///< Hash table over the smaller input, probed with the other one
+        IndexNestedLoop, ///< Lookup of every left row in the index of the right table
+        SortMerge        ///< Merge of two inputs ordered on their join column
+    };
+
+    /**
+     * @brief Pick the cheapest join algorithm from the sizes of the inputs
+     *
+     * A hash join reads and hashes both inputs, a sort-merge join reads both
+     * inputs without hashing, and an index nested-loop join descends the index
+     * of the right table once per left row.
+     * @param leftRows Estimated number of left rows
+     * @param leftOrdered Whether the left rows can be read ordered on the join column
+     * @param rightRows Number of rows of the right table
+     * @param rightIndexed Whether the join column of the right table is indexed
+     * @return Chosen strategy
+     */
+    JoinStrategy chooseJoinStrategy(size_t leftRows, bool leftOrdered, size_t rightRows, bool rightIndexed);
+
+    /**
+     * @brief Check if two values join
+     *
+     * Values join when they are equal, integers and floats being compared by value.
+     * @param a Value of the left row
+     * @param b Value of the right row
+     * @return True if the rows holding them join
+     */
+    bool joinValuesEqual(const Xale::DataStructure::FieldValue& a, const Xale::DataStructure::FieldValue& b);
+
+    /**
+     * @brief Hash of a join key, consistent with joinValuesEqual()
+     */
+    struct JoinKeyHash
+    {
+        size_t operator()(const Xale::DataStructure::FieldValue& value) const;
+    };
+
+    /**
+     * @brief Equality of join keys, joinValuesEqual() as a function object
+     */
+    struct JoinKeyEqual
+    {
+        bool operator()(const Xale::DataStructure::FieldValue& a, const Xale::DataStructure::FieldValue& b) const
+        {
+            return joinValuesEqual(a, b);
+        }
+    };
+}
+
+#endif // EXECUTION_JOIN_H
@@ -0,0 +1,516 @@
+#ifndef EXECUTION_OPERATORS_H
+#define EXECUTION_OPERATORS_H
+
+#include "DataStructure/DataTypes.h"
+#include "DataStructure/Table.h"
+#include "Execution/ColumnFilter.h"
+#include "Execution/Join.h"
+#include "Execution/PlanNode.h"
+#include "Execution/Predicate.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Xale::Execution
+{
+    /**
+     * @brief Operator of a pull-based execution pipeline
+     *
+     * The consumer opens the root operator and calls next() until it returns
+     * false or it has enough rows, every operator pulling the rows of its
+     * inputs one at a time. Only hash joins, aggregations and sorts hold the
+     * rows, or the groups, of an input.
+     */
+    class Operator
+    {
+        public:
+            virtual ~Operator() = default;
+
+            /**
+             * @brief Prepare the operator and its inputs to produce rows
+             */
+            virtual void open() = 0;
+
+            /**
+             * @brief Produce the next row
+             * @param row Output row, its values are replaced
+             * @return False once every row was produced
+             */
+            virtual bool next(Xale::DataStructure::Row& row) = 0;
+
+            /**
+             * @brief Release the state of the operator and close its inputs
+             */
+            virtual void close() = 0;
+    };
+
+    /**
+     * @brief Produces no row, for a join on an unknown column
+     */
+    class EmptyOperator : public Operator
+    {
+        public:
+            void open() override {}
+            bool next(Xale::DataStructure::Row&) override { return false; }
+            void close() override {}
+    };
+
+    /**
+     * @brief Reads some columns of the rows of a table, in the order of their slots
+     */
+    class ScanOperator : public Operator
+    {
+        public:
+            /**
+             * @param table Table to read, only written through its versioned methods while the operator is open
+             * @param columns Positions of the columns read
+             * @param snapshot Snapshot of the statement, whose visible rows are read
+             */
+            ScanOperator(const Xale::DataStructure::Table& table, std::vector<size_t> columns,
+                Xale::DataStructure::Snapshot snapshot = Xale::DataStructure::Snapshot());
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            const Xale::DataStructure::Table& _table;
+            std::vector<size_t> _columns;
+            Xale::DataStructure::Snapshot _snapshot;
+            size_t _slot = 0;
+            size_t _count = 0;        ///< Slots existing when opened, the later ones being invisible
+            bool _allVisible = false; ///< Whether the visibility checks can be skipped
+    };
+
+    /**
+     * @brief Reads some columns of given rows of a table, found through an index
+     */
+    class SlotScanOperator : public Operator
+    {
+        public:
+            /**
+             * @param table Table to read, only written through its versioned methods while the operator is open
+             * @param slots Slots of the rows read, in output order, visible to the statement
+             * @param columns Positions of the columns read
+             */
+            SlotScanOperator(const Xale::DataStructure::Table& table, std::vector<size_t> slots, std::vector<size_t> columns);
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            const Xale::DataStructure::Table& _table;
+            std::vector<size_t> _slots;
+            std::vector<size_t> _columns;
+            size_t _position = 0;
+    };
+
+    /**
+     * @brief Reads the rows of a table matching a condition, filtering its columnar copy batch by batch
+     */
+    class FilteredScanOperator : public Operator
+    {
+        public:
+            /**
+             * @param table Table to read, only written through its versioned methods while the operator is open
+             * @param columns Positions of the columns read
+             * @param condition Comparison on a column of the table
+             * @param snapshot Snapshot of the statement, whose visible rows are read
+             */
+            FilteredScanOperator(const Xale::DataStructure::Table& table, std::vector<size_t> columns, const BoundCondition& condition,
+                Xale::DataStructure::Snapshot snapshot = Xale::DataStructure::Snapshot());
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            const Xale::DataStructure::Table& _table;
+            std::vector<size_t> _columns;
+            int _column;
+            ColumnFilter _filter;
+            Xale::DataStructure::Snapshot _snapshot;
+            std::shared_ptr<const Xale::DataStructure::ColumnarTable> _columnar; ///< Copy read, kept while the table changes
+            bool _allVisible = false;
+            const Xale::DataStructure::ColumnVector* _values = nullptr;
+            std::vector<uint32_t> _selection;
+            size_t _batchBegin = 0; ///< Slot of the first row of the current batch
+            size_t _nextBatch = 0;  ///< Slot of the first row of the next batch
+            size_t _selected = 0;   ///< Number of matches of the current batch
+            size_t _position = 0;   ///< Next match of the current batch
+    };
+
+    /**
+     * @brief Keeps the rows of its input matching a condition
+     */
+    class FilterOperator : public Operator
+    {
+        public:
+            /**
+             * @param input Input operator
+             * @param predicate Condition compiled on the columns of the input rows
+             */
+            FilterOperator(std::unique_ptr<Operator> input, RowPredicate predicate);
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            std::unique_ptr<Operator> _input;
+            RowPredicate _predicate;
+    };
+
+    /**
+     * @brief Computes the output columns from the columns of its input
+     */
+    class ProjectOperator : public Operator
+    {
+        public:
+            /**
+             * @param input Input operator
+             * @param projection Position in the input of every output column, -1 for NULL
+             */
+            ProjectOperator(std::unique_ptr<Operator> input, std::vector<int> projection);
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            std::unique_ptr<Operator> _input;
+            std::vector<int> _projection;
+            Xale::DataStructure::Row _inputRow;
+    };
+
+    /**
+     * @brief Skips the first rows of its input and stops after a number of rows
+     *
+     * No row is pulled from the input once the limit is reached.
+     */
+    class LimitOperator : public Operator
+    {
+        public:
+            /**
+             * @param input Input operator
+             * @param limit Maximum number of rows produced
+             * @param offset Number of rows skipped first
+             */
+            LimitOperator(std::unique_ptr<Operator> input, size_t limit, size_t offset);
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            std::unique_ptr<Operator> _input;
+            size_t _limit;
+            size_t _offset;
+            size_t _produced = 0;
+            bool _skipped = false;
+    };
+
+    /**
+     * @brief Hash of the GROUP BY values of a row, combining their JoinKeyHash
+     */
+    struct GroupKeyHash
+    {
+        size_t operator()(const std::vector<Xale::DataStructure::FieldValue>& key) const;
+    };
+
+    /**
+     * @brief Equality of GROUP BY values, integers and floats being compared by value like join keys
+     */
+    struct GroupKeyEqual
+    {
+        bool operator()(const std::vector<Xale::DataStructure::FieldValue>& a, const std::vector<Xale::DataStructure::FieldValue>& b) const;
+    };
+
+    /**
+     * @brief Groups the rows of its input through a hash table and computes aggregate functions over each group
+     *
+     * Every input row is pulled by open(). Groups are produced in the order of
+     * their first row, with the GROUP BY values followed by the aggregates.
+     * Without GROUP BY columns, a single group is produced even from no rows.
+     */
+    class HashAggregateOperator : public Operator
+    {
+        public:
+            /**
+             * @param input Input operator
+             * @param groupColumns Positions of the GROUP BY columns in the input rows, -1 for NULL
+             * @param aggregates Functions computed, on columns of the input rows
+             */
+            HashAggregateOperator(std::unique_ptr<Operator> input, std::vector<int> groupColumns, std::vector<AggregateSpec> aggregates);
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            std::unique_ptr<Operator> _input;
+            std::vector<int> _groupColumns;
+            std::vector<AggregateSpec> _aggregates;
+
+            std::vector<std::vector<Xale::DataStructure::FieldValue>> _keys; ///< GROUP BY values of every group
+            std::vector<std::vector<Accumulator>> _accumulators;            ///< Accumulators of every group
+            std::unordered_map<std::vector<Xale::DataStructure::FieldValue>, size_t, GroupKeyHash, GroupKeyEqual> _groups;
+            size_t _position = 0;
+    };
+
+    /**
+     * @brief Computes aggregate functions over whole columns of a table, without GROUP BY
+     *
+     * The columns are read from the columnar copy of the table, through the
+     * column kernels of Accumulator::addColumn(), and a single row is produced.
+     * When the snapshot misses some rows, their values are skipped one by one.
+     */
+    class ColumnarAggregateOperator : public Operator
+    {
+        public:
+            /**
+             * @param table Table to read, only written through its versioned methods while the operator is open
+             * @param aggregates Functions computed, on columns of the table
+             * @param snapshot Snapshot of the statement, whose visible rows are aggregated
+             */
+            ColumnarAggregateOperator(const Xale::DataStructure::Table& table, std::vector<AggregateSpec> aggregates,
+                Xale::DataStructure::Snapshot snapshot = Xale::DataStructure::Snapshot());
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            const Xale::DataStructure::Table& _table;
+            std::vector<AggregateSpec> _aggregates;
+            Xale::DataStructure::Snapshot _snapshot;
+            bool _produced = false;
+    };
+
+    /**
+     * @brief Orders the rows of its input, spilling sorted runs to temporary files past a memory budget
+     *
+     * Every input row is pulled by open(). Rows are sorted in memory while they
+     * fit the budget. Otherwise each full buffer is sorted and written to a run
+     * file, and next() merges the runs through a heap holding one row per run.
+     * Rows with equal keys keep their input order.
+     */
+    class SortOperator : public Operator
+    {
+        public:
+            /**
+             * @param input Input operator
+             * @param keys Sort keys, on columns of the input rows
+             * @param schema Columns of the input rows
+             * @param memoryBudget Memory of the rows buffered before a run is spilled
+             */
+            SortOperator(
+                std::unique_ptr<Operator> input,
+                std::vector<SortKey> keys,
+                std::vector<Xale::DataStructure::ColumnDefinition> schema,
+                size_t memoryBudget = SORT_MEMORY_BUDGET);
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+            /**
+             * @brief Number of runs spilled to disk by the last open(), 0 for an in-memory sort
+             */
+            size_t getRunCount() const;
+
+        private:
+            /**
+             * @brief Sorted rows spilled to a temporary file, deleted once closed
+             */
+            struct Run
+            {
+                std::unique_ptr<std::FILE, int (*)(std::FILE*)> file{ nullptr, &std::fclose };
+                Xale::DataStructure::Row head; ///< Next row of the run, read from the file
+            };
+
+            std::unique_ptr<Operator> _input;
+            std::vector<SortKey> _keys;
+            std::vector<Xale::DataStructure::ColumnDefinition> _schema;
+            size_t _memoryBudget;
+
+            std::vector<Xale::DataStructure::Row> _rows; ///< Rows sorted in memory, or buffered for the next run
+            size_t _position = 0;
+            std::vector<Run> _runs;
+            std::vector<size_t> _heap; ///< Runs with a head row, the smallest head first
+
+            void spillRun();
+            bool readHead(Run& run);
+            bool runAfter(size_t a, size_t b) const;
+    };
+
+    /**
+     * @brief Produces the first rows of its input in sort order, through a bounded heap
+     *
+     * Every input row is pulled by open(), but only the rows among the first
+     * ones seen so far are kept, in a max-heap whose top is replaced by any
+     * smaller row. Rows with equal keys keep their input order.
+     */
+    class TopKSortOperator : public Operator
+    {
+        public:
+            /**
+             * @param input Input operator
+             * @param keys Sort keys, on columns of the input rows
+             * @param count Number of rows kept
+             */
+            TopKSortOperator(std::unique_ptr<Operator> input, std::vector<SortKey> keys, size_t count);
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            struct Entry
+            {
+                Xale::DataStructure::Row row;
+                size_t sequence; ///< Position of the row in the input, breaking ties
+            };
+
+            std::unique_ptr<Operator> _input;
+            std::vector<SortKey> _keys;
+            size_t _count;
+
+            std::vector<Entry> _heap; ///< Rows kept, the last one in sort order first, then sorted by open()
+            size_t _position = 0;
+
+            bool entryLess(const Entry& a, const Entry& b) const;
+    };
+
+    /**
+     * @brief Joins two inputs through a hash table built over one of them
+     *
+     * The other input is streamed, joined rows following its order. Joined rows
+     * hold the values of the left row followed by the values of the right row.
+     */
+    class HashJoinOperator : public Operator
+    {
+        public:
+            /**
+             * @param left Left input
+             * @param leftColumn Position of the join column in the left rows
+             * @param right Right input
+             * @param rightColumn Position of the join column in the right rows
+             * @param buildLeft Whether the hash table holds the left rows, the smaller input
+             */
+            HashJoinOperator(std::unique_ptr<Operator> left, size_t leftColumn, std::unique_ptr<Operator> right, size_t rightColumn, bool buildLeft);
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            std::unique_ptr<Operator> _left;
+            std::unique_ptr<Operator> _right;
+            size_t _leftColumn;
+            size_t _rightColumn;
+            bool _buildLeft;
+
+            std::vector<Xale::DataStructure::Row> _built;
+            std::unordered_map<Xale::DataStructure::FieldValue, std::vector<size_t>, JoinKeyHash, JoinKeyEqual> _table;
+            Xale::DataStructure::Row _probeRow;
+            const std::vector<size_t>* _matches = nullptr; ///< Built rows joining the probe row
+            size_t _position = 0;
+    };
+
+    /**
+     * @brief Joins its input with a table by looking up their join value in the index of the table
+     *
+     * Joined rows are ordered by left row then right slot.
+     */
+    class IndexNestedLoopJoinOperator : public Operator
+    {
+        public:
+            /**
+             * @param left Left input
+             * @param leftColumn Position of the join column in the left rows
+             * @param right Right table, whose join column should be indexed
+             * @param rightColumn Position of the join column in the right table
+             * @param rightColumns Positions of the right table columns kept in the joined rows
+             * @param snapshot Snapshot of the statement, whose visible right rows are joined
+             */
+            IndexNestedLoopJoinOperator(
+                std::unique_ptr<Operator> left,
+                size_t leftColumn,
+                const Xale::DataStructure::Table& right,
+                size_t rightColumn,
+                std::vector<size_t> rightColumns,
+                Xale::DataStructure::Snapshot snapshot = Xale::DataStructure::Snapshot());
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            std::unique_ptr<Operator> _left;
+            size_t _leftColumn;
+            const Xale::DataStructure::Table& _right;
+            size_t _rightColumn;
+            std::vector<size_t> _rightColumns;
+            Xale::DataStructure::Snapshot _snapshot;
+
+            Xale::DataStructure::Row _leftRow;
+            std::vector<size_t> _slots; ///< Slots of the right rows holding the key of the left row
+            size_t _position = 0;
+    };
+
+    /**
+     * @brief Joins two tables by merging their rows read in the order of their indexed join column
+     *
+     * Joined rows are ordered on the join key.
+     */
+    class SortMergeJoinOperator : public Operator
+    {
+        public:
+            /**
+             * @param left Left table
+             * @param leftColumns Positions of the left table columns kept in the joined rows
+             * @param leftColumn Position of the join column in the left table
+             * @param right Right table
+             * @param rightColumns Positions of the right table columns kept in the joined rows
+             * @param rightColumn Position of the join column in the right table
+             * @param snapshot Snapshot of the statement, whose visible rows are joined
+             */
+            SortMergeJoinOperator(
+                const Xale::DataStructure::Table& left,
+                std::vector<size_t> leftColumns,
+                size_t leftColumn,
+                const Xale::DataStructure::Table& right,
+                std::vector<size_t> rightColumns,
+                size_t rightColumn,
+                Xale::DataStructure::Snapshot snapshot = Xale::DataStructure::Snapshot());
+
+            void open() override;
+            bool next(Xale::DataStructure::Row& row) override;
+            void close() override;
+
+        private:
+            const Xale::DataStructure::Table& _left;
+            std::vector<size_t> _leftColumns;
+            size_t _leftColumn;
+            const Xale::DataStructure::Table& _right;
+            std::vector<size_t> _rightColumns;
+            size_t _rightColumn;
+            Xale::DataStructure::Snapshot _snapshot;
+
+            std::vector<size_t> _leftOrder;
+            std::vector<size_t> _rightOrder;
+            size_t _l = 0;        ///< First left row of the current key
+            size_t _r = 0;        ///< First right row of the current key
+            size_t _leftEnd = 0;  ///< End of the left rows of the current key, equal to _l outside a key
+            size_t _rightEnd = 0; ///< End of the right rows of the current key
+            size_t _i = 0;        ///< Left row being joined
+            size_t _j = 0;        ///< Next right row joined with it
+    };
+}
+
+#endif // EXECUTION_OPERATORS_H
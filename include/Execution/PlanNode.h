@@ -0,0 +1,127 @@
+#ifndef EXECUTION_PLAN_NODE_H
+#define EXECUTION_PLAN_NODE_H
+
+#include "DataStructure/DataTypes.h"
+#include "DataStructure/Table.h"
+#include "Execution/Aggregate.h"
+#include "Execution/ColumnFilter.h"
+#include "Execution/Join.h"
+#include "Execution/Predicate.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Xale::Execution
+{
+    /**
+     * @brief Aggregate function computed by an Aggregate node
+     */
+    struct AggregateSpec
+    {
+        AggregateFunction function = AggregateFunction::Count;
+        bool allRows = false; ///< COUNT(*), counting rows rather than values
+        int column = -1;      ///< Position of the aggregated column in the input, -1 if it does not exist
+        std::string name;     ///< Output column name, such as "SUM(amount)"
+    };
+
+    /**
+     * @brief Memory held by the rows buffered by a sort before they are spilled to a run on disk
+     */
+    constexpr size_t SORT_MEMORY_BUDGET = 64 * 1024 * 1024;
+
+    /**
+     * @brief Key of a sort, rows being ordered by FieldValueLess on its column
+     */
+    struct SortKey
+    {
+        int column = -1;         ///< Position of the column, -1 if it does not exist
+        bool descending = false;
+    };
+
+    /**
+     * @brief Algorithms of a Sort node
+     */
+    enum class SortStrategy
+    {
+        InMemory, ///< Sort every row in memory
+        TopK,     ///< Keep the first rows in a bounded heap, for ORDER BY with LIMIT
+        External  ///< Sort runs that fit the memory budget, spill them to disk and merge them
+    };
+
+    /**
+     * @brief Operators of a query plan
+     */
+    enum class PlanNodeType
+    {
+        Scan,      ///< Read every row of a table
+        IndexScan, ///< Read the rows of a table matching a condition through an index
+        Filter,    ///< Keep the rows of its input matching a condition
+        Project,   ///< Compute the output columns from the columns of its input
+        Join,      ///< Join its two inputs on the equality of one column each
+        Limit,     ///< Skip the first rows of its input and stop after a number of rows
+        Aggregate, ///< Group the rows of its input and compute aggregate functions over each group
+        Sort       ///< Order the rows of its input
+    };
+
+    /**
+     * @brief Operator of a physical query plan, built by the QueryPlanner
+     *
+     * Every node produces rows with the columns of its schema. Only the
+     * members of its type are used.
+     */
+    struct PlanNode
+    {
+        PlanNodeType type;
+        std::vector<std::unique_ptr<PlanNode>> children;
+        std::vector<Xale::DataStructure::ColumnDefinition> schema; ///< Columns of the rows produced
+        double estimatedRows = 0;                                  ///< Cardinality estimate, used to choose the plan
+        std::string detail;                                        ///< Description printed by EXPLAIN
+
+        /** @brief Scan, IndexScan: table read */
+        const Xale::DataStructure::Table* table = nullptr;
+
+        /** @brief Scan, IndexScan: positions in the table of the columns produced */
+        std::vector<size_t> columns;
+
+        /** @brief IndexScan: condition on a table column, Filter: condition on a column of its input read by a FilteredScan */
+        BoundCondition condition;
+
+        /** @brief Filter: whole condition on the columns of its input */
+        RowPredicate predicate;
+
+        /** @brief Project: position in the input of every output column, -1 for NULL */
+        std::vector<int> projection;
+
+        /** @brief Join: algorithm, the right input being a Scan for IndexNestedLoop and both for SortMerge */
+        JoinStrategy strategy = JoinStrategy::Hash;
+
+        /** @brief Join: position of the join column in the left input, -1 if it does not exist */
+        int leftColumn = -1;
+
+        /** @brief Join: position of the join column in the right input, -1 if it does not exist */
+        int rightColumn = -1;
+
+        /** @brief Sort: keys on columns of its input, Scan: single key on a table column read in index order */
+        std::vector<SortKey> sortKeys;
+
+        /** @brief Sort: algorithm */
+        SortStrategy sortStrategy = SortStrategy::InMemory;
+
+        /** @brief Limit: maximum number of rows produced, Sort: number of rows kept by TopK */
+        size_t limit = 0;
+
+        /** @brief Limit: number of rows skipped first */
+        size_t offset = 0;
+
+        /** @brief Aggregate: positions in the input of the GROUP BY columns, -1 if they do not exist */
+        std::vector<int> groupColumns;
+
+        /** @brief Aggregate: functions computed, output after the GROUP BY columns */
+        std::vector<AggregateSpec> aggregates;
+
+        explicit PlanNode(PlanNodeType t) : type(t) {}
+    };
+}
+
+#endif // EXECUTION_PLAN_NODE_H
@@ -0,0 +1,105 @@
+#ifndef EXECUTION_PREDICATE_H
+#define EXECUTION_PREDICATE_H
+
+#include "DataStructure/DataTypes.h"
+#include "Execution/ColumnFilter.h"
+#include "Query/Statement.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Xale::Execution
+{
+    /**
+     * @brief WHERE condition bound to the rows it is evaluated on
+     *
+     * The compared column is resolved to its position in the rows, and the
+     * operator and the literal are evaluated, so that rows are compared
+     * without any lookup or parsing.
+     */
+    struct BoundCondition
+    {
+        bool matchesAll = true; ///< No condition, or one that is not a column comparison
+        int column = -1;        ///< Position of the compared column, -1 if it does not exist
+        CompareOp op = CompareOp::Equal;
+        Xale::DataStructure::FieldValue value;
+    };
+
+    /**
+     * @brief Condition compiled into closures, evaluated on every row
+     */
+    using RowPredicate = std::function<bool(const Xale::DataStructure::Row&)>;
+
+    /**
+     * @brief Position in the rows of a column, from its name, -1 if it does not exist
+     */
+    using ColumnResolver = std::function<int(const std::string&)>;
+
+    /**
+     * @brief Compile a condition (comparisons, IN, BETWEEN, AND, OR, NOT) into closures
+     *
+     * Columns are resolved and literals evaluated once, and every comparison
+     * is specialized on its operator and the type of its literal, so rows are
+     * evaluated without any dispatch on the operator. Comparisons follow
+     * compareValues(), a comparison on an unknown column matching nothing.
+     * @param expr Condition
+     * @param resolve Position of the columns in the rows
+     * @return Predicate on the rows
+     * @throws DbException if the expression is not a condition
+     */
+    RowPredicate compilePredicate(const Xale::Query::Expression& expr, const ColumnResolver& resolve);
+
+    /**
+     * @brief Compile conditions joined by AND, evaluated in their order
+     * @param conjuncts Conditions, all of them to hold
+     * @param resolve Position of the columns in the rows
+     * @return Predicate on the rows
+     * @throws DbException if an expression is not a condition
+     */
+    RowPredicate compileConjuncts(const std::vector<const Xale::Query::Expression*>& conjuncts, const ColumnResolver& resolve);
+
+    /**
+     * @brief Compile a comparison of a column with a literal
+     * @param condition Condition bound to the rows
+     * @return Predicate on the rows
+     */
+    RowPredicate compileCondition(const BoundCondition& condition);
+
+    /**
+     * @brief Match a comparison of a column with a literal, the literal being on either side
+     * @param expr Expression
+     * @param column Name of the compared column
+     * @param op Comparison operator, reversed when the literal is on the left
+     * @param value Evaluated literal
+     * @return False if the expression is not such a comparison
+     */
+    bool matchComparison(const Xale::Query::Expression& expr, std::string& column, CompareOp& op, Xale::DataStructure::FieldValue& value);
+
+    /**
+     * @brief Split a condition into the operands of its top-level ANDs
+     * @param expr Condition
+     * @param out Operands, all of them to hold for the condition to hold
+     */
+    void splitConjuncts(const Xale::Query::Expression& expr, std::vector<const Xale::Query::Expression*>& out);
+
+    /**
+     * @brief Collect the names of the columns read by a condition
+     * @param expr Condition
+     * @param out Column names, appended in reading order
+     */
+    void collectColumns(const Xale::Query::Expression& expr, std::vector<std::string>& out);
+
+    /**
+     * @brief Text of the conjunction of conditions, literals being printed as evaluated
+     * @param conjuncts Conditions joined by AND
+     */
+    std::string describeConjuncts(const std::vector<const Xale::Query::Expression*>& conjuncts);
+
+    /**
+     * @brief Text of a value as a SQL literal
+     */
+    std::string formatValue(const Xale::DataStructure::FieldValue& value);
+}
+
+#endif // EXECUTION_PREDICATE_H
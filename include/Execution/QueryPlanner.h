@@ -0,0 +1,60 @@
+#ifndef EXECUTION_QUERY_PLANNER_H
+#define EXECUTION_QUERY_PLANNER_H
+
+#include "Execution/PlanNode.h"
+#include "Execution/TableManager.h"
+#include "Query/Statement.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Xale::Execution
+{
+    /**
+     * @brief Turns SELECT statements into physical query plans
+     *
+     * The WHERE condition is pushed down to the table holding its column, and
+     * answered through an index when the column has one. Tables only produce
+     * the columns used by the query. Joins are reordered greedily from the
+     * estimated size of their inputs, starting with the smallest one, and
+     * their algorithm is picked by chooseJoinStrategy().
+     */
+    class QueryPlanner
+    {
+        public:
+            /**
+             * @brief Construct a planner over the tables of a TableManager
+             * @param tableManager Tables the statements refer to
+             */
+            explicit QueryPlanner(TableManager& tableManager);
+
+            /**
+             * @brief Plan a SELECT statement
+             *
+             * Throws a DbException if a table does not exist.
+             * @param stmt Statement to plan
+             * @return Root of the plan, a Project node, below a Limit node for a LIMIT clause
+             */
+            std::unique_ptr<PlanNode> planSelect(const Xale::Query::SelectStatement& stmt);
+
+            /**
+             * @brief Describe a plan, one line per node
+             * @param plan Root of the plan
+             * @return Lines describing the nodes, children indented below their parent
+             */
+            static std::vector<std::string> explain(const PlanNode& plan);
+
+            /**
+             * @brief Evaluate a literal expression
+             * @param expr Expression, a numeric or string literal or an identifier
+             * @return Value of the literal, NULL for other expressions
+             */
+            static Xale::DataStructure::FieldValue evaluateLiteral(const Xale::Query::Expression& expr);
+
+        private:
+            TableManager& _tableManager;
+    };
+}
+
+#endif // EXECUTION_QUERY_PLANNER_H
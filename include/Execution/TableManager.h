@@ -1,20 +1,74 @@
 #ifndef TABLE_MANAGER_H
 #define TABLE_MANAGER_H
 
+#include "Core/SharedMutex.h"
 #include "DataStructure/Table.h"
 #include "Storage/IStorageEngine.h"
 #include "Storage/IFileManager.h"
 #include "Storage/BinaryFileManager.h"
+#include "Storage/BufferPool.h"
+#include "Storage/PageDirectory.h"
+#include "Storage/WriteAheadLog.h"
 
 #include <cstring>
 #include <fstream>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
 
 namespace Xale::Execution
 {
+    /**
+     * @brief Locks held by a statement while it executes, released on destruction
+     *
+     * Obtained from TableManager::lockTables() or TableManager::lockCatalog().
+     * The catalog and writer locks may be released by another thread, so a
+     * transaction keeps them from one statement to the next.
+     */
+    class TableLocks
+    {
+        private:
+            friend class TableManager;
+
+            std::shared_lock<Xale::Core::SharedMutex> _catalog;
+            std::unique_lock<Xale::Core::SharedMutex> _catalogExclusive;
+            std::vector<std::shared_lock<std::shared_mutex>> _readers;
+            std::vector<std::unique_lock<Xale::Core::SharedMutex>> _writers;
+    };
+
     /**
      * @brief Manages the lifecycle of tables, including creation, retrieval, deletion, and persistence.
+     *
+     * Tables are persisted in fixed-size pages through a Xale::Storage::BufferPool.
+     * A catalog directory holds one record per table (its schema and the root of
+     * its own page directory), and each row is stored as its own record, so that
+     * saving only writes the pages holding rows changed since the last save.
+     *
+     * When a log file is given, saving only appends redo records to a
+     * Xale::Storage::WriteAheadLog; pages are written by checkpoints, once the
+     * log grows past a threshold. The log is replayed on construction.
+     *
+     * Statements of several threads run at once under table-level locks: a
+     * statement holds the catalog shared, then each table it reads shared and
+     * each table it writes exclusively. Statements creating or dropping tables
+     * or indexes hold the catalog exclusively, alone. Saving and checkpoints
+     * are serialized, and only read the copies of the changes taken by the
+     * writers, never a table another statement may be changing.
+     *
+     * Writers never block readers: a write runs in a transaction whose row
+     * versions (see Xale::DataStructure::RowVersion) stay hidden until it
+     * commits, and readers read through the snapshot of the last commit. The
+     * versions ended by a commit are reclaimed at once when nobody reads the
+     * table, otherwise later by vacuum(). A transaction spanning several
+     * statements keeps the catalog shared and the tables it wrote locked
+     * until it ends, so its versions are only saved by its commit.
      */
     class TableManager
     {
@@ -23,11 +77,108 @@ namespace Xale::Execution
              * @brief Constructor for TableManager
              * @param storage Reference to the storage engine
              * @param fileManager Reference to the file manager
+             * @param logFileManager Opened file manager of the write-ahead log, nullptr to write pages on every save
+             * @param checkpointThreshold Log size triggering a checkpoint
+             */
+            TableManager(
+                Xale::Storage::IStorageEngine& storage,
+                Xale::Storage::IFileManager& fileManager,
+                Xale::Storage::IFileManager* logFileManager = nullptr,
+                std::uint64_t checkpointThreshold = Xale::Storage::DEFAULT_CHECKPOINT_THRESHOLD);
+
+            /**
+             * @brief Stop the background vacuum, if started
+             */
+            ~TableManager();
+
+            /**
+             * @brief Lock the tables a statement reads and writes, until the returned locks are destroyed
+             *
+             * Tables are locked in name order, so that statements never wait for each other in a cycle.
+             * A written table is only locked against the other writers and vacuum(), its
+             * readers going on with the versions they see.
+             * @param readTables Tables only read, locked shared
+             * @param writeTables Tables changed, locked against other writers, taking precedence over readTables
+             * @return Locks of the catalog (shared) and of the existing tables among the given ones
+             */
+            TableLocks lockTables(const std::vector<std::string>& readTables, const std::vector<std::string>& writeTables);
+
+            /**
+             * @brief Lock one more table against the other writers, for a transaction keeping the tables it writes locked
+             *
+             * Tables are locked in the order the transaction writes them, so two
+             * transactions may wait for each other: the wait is bounded.
+             * @param locks Locks of the transaction, holding the catalog shared
+             * @param name Name of the table, existing
+             * @param timeout Longest wait for the other writer of the table
+             * @return False if the table stayed locked by another writer
+             */
+            bool lockWriter(TableLocks& locks, const std::string& name, std::chrono::milliseconds timeout);
+
+            /**
+             * @brief Lock the catalog exclusively, for statements creating or dropping tables or indexes
+             *
+             * Waits for every other statement and open transaction to complete, then holds back the next ones.
+             * An idle client may keep its transaction open: the wait is bounded.
+             * @param locks Locks of the statement, receiving the catalog lock
+             * @param timeout Longest wait for the other statements and transactions
+             * @return False if the catalog stayed in use
+             */
+            bool lockCatalog(TableLocks& locks, std::chrono::milliseconds timeout);
+
+            /**
+             * @brief Get the snapshot a statement reads from, taken once its tables are locked
+             * @param transaction Pending stamp of the transaction of the statement, 0 for none
+             * @return Snapshot of the last commit, plus the changes of the transaction
+             */
+            Xale::DataStructure::Snapshot getSnapshot(std::uint64_t transaction = 0) const;
+
+            /**
+             * @brief Start a transaction, writing row versions hidden from the other statements
+             * @return Pending stamp of the transaction
+             */
+            std::uint64_t beginTransaction();
+
+            /**
+             * @brief Commit a transaction and save the tables it wrote, locked by the caller
+             *
+             * Its versions become visible to the snapshots taken from now on. The
+             * versions it ended are reclaimed at once when nobody reads their table.
+             * @param transaction Pending stamp of the transaction
+             * @param names Names of the tables written by the transaction
+             */
+            void commitTransaction(std::uint64_t transaction, const std::vector<std::string>& names);
+
+            /**
+             * @brief Undo the changes of a transaction to the tables it wrote, locked by the caller
+             * @param transaction Pending stamp of the transaction
+             * @param names Names of the tables written by the transaction
+             */
+            void rollbackTransaction(std::uint64_t transaction, const std::vector<std::string>& names);
+
+            /**
+             * @brief Reclaim the row versions no statement sees any more, and save the tables compacted
+             *
+             * Tables being written or read are skipped, left to the next call.
+             * @return Number of versions reclaimed
+             */
+            std::size_t vacuum();
+
+            /**
+             * @brief Run vacuum() on a background thread at a fixed interval, until stopVacuum()
+             * @param interval Time between two runs, 0 to not start it
+             */
+            void startVacuum(std::chrono::milliseconds interval);
+
+            /**
+             * @brief Stop the background vacuum, waiting for a run in progress
              */
-            TableManager(Xale::Storage::IStorageEngine& storage, Xale::Storage::IFileManager& fileManager);
+            void stopVacuum();
 
             /**
              * @brief Creates a new table with the given name
+             *
+             * The caller holds the catalog exclusively, like dropTable().
              * @param name Name of the table to create
              * @return Pointer to the created Xale::DataStructure::Table, or nullptr if it already exists
              */
@@ -60,20 +211,188 @@ namespace Xale::Execution
              */
             std::vector<std::string> getTableNames() const;
 
+            /**
+             * @brief Memory used by the indexes of all the tables
+             * @return Number of bytes
+             */
+            std::size_t getIndexMemoryUsage() const;
+
+            /**
+             * @brief Set the maximum memory the indexes may use
+             *
+             * An index whose creation goes past the limit is dropped, and the
+             * inserts and updates are refused once the limit is reached.
+             * @param bytes Number of bytes, 0 for no limit
+             */
+            void setIndexMemoryLimit(std::size_t bytes);
+
+            /**
+             * @brief Get the maximum memory the indexes may use
+             * @return Number of bytes, 0 for no limit
+             */
+            std::size_t getIndexMemoryLimit() const;
+
+            /**
+             * @brief Save the changes of some tables, locked exclusively by the caller
+             *
+             * Same as saveAllTables(), limited to the given tables.
+             * @param names Names of the tables
+             */
+            void saveTables(const std::vector<std::string>& names);
+
             /**
              * @brief Save all tables to disk
-             * File format:
-             * [4 bytes: table_count]
-             * For each table:
-             *   [4 bytes: table_name_length]
-             *   [N bytes: table_name]
-             *   [4 bytes: table_data_length]
-             *   [M bytes: table_data (serialized)]
+             *
+             * The caller holds the catalog exclusively, or runs alone.
+             * Only the catalog entries and the rows modified since the last save
+             * are rewritten, then the dirty pages are flushed and the file synced.
+             * With a write-ahead log, the changes are committed to the log instead
+             * and pages are only written by checkpoint().
+             * Record formats:
+             * Catalog: [4 bytes: directory_root_page][N bytes: table schema (serialized)]
+             * Row:     [4 bytes: row_slot][M bytes: row (serialized)]
              */
             void saveAllTables();
 
             /**
              * @brief Load all tables from disk
+             *
+             * A data file written with the former single-blob format is loaded
+             * and migrated to the paged format.
+             */
+            void loadAllTables();
+
+            /**
+             * @brief Write every logged change to the data file and reset the write-ahead log
+             *
+             * The page images are logged before being written, so a checkpoint
+             * interrupted by a crash is completed by the next recovery.
+             */
+            void checkpoint();
+
+            /**
+             * @brief Get the write-ahead log
+             * @return Pointer to the log, nullptr if the manager runs without one
+             */
+            Xale::Storage::WriteAheadLog* getWriteAheadLog();
+
+            /**
+             * @brief Get the buffer pool caching the data file pages
+             * @return Reference to the buffer pool
+             */
+            Xale::Storage::BufferPool& getBufferPool();
+
+        private:
+            /**
+             * @brief On-disk location of a table
+             */
+            struct TableStorage
+            {
+                Xale::Storage::RecordId catalogRecord;
+                std::unique_ptr<Xale::Storage::PageDirectory> directory;
+                std::vector<Xale::Storage::RecordId> rowLocations; ///< Indexed by row slot
+            };
+
+            /**
+             * @brief Changes of a table not written to the data file yet, copied when they were saved
+             */
+            struct PendingChanges
+            {
+                std::vector<char> schema;                  ///< Serialized schema, empty if unchanged
+                size_t rowCount = 0;                       ///< Number of rows, the records past it being removed
+                std::map<size_t, std::vector<char>> rows;  ///< Row records by slot
+            };
+
+            Xale::Storage::IStorageEngine& _storage;
+            Xale::Storage::IFileManager& _fileManager;
+            std::unordered_map<std::string, std::unique_ptr<Xale::DataStructure::Table>> _tables;
+            std::unique_ptr<Xale::Storage::BufferPool> _bufferPool;
+            std::unique_ptr<Xale::Storage::PageDirectory> _catalog;
+            std::unordered_map<std::string, TableStorage> _tableStorage;
+            std::unique_ptr<Xale::Storage::WriteAheadLog> _wal;
+            std::uint64_t _checkpointThreshold;
+            std::size_t _indexMemoryLimit = 0;
+            std::unordered_map<std::string, PendingChanges> _pendingChanges;
+            std::vector<std::string> _droppedTables;   ///< Dropped since the last save
+            std::vector<std::string> _pendingDrops;    ///< Dropped since the last checkpoint
+
+            /**
+             * @brief Locks of a table
+             */
+            struct TableLock
+            {
+                std::shared_mutex readers; ///< Shared by the statements reading the table, exclusive to reclaim its versions
+                Xale::Core::SharedMutex writer; ///< Held exclusively by the transaction writing the table, and to reclaim its versions
+            };
+
+            Xale::Core::SharedMutex _catalogMutex; ///< Shared by statements and open transactions, exclusive while tables or indexes are created or dropped
+            std::mutex _tableLocksMutex;     ///< Guards _tableLocks
+            std::unordered_map<std::string, std::unique_ptr<TableLock>> _tableLocks;
+            std::mutex _storageMutex;        ///< Serializes saving and checkpoints
+
+            std::atomic<std::uint64_t> _clock{ 0 };           ///< Timestamp of the last commit
+            std::atomic<std::uint64_t> _lastTransaction{ 0 }; ///< Id of the last transaction started
+            std::mutex _commitMutex;                          ///< Serializes commits, so that timestamps are published in order
+
+            std::thread _vacuumThread;
+            std::mutex _vacuumMutex;
+            std::condition_variable _vacuumCondition;
+            bool _vacuumStopping = false;
+
+            /**
+             * @brief Lock of a table, created on first use and kept if the table is dropped
+             */
+            TableLock& tableLock(const std::string& name);
+
+            /**
+             * @brief Reclaim the dead versions of a table written by the caller, unless a statement reads it
+             * @return Number of versions reclaimed
+             */
+            std::size_t reclaimUnread(const std::string& name, Xale::DataStructure::Table& table);
+
+            /**
+             * @brief Save the changes of the given tables, of all tables if null
+             */
+            void save(const std::vector<std::string>* names);
+
+            /**
+             * @brief Body of checkpoint(), the caller holding _storageMutex or running alone
+             */
+            void writeCheckpoint();
+
+            /**
+             * @brief Read the tables of the data file, formatting it if needed
+             * @return True if the data file must be written (new or migrated file)
+             */
+            bool loadTables();
+
+            /**
+             * @brief Move the changes tracked by the tables to the pending changes
+             * @param records Output redo records, may be null
+             * @param names Tables to collect, all of them if null
+             */
+            void collectChanges(std::vector<Xale::Storage::LogRecord>* records, const std::vector<std::string>* names = nullptr);
+
+            /**
+             * @brief Write back the page images of a complete logged checkpoint
+             * @param records Records read from the write-ahead log
+             * @return True if a checkpoint was completed
+             */
+            bool restoreCheckpoint(const std::vector<Xale::Storage::LogRecord>& records);
+
+            /**
+             * @brief Apply the committed redo records to the loaded tables
+             * @param records Records read from the write-ahead log
+             */
+            void replay(const std::vector<Xale::Storage::LogRecord>& records);
+
+            /**
+             * @brief Apply a single redo record
+             */
+            void applyLogRecord(const Xale::Storage::LogRecord& record);
+
+            /**
+             * @brief Load tables saved with the former single-blob format
              * File format:
              * [4 bytes: table_count]
              * For each table:
@@ -82,25 +401,35 @@ namespace Xale::Execution
              *   [4 bytes: table_data_length]
              *   [M bytes: table_data (serialized)]
              */
-            void loadAllTables();
+            void loadLegacyTables();
+
+            /**
+             * @brief Load a single table from its catalog record
+             * @param rid Location of the catalog record
+             * @param record Catalog record bytes
+             */
+            void loadTable(Xale::Storage::RecordId rid, const std::vector<char>& record);
+
+            /**
+             * @brief Write the modified rows of a table to its pages
+             * @param storage On-disk location of the table
+             * @param changes Changes to write
+             */
+            void saveTable(TableStorage& storage, const PendingChanges& changes);
 
-        private:
-            Xale::Storage::IStorageEngine& _storage;
-            Xale::Storage::IFileManager& _fileManager;
-            std::unordered_map<std::string, std::unique_ptr<Xale::DataStructure::Table>> _tables;
-            
             /**
-             * @brief Save a single table to disk
-             * @param table The table to save
+             * @brief Build the catalog record of a table
+             * @param directoryRoot Root page of the directory of its rows
+             * @param schema Serialized schema of the table
              */
-            void saveTable(const Xale::DataStructure::Table& table);
+            static std::vector<char> makeCatalogRecord(Xale::Storage::PageId directoryRoot, const std::vector<char>& schema);
 
             /**
-             * @brief Load a single table from disk
-             * @param tableName Name of the table
-             * @param data Serialized table data
+             * @brief Build the record of a row
+             * @param slot Slot of the row
+             * @param row Serialized row
              */
-            void loadTable(const std::string& tableName, const std::vector<char>& data);
+            static std::vector<char> makeRowRecord(std::size_t slot, const std::vector<char>& row);
     };
 }
 
@@ -0,0 +1,101 @@
+#ifndef EXECUTION_TRANSACTION_H
+#define EXECUTION_TRANSACTION_H
+
+#include "Execution/IExecutor.h"
+#include "Execution/TableManager.h"
+#include "DataStructure/RowVersion.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Xale::Execution
+{
+    /**
+     * @brief Longest wait of a transaction for a table written by another one
+     */
+    constexpr std::chrono::milliseconds DEFAULT_LOCK_TIMEOUT{ 5000 };
+
+    /**
+     * @brief Transaction of a client, spanning its statements from BEGIN to COMMIT or ROLLBACK
+     *
+     * While open, it holds the catalog shared, so tables and indexes are only
+     * created or dropped between transactions, and keeps each table it wrote
+     * locked against the other writers. Its row versions stay pending, seen
+     * by its own statements only, until the commit stamps and saves them at
+     * once. An open transaction is rolled back on destruction, when its client
+     * goes away.
+     */
+    class Transaction : public IExecutionState
+    {
+        public:
+            /**
+             * @param tableManager Manager of the tables written
+             * @param lockTimeout Longest wait for a table written by another transaction
+             */
+            explicit Transaction(TableManager& tableManager, std::chrono::milliseconds lockTimeout = DEFAULT_LOCK_TIMEOUT);
+
+            /**
+             * @brief Roll back the transaction if still open
+             */
+            ~Transaction() override;
+
+            Transaction(const Transaction&) = delete;
+            Transaction& operator=(const Transaction&) = delete;
+
+            /**
+             * @brief Check if the transaction is open
+             */
+            bool isActive() const;
+
+            /**
+             * @brief Pending stamp of the transaction, 0 if not open
+             */
+            std::uint64_t getId() const;
+
+            /**
+             * @brief Snapshot of a statement of the transaction, seeing its own changes
+             */
+            Xale::DataStructure::Snapshot getSnapshot() const;
+
+            /**
+             * @brief Open the transaction
+             * @throws DbException if it is already open
+             */
+            void begin();
+
+            /**
+             * @brief Lock a table before writing it, kept locked until the transaction ends
+             * @param name Name of the table, existing
+             * @throws DbException if another transaction kept the table locked past the timeout
+             */
+            void lockTable(const std::string& name);
+
+            /**
+             * @brief Make the changes visible to the next statements and save them
+             * @throws DbException if the transaction is not open
+             */
+            void commit();
+
+            /**
+             * @brief Undo the changes
+             * @throws DbException if the transaction is not open
+             */
+            void rollback();
+
+        private:
+            TableManager& _tableManager;
+            std::chrono::milliseconds _lockTimeout;
+            std::uint64_t _id = 0;
+            TableLocks _locks;
+            std::vector<std::string> _tables; ///< Tables written, locked by _locks
+
+            /**
+             * @brief Release the locks and close the transaction
+             */
+            void end();
+    };
+}
+
+#endif // EXECUTION_TRANSACTION_H
@@ -0,0 +1,84 @@
+#ifndef NET_FRAME_READER_H
+#define NET_FRAME_READER_H
+
+#include "Net/Packet/Packet.h"
+#include "Net/Packet/PacketConstants.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Xale::Net
+{
+    /**
+     * @brief Cuts a byte stream into packets, using the payload length of their header
+     *
+     * Received bytes are written straight into a buffer owned by the reader,
+     * which keeps its capacity from one packet to the next: partial reads are
+     * accumulated until a packet is complete, and a single read may hold
+     * several packets.
+     */
+    class FrameReader
+    {
+        public:
+            /**
+             * @param maxPayloadSize Largest payload accepted, a bigger announced length being a stream error
+             */
+            explicit FrameReader(uint32_t maxPayloadSize = MAX_PAYLOAD_SIZE);
+
+            /**
+             * @brief Writable space at the end of the buffered bytes
+             * @param size Number of bytes about to be received
+             * @return Space of at least size bytes, valid until the next call to the reader
+             */
+            uint8_t* prepare(std::size_t size);
+
+            /**
+             * @brief Add the bytes received into the space returned by prepare()
+             * @param size Number of bytes written, at most the prepared size
+             */
+            void commit(std::size_t size);
+
+            /**
+             * @brief Copy received bytes into the buffer
+             */
+            void append(const uint8_t* data, std::size_t size);
+
+            /**
+             * @brief Extract the next complete packet
+             * @param packet Packet filled in, its payload capacity being reused
+             * @return False if the next packet is not fully received yet
+             * @throws DbException PacketError if the header is invalid or announces a payload over the limit
+             */
+            bool next(Packet& packet);
+
+            /**
+             * @brief Bytes still missing to complete the next packet, or its header when not received yet
+             * @throws DbException PacketError if the buffered header is invalid
+             */
+            std::size_t missingBytes() const;
+
+            /**
+             * @brief Bytes received and not extracted yet
+             */
+            std::size_t bufferedBytes() const;
+
+            /**
+             * @brief Drop the buffered bytes, keeping the capacity
+             */
+            void clear();
+
+        private:
+            std::vector<uint8_t> _buffer;
+            std::size_t _begin = 0; ///< First byte not extracted yet
+            std::size_t _end = 0;   ///< End of the received bytes
+            uint32_t _maxPayloadSize;
+
+            /**
+             * @brief Payload length announced by the buffered header, validated against the limit
+             */
+            uint32_t payloadLength() const;
+    };
+}
+
+#endif // NET_FRAME_READER_H
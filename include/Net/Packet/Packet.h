@@ -39,11 +39,22 @@ namespace Xale::Net
              * @return Serialized packet as vector of bytes
              */
             std::vector<uint8_t> serialize() const override;
+            /**
+             * @brief Appends the serialized packet to a buffer, reusing its capacity.
+             * @param buffer Buffer the header and payload are appended to
+             */
+            void serializeTo(std::vector<uint8_t>& buffer) const;
             /**
              * @brief Deserializes the packet from a byte vector.
              * @param buffer Byte vector containing serialized packet
              */
             void deserialize(const std::vector<uint8_t>& buffer) override;
+            /**
+             * @brief Deserializes the packet from a byte range, reusing the payload capacity.
+             * @param data First byte of the serialized packet
+             * @param size Number of bytes available from data
+             */
+            void deserialize(const uint8_t* data, std::size_t size);
 
             /**
              * @brief Gets the total size of the packet in bytes.
@@ -55,7 +66,7 @@ namespace Xale::Net
              * @brief Gets the payload data of the packet.
              * @return Payload as vector of bytes
              */
-            const std::vector<uint8_t> getPayload() const;
+            const std::vector<uint8_t>& getPayload() const;
     };
 }
 
@@ -1,6 +1,7 @@
 #ifndef NET_PACKET_CONST_H
 #define NET_PACKET_CONST_H
 
+#include <cstddef>
 #include <cstdint>
 
 namespace Xale::Net
@@ -8,6 +9,9 @@ namespace Xale::Net
     constexpr uint32_t MAGIC_NUMBER = 0x58414C45; // "XALE"
     constexpr uint16_t VERSION = 0x0100;          // 1.0
 
+    constexpr std::size_t HEADER_SIZE = 11;                // magic (4), version (2), command (1), payload length (4)
+    constexpr uint32_t MAX_PAYLOAD_SIZE = 64 * 1024 * 1024; // Default limit of a received payload
+
     enum class CommandType : uint8_t 
     {
         AUTH = 0x01,
@@ -10,18 +10,24 @@ namespace Xale::Net
      * @brief Represents an established per-client TCP connection
      *
      * Returned by IListenerSocket::acceptClient(). Each instance is independent
-     * and safe to use from a dedicated thread.
+     * and safe to use from a dedicated thread. Once switched to non-blocking
+     * mode, it is polled through its handle by an event loop.
      */
     class IClientConnection
     {
         public:
+            /**
+             * @brief Returned by read() and respond() when a non-blocking connection cannot make progress yet
+             */
+            static constexpr int WOULD_BLOCK = -2;
+
             virtual ~IClientConnection() = default;
 
             /**
              * @brief Read data from the client
              * @param buffer Buffer filled with received bytes
              * @param size   Maximum bytes to read
-             * @return Bytes read, 0 on clean disconnect, <0 on error
+             * @return Bytes read, 0 on clean disconnect, WOULD_BLOCK if no data is available yet, <0 on error
              */
             virtual int read(std::vector<uint8_t>& buffer, size_t size) = 0;
 
@@ -29,10 +35,38 @@ namespace Xale::Net
              * @brief Send data to the client
              * @param data Data to send
              * @param size Number of bytes to send
-             * @return Bytes sent, <0 on error
+             * @return Bytes sent, possibly fewer than size once non-blocking, WOULD_BLOCK if none could be sent yet, <0 on error
              */
             virtual int respond(const std::vector<uint8_t>* data, size_t size) = 0;
 
+            /**
+             * @brief Read data from the client straight into caller memory
+             * @param buffer Destination of at least size bytes
+             * @param size   Maximum bytes to read
+             * @return Same as read(std::vector<uint8_t>&, size_t)
+             */
+            virtual int read(uint8_t* buffer, size_t size) = 0;
+
+            /**
+             * @brief Send raw bytes to the client
+             * @param data Bytes to send
+             * @param size Number of bytes to send
+             * @return Same as respond(const std::vector<uint8_t>*, size_t)
+             */
+            virtual int respond(const uint8_t* data, size_t size) = 0;
+
+            /**
+             * @brief Switch the connection to non-blocking reads and writes
+             * @return True on success
+             */
+            virtual bool setNonBlocking() = 0;
+
+            /**
+             * @brief File descriptor of the connection, polled for readiness
+             * @return Descriptor, -1 once closed
+             */
+            virtual int getHandle() const = 0;
+
             /**
              * @brief Close this client connection
              */
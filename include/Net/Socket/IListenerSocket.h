@@ -26,10 +26,24 @@ namespace Xale::Net
 
             /**
              * @brief Block until a new client connects, then return a connection object
+             *
+             * Once non-blocking, returns nullptr at once when no client is waiting.
              * @return Unique pointer to an IClientConnection, or nullptr on error
              */
             virtual std::unique_ptr<IClientConnection> acceptClient() = 0;
 
+            /**
+             * @brief Switch the listening socket to non-blocking accepts
+             * @return True on success
+             */
+            virtual bool setNonBlocking() = 0;
+
+            /**
+             * @brief File descriptor of the listening socket, polled for incoming clients
+             * @return Descriptor, -1 when not open
+             */
+            virtual int getHandle() const = 0;
+
             /**
              * @brief Close the listening socket
              */
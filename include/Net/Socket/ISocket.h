@@ -13,6 +13,8 @@ namespace Xale::Net
             virtual bool connect(const std::string& hostAddress, int port) = 0;
             virtual int send(const std::vector<uint8_t>* data, size_t size) = 0;
             virtual int receive(std::vector<uint8_t>* buffer, size_t size) = 0;
+            virtual int send(const uint8_t* data, size_t size) = 0;
+            virtual int receive(uint8_t* buffer, size_t size) = 0;
             virtual void close() = 0;
     };
 }
@@ -8,6 +8,7 @@
 #include "Net/Socket/IClientConnection.h"
 
 #include <sys/socket.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <vector>
 #include <cstdint>
@@ -41,6 +42,26 @@ namespace Xale::Net
              */
             int respond(const std::vector<uint8_t>* data, size_t size) override;
 
+            /**
+             * @brief Read data the client socket into caller memory
+             */
+            int read(uint8_t* buffer, size_t size) override;
+
+            /**
+             * @brief Send raw bytes the client socket
+             */
+            int respond(const uint8_t* data, size_t size) override;
+
+            /**
+             * @brief Switch the socket to non-blocking mode
+             */
+            bool setNonBlocking() override;
+
+            /**
+             * @brief Client socket fd
+             */
+            int getHandle() const override;
+
             /**
              * @brief Close the client socket
              */
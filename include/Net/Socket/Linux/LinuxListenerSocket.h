@@ -9,6 +9,7 @@
 #include "Net/Socket/Linux/LinuxClientConnection.h"
 
 #include <sys/socket.h>
+#include <fcntl.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
@@ -40,6 +41,16 @@ namespace Xale::Net
              */
             std::unique_ptr<IClientConnection> acceptClient() override;
 
+            /**
+             * @brief Switch the listening socket to non-blocking mode
+             */
+            bool setNonBlocking() override;
+
+            /**
+             * @brief Listening socket fd
+             */
+            int getHandle() const override;
+
             /**
              * @brief Close the listening socket
              */
@@ -6,6 +6,7 @@
 #include "Net/Socket/IClientConnection.h"
 
 #include <openssl/ssl.h>
+#include <fcntl.h>
 #include <sys/socket.h>
 #include <unistd.h>
 #include <vector>
@@ -25,7 +26,7 @@ namespace Xale::Net
             /**
              * @brief Construct from an accepted fd and its SSL object
              * @param fd  Accepted client socket fd
-             * @param ssl SSL object already handshaked for this connection
+             * @param ssl SSL object in server mode, handshaked by the first reads
              */
             LinuxSSLClientConnection(int fd, SSL* ssl);
 
@@ -44,6 +45,26 @@ namespace Xale::Net
              */
             int respond(const std::vector<uint8_t>* data, size_t size) override;
 
+            /**
+             * @brief Read data through SSL into caller memory
+             */
+            int read(uint8_t* buffer, size_t size) override;
+
+            /**
+             * @brief Send raw bytes through SSL
+             */
+            int respond(const uint8_t* data, size_t size) override;
+
+            /**
+             * @brief Switch the socket to non-blocking mode
+             */
+            bool setNonBlocking() override;
+
+            /**
+             * @brief Client socket fd
+             */
+            int getHandle() const override;
+
             /**
              * @brief Shutdown SSL and close the socket
              */
@@ -11,6 +11,7 @@
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include <sys/socket.h>
+#include <fcntl.h>
 #include <netinet/in.h>
 #include <unistd.h>
 
@@ -33,11 +34,24 @@ namespace Xale::Net
             bool open(int port) override;
 
             /**
-             * @brief Block until a client connects, perform SSL handshake, return connection
+             * @brief Block until a client connects, return its connection
+             *
+             * The SSL handshake is left to the first reads of the connection, so
+             * that a slow client never holds the accepting thread.
              * @return IClientConnection for the accepted client, nullptr on error
              */
             std::unique_ptr<IClientConnection> acceptClient() override;
 
+            /**
+             * @brief Switch the listening socket to non-blocking mode
+             */
+            bool setNonBlocking() override;
+
+            /**
+             * @brief Listening socket fd
+             */
+            int getHandle() const override;
+
             /**
              * @brief Close the listening socket and free SSL context
              */
@@ -23,6 +23,8 @@ namespace Xale::Net
             bool connect(const std::string& ip, int port) override;
             int send(const std::vector<uint8_t>* data, size_t size) override;
             int receive(std::vector<uint8_t>* buffer, size_t size) override;
+            int send(const uint8_t* data, size_t size) override;
+            int receive(uint8_t* buffer, size_t size) override;
             void close() override;
 
         private:
@@ -48,6 +48,20 @@ namespace Xale::Net
              */
             int receive(std::vector<uint8_t>* buffer, size_t size) override;
 
+            /**
+             * @brief Send raw bytes through the socket
+             * @param data Bytes to send
+             * @param size Number of bytes
+             */
+            int send(const uint8_t* data, size_t size) override;
+
+            /**
+             * @brief Receive data straight into caller memory
+             * @param buffer Destination of at least size bytes
+             * @param size Maximum size to receive
+             */
+            int receive(uint8_t* buffer, size_t size) override;
+
             /**
              * @brief Close the socket
              */
@@ -2,6 +2,7 @@
 #define NET_TCP_CLIENT_H
 
 #include "Net/Socket/ISocketFactory.h"
+#include "Net/Packet/FrameReader.h"
 #include "Net/Packet/Packet.h"
 
 #include <string>
@@ -42,18 +43,22 @@ namespace Xale::Net
             int receive(std::string* buffer, size_t size);
 
             /**
-             * @brief Sends a packet to the connected TCP server.
+             * @brief Sends a whole packet to the connected TCP server.
              * @param data A pointer to the packet to be sent.
-             * @param size The size of the packet to be sent in bytes.
+             * @param size Unused, the whole serialized packet is sent.
              * @return The number of bytes sent, or -1 if an error occurred.
              */
             int send(const Xale::Net::Packet* data, size_t size);
 
             /**
-             * @brief Receives a packet from the connected TCP server.
+             * @brief Receives the next whole packet from the connected TCP server.
+             *
+             * Reads are accumulated until the length announced by the header is
+             * received; bytes of the following packets are kept for the next call.
              * @param buffer A pointer to the packet where the received data will be stored.
-             * @param size The maximum size of the packet to be received in bytes.
-             * @return The number of bytes received, or -1 if an error occurred.
+             * @param size The number of bytes read per call, more when the pending packet is larger.
+             * @return The size of the packet, 0 if the server closed the connection, or -1 if an error occurred.
+             * @throws DbException PacketError if the stream holds an invalid header.
              */
             int receive(Xale::Net::Packet* buffer, size_t size);
 
@@ -64,7 +69,8 @@ namespace Xale::Net
         private:
             std::unique_ptr<Xale::Net::ISocket> _socket;
             std::unique_ptr<Xale::Net::ISocketFactory> _socketFactory;
-
+            Xale::Net::FrameReader _frames;
+            std::vector<uint8_t> _sendBuffer; ///< Serialized packet, reused from one send to the next
     };
 }
 
@@ -7,46 +7,173 @@
 #include "Net/Socket/IListenerSocket.h"
 #include "Net/Socket/IClientConnection.h"
 
+#include "Net/Packet/FrameReader.h"
 #include "Net/Packet/Packet.h"
 #include "Net/Packet/PacketConstants.h"
 
-#include "Engine/QueryEngine.h" // TODO: remove when injecting from outside
+#include "Core/ThreadPool.h"
+#include "Engine/SessionContext.h"
+#include "Execution/IExecutor.h"
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <mutex>
+#include <unordered_map>
+#include <vector>
 
 namespace Xale::Net
 {
+    /**
+     * @brief Limits of a TcpServer
+     */
+    struct TcpServerOptions
+    {
+        std::size_t workerThreads = 0;        ///< Threads executing queries, 0 for one per hardware thread
+        std::size_t maxConnections = 10000;   ///< Clients served at once, the next ones being disconnected at once
+        std::size_t maxEventsPerWait = 256;   ///< Readiness events handled per wait of the event loop
+        std::size_t readChunkSize = 4096;     ///< Bytes read from a client per call, more when a larger packet is pending
+        uint32_t maxPayloadSize = MAX_PAYLOAD_SIZE; ///< Largest query accepted, a client announcing more being disconnected
+    };
+
+    /**
+     * @brief Serves queries from many clients on a single event loop
+     *
+     * A single thread multiplexes every client in non-blocking mode through
+     * edge-triggered epoll, and a fixed pool of workers executes their queries.
+     * Each client has at most one query executing at a time, its responses
+     * going back in order. An idle client only costs its buffers.
+     *
+     * Each client parses and formats its queries in its own
+     * Xale::Engine::SessionContext, created with its first query; the
+     * executor is shared and locks the tables of every statement, so the
+     * queries of different clients run in parallel on the workers.
+     *
+     * Requests are cut from the byte stream by the length of their header, so
+     * a query may span many reads and a read may hold several queries. While a
+     * complete query waits for the previous one, nothing more is read from
+     * that client.
+     */
     class TcpServer
     {
         public:
-            TcpServer(Xale::Engine::QueryEngine& queryEngine, std::unique_ptr<Xale::Net::ISocketFactory> socketFactory);
+            /**
+             * @param executor Executor shared by the clients, safe to call from several threads
+             * @param socketFactory Factory of the listening socket
+             * @param options Limits of the server
+             */
+            TcpServer(Xale::Execution::IExecutor& executor, std::unique_ptr<Xale::Net::ISocketFactory> socketFactory,
+                TcpServerOptions options = TcpServerOptions());
             ~TcpServer();
 
             /**
-             * @brief Start the server on the given port (blocking accept loop)
+             * @brief Start the server on the given port, running the event loop until stop()
              * @param port TCP port to listen on
+             * @return False if the server could not listen
              */
             bool start(int port);
 
             /**
-             * @brief Stop the server and close the listening socket
+             * @brief Stop the server and close the listening socket, may be called from any thread
              */
             void stop();
 
+            /**
+             * @brief Number of clients currently connected
+             */
+            std::size_t getConnectionCount() const;
+
         private:
+            /**
+             * @brief State of a connected client, owned by the event loop thread
+             */
+            struct Session
+            {
+                explicit Session(uint32_t maxPayloadSize) : frames(maxPayloadSize) {}
+
+                std::unique_ptr<IClientConnection> connection;
+                std::unique_ptr<Xale::Engine::SessionContext> context; ///< Created with the first query
+                FrameReader frames;          ///< Bytes received, not handed to a worker yet
+                Packet request{ CommandType::UNKNOWN, {} }; ///< Query executing, reused from one query to the next
+                std::vector<uint8_t> output; ///< Bytes of the responses
+                std::size_t outputSent = 0;  ///< Bytes of output already sent
+                bool busy = false;           ///< A query of the client is executing on a worker
+                bool closing = false;        ///< Nothing more is read, closed once its work is done
+            };
+
+            /**
+             * @brief Response computed by a worker, sent by the event loop
+             */
+            struct Completion
+            {
+                uint64_t session;
+                std::vector<uint8_t> response;
+            };
+
             Xale::Logger::Logger<TcpServer>& _logger;
             std::unique_ptr<Xale::Net::IListenerSocket> _serverSocket;
             std::unique_ptr<Xale::Net::ISocketFactory>  _socketFactory;
-            Xale::Engine::QueryEngine& _queryEngine; // TODO: inject from outside
-            std::mutex _queryMutex; ///< Protects QueryEngine from concurrent access
+            Xale::Execution::IExecutor& _executor;
+            TcpServerOptions _options;
+
+            int _epoll = -1;
+            int _wakeup = -1; ///< eventfd signaled by the workers and by stop()
+            std::atomic<bool> _running{ false };
+            std::atomic<std::size_t> _connectionCount{ 0 };
+            std::unordered_map<uint64_t, Session> _sessions;
+            uint64_t _nextSession = 0;
+            std::unique_ptr<Xale::Core::ThreadPool> _workers;
+            std::mutex _completionMutex;
+            std::vector<Completion> _completions;
+
+            /**
+             * @brief Accept every waiting client
+             */
+            void acceptClients();
+
+            /**
+             * @brief Read what a client sent, until its socket is drained or a complete query waits
+             */
+            void readClient(Session& session);
+
+            /**
+             * @brief Send as much of the pending responses of a client as its socket takes
+             */
+            void flushClient(Session& session);
+
+            /**
+             * @brief Hand the next complete query of a client to a worker
+             */
+            void dispatch(uint64_t id, Session& session);
+
+            /**
+             * @brief Answer a malformed stream with an error and close the client
+             */
+            void rejectClient(Session& session, const std::string& error);
+
+            /**
+             * @brief Queue the responses computed by the workers
+             */
+            void handleCompletions();
+
+            /**
+             * @brief Dispatch or close a client after its events were handled
+             */
+            void updateSession(uint64_t id);
+
+            /**
+             * @brief Execute the query of a request packet, on a worker
+             * @param context Execution context of the client
+             * @param request Packet received from the client
+             * @return Serialized response packet
+             */
+            std::vector<uint8_t> handleRequest(Xale::Engine::SessionContext& context, const Packet& request);
 
             /**
-             * @brief Handle a single client connection in a dedicated thread
-             * @param conn The client connection (takes ownership)
+             * @brief Close every client and release the event loop
              */
-            void handleClient(std::unique_ptr<IClientConnection> conn);
+            void shutdownLoop();
     };
 }
 
@@ -140,6 +140,13 @@ namespace Xale::Query
              */
             std::unique_ptr<CreateStatement> parseCreate();
 
+            /**
+             * @brief Parse CREATE INDEX statement
+             * @return Unique pointer to CreateIndexStatement
+             * @throws DbException if syntax is invalid
+             */
+            std::unique_ptr<CreateIndexStatement> parseCreateIndex();
+
             /**
              * @brief Parse DROP statement
              * @return Unique pointer to DropStatement
@@ -147,11 +154,53 @@ namespace Xale::Query
              */
             std::unique_ptr<DropStatement> parseDrop();
 
+            /**
+             * @brief Parse DROP INDEX statement
+             * @return Unique pointer to DropIndexStatement
+             * @throws DbException if syntax is invalid
+             */
+            std::unique_ptr<DropIndexStatement> parseDropIndex();
+
+            /**
+             * @brief Check if the token following the current one is a specific identifier
+             * @param identifier Identifier to match (case-insensitive)
+             * @return True if matches, false otherwise
+             */
+            bool peekIdentifier(const std::string& identifier);
+
             /**
              * @brief Parse LIST statement
              */
             std::unique_ptr<ListStatement> parseList();
 
+            /**
+             * @brief Parse EXPLAIN statement (EXPLAIN SELECT ...)
+             * @return Unique pointer to ExplainStatement
+             * @throws DbException if syntax is invalid
+             */
+            std::unique_ptr<ExplainStatement> parseExplain();
+
+            /**
+             * @brief Parse BEGIN, COMMIT or ROLLBACK statement, optionally followed by TRANSACTION
+             * @return Unique pointer to TransactionStatement
+             */
+            std::unique_ptr<TransactionStatement> parseTransaction();
+
+            /**
+             * @brief Parse an aggregate function call of a select list (COUNT(*), SUM(column), ...)
+             * @param name Name of the function, its opening parenthesis being the current token
+             * @return Aggregate expression
+             * @throws DbException if the function is unknown or the syntax is invalid
+             */
+            Expression parseAggregate(const std::string& name);
+
+            /**
+             * @brief Parse the row count of a LIMIT or OFFSET clause
+             * @return Parsed count
+             * @throws DbException if the count is not a non-negative integer
+             */
+            size_t parseRowCount();
+
             /**
              * @brief Parse a JOIN clause (tableName ON left = right)
              * @return Parsed JoinClause
@@ -160,14 +209,28 @@ namespace Xale::Query
             JoinClause parseJoinClause();
 
             /**
-             * @brief Parse an expression
+             * @brief Parse an expression, conditions being combined by OR, then AND, then NOT
              * @return Unique pointer to Expression
              * @throws DbException if syntax is invalid
              */
             std::unique_ptr<Expression> parseExpression();
 
             /**
-             * @brief Parse a comparison expression
+             * @brief Parse conditions combined by AND
+             * @return Unique pointer to Expression
+             * @throws DbException if syntax is invalid
+             */
+            std::unique_ptr<Expression> parseAnd();
+
+            /**
+             * @brief Parse a condition, negated by any NOT in front of it
+             * @return Unique pointer to Expression
+             * @throws DbException if syntax is invalid
+             */
+            std::unique_ptr<Expression> parseNot();
+
+            /**
+             * @brief Parse a comparison, IN or BETWEEN expression, or a parenthesized condition
              * @return Unique pointer to Expression
              * @throws DbException if syntax is invalid
              */
@@ -19,7 +19,13 @@ namespace Xale::Query
         Delete,
         Create,
         Drop,
+        CreateIndex,
+        DropIndex,
         List,
+        Explain,
+        Begin,
+        Commit,
+        Rollback,
         Unknown
     };
 
@@ -32,7 +38,11 @@ namespace Xale::Query
         StringLiteral,
         NumericLiteral,
         BinaryOp,
-        Wildcard
+        Wildcard,
+        Aggregate, ///< Aggregate function, its name in value and its column or wildcard in argument
+        Not,       ///< Negation of the condition in argument
+        In,        ///< Whether argument equals one of the literals of list
+        Between    ///< Whether argument lies between the two literals of list, inclusive
     };
 
     /**
@@ -49,6 +59,8 @@ namespace Xale::Query
         ExpressionType type;
         std::string value;
         std::unique_ptr<BinaryExpression> binary;
+        std::unique_ptr<Expression> argument;
+        std::vector<Expression> list;
 
         Expression() : type(ExpressionType::Identifier) {}
         explicit Expression(ExpressionType t, std::string val = "")
@@ -56,7 +68,7 @@ namespace Xale::Query
     };
 
     /**
-     * @brief Binary expression
+     * @brief Binary expression, a comparison or the AND / OR of two conditions
      */
     struct BinaryExpression
     {
@@ -102,6 +114,15 @@ namespace Xale::Query
         std::string rightTableCol;  ///< Right side of ON condition (e.g. "users.id")
     };
 
+    /**
+     * @brief Represents a key of an ORDER BY clause
+     */
+    struct OrderByItem
+    {
+        Expression expression;   ///< Column, or aggregate function of a grouped query
+        bool descending = false; ///< DESC rather than ASC
+    };
+
     /**
      * @brief SELECT statement structure
      */
@@ -111,6 +132,11 @@ namespace Xale::Query
         std::string tableName;
         std::vector<JoinClause> joins; ///< Optional JOIN clauses
         std::unique_ptr<WhereClause> where;
+        std::vector<std::string> groupBy; ///< Optional GROUP BY columns
+        std::vector<OrderByItem> orderBy; ///< Optional ORDER BY keys, the first one sorting first
+        bool hasLimit = false;         ///< Whether a LIMIT clause is present
+        size_t limit = 0;              ///< Maximum number of rows returned
+        size_t offset = 0;             ///< Number of rows skipped first
 
         SelectStatement() : Statement(StatementType::Select) {}
     };
@@ -195,6 +221,27 @@ namespace Xale::Query
         DropStatement() : Statement(StatementType::Drop) {}
     };
 
+    /**
+     * @brief CREATE INDEX statement structure
+     */
+    struct CreateIndexStatement : public Statement
+    {
+        std::string indexName;
+        std::string tableName;
+        std::string columnName;
+
+        CreateIndexStatement() : Statement(StatementType::CreateIndex) {}
+    };
+
+    /**
+     * @brief DROP INDEX statement structure
+     */
+    struct DropIndexStatement : public Statement
+    {
+        std::string indexName;
+
+        DropIndexStatement() : Statement(StatementType::DropIndex) {}
+    };
 
     /**
      * @brief LIST TABLE statement structure
@@ -203,6 +250,24 @@ namespace Xale::Query
     {
         ListStatement() : Statement(StatementType::List) {}
     };
+
+    /**
+     * @brief EXPLAIN statement structure, describing the plan of a SELECT
+     */
+    struct ExplainStatement : public Statement
+    {
+        std::unique_ptr<SelectStatement> select;
+
+        ExplainStatement() : Statement(StatementType::Explain) {}
+    };
+
+    /**
+     * @brief BEGIN, COMMIT or ROLLBACK statement, opening or closing a transaction
+     */
+    struct TransactionStatement : public Statement
+    {
+        explicit TransactionStatement(StatementType t) : Statement(t) {}
+    };
 }
 
 #endif // QUERY_STATEMENT_H
@@ -63,7 +63,14 @@ namespace Xale::Query
     DECLARE_TOKENS(sql_query_kw,
         "FROM",
         "WHERE",
-        "ON"
+        "ON",
+        "LIMIT",
+        "OFFSET",
+        "GROUP",
+        "BY",
+        "ORDER",
+        "ASC",
+        "DESC"
     );
 
     // Join keywords
@@ -77,7 +84,9 @@ namespace Xale::Query
     DECLARE_TOKENS(sql_logical_kw,
         "AND", 
         "OR", 
-        "NOT"
+        "NOT",
+        "IN",
+        "BETWEEN"
     );
 
     // Operators
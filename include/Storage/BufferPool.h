@@ -0,0 +1,204 @@
+#ifndef STORAGE_BUFFER_POOL_H
+#define STORAGE_BUFFER_POOL_H
+
+#include "Storage/IFileManager.h"
+#include "Storage/Page.h"
+#include "Core/ExceptionHandler.h"
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Xale::Storage
+{
+    /**
+     * @brief Default number of frames of a buffer pool (4 MB with 4 KB pages)
+     */
+    constexpr std::size_t DEFAULT_BUFFER_POOL_CAPACITY = 1024;
+
+    /**
+     * @brief Fixed-size cache of pages on top of an IFileManager
+     *
+     * Pages are read and written one at a time with IFileManager::readAt/writeAt.
+     * Frames are pinned while in use, modified frames are tracked as dirty and
+     * only those are written back (on eviction or flush). Victims are chosen
+     * with the CLOCK (second chance) policy.
+     *
+     * Page 0 of the file is reserved for the file header, which keeps the page
+     * count, the head of the free page list and a root page for the caller.
+     */
+    class BufferPool
+    {
+        public:
+            /**
+             * @brief Constructor
+             * @param fileManager Opened file manager backing the pages
+             * @param capacity Number of frames
+             */
+            BufferPool(IFileManager& fileManager, std::size_t capacity = DEFAULT_BUFFER_POOL_CAPACITY);
+
+            BufferPool(const BufferPool&) = delete;
+            BufferPool& operator=(const BufferPool&) = delete;
+
+            /**
+             * @brief Read the file header, or format a new one if the file has none
+             * @return True if the file already contained a paged layout
+             */
+            bool open();
+
+            /**
+             * @brief Check if the file starts with a paged layout header
+             * @param fileManager Opened file manager
+             * @return True if the header magic is present
+             */
+            static bool hasPagedLayout(IFileManager& fileManager);
+
+            /**
+             * @brief Fetch and pin a page
+             * @param pageId Page to fetch
+             * @return Pointer to the page, valid until unpinned
+             */
+            Page* fetchPage(PageId pageId);
+
+            /**
+             * @brief Release a pinned page
+             * @param pageId Page to release
+             * @param isDirty Whether the caller modified the page
+             */
+            void unpinPage(PageId pageId, bool isDirty);
+
+            /**
+             * @brief Allocate and pin a new page, reusing a free page if possible
+             * @param type Type of the new page
+             * @param outPageId Output identifier of the new page
+             * @return Pointer to the new (dirty) page
+             */
+            Page* newPage(PageType type, PageId& outPageId);
+
+            /**
+             * @brief Give a page back to the free list
+             * @param pageId Page to free (must not be pinned)
+             */
+            void freePage(PageId pageId);
+
+            /**
+             * @brief Write a page back if it is dirty
+             * @param pageId Page to flush
+             */
+            void flushPage(PageId pageId);
+
+            /**
+             * @brief Write back every dirty page and the file header
+             */
+            void flushAllPages();
+
+            /**
+             * @brief Visit the content of every dirty page, file header (page 0) included
+             * @param callback Called with the page identifier and its PAGE_SIZE bytes
+             */
+            void forEachDirtyPage(const std::function<void(PageId, const char*)>& callback);
+
+            /**
+             * @brief Forbid writing dirty pages back on eviction
+             *
+             * Used when pages may only reach the file once logged (see WriteAheadLog).
+             * When every frame is dirty or pinned, the pool grows instead of evicting.
+             * @param noSteal True to keep dirty pages in memory until flushed
+             */
+            void setNoSteal(bool noSteal);
+
+            /**
+             * @brief Get the caller root page (e.g. the catalog)
+             */
+            PageId getRootPageId() const;
+
+            /**
+             * @brief Set the caller root page
+             * @param pageId Root page identifier
+             */
+            void setRootPageId(PageId pageId);
+
+            /**
+             * @brief Number of pages of the file, header page included
+             */
+            std::uint32_t getPageCount() const;
+
+            /**
+             * @brief Number of frames
+             */
+            std::size_t getCapacity() const;
+
+            /**
+             * @brief Number of pages read from the file since construction
+             */
+            std::uint64_t getReadCount() const;
+
+            /**
+             * @brief Number of pages written to the file since construction
+             */
+            std::uint64_t getWriteCount() const;
+
+        private:
+            /**
+             * @brief Persistent file header stored at the beginning of page 0
+             */
+            struct FileHeader
+            {
+                char magic[4];
+                std::uint32_t version;
+                std::uint32_t pageCount;
+                std::uint32_t freeListHead;
+                std::uint32_t rootPageId;
+            };
+
+            /**
+             * @brief In-memory slot holding one page
+             */
+            struct Frame
+            {
+                Page page;
+                PageId pageId = INVALID_PAGE_ID;
+                int pinCount = 0;
+                bool dirty = false;
+                bool referenced = false;
+            };
+
+            IFileManager& _fileManager;
+            std::deque<Frame> _frames; ///< Deque so that growing keeps Page pointers valid
+            std::unordered_map<PageId, std::size_t> _pageTable;
+            std::size_t _clockHand = 0;
+            FileHeader _header;
+            bool _headerDirty = false;
+            bool _noSteal = false;
+            std::uint64_t _readCount = 0;
+            std::uint64_t _writeCount = 0;
+            mutable std::mutex _mutex;
+
+            /**
+             * @brief Find a frame for a new page, evicting a victim if needed
+             * @return Index of the free frame
+             */
+            std::size_t acquireFrame();
+
+            /**
+             * @brief Pin a page without locking (caller holds the mutex)
+             */
+            Page* fetchPageUnlocked(PageId pageId);
+
+            /**
+             * @brief Write a frame back to the file
+             */
+            void writeFrame(Frame& frame);
+
+            /**
+             * @brief Write the file header to page 0
+             */
+            void writeHeader();
+    };
+}
+
+#endif // STORAGE_BUFFER_POOL_H
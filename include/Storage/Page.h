@@ -0,0 +1,195 @@
+#ifndef STORAGE_PAGE_H
+#define STORAGE_PAGE_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Xale::Storage
+{
+    /**
+     * @brief Size in bytes of every page of the data file
+     */
+    constexpr std::size_t PAGE_SIZE = 4096;
+
+    /**
+     * @brief Page identifier (index of the page in the data file)
+     */
+    using PageId = std::uint32_t;
+
+    /**
+     * @brief Sentinel value used for "no page" links
+     */
+    constexpr PageId INVALID_PAGE_ID = 0xFFFFFFFF;
+
+    /**
+     * @brief Kind of content stored in a page
+     */
+    enum class PageType : std::uint8_t
+    {
+        Free = 0,
+        FileHeader,
+        Catalog,
+        Directory,
+        Data,
+        Overflow
+    };
+
+    /**
+     * @brief Location of a record inside the data file
+     */
+    struct RecordId
+    {
+        PageId pageId = INVALID_PAGE_ID;
+        std::uint16_t slot = 0;
+
+        bool isValid() const { return pageId != INVALID_PAGE_ID; }
+    };
+
+    /**
+     * @brief Common header at the beginning of every page
+     */
+    struct PageHeader
+    {
+        std::uint32_t nextPageId;   ///< Next page of the same chain, INVALID_PAGE_ID if none
+        std::uint16_t slotCount;    ///< Number of slot entries (slotted pages)
+        std::uint16_t freeStart;    ///< End of the slot array
+        std::uint16_t freeEnd;      ///< Start of the record heap
+        std::uint8_t type;          ///< PageType
+        std::uint8_t reserved;
+    };
+
+    /**
+     * @brief Fixed-size page with a slotted layout
+     *
+     * Layout: [PageHeader][slot array ->    free space    <- record heap]
+     * Each slot entry stores the offset and the length of its record. A slot
+     * with an offset of 0 is empty and can be reused. The highest bit of the
+     * length is left to callers as a record flag (see RECORD_FLAG).
+     */
+    class Page
+    {
+        public:
+            /**
+             * @brief Flag bit callers may set on a record length
+             */
+            static constexpr std::uint16_t RECORD_FLAG = 0x8000;
+
+            /**
+             * @brief Reset the page to an empty page of the given type
+             * @param type Type of the page
+             */
+            void init(PageType type);
+
+            /**
+             * @brief Get raw page bytes
+             */
+            char* data();
+
+            /** @copydoc Page::data */
+            const char* data() const;
+
+            /**
+             * @brief Get the bytes following the header, for pages without slots
+             */
+            char* payload();
+
+            /** @copydoc Page::payload */
+            const char* payload() const;
+
+            /**
+             * @brief Size of the payload area
+             */
+            static constexpr std::size_t payloadSize()
+            {
+                return PAGE_SIZE - sizeof(PageHeader);
+            }
+
+            /**
+             * @brief Get the page type
+             */
+            PageType getType() const;
+
+            /**
+             * @brief Get the next page in the chain
+             */
+            PageId getNextPageId() const;
+
+            /**
+             * @brief Set the next page in the chain
+             * @param pageId Next page identifier
+             */
+            void setNextPageId(PageId pageId);
+
+            /**
+             * @brief Get the number of slot entries (including empty ones)
+             */
+            std::uint16_t getSlotCount() const;
+
+            /**
+             * @brief Bytes available for a new record, slot entry included, after compaction
+             */
+            std::size_t getFreeSpace() const;
+
+            /**
+             * @brief Insert a record in the page
+             * @param record Record bytes
+             * @param size Record size
+             * @param flag Whether RECORD_FLAG is set on the record
+             * @return Slot of the new record, or -1 if the page is full
+             */
+            int insertRecord(const char* record, std::uint16_t size, bool flag = false);
+
+            /**
+             * @brief Replace the content of a record
+             * @param slot Slot of the record
+             * @param record New record bytes
+             * @param size New record size
+             * @param flag Whether RECORD_FLAG is set on the record
+             * @return False if the new record does not fit in this page
+             */
+            bool updateRecord(std::uint16_t slot, const char* record, std::uint16_t size, bool flag = false);
+
+            /**
+             * @brief Remove a record from the page
+             * @param slot Slot of the record
+             */
+            void eraseRecord(std::uint16_t slot);
+
+            /**
+             * @brief Get a record
+             * @param slot Slot of the record
+             * @param size Output record size
+             * @param flag Output RECORD_FLAG state, may be null
+             * @return Pointer to the record bytes, nullptr if the slot is empty
+             */
+            const char* getRecord(std::uint16_t slot, std::uint16_t& size, bool* flag = nullptr) const;
+
+            /**
+             * @brief Largest record a single empty page can hold
+             */
+            static constexpr std::size_t maxRecordSize()
+            {
+                return PAGE_SIZE - sizeof(PageHeader) - 2 * sizeof(std::uint16_t);
+            }
+
+        private:
+            alignas(8) char _data[PAGE_SIZE];
+
+            PageHeader* header();
+            const PageHeader* header() const;
+            std::uint16_t* slotEntry(std::uint16_t slot);
+            const std::uint16_t* slotEntry(std::uint16_t slot) const;
+
+            /**
+             * @brief Bytes taken by the header, the slot array and the records
+             */
+            std::size_t getUsedSpace() const;
+
+            /**
+             * @brief Rewrite the record heap without holes
+             */
+            void compact();
+    };
+}
+
+#endif // STORAGE_PAGE_H
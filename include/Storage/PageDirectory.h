@@ -0,0 +1,148 @@
+#ifndef STORAGE_PAGE_DIRECTORY_H
+#define STORAGE_PAGE_DIRECTORY_H
+
+#include "Storage/BufferPool.h"
+#include "Storage/Page.h"
+
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace Xale::Storage
+{
+    /**
+     * @brief Set of slotted data pages owned by one table (or the catalog)
+     *
+     * The directory itself is a chain of pages listing the identifiers of the
+     * data pages. Records larger than a page are stored in a chain of overflow
+     * pages and referenced by a flagged stub record.
+     */
+    class PageDirectory
+    {
+        public:
+            /**
+             * @brief Open an existing directory
+             * @param pool Buffer pool of the data file
+             * @param rootPageId First page of the directory chain
+             */
+            PageDirectory(BufferPool& pool, PageId rootPageId);
+
+            /**
+             * @brief Allocate an empty directory
+             * @param pool Buffer pool of the data file
+             * @return First page of the new directory chain
+             */
+            static PageId create(BufferPool& pool);
+
+            /**
+             * @brief Get the first page of the directory chain
+             */
+            PageId getRootPageId() const;
+
+            /**
+             * @brief Get the number of data pages
+             */
+            std::size_t getDataPageCount() const;
+
+            /**
+             * @brief Store a new record
+             * @param record Record bytes
+             * @return Location of the record
+             */
+            RecordId insertRecord(const std::vector<char>& record);
+
+            /**
+             * @brief Replace a record, moving it if it does not fit in its page anymore
+             * @param rid Current location of the record
+             * @param record New record bytes
+             * @return New location of the record
+             */
+            RecordId updateRecord(RecordId rid, const std::vector<char>& record);
+
+            /**
+             * @brief Remove a record
+             * @param rid Location of the record
+             */
+            void eraseRecord(RecordId rid);
+
+            /**
+             * @brief Read a record
+             * @param rid Location of the record
+             * @return Record bytes
+             */
+            std::vector<char> readRecord(RecordId rid);
+
+            /**
+             * @brief Visit every record, page by page
+             * @param callback Called with the location and the bytes of each record
+             */
+            void forEachRecord(const std::function<void(RecordId, const std::vector<char>&)>& callback);
+
+            /**
+             * @brief Give every page of the directory back to the buffer pool
+             */
+            void drop();
+
+        private:
+            BufferPool& _pool;
+            PageId _rootPageId;
+            std::vector<PageId> _directoryPages;
+            std::vector<PageId> _dataPages;
+            std::unordered_map<PageId, std::size_t> _pageIndexes; ///< Data page id -> index in _dataPages
+            std::set<std::size_t> _pagesWithSpace; ///< Indexes in _dataPages worth trying on insert
+
+            /**
+             * @brief Number of page ids a directory page can hold
+             */
+            static constexpr std::size_t entriesPerPage()
+            {
+                return (Page::payloadSize() - sizeof(std::uint32_t)) / sizeof(PageId);
+            }
+
+            /**
+             * @brief Register a new data page in the directory chain
+             * @return Identifier of the new data page
+             */
+            PageId appendDataPage();
+
+            /**
+             * @brief Remember that a data page got some room back
+             */
+            void markHasSpace(PageId pageId);
+
+            /**
+             * @brief Try to insert an inline record in a given data page
+             * @return Slot of the record, -1 if it did not fit
+             */
+            int tryInsert(std::size_t pageIndex, const char* record, std::uint16_t size, bool flag);
+
+            /**
+             * @brief Store an inline record (or overflow stub) somewhere with room
+             */
+            RecordId insertInline(const char* record, std::uint16_t size, bool flag);
+
+            /**
+             * @brief Write a large record into a chain of overflow pages
+             * @return First page of the chain
+             */
+            PageId writeOverflow(const std::vector<char>& record);
+
+            /**
+             * @brief Read back a large record from its overflow chain
+             */
+            std::vector<char> readOverflow(PageId firstPageId, std::uint32_t size);
+
+            /**
+             * @brief Free a chain of overflow pages
+             */
+            void freeOverflow(PageId firstPageId);
+
+            /**
+             * @brief Decode a raw record, following the overflow chain if flagged
+             */
+            std::vector<char> materialize(const char* data, std::uint16_t size, bool flag);
+    };
+}
+
+#endif // STORAGE_PAGE_DIRECTORY_H
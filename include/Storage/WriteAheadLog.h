@@ -0,0 +1,152 @@
+#ifndef STORAGE_WRITE_AHEAD_LOG_H
+#define STORAGE_WRITE_AHEAD_LOG_H
+
+#include "Storage/IFileManager.h"
+#include "Core/ExceptionHandler.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Xale::Storage
+{
+    /**
+     * @brief Default log size after which the owner should checkpoint (4 MB)
+     */
+    constexpr std::uint64_t DEFAULT_CHECKPOINT_THRESHOLD = 4 * 1024 * 1024;
+
+    /**
+     * @brief Kind of a log record
+     */
+    enum class LogRecordType : std::uint8_t
+    {
+        SetSchema = 1,  ///< Table created or schema changed
+        SetRow,         ///< Row slot written
+        TruncateRows,   ///< Rows removed from the end of a table
+        DropTable,      ///< Table dropped
+        Commit,         ///< End of a group of records applied atomically
+        PageImage,      ///< Page content written by a checkpoint
+        CheckpointEnd   ///< Every page image of a checkpoint is logged
+    };
+
+    /**
+     * @brief Single log record, the payload format is defined by the owner
+     */
+    struct LogRecord
+    {
+        LogRecordType type;
+        std::vector<char> payload;
+    };
+
+    /**
+     * @brief Append-only redo log with group commit
+     *
+     * File layout: [header: magic, version, epoch][record]*
+     * Record layout: [4 bytes: payload_length][4 bytes: checksum][1 byte: type][N bytes: payload]
+     *
+     * The checksum covers the epoch, so resetting the log only rewrites the
+     * header: records left from a previous epoch no longer validate and the
+     * recovery stops at the first of them.
+     *
+     * Committed records are written and synced by a dedicated thread: every
+     * committer waiting while a sync is in progress shares the next one.
+     */
+    class WriteAheadLog
+    {
+        public:
+            /**
+             * @brief Constructor
+             * @param fileManager Opened file manager of the log file
+             */
+            explicit WriteAheadLog(IFileManager& fileManager);
+
+            /**
+             * @brief Destructor, stops the group commit thread
+             */
+            ~WriteAheadLog();
+
+            WriteAheadLog(const WriteAheadLog&) = delete;
+            WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+            /**
+             * @brief Read back the valid records of the log and start the group commit thread
+             *
+             * A log file without header is initialized.
+             * @return Records of the current epoch, in order
+             */
+            std::vector<LogRecord> recover();
+
+            /**
+             * @brief Append records followed by a Commit record, wait until they are synced
+             * @param records Records to commit
+             */
+            void commit(const std::vector<LogRecord>& records);
+
+            /**
+             * @brief Append page images followed by a CheckpointEnd record, and sync
+             * @param pageImages PageImage records
+             */
+            void writeCheckpoint(const std::vector<LogRecord>& pageImages);
+
+            /**
+             * @brief Discard every record, once checkpointed in the data file
+             */
+            void reset();
+
+            /**
+             * @brief Bytes of records appended since the last reset
+             */
+            std::uint64_t size() const;
+
+            /**
+             * @brief Number of syncs of the log file since construction
+             */
+            std::uint64_t getSyncCount() const;
+
+        private:
+            IFileManager& _fileManager;
+            std::uint64_t _epoch = 0;
+            std::uint64_t _writeOffset = 0;     ///< End of the records written to the file
+            std::vector<char> _pending;         ///< Committed records not written yet
+            std::uint64_t _appendedCommits = 0;
+            std::uint64_t _durableCommits = 0;
+            std::uint64_t _syncCount = 0;
+            bool _running = false;
+            bool _stopping = false;
+            std::exception_ptr _error;
+            mutable std::mutex _mutex;
+            std::condition_variable _flushCondition;
+            std::condition_variable _durableCondition;
+            std::thread _flusher;
+
+            /**
+             * @brief Group commit thread body
+             */
+            void flushLoop();
+
+            /**
+             * @brief Wait until every committed record is synced (caller holds the lock)
+             */
+            void waitDurable(std::unique_lock<std::mutex>& lock, std::uint64_t commit);
+
+            /**
+             * @brief Write the header with the current epoch and sync
+             */
+            void writeHeader();
+
+            /**
+             * @brief Encode a record at the end of a buffer
+             */
+            void encode(std::vector<char>& buffer, LogRecordType type, const std::vector<char>& payload) const;
+
+            /**
+             * @brief Checksum of a record for the current epoch
+             */
+            std::uint32_t checksum(LogRecordType type, const char* payload, std::size_t size) const;
+    };
+}
+
+#endif // STORAGE_WRITE_AHEAD_LOG_H
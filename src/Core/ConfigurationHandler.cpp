@@ -102,6 +102,50 @@ namespace Xale::Core
             }
         }
 
+        // Optional, no limit by default
+        std::string indexMemoryLimit;
+        _indexMemoryLimit = 0;
+        if (extractStringField(content, "IndexMemoryLimit", indexMemoryLimit)) {
+            try {
+                _indexMemoryLimit = static_cast<std::size_t>(std::stoull(indexMemoryLimit));
+            } catch (...) {
+                outError = "Invalid 'IndexMemoryLimit' in config";
+            }
+        }
+
+        // Optional, one worker per hardware thread by default
+        std::string serverWorkers;
+        _serverWorkers = 0;
+        if (extractStringField(content, "ServerWorkers", serverWorkers)) {
+            try {
+                _serverWorkers = static_cast<std::size_t>(std::stoull(serverWorkers));
+            } catch (...) {
+                outError = "Invalid 'ServerWorkers' in config";
+            }
+        }
+
+        // Optional
+        std::string maxConnections;
+        _maxConnections = 10000;
+        if (extractStringField(content, "MaxConnections", maxConnections)) {
+            try {
+                _maxConnections = static_cast<std::size_t>(std::stoull(maxConnections));
+            } catch (...) {
+                outError = "Invalid 'MaxConnections' in config";
+            }
+        }
+
+        // Optional, in milliseconds, 0 disables the background vacuum
+        std::string vacuumInterval;
+        _vacuumInterval = 1000;
+        if (extractStringField(content, "VacuumInterval", vacuumInterval)) {
+            try {
+                _vacuumInterval = static_cast<std::size_t>(std::stoull(vacuumInterval));
+            } catch (...) {
+                outError = "Invalid 'VacuumInterval' in config";
+            }
+        }
+
         _loaded = true;
         return true;
     }
@@ -156,6 +200,26 @@ namespace Xale::Core
         return _serverSSLKey; 
     }
 
+    std::size_t ConfigurationHandler::getIndexMemoryLimit() const noexcept
+    {
+        return _indexMemoryLimit;
+    }
+
+    std::size_t ConfigurationHandler::getServerWorkers() const noexcept
+    {
+        return _serverWorkers;
+    }
+
+    std::size_t ConfigurationHandler::getMaxConnections() const noexcept
+    {
+        return _maxConnections;
+    }
+
+    std::size_t ConfigurationHandler::getVacuumInterval() const noexcept
+    {
+        return _vacuumInterval;
+    }
+
     bool ConfigurationHandler::extractStringField(const std::string& text, const std::string& key, std::string& outValue)
     {
         const std::string pattern = "\"" + key + "\"";
@@ -85,6 +85,10 @@ namespace Xale::Core
             _logger.debug("Use SSL: " + std::string(configHandler.useSSL() ? "true" : "false"));
             _logger.debug("SSL Cert File: " + configHandler.getServerSSLCert());
             _logger.debug("SSL Key File: " + configHandler.getServerSSLKey());
+            _logger.debug("Index Memory Limit: " + std::to_string(configHandler.getIndexMemoryLimit()));
+            _logger.debug("Server Workers: " + std::to_string(configHandler.getServerWorkers()));
+            _logger.debug("Max Connections: " + std::to_string(configHandler.getMaxConnections()));
+            _logger.debug("Vacuum Interval: " + std::to_string(configHandler.getVacuumInterval()) + " ms");
 
             // Setup engines
 
@@ -102,9 +106,18 @@ namespace Xale::Core
                 _logger.error("Executor StorageEngine startup failed");
                 return false;
             }
+            _walFm = std::make_unique<Xale::Storage::BinaryFileManager>();
+            _walStorageEngine = std::make_unique<Xale::Storage::FileStorageEngine>(*_walFm, dataFilePath + ".wal");
+            if (!_walStorageEngine->startup())
+            {
+                _logger.error("Write-ahead log StorageEngine startup failed");
+                return false;
+            }
             _parserTokenizer =  std::make_unique<Xale::Query::BasicTokenizer>();
             _parser = std::make_unique<Xale::Query::BasicParser>(_parserTokenizer.get());
-            _tableManager = std::make_unique<Xale::Execution::TableManager>(*_fileStorageEngine, *_execFm);
+            _tableManager = std::make_unique<Xale::Execution::TableManager>(*_fileStorageEngine, *_execFm, _walFm.get());
+            _tableManager->setIndexMemoryLimit(configHandler.getIndexMemoryLimit());
+            _tableManager->startVacuum(std::chrono::milliseconds(configHandler.getVacuumInterval()));
             _executor = std::make_unique<Xale::Execution::BasicExecutor>(*_tableManager);
             _queryEngine = std::make_unique<Xale::Engine::QueryEngine>(_parser.get(), _executor.get());
             _isSetupDone = true;
@@ -118,6 +131,11 @@ namespace Xale::Core
         return *_queryEngine;
     }
 
+    Xale::Execution::IExecutor& Setup::getExecutor()
+    {
+        return *_executor;
+    }
+
     std::unique_ptr<Xale::Net::ISocketFactory>& Setup::getSocketFactory()
     {
         return _socketFactory;
@@ -134,6 +152,16 @@ namespace Xale::Core
         {
             _queryEngine.reset();
             _executor.reset();
+            if (_tableManager)
+            {
+                try {
+                    _tableManager->checkpoint();
+                }
+                catch (const Xale::Core::DbException& e)
+                {
+                    _logger.error("Checkpoint failed: " + std::string(e.what()));
+                }
+            }
             _tableManager.reset();
             _parser.reset();
             _parserTokenizer.reset();
@@ -146,6 +174,15 @@ namespace Xale::Core
             {
                 _execFm.reset();
             }
+            if (_walStorageEngine)
+            {
+                _walStorageEngine->shutdown();
+                _walStorageEngine.reset();
+            }
+            if (_walFm)
+            {
+                _walFm.reset();
+            }
             if (_socketFactory)
             {
                 _socketFactory.reset();
@@ -0,0 +1,69 @@
+#include "Core/SharedMutex.h"
+
+namespace Xale::Core
+{
+    void SharedMutex::lock()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _released.wait(lock, [this] { return !_exclusive && _shared == 0; });
+        _exclusive = true;
+    }
+
+    bool SharedMutex::try_lock()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_exclusive || _shared != 0)
+            return false;
+
+        _exclusive = true;
+        return true;
+    }
+
+    bool SharedMutex::try_lock_for(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_released.wait_for(lock, timeout, [this] { return !_exclusive && _shared == 0; }))
+            return false;
+
+        _exclusive = true;
+        return true;
+    }
+
+    void SharedMutex::unlock()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _exclusive = false;
+        }
+        _released.notify_all();
+    }
+
+    void SharedMutex::lock_shared()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _released.wait(lock, [this] { return !_exclusive; });
+        ++_shared;
+    }
+
+    bool SharedMutex::try_lock_shared()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_exclusive)
+            return false;
+
+        ++_shared;
+        return true;
+    }
+
+    void SharedMutex::unlock_shared()
+    {
+        bool isLast;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            isLast = --_shared == 0;
+        }
+
+        if (isLast)
+            _released.notify_all();
+    }
+}
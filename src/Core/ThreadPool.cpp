@@ -0,0 +1,67 @@
+#include "Core/ThreadPool.h"
+
+#include <algorithm>
+
+namespace Xale::Core
+{
+    ThreadPool::ThreadPool(std::size_t threadCount)
+    {
+        if (threadCount == 0)
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+        _threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i)
+            _threads.emplace_back(&ThreadPool::work, this);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _taskCondition.notify_all();
+
+        for (auto& thread : _threads)
+            thread.join();
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.push_back(std::move(task));
+        }
+        _taskCondition.notify_one();
+    }
+
+    std::size_t ThreadPool::getThreadCount() const
+    {
+        return _threads.size();
+    }
+
+    void ThreadPool::work()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _taskCondition.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+
+                // Queued tasks still run once the pool is stopping
+                if (_tasks.empty())
+                    return;
+
+                task = std::move(_tasks.front());
+                _tasks.pop_front();
+            }
+
+            try {
+                task();
+            } catch (...) {
+                // A failing task must not take its thread down
+            }
+        }
+    }
+}
@@ -0,0 +1,187 @@
+#include "DataStructure/ColumnVector.h"
+
+namespace Xale::DataStructure
+{
+	ColumnVector::ColumnVector(ColumnKind kind)
+		:_kind(kind)
+	{}
+
+	ColumnKind ColumnVector::getKind() const
+	{
+		return _kind;
+	}
+
+	size_t ColumnVector::size() const
+	{
+		return _size;
+	}
+
+	size_t ColumnVector::nullCount() const
+	{
+		return _nullCount;
+	}
+
+	const std::vector<uint64_t>& ColumnVector::getNullBitmap() const
+	{
+		return _nulls;
+	}
+
+	const int32_t* ColumnVector::integers() const
+	{
+		return _integers.data();
+	}
+
+	const double* ColumnVector::floats() const
+	{
+		return _floats.data();
+	}
+
+	FieldValue ColumnVector::valueAt(size_t index) const
+	{
+		if (_kind == ColumnKind::Mixed)
+			return _mixed[index];
+		if (isNull(index))
+			return std::monostate{};
+
+		switch (_kind)
+		{
+			case ColumnKind::Integer:
+				return static_cast<int>(_integers[index]);
+			case ColumnKind::Float:
+				return _floats[index];
+			default:
+				return std::string(stringAt(index));
+		}
+	}
+
+	void ColumnVector::append(const FieldValue& value)
+	{
+		if (_size % 64 == 0)
+			_nulls.push_back(0);
+
+		const bool isNullValue = std::holds_alternative<std::monostate>(value);
+
+		if (!isNullValue && _kind != ColumnKind::Mixed && kindOf(value) != _kind)
+		{
+			// Only NULL values so far: the column takes the kind of the first value
+			if (_nullCount == _size)
+			{
+				_integers.clear();
+				_floats.clear();
+				_offsets.assign(1, 0);
+				_kind = kindOf(value);
+				for (size_t i = 0; i < _size; ++i)
+					appendEmpty();
+			}
+			else
+			{
+				convertToMixed();
+			}
+		}
+
+		if (isNullValue)
+		{
+			_nulls.back() |= uint64_t(1) << (_size % 64);
+			++_nullCount;
+		}
+
+		switch (_kind)
+		{
+			case ColumnKind::Integer:
+				_integers.push_back(isNullValue ? 0 : std::get<int>(value));
+				break;
+			case ColumnKind::Float:
+				_floats.push_back(isNullValue ? 0.0 : std::get<double>(value));
+				break;
+			case ColumnKind::String:
+				if (!isNullValue)
+				{
+					const std::string& str = std::get<std::string>(value);
+					_heap.insert(_heap.end(), str.begin(), str.end());
+				}
+				_offsets.push_back(_heap.size());
+				break;
+			case ColumnKind::Mixed:
+				_mixed.push_back(value);
+				break;
+		}
+
+		++_size;
+	}
+
+	void ColumnVector::reserve(size_t count)
+	{
+		_nulls.reserve((count + 63) / 64);
+
+		switch (_kind)
+		{
+			case ColumnKind::Integer:
+				_integers.reserve(count);
+				break;
+			case ColumnKind::Float:
+				_floats.reserve(count);
+				break;
+			case ColumnKind::String:
+				_offsets.reserve(count + 1);
+				break;
+			case ColumnKind::Mixed:
+				_mixed.reserve(count);
+				break;
+		}
+	}
+
+	size_t ColumnVector::memoryUsage() const
+	{
+		return _integers.capacity() * sizeof(int32_t)
+			+ _floats.capacity() * sizeof(double)
+			+ _offsets.capacity() * sizeof(size_t)
+			+ _heap.capacity()
+			+ _mixed.capacity() * sizeof(FieldValue)
+			+ _nulls.capacity() * sizeof(uint64_t);
+	}
+
+	ColumnKind ColumnVector::kindOf(const FieldValue& value)
+	{
+		if (std::holds_alternative<int>(value))
+			return ColumnKind::Integer;
+		if (std::holds_alternative<double>(value))
+			return ColumnKind::Float;
+		if (std::holds_alternative<std::string>(value))
+			return ColumnKind::String;
+		return ColumnKind::Mixed;
+	}
+
+	void ColumnVector::convertToMixed()
+	{
+		std::vector<FieldValue> values;
+		values.reserve(_size);
+		for (size_t i = 0; i < _size; ++i)
+			values.push_back(valueAt(i));
+
+		_integers = {};
+		_floats = {};
+		_offsets = { 0 };
+		_heap = {};
+		_mixed = std::move(values);
+		_kind = ColumnKind::Mixed;
+	}
+
+	void ColumnVector::appendEmpty()
+	{
+		switch (_kind)
+		{
+			case ColumnKind::Integer:
+				_integers.push_back(0);
+				break;
+			case ColumnKind::Float:
+				_floats.push_back(0.0);
+				break;
+			case ColumnKind::String:
+				_offsets.push_back(_heap.size());
+				break;
+			case ColumnKind::Mixed:
+				_mixed.push_back(std::monostate{});
+				break;
+		}
+	}
+}
@@ -0,0 +1,133 @@
+#include "DataStructure/ColumnarTable.h"
+
+namespace Xale::DataStructure
+{
+	namespace
+	{
+		ColumnKind kindOfType(FieldType type)
+		{
+			switch (type)
+			{
+				case FieldType::Integer:
+					return ColumnKind::Integer;
+				case FieldType::Float:
+					return ColumnKind::Float;
+				case FieldType::String:
+					return ColumnKind::String;
+				default:
+					return ColumnKind::Mixed;
+			}
+		}
+	}
+
+	ColumnarTable::ColumnarTable(const std::string& name, const std::vector<ColumnDefinition>& schema)
+		:_name(name), _schema(schema)
+	{
+		_columns.reserve(_schema.size());
+		for (const auto& column : _schema)
+			_columns.emplace_back(kindOfType(column.type));
+	}
+
+	ColumnarTable::ColumnarTable(const IDataTemplate& source)
+		:ColumnarTable(source.getName(), source.getSchema())
+	{
+		reserve(source.getRowCount());
+		for (const auto& row : source.getRows())
+			appendRow(row);
+	}
+
+	const std::string& ColumnarTable::getName() const
+	{
+		return _name;
+	}
+
+	const std::vector<ColumnDefinition>& ColumnarTable::getSchema() const
+	{
+		return _schema;
+	}
+
+	const std::vector<Row>& ColumnarTable::getRows() const
+	{
+		if (!_rowCacheValid)
+		{
+			_rowCache.clear();
+			_rowCache.reserve(_rowCount);
+			for (size_t i = 0; i < _rowCount; ++i)
+				_rowCache.push_back(getRow(i));
+			_rowCacheValid = true;
+		}
+
+		return _rowCache;
+	}
+
+	size_t ColumnarTable::getRowCount() const
+	{
+		return _rowCount;
+	}
+
+	size_t ColumnarTable::getColumnCount() const
+	{
+		return _schema.size();
+	}
+
+	bool ColumnarTable::isEmpty() const
+	{
+		return _rowCount == 0;
+	}
+
+	bool ColumnarTable::isMutable() const
+	{
+		return false;
+	}
+
+	const ColumnVector& ColumnarTable::getColumn(size_t index) const
+	{
+		return _columns[index];
+	}
+
+	Row ColumnarTable::getRow(size_t index) const
+	{
+		Row row;
+		row.values.reserve(_columns.size());
+
+		for (const auto& column : _columns)
+			row.values.push_back(column.valueAt(index));
+
+		return row;
+	}
+
+	bool ColumnarTable::appendRow(const Row& row)
+	{
+		if (row.values.size() != _columns.size())
+			return false;
+
+		for (size_t i = 0; i < _columns.size(); ++i)
+			_columns[i].append(row.values[i]);
+
+		++_rowCount;
+
+		if (_rowCacheValid)
+		{
+			_rowCache = {};
+			_rowCacheValid = false;
+		}
+
+		return true;
+	}
+
+	void ColumnarTable::reserve(size_t count)
+	{
+		for (auto& column : _columns)
+			column.reserve(count);
+	}
+
+	size_t ColumnarTable::memoryUsage() const
+	{
+		size_t bytes = 0;
+
+		for (const auto& column : _columns)
+			bytes += column.memoryUsage();
+
+		return bytes;
+	}
+}
@@ -1,7 +1,37 @@
 #include "DataStructure/Table.h"
+#include "Core/ExceptionHandler.h"
+
+#include <algorithm>
+#include <iterator>
 
 namespace Xale::DataStructure
 {
+	namespace
+	{
+		/**
+		 * @brief Call a function on the values of an index whose key lies in a range, in key order
+		 */
+		template <typename TTree, typename TFunction>
+		void forEachInRange(
+			TTree& tree,
+			const FieldValue* lower,
+			bool lowerInclusive,
+			const FieldValue* upper,
+			bool upperInclusive,
+			TFunction function)
+		{
+			FieldValueLess less;
+			auto it = !lower ? tree.begin() : (lowerInclusive ? tree.lowerBound(*lower) : tree.upperBound(*lower));
+
+			for (; it != tree.end(); ++it)
+			{
+				if (upper && (upperInclusive ? less(*upper, it.key()) : !less(it.key(), *upper)))
+					break;
+				function(it.value());
+			}
+		}
+	}
+
 	Table::Table(const std::string& name)
 		:_name(name)
 	{}
@@ -23,7 +53,46 @@ namespace Xale::DataStructure
 
 	size_t Table::getRowCount() const
 	{
-		return _rows.size();
+		return _shared->slotCount.load();
+	}
+
+	const Row& Table::getRow(size_t slot) const
+	{
+		return _shared->rows.load()[slot];
+	}
+
+	bool Table::isVisible(size_t slot, const Snapshot& snapshot) const
+	{
+		const RowVersion& version = _shared->versions.load()[slot];
+		return snapshot.sees(version.begin.load(), version.end.load());
+	}
+
+	bool Table::hasHiddenVersions(const Snapshot& snapshot) const
+	{
+		// A commit stores its timestamp before releasing its pending versions
+		return _shared->endedCount.load() > 0
+			|| _shared->pendingCount.load() > 0
+			|| _shared->lastCommit.load() > snapshot.timestamp;
+	}
+
+	bool Table::hasCommittedRow(size_t slot) const
+	{
+		const RowVersion& version = _versions[slot];
+		return !isRemoved(slot)
+			&& !(version.begin.load() & PENDING_VERSION)
+			&& (version.end.load() & PENDING_VERSION);
+	}
+
+	bool Table::isRemoved(size_t slot) const
+	{
+		return !_schema.empty() && _rows[slot].values.empty();
+	}
+
+	void Table::publishRows()
+	{
+		_shared->rows.store(_rows.data());
+		_shared->versions.store(_versions.data());
+		_shared->slotCount.store(_rows.size());
 	}
 
 	size_t Table::getColumnCount() const
@@ -33,7 +102,7 @@ namespace Xale::DataStructure
 
 	bool Table::isEmpty() const
 	{
-		return _rows.empty();
+		return getRowCount() == 0;
 	}
 
 	bool Table::isMutable() const
@@ -44,283 +113,1275 @@ namespace Xale::DataStructure
 	void Table::addColumn(const ColumnDefinition& column)
 	{
 		_schema.push_back(column);
+		_schemaDirty = true;
+		_columnar.reset();
+
+		// Only the first primary key column is indexed
+		if (column.isPrimaryKey && _primaryKeyColumn == -1)
+		{
+			_primaryKeyColumn = static_cast<int>(_schema.size() - 1);
+			_primaryIndex = std::make_unique<PrimaryIndex>(PRIMARY_INDEX_DEGREE);
+			rebuildPrimaryIndex();
+		}
 	}
 
-	bool Table::insertRow(const Row& row)
+	int Table::getColumnIndex(const std::string& columnName) const
+	{
+		for (size_t i = 0; i < _schema.size(); ++i)
+		{
+			if (_schema[i].name == columnName)
+				return static_cast<int>(i);
+		}
+
+		return -1;
+	}
+
+	int Table::getPrimaryKeyColumn() const
+	{
+		return _primaryKeyColumn;
+	}
+
+	bool Table::findSlotByPrimaryKey(const FieldValue& key, size_t& slot, const Snapshot& snapshot) const
 	{
-		if (row.fields.size() != _schema.size())
+		if (!_primaryIndex)
+			return false;
+
+		std::shared_lock<std::shared_mutex> lock(_shared->indexMutex);
+		size_t* found = _primaryIndex->search(key);
+		if (!found)
+			return false;
+
+		size_t visible = findVersion(*found, snapshot);
+		if (visible == NO_VERSION)
 			return false;
-		
-		_rows.push_back(row);
 
+		slot = visible;
 		return true;
 	}
 
-	size_t Table::updateRows(
-		const std::string& columnName,
-		const FieldValue& value,
-		const std::unordered_map<std::string, FieldValue>& updates)
+	size_t Table::findVersion(size_t slot, const Snapshot& snapshot) const
 	{
-		size_t updatedCount = 0;
-		int columnIndex = -1;
+		const RowVersion* versions = _shared->versions.load();
 
-		for (size_t i = 0; i < _schema.size(); ++i)
+		for (; slot != NO_VERSION; slot = versions[slot].previous)
 		{
-			if (_schema[i].name == columnName)
+			if (snapshot.sees(versions[slot].begin.load(), versions[slot].end.load()))
+				return slot;
+		}
+
+		return NO_VERSION;
+	}
+
+	void Table::relinkVersion(const FieldValue& key, size_t slot, size_t replacement)
+	{
+		size_t* head = _primaryIndex->search(key);
+		if (!head)
+			return;
+
+		const size_t next = replacement != NO_VERSION ? replacement : _versions[slot].previous;
+		if (*head == slot)
+		{
+			if (next != NO_VERSION)
+				*head = next;
+			else
+				_primaryIndex->remove(key);
+			return;
+		}
+
+		for (size_t current = *head; current != NO_VERSION; current = _versions[current].previous)
+		{
+			if (_versions[current].previous == slot)
 			{
-				columnIndex = static_cast<int>(i);
-				break;
+				_versions[current].previous = next;
+				return;
 			}
 		}
+	}
 
+	bool Table::createIndex(const IndexDefinition& index)
+	{
+		int columnIndex = getColumnIndex(index.column);
 		if (columnIndex == -1)
-			return 0;
+			return false;
 
-		for (auto& row : _rows)
+		for (const auto& existing : _secondaryIndexes)
 		{
-			if (row.fields[columnIndex].value == value)
-			{
-				for (const auto& [updateColumn, newValue] : updates)
-				{
-					for (size_t j = 0; j < _schema.size(); ++j)
-					{
-						if (_schema[j].name == updateColumn)
-						{
-							row.fields[j].value = newValue;
-							break;
-						}
-					}
-				}
-				++updatedCount;
-			}
+			if (existing.definition.name == index.name)
+				return false;
 		}
 
-		return updatedCount;
+		SecondaryIndex secondary{ index, static_cast<size_t>(columnIndex), nullptr };
+		buildSecondaryIndex(secondary);
+
+		_secondaryIndexes.push_back(std::move(secondary));
+		_schemaDirty = true;
+		measureIndexMemory();
+
+		return true;
 	}
 
-	size_t Table::deleteRows(const std::string& columnName, const FieldValue& value)
+	bool Table::dropIndex(const std::string& indexName)
 	{
-		size_t deletedCount = 0;
-		int columnIndex = -1;
+		auto it = std::find_if(_secondaryIndexes.begin(), _secondaryIndexes.end(), [&](const SecondaryIndex& index) {
+			return index.definition.name == indexName;
+		});
 
-		for (size_t i = 0; i < _schema.size(); ++i)
+		if (it == _secondaryIndexes.end())
+			return false;
+
+		_secondaryIndexes.erase(it);
+		_schemaDirty = true;
+		measureIndexMemory();
+
+		return true;
+	}
+
+	std::vector<IndexDefinition> Table::getIndexes() const
+	{
+		std::vector<IndexDefinition> indexes;
+
+		for (const auto& index : _secondaryIndexes)
+			indexes.push_back(index.definition);
+
+		return indexes;
+	}
+
+	bool Table::isIndexed(const std::string& columnName) const
+	{
+		int columnIndex = getColumnIndex(columnName);
+		if (columnIndex == -1)
+			return false;
+
+		return columnIndex == _primaryKeyColumn || findSecondaryIndex(static_cast<size_t>(columnIndex)) != nullptr;
+	}
+
+	size_t Table::getIndexMemoryUsage() const
+	{
+		return _shared->indexMemory.load();
+	}
+
+	void Table::measureIndexMemory()
+	{
+		size_t bytes = _primaryIndex ? _primaryIndex->memoryUsage() : 0;
+
+		for (const auto& index : _secondaryIndexes)
+			bytes += index.tree->memoryUsage();
+
+		_shared->indexMemory.store(bytes);
+	}
+
+	std::shared_ptr<const ColumnarTable> Table::getColumnar() const
+	{
+		std::lock_guard<std::mutex> lock(_shared->columnarMutex);
+		if (!_columnar)
 		{
-			if (_schema[i].name == columnName)
+			const size_t count = getRowCount();
+			const Row removed(std::vector<FieldValue>(_schema.size()));
+
+			auto columnar = std::make_shared<ColumnarTable>(_name, _schema);
+			columnar->reserve(count);
+			for (size_t slot = 0; slot < count; ++slot)
 			{
-				columnIndex = static_cast<int>(i);
-				break;
+				const Row& row = getRow(slot);
+				columnar->appendRow(row.values.empty() ? removed : row);
 			}
+
+			_columnar = std::move(columnar);
 		}
 
-		if (columnIndex == -1)
-			return 0;
-		auto it = _rows.begin();
+		return _columnar;
+	}
+
+	void Table::releaseColumnar()
+	{
+		std::lock_guard<std::mutex> lock(_shared->columnarMutex);
+		_columnar.reset();
+	}
 
-		while (it != _rows.end())
+	const Table::SecondaryIndex* Table::findSecondaryIndex(size_t column) const
+	{
+		for (const auto& index : _secondaryIndexes)
 		{
-			if ((*it).fields[columnIndex].value == value)
-			{
-				it = _rows.erase(it);
-				++deletedCount;
-			}
+			if (index.column == column)
+				return &index;
+		}
+
+		return nullptr;
+	}
+
+	void Table::buildSecondaryIndex(SecondaryIndex& index)
+	{
+		FieldValueLess less;
+		std::vector<size_t> order;
+		order.reserve(_rows.size());
+		for (size_t slot = 0; slot < _rows.size(); ++slot)
+		{
+			if (!isRemoved(slot))
+				order.push_back(slot);
+		}
+
+		// Stable, so the slots of a value stay in ascending order
+		std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+			return less(_rows[a].values[index.column], _rows[b].values[index.column]);
+		});
+
+		std::vector<std::pair<FieldValue, std::vector<size_t>>> entries;
+		for (size_t slot : order)
+		{
+			const FieldValue& key = _rows[slot].values[index.column];
+			if (entries.empty() || less(entries.back().first, key))
+				entries.push_back({ key, { slot } });
 			else
-				++it;
+				entries.back().second.push_back(slot);
 		}
 
-		return deletedCount;
+		index.tree = std::make_unique<SecondaryIndexTree>(SECONDARY_INDEX_DEGREE);
+		index.tree->bulkLoad(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()), INDEX_BULK_FILL_FACTOR);
 	}
 
-	std::vector<Row> Table::findRows(const std::string& columnName, const FieldValue& value) const
+	void Table::indexSlot(SecondaryIndex& index, size_t slot)
 	{
-		std::vector<Row> result;
-		int columnIndex = -1;
+		const FieldValue& key = _rows[slot].values[index.column];
 
-		for (size_t i = 0; i < _schema.size(); ++i)
+		if (std::vector<size_t>* slots = index.tree->search(key))
 		{
-			if (_schema[i].name == columnName)
+			slots->push_back(slot);
+			return;
+		}
+
+		std::vector<size_t> slots{ slot };
+		index.tree->insert(key, &slots);
+	}
+
+	void Table::unindexSlot(SecondaryIndex& index, size_t slot)
+	{
+		const FieldValue& key = _rows[slot].values[index.column];
+		std::vector<size_t>* slots = index.tree->search(key);
+
+		if (!slots)
+			return;
+
+		slots->erase(std::remove(slots->begin(), slots->end(), slot), slots->end());
+		if (slots->empty())
+			index.tree->remove(key);
+	}
+
+	bool Table::insertRow(const Row& row)
+	{
+		if (row.values.size() != _schema.size())
+			return false;
+
+		if (_primaryIndex)
+		{
+			const FieldValue& key = row.values[_primaryKeyColumn];
+			if (std::holds_alternative<std::monostate>(key) || _primaryIndex->search(key))
+				return false;
+		}
+
+		appendVersion(row, 0, NO_VERSION);
+		return true;
+	}
+
+	bool Table::insertVersion(const Row& row, uint64_t transaction)
+	{
+		if (row.values.size() != _schema.size())
+			return false;
+
+		// The key may only be reused by the versions the transaction does not see
+		size_t previous = NO_VERSION;
+		if (_primaryIndex)
+		{
+			const FieldValue& key = row.values[_primaryKeyColumn];
+			if (std::holds_alternative<std::monostate>(key))
+				return false;
+
+			if (const size_t* head = _primaryIndex->search(key))
 			{
-				columnIndex = static_cast<int>(i);
-				break;
+				if (findVersion(*head, Snapshot{ LATEST_VERSION, transaction }) != NO_VERSION)
+					return false;
+				previous = *head;
 			}
 		}
 
-		if (columnIndex == -1)
-			return result;
+		appendVersion(row, transaction, previous);
+		return true;
+	}
+
+	void Table::reserveSlot()
+	{
+		if (_rows.size() < _rows.capacity() && _versions.size() < _versions.capacity())
+			return;
+
+		// Statements may still read the current storage, it is retired instead of reallocated
+		const size_t capacity = std::max<size_t>(16, 2 * _rows.size());
+
+		std::vector<Row> rows;
+		rows.reserve(capacity);
+		rows.assign(_rows.begin(), _rows.end());
 
-		for (const auto& row : _rows)
+		std::vector<RowVersion> versions;
+		versions.reserve(capacity);
+		versions.assign(_versions.begin(), _versions.end());
+
+		_retiredRows.push_back(std::move(_rows));
+		_retiredVersions.push_back(std::move(_versions));
+		_rows = std::move(rows);
+		_versions = std::move(versions);
+		publishRows();
+	}
+
+	void Table::appendVersion(const Row& row, uint64_t begin, size_t previous)
+	{
+		reserveSlot();
+
+		size_t slot = _rows.size();
+		_rows.push_back(row);
+		_versions.emplace_back(begin, INFINITE_VERSION, previous);
+		if (begin & PENDING_VERSION)
 		{
-			if (row.fields[columnIndex].value == value)
-				result.push_back(row);
+			_pendingBegins.push_back(slot);
+			++_shared->pendingCount;
 		}
 
-		return result;
+		// Published before being indexed, so that lookups never find a slot past the count
+		publishRows();
+
+		{
+			std::unique_lock<std::shared_mutex> lock(_shared->indexMutex);
+
+			if (_primaryIndex)
+			{
+				const FieldValue& key = row.values[_primaryKeyColumn];
+				if (size_t* head = _primaryIndex->search(key))
+					*head = slot;
+				else
+					_primaryIndex->insert(key, &slot);
+			}
+
+			for (auto& index : _secondaryIndexes)
+				indexSlot(index, slot);
+		}
+		measureIndexMemory();
+
+		{
+			// A published copy may be scanned at any time, never changed: the next scan builds a new one
+			std::lock_guard<std::mutex> lock(_shared->columnarMutex);
+			if (_columnar && _columnar->getRowCount() != slot + 1)
+				_columnar.reset();
+		}
+
+		_dirtySlots.insert(slot);
 	}
 
-	std::vector<char> Table::serialize() const
+	bool Table::loadRows(std::vector<Row> rows)
 	{
-		std::vector<char> buffer;
-		
-		// Helper to write data to buffer
-		auto writeString = [&](const std::string& str) {
-			uint32_t len = str.length();
-			buffer.insert(buffer.end(), reinterpret_cast<const char*>(&len), reinterpret_cast<const char*>(&len) + sizeof(len));
-			buffer.insert(buffer.end(), str.begin(), str.end());
-		};
-		
-		auto writeInt = [&](int32_t val) {
-			buffer.insert(buffer.end(), reinterpret_cast<const char*>(&val), reinterpret_cast<const char*>(&val) + sizeof(val));
-		};
-		
-		auto writeDouble = [&](double val) {
-			buffer.insert(buffer.end(), reinterpret_cast<const char*>(&val), reinterpret_cast<const char*>(&val) + sizeof(val));
-		};
-		
-		// Write table name
-		writeString(_name);
-		
-		// Write schema
-		uint32_t schemaSize = _schema.size();
-		buffer.insert(buffer.end(), reinterpret_cast<const char*>(&schemaSize), reinterpret_cast<const char*>(&schemaSize) + sizeof(schemaSize));
-		
-		for (const auto& col : _schema)
-		{
-			writeString(col.name);
-			int32_t type = static_cast<int32_t>(col.type);
-			writeInt(type);
-			char isPK = col.isPrimaryKey ? 1 : 0;
-			buffer.push_back(isPK);
-			char isNull = col.isNullable ? 1 : 0;
-			buffer.push_back(isNull);
-			writeString(col.refTable);
-			writeString(col.refColumn);
-		}
-		
-		// Write rows
-		uint32_t rowCount = _rows.size();
-		buffer.insert(buffer.end(), reinterpret_cast<const char*>(&rowCount), reinterpret_cast<const char*>(&rowCount) + sizeof(rowCount));
-		
-		for (const auto& row : _rows)
+		if (!_rows.empty())
+			return false;
+
+		std::vector<RowVersion> versions;
+		versions.reserve(rows.size());
+		for (size_t slot = 0; slot < rows.size(); ++slot)
 		{
-			for (const auto& field : row.fields)
+			const Row& row = rows[slot];
+
+			// Empty rows are removed rows, dead until reclaimed
+			if (row.values.empty() && !_schema.empty())
 			{
-				std::visit([&](auto&& arg) {
-					using T = std::decay_t<decltype(arg)>;
-					if constexpr (std::is_same_v<T, int>)
-					{
-						writeInt(static_cast<int32_t>(FieldType::Integer));
-						writeInt(arg);
-					}
-					else if constexpr (std::is_same_v<T, double>)
-					{
-						writeInt(static_cast<int32_t>(FieldType::Float));
-						writeDouble(arg);
-					}
-					else if constexpr (std::is_same_v<T, std::string>)
-					{
-						writeInt(static_cast<int32_t>(FieldType::String));
-						writeString(arg);
-					}
-					else if constexpr (std::is_same_v<T, std::monostate>)
-					{
-						writeInt(static_cast<int32_t>(FieldType::Null));
-						// NULL value, no data to write
-					}
-				}, field.value);
+				versions.emplace_back(0, 0, NO_VERSION);
+				_deadSlots.push_back(slot);
+				continue;
 			}
+
+			if (row.values.size() != _schema.size())
+				return false;
+			if (_primaryKeyColumn != -1 && std::holds_alternative<std::monostate>(row.values[_primaryKeyColumn]))
+				return false;
+			versions.emplace_back(0, INFINITE_VERSION, NO_VERSION);
 		}
-		
-		return buffer;
+
+		_rows = std::move(rows);
+		_versions = std::move(versions);
+		_shared->endedCount = _deadSlots.size();
+		_columnar.reset();
+		publishRows();
+
+		if (_primaryIndex && !rebuildPrimaryIndex())
+		{
+			_rows.clear();
+			_versions.clear();
+			_deadSlots.clear();
+			_shared->endedCount = 0;
+			publishRows();
+			return false;
+		}
+
+		for (auto& index : _secondaryIndexes)
+			buildSecondaryIndex(index);
+		measureIndexMemory();
+
+		for (size_t slot = 0; slot < _rows.size(); ++slot)
+			_dirtySlots.insert(slot);
+
+		return true;
 	}
 
-	Table Table::deserialize(const std::vector<char>& data)
+	size_t Table::updateRows(
+		const std::string& columnName,
+		const FieldValue& value,
+		const std::unordered_map<std::string, FieldValue>& updates)
 	{
-		size_t offset = 0;
-		
-		// Helper to read data from buffer
-		auto readString = [&]() -> std::string {
-			uint32_t len;
-			std::memcpy(&len, &data[offset], sizeof(len));
-			offset += sizeof(len);
-			std::string str(data.begin() + offset, data.begin() + offset + len);
-			offset += len;
-			return str;
-		};
-		
-		auto readInt = [&]() -> int32_t {
-			int32_t val;
-			std::memcpy(&val, &data[offset], sizeof(val));
-			offset += sizeof(val);
-			return val;
-		};
-		
-		auto readDouble = [&]() -> double {
-			double val;
-			std::memcpy(&val, &data[offset], sizeof(val));
-			offset += sizeof(val);
-			return val;
-		};
-		
-		// Read table name
-		std::string tableName = readString();
-		Table table(tableName);
-		
-		// Read schema
-		uint32_t schemaSize;
-		std::memcpy(&schemaSize, &data[offset], sizeof(schemaSize));
-		offset += sizeof(schemaSize);
-		
-		for (uint32_t i = 0; i < schemaSize; ++i)
-		{
-			std::string colName = readString();
-			int32_t typeInt = readInt();
-			FieldType type = static_cast<FieldType>(typeInt);
-			bool isPK = data[offset++] == 1;
-			bool isNull = data[offset++] == 1;
-			std::string refTable = readString();
-			std::string refColumn = readString();
-			
-			table.addColumn(ColumnDefinition(colName, type, isPK, isNull, refTable, refColumn));
-		}
-		
-		// Read rows
-		uint32_t rowCount;
-		std::memcpy(&rowCount, &data[offset], sizeof(rowCount));
-		offset += sizeof(rowCount);
-		
-		const auto& schema = table.getSchema();
-		
-		for (uint32_t i = 0; i < rowCount; ++i)
+		return updateRowsAt(findSlots(columnName, value), updates);
+	}
+
+	size_t Table::updateRowsAt(
+		const std::vector<size_t>& slots,
+		const std::unordered_map<std::string, FieldValue>& updates)
+	{
+		std::vector<std::pair<size_t, FieldValue>> columnUpdates;
+		for (const auto& [updateColumn, newValue] : updates)
 		{
-			Row row;
-			for (size_t colIdx = 0; colIdx < schema.size(); ++colIdx)
+			int columnIndex = getColumnIndex(updateColumn);
+			if (columnIndex != -1)
+				columnUpdates.push_back({ static_cast<size_t>(columnIndex), newValue });
+		}
+
+		// Primary key changes are checked before touching any row
+		const FieldValue* newKey = nullptr;
+		for (const auto& [columnIndex, newValue] : columnUpdates)
+		{
+			if (static_cast<int>(columnIndex) == _primaryKeyColumn)
+				newKey = &newValue;
+		}
+
+		if (newKey && !slots.empty())
+		{
+			size_t existing = 0;
+			if (std::holds_alternative<std::monostate>(*newKey))
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Primary key cannot be NULL");
+			if (slots.size() > 1 || (findSlotByPrimaryKey(*newKey, existing) && existing != slots.front()))
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Duplicate primary key");
+		}
+
+		std::vector<SecondaryIndex*> updatedIndexes;
+		for (auto& index : _secondaryIndexes)
+		{
+			for (const auto& [columnIndex, newValue] : columnUpdates)
 			{
-				const auto& col = schema[colIdx];
-				int32_t ftypeInt = readInt();
-				FieldType ftype = static_cast<FieldType>(ftypeInt);
-				
-				FieldValue value;
-				if (ftype == FieldType::Integer)
-				{
-					value = readInt();
-				}
-				else if (ftype == FieldType::Float)
-				{
-					value = readDouble();
-				}
-				else if (ftype == FieldType::String)
-				{
-					value = readString();
-				}
-				else // Null
+				if (columnIndex == index.column)
 				{
-					value = std::monostate{};
+					updatedIndexes.push_back(&index);
+					break;
 				}
-				
-				row.fields.push_back(Field(col.name, ftype, value));
 			}
-			table.insertRow(row);
 		}
-		
-		return table;
+
+		if (!slots.empty())
+			_columnar.reset();
+
+		for (size_t slot : slots)
+		{
+			auto& row = _rows[slot];
+
+			if (newKey)
+			{
+				_primaryIndex->remove(row.values[_primaryKeyColumn]);
+				_primaryIndex->insert(*newKey, &slot);
+			}
+
+			for (auto* index : updatedIndexes)
+				unindexSlot(*index, slot);
+
+			for (const auto& [columnIndex, newValue] : columnUpdates)
+				row.values[columnIndex] = newValue;
+
+			for (auto* index : updatedIndexes)
+				indexSlot(*index, slot);
+
+			_dirtySlots.insert(slot);
+		}
+		measureIndexMemory();
+
+		return slots.size();
+	}
+
+	size_t Table::deleteRows(const std::string& columnName, const FieldValue& value)
+	{
+		return deleteRowsAt(findSlots(columnName, value));
+	}
+
+	size_t Table::deleteRowsAt(std::vector<size_t> slots)
+	{
+		// From the end, so that rows moved into freed slots are never pending deletion
+		std::sort(slots.begin(), slots.end());
+		slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+
+		for (auto it = slots.rbegin(); it != slots.rend(); ++it)
+			removeRowAt(*it);
+		measureIndexMemory();
+
+		publishRows();
+		return slots.size();
+	}
+
+	size_t Table::updateVersionsAt(
+		const std::vector<size_t>& slots,
+		const std::unordered_map<std::string, FieldValue>& updates,
+		uint64_t transaction)
+	{
+		std::vector<std::pair<size_t, FieldValue>> columnUpdates;
+		for (const auto& [updateColumn, newValue] : updates)
+		{
+			int columnIndex = getColumnIndex(updateColumn);
+			if (columnIndex != -1)
+				columnUpdates.push_back({ static_cast<size_t>(columnIndex), newValue });
+		}
+
+		// Primary key changes are checked before touching any row
+		const FieldValue* newKey = nullptr;
+		for (const auto& [columnIndex, newValue] : columnUpdates)
+		{
+			if (static_cast<int>(columnIndex) == _primaryKeyColumn)
+				newKey = &newValue;
+		}
+
+		if (newKey && !slots.empty())
+		{
+			size_t existing = 0;
+			if (std::holds_alternative<std::monostate>(*newKey))
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Primary key cannot be NULL");
+			if (slots.size() > 1 || (findSlotByPrimaryKey(*newKey, existing, Snapshot{ LATEST_VERSION, transaction }) && existing != slots.front()))
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Duplicate primary key");
+		}
+
+		// Ascending, so that reclaiming the old versions moves the new ones back into their slots
+		std::vector<size_t> ordered(slots);
+		std::sort(ordered.begin(), ordered.end());
+		ordered.erase(std::unique(ordered.begin(), ordered.end()), ordered.end());
+
+		for (size_t slot : ordered)
+		{
+			Row row = _rows[slot];
+			for (const auto& [columnIndex, newValue] : columnUpdates)
+				row.values[columnIndex] = newValue;
+
+			size_t previous = NO_VERSION;
+			if (_primaryIndex)
+			{
+				if (const size_t* head = _primaryIndex->search(row.values[_primaryKeyColumn]))
+					previous = *head;
+			}
+
+			++_shared->endedCount;
+			_versions[slot].end.store(transaction);
+			_pendingEnds.push_back(slot);
+			_dirtySlots.insert(slot);
+
+			appendVersion(row, transaction, previous);
+		}
+
+		return ordered.size();
+	}
+
+	size_t Table::deleteVersionsAt(std::vector<size_t> slots, uint64_t transaction)
+	{
+		std::sort(slots.begin(), slots.end());
+		slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+
+		for (size_t slot : slots)
+		{
+			++_shared->endedCount;
+			_versions[slot].end.store(transaction);
+			_pendingEnds.push_back(slot);
+			_dirtySlots.insert(slot);
+		}
+
+		return slots.size();
+	}
+
+	void Table::commitVersions(uint64_t transaction, uint64_t timestamp)
+	{
+		// The table has a single writer, every pending version belongs to the transaction
+		(void)transaction;
+		if (_pendingBegins.empty() && _pendingEnds.empty())
+			return;
+
+		_shared->lastCommit.store(timestamp);
+
+		for (size_t slot : _pendingBegins)
+			_versions[slot].begin.store(timestamp);
+
+		for (size_t slot : _pendingEnds)
+		{
+			_versions[slot].end.store(timestamp);
+			_deadSlots.push_back(slot);
+		}
+
+		_shared->pendingCount -= _pendingBegins.size();
+		_pendingBegins.clear();
+		_pendingEnds.clear();
+	}
+
+	void Table::rollbackVersions(uint64_t transaction)
+	{
+		(void)transaction;
+
+		for (size_t slot : _pendingEnds)
+		{
+			_versions[slot].end.store(INFINITE_VERSION);
+			--_shared->endedCount;
+		}
+
+		// Ended before being begun, so that no statement ever sees them
+		for (size_t slot : _pendingBegins)
+		{
+			++_shared->endedCount;
+			_versions[slot].end.store(0);
+			_versions[slot].begin.store(0);
+			_deadSlots.push_back(slot);
+		}
+
+		_shared->pendingCount -= _pendingBegins.size();
+		_pendingBegins.clear();
+		_pendingEnds.clear();
+	}
+
+	size_t Table::reclaimVersions()
+	{
+		std::vector<size_t> dead = std::move(_deadSlots);
+		_deadSlots.clear();
+
+		// From the end, so that versions moved into freed slots are never pending removal
+		std::sort(dead.begin(), dead.end());
+		dead.erase(std::unique(dead.begin(), dead.end()), dead.end());
+
+		for (auto it = dead.rbegin(); it != dead.rend(); ++it)
+			removeRowAt(*it);
+		measureIndexMemory();
+
+		_retiredRows.clear();
+		_retiredVersions.clear();
+		publishRows();
+
+		return dead.size();
+	}
+
+	size_t Table::getDeadVersionCount() const
+	{
+		return _deadSlots.size();
+	}
+
+	void Table::removeRowAt(size_t slot)
+	{
+		const size_t last = _rows.size() - 1;
+
+		if (!isRemoved(slot))
+		{
+			if (_primaryIndex)
+				relinkVersion(_rows[slot].values[_primaryKeyColumn], slot, NO_VERSION);
+
+			for (auto& index : _secondaryIndexes)
+				unindexSlot(index, slot);
+		}
+
+		if (_versions[slot].end.load() != INFINITE_VERSION)
+			--_shared->endedCount;
+
+		if (!_deadSlots.empty())
+		{
+			_deadSlots.erase(std::remove(_deadSlots.begin(), _deadSlots.end(), slot), _deadSlots.end());
+			std::replace(_deadSlots.begin(), _deadSlots.end(), last, slot);
+		}
+
+		if (slot != last)
+		{
+			_rows[slot] = std::move(_rows[last]);
+			_versions[slot] = _versions[last];
+
+			if (!isRemoved(slot))
+			{
+				if (_primaryIndex)
+					relinkVersion(_rows[slot].values[_primaryKeyColumn], last, slot);
+
+				for (auto& index : _secondaryIndexes)
+				{
+					std::vector<size_t>* slots = index.tree->search(_rows[slot].values[index.column]);
+					std::replace(slots->begin(), slots->end(), last, slot);
+				}
+			}
+		}
+
+		_rows.pop_back();
+		_versions.pop_back();
+		_dirtySlots.insert(slot);
+		_dirtySlots.insert(last);
+		_columnar.reset();
+	}
+
+	std::vector<size_t> Table::findSlots(const std::string& columnName, const FieldValue& value, const Snapshot& snapshot) const
+	{
+		std::vector<size_t> result;
+		int columnIndex = getColumnIndex(columnName);
+
+		if (columnIndex == -1)
+			return result;
+
+		if (columnIndex == _primaryKeyColumn)
+		{
+			size_t slot = 0;
+			if (findSlotByPrimaryKey(value, slot, snapshot) && getRow(slot).values[columnIndex] == value)
+				result.push_back(slot);
+			return result;
+		}
+
+		if (const SecondaryIndex* index = findSecondaryIndex(static_cast<size_t>(columnIndex)))
+		{
+			std::vector<size_t> slots;
+			{
+				std::shared_lock<std::shared_mutex> lock(_shared->indexMutex);
+				if (const std::vector<size_t>* found = index->tree->search(value))
+					slots = *found;
+			}
+
+			// The index compares numbers by value, keep only the exact matches
+			for (size_t slot : slots)
+			{
+				if (isVisible(slot, snapshot) && getRow(slot).values[columnIndex] == value)
+					result.push_back(slot);
+			}
+			std::sort(result.begin(), result.end());
+			return result;
+		}
+
+		const size_t count = getRowCount();
+		for (size_t slot = 0; slot < count; ++slot)
+		{
+			if (isVisible(slot, snapshot) && getRow(slot).values[columnIndex] == value)
+				result.push_back(slot);
+		}
+
+		return result;
+	}
+
+	std::vector<Row> Table::findRows(const std::string& columnName, const FieldValue& value, const Snapshot& snapshot) const
+	{
+		std::vector<Row> result;
+
+		for (size_t slot : findSlots(columnName, value, snapshot))
+			result.push_back(getRow(slot));
+
+		return result;
+	}
+
+	std::vector<size_t> Table::findSlotsInRange(
+		const std::string& columnName,
+		const FieldValue* lower,
+		bool lowerInclusive,
+		const FieldValue* upper,
+		bool upperInclusive,
+		const Snapshot& snapshot) const
+	{
+		std::vector<size_t> result;
+		int columnIndex = getColumnIndex(columnName);
+
+		if (columnIndex == -1)
+			return result;
+
+		if (columnIndex == _primaryKeyColumn)
+		{
+			std::shared_lock<std::shared_mutex> lock(_shared->indexMutex);
+			forEachInRange(*_primaryIndex, lower, lowerInclusive, upper, upperInclusive, [&](size_t slot) {
+				size_t visible = findVersion(slot, snapshot);
+				if (visible != NO_VERSION)
+					result.push_back(visible);
+			});
+		}
+		else if (const SecondaryIndex* index = findSecondaryIndex(static_cast<size_t>(columnIndex)))
+		{
+			{
+				std::shared_lock<std::shared_mutex> lock(_shared->indexMutex);
+				forEachInRange(*index->tree, lower, lowerInclusive, upper, upperInclusive, [&](const std::vector<size_t>& slots) {
+					result.insert(result.end(), slots.begin(), slots.end());
+				});
+			}
+			result.erase(std::remove_if(result.begin(), result.end(), [&](size_t slot) {
+				return !isVisible(slot, snapshot);
+			}), result.end());
+		}
+		else
+		{
+			FieldValueLess less;
+			const size_t count = getRowCount();
+			for (size_t slot = 0; slot < count; ++slot)
+			{
+				if (!isVisible(slot, snapshot))
+					continue;
+
+				const FieldValue& value = getRow(slot).values[columnIndex];
+				if (lower && (lowerInclusive ? less(value, *lower) : !less(*lower, value)))
+					continue;
+				if (upper && (upperInclusive ? less(*upper, value) : !less(value, *upper)))
+					continue;
+				result.push_back(slot);
+			}
+		}
+
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	std::vector<size_t> Table::findSlotsInKeyOrder(const std::string& columnName, const Snapshot& snapshot) const
+	{
+		std::vector<size_t> result;
+		int columnIndex = getColumnIndex(columnName);
+
+		if (columnIndex == -1)
+			return result;
+
+		const size_t count = getRowCount();
+		result.reserve(count);
+
+		if (columnIndex == _primaryKeyColumn)
+		{
+			std::shared_lock<std::shared_mutex> lock(_shared->indexMutex);
+			forEachInRange(*_primaryIndex, nullptr, true, nullptr, true, [&](size_t slot) {
+				size_t visible = findVersion(slot, snapshot);
+				if (visible != NO_VERSION)
+					result.push_back(visible);
+			});
+		}
+		else if (const SecondaryIndex* index = findSecondaryIndex(static_cast<size_t>(columnIndex)))
+		{
+			std::shared_lock<std::shared_mutex> lock(_shared->indexMutex);
+			forEachInRange(*index->tree, nullptr, true, nullptr, true, [&](const std::vector<size_t>& slots) {
+				size_t first = result.size();
+				for (size_t slot : slots)
+				{
+					if (isVisible(slot, snapshot))
+						result.push_back(slot);
+				}
+				std::sort(result.begin() + first, result.end());
+			});
+		}
+		else
+		{
+			FieldValueLess less;
+			for (size_t slot = 0; slot < count; ++slot)
+			{
+				if (isVisible(slot, snapshot))
+					result.push_back(slot);
+			}
+			std::stable_sort(result.begin(), result.end(), [&](size_t a, size_t b) {
+				return less(getRow(a).values[columnIndex], getRow(b).values[columnIndex]);
+			});
+		}
+
+		return result;
+	}
+
+	bool Table::rebuildPrimaryIndex()
+	{
+		FieldValueLess less;
+		std::vector<std::pair<FieldValue, size_t>> entries;
+		entries.reserve(_rows.size());
+
+		for (size_t slot = 0; slot < _rows.size(); ++slot)
+		{
+			if (!isRemoved(slot))
+				entries.push_back({ _rows[slot].values[_primaryKeyColumn], slot });
+		}
+
+		std::sort(entries.begin(), entries.end(), [&](const auto& a, const auto& b) {
+			return less(a.first, b.first);
+		});
+
+		// Fails on duplicated keys
+		auto index = std::make_unique<PrimaryIndex>(PRIMARY_INDEX_DEGREE);
+		if (!index->bulkLoad(std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()), INDEX_BULK_FILL_FACTOR))
+			return false;
+
+		_primaryIndex = std::move(index);
+		measureIndexMemory();
+		return true;
+	}
+
+	bool Table::setRow(size_t slot, const Row& row)
+	{
+		const bool isRemoval = row.values.empty() && !_schema.empty();
+		if (slot > _rows.size() || (!isRemoval && row.values.size() != _schema.size()))
+			return false;
+
+		const bool isReplaced = slot < _rows.size() && !isRemoved(slot);
+		if (_primaryIndex)
+		{
+			if (isReplaced)
+				_primaryIndex->remove(_rows[slot].values[_primaryKeyColumn]);
+			if (!isRemoval && !_primaryIndex->insert(row.values[_primaryKeyColumn], &slot))
+				return false;
+		}
+
+		if (isReplaced)
+		{
+			for (auto& index : _secondaryIndexes)
+				unindexSlot(index, slot);
+		}
+
+		// Removed rows are dead versions, reclaimed by reclaimVersions()
+		RowVersion version(0, isRemoval ? 0 : INFINITE_VERSION, NO_VERSION);
+		if (slot == _rows.size())
+		{
+			_rows.push_back(row);
+			_versions.push_back(version);
+		}
+		else
+		{
+			if (_versions[slot].end.load() != INFINITE_VERSION)
+			{
+				--_shared->endedCount;
+				_deadSlots.erase(std::remove(_deadSlots.begin(), _deadSlots.end(), slot), _deadSlots.end());
+			}
+			_rows[slot] = row;
+			_versions[slot] = version;
+		}
+
+		// Published copies are never changed, a scan may be reading them
+		releaseColumnar();
+
+		if (isRemoval)
+		{
+			++_shared->endedCount;
+			_deadSlots.push_back(slot);
+		}
+		else
+		{
+			for (auto& index : _secondaryIndexes)
+				indexSlot(index, slot);
+		}
+
+		_dirtySlots.insert(slot);
+		measureIndexMemory();
+		publishRows();
+
+		return true;
+	}
+
+	void Table::truncateRows(size_t count)
+	{
+		while (_rows.size() > count)
+		{
+			const size_t last = _rows.size() - 1;
+			if (!isRemoved(last))
+			{
+				if (_primaryIndex)
+					_primaryIndex->remove(_rows.back().values[_primaryKeyColumn]);
+				for (auto& index : _secondaryIndexes)
+					unindexSlot(index, last);
+			}
+
+			if (_versions.back().end.load() != INFINITE_VERSION)
+			{
+				--_shared->endedCount;
+				_deadSlots.erase(std::remove(_deadSlots.begin(), _deadSlots.end(), last), _deadSlots.end());
+			}
+
+			_rows.pop_back();
+			_versions.pop_back();
+			_dirtySlots.insert(last);
+			_columnar.reset();
+		}
+
+		measureIndexMemory();
+		publishRows();
+	}
+
+	const std::unordered_set<size_t>& Table::getDirtySlots() const
+	{
+		return _dirtySlots;
+	}
+
+	bool Table::isSchemaDirty() const
+	{
+		return _schemaDirty;
+	}
+
+	void Table::markAllDirty()
+	{
+		_schemaDirty = true;
+		for (size_t slot = 0; slot < _rows.size(); ++slot)
+			_dirtySlots.insert(slot);
+	}
+
+	void Table::clearChanges()
+	{
+		_schemaDirty = false;
+		_dirtySlots.clear();
+
+		// Versions of a pending transaction are persisted once it ends
+		_dirtySlots.insert(_pendingBegins.begin(), _pendingBegins.end());
+		_dirtySlots.insert(_pendingEnds.begin(), _pendingEnds.end());
+	}
+
+	namespace
+	{
+		void writeString(std::vector<char>& buffer, const std::string& str)
+		{
+			uint32_t len = str.length();
+			buffer.insert(buffer.end(), reinterpret_cast<const char*>(&len), reinterpret_cast<const char*>(&len) + sizeof(len));
+			buffer.insert(buffer.end(), str.begin(), str.end());
+		}
+
+		void writeInt(std::vector<char>& buffer, int32_t val)
+		{
+			buffer.insert(buffer.end(), reinterpret_cast<const char*>(&val), reinterpret_cast<const char*>(&val) + sizeof(val));
+		}
+
+		void writeDouble(std::vector<char>& buffer, double val)
+		{
+			buffer.insert(buffer.end(), reinterpret_cast<const char*>(&val), reinterpret_cast<const char*>(&val) + sizeof(val));
+		}
+
+		/**
+		 * @brief Bounds-checked reader over a serialized buffer
+		 */
+		struct Reader
+		{
+			const char* data;
+			size_t size;
+			size_t offset = 0;
+
+			void read(void* out, size_t len)
+			{
+				if (offset + len > size)
+					THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Truncated table data");
+				std::memcpy(out, data + offset, len);
+				offset += len;
+			}
+
+			std::string readString()
+			{
+				uint32_t len = readInt();
+				if (offset + len > size)
+					THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Truncated table data");
+				std::string str(data + offset, len);
+				offset += len;
+				return str;
+			}
+
+			int32_t readInt()
+			{
+				int32_t val;
+				read(&val, sizeof(val));
+				return val;
+			}
+
+			double readDouble()
+			{
+				double val;
+				read(&val, sizeof(val));
+				return val;
+			}
+
+			char readByte()
+			{
+				char val;
+				read(&val, sizeof(val));
+				return val;
+			}
+		};
+
+		void writeSchema(std::vector<char>& buffer, const std::string& name, const std::vector<ColumnDefinition>& schema)
+		{
+			writeString(buffer, name);
+
+			uint32_t schemaSize = schema.size();
+			buffer.insert(buffer.end(), reinterpret_cast<const char*>(&schemaSize), reinterpret_cast<const char*>(&schemaSize) + sizeof(schemaSize));
+
+			for (const auto& col : schema)
+			{
+				writeString(buffer, col.name);
+				writeInt(buffer, static_cast<int32_t>(col.type));
+				buffer.push_back(col.isPrimaryKey ? 1 : 0);
+				buffer.push_back(col.isNullable ? 1 : 0);
+				writeString(buffer, col.refTable);
+				writeString(buffer, col.refColumn);
+			}
+		}
+
+		Table readSchema(Reader& reader)
+		{
+			Table table(reader.readString());
+
+			uint32_t schemaSize = static_cast<uint32_t>(reader.readInt());
+			for (uint32_t i = 0; i < schemaSize; ++i)
+			{
+				std::string colName = reader.readString();
+				FieldType type = static_cast<FieldType>(reader.readInt());
+				bool isPK = reader.readByte() == 1;
+				bool isNull = reader.readByte() == 1;
+				std::string refTable = reader.readString();
+				std::string refColumn = reader.readString();
+
+				table.addColumn(ColumnDefinition(colName, type, isPK, isNull, refTable, refColumn));
+			}
+
+			return table;
+		}
+
+		void writeIndexes(std::vector<char>& buffer, const std::vector<IndexDefinition>& indexes)
+		{
+			writeInt(buffer, static_cast<int32_t>(indexes.size()));
+
+			for (const auto& index : indexes)
+			{
+				writeString(buffer, index.name);
+				writeString(buffer, index.column);
+			}
+		}
+
+		void readIndexes(Reader& reader, Table& table)
+		{
+			// Tables saved before secondary indexes have no index section
+			if (reader.offset == reader.size)
+				return;
+
+			uint32_t indexCount = static_cast<uint32_t>(reader.readInt());
+			for (uint32_t i = 0; i < indexCount; ++i)
+			{
+				std::string indexName = reader.readString();
+				std::string columnName = reader.readString();
+
+				if (!table.createIndex(IndexDefinition(indexName, columnName)))
+					THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Invalid index " + indexName);
+			}
+		}
+
+		void writeRow(std::vector<char>& buffer, const Row& row)
+		{
+			for (const auto& value : row.values)
+			{
+				std::visit([&](auto&& arg) {
+					using T = std::decay_t<decltype(arg)>;
+					if constexpr (std::is_same_v<T, int>)
+					{
+						writeInt(buffer, static_cast<int32_t>(FieldType::Integer));
+						writeInt(buffer, arg);
+					}
+					else if constexpr (std::is_same_v<T, double>)
+					{
+						writeInt(buffer, static_cast<int32_t>(FieldType::Float));
+						writeDouble(buffer, arg);
+					}
+					else if constexpr (std::is_same_v<T, std::string>)
+					{
+						writeInt(buffer, static_cast<int32_t>(FieldType::String));
+						writeString(buffer, arg);
+					}
+					else if constexpr (std::is_same_v<T, std::monostate>)
+					{
+						writeInt(buffer, static_cast<int32_t>(FieldType::Null));
+						// NULL value, no data to write
+					}
+				}, value);
+			}
+		}
+
+		Row readRow(Reader& reader, const std::vector<ColumnDefinition>& schema)
+		{
+			Row row;
+			row.values.reserve(schema.size());
+
+			for (size_t i = 0; i < schema.size(); ++i)
+			{
+				FieldType ftype = static_cast<FieldType>(reader.readInt());
+
+				FieldValue value;
+				if (ftype == FieldType::Integer)
+					value = reader.readInt();
+				else if (ftype == FieldType::Float)
+					value = reader.readDouble();
+				else if (ftype == FieldType::String)
+					value = reader.readString();
+				else // Null
+					value = std::monostate{};
+
+				row.values.push_back(std::move(value));
+			}
+
+			return row;
+		}
+	}
+
+	std::vector<char> Table::serialize() const
+	{
+		std::vector<char> buffer;
+
+		writeSchema(buffer, _name, _schema);
+
+		// Write the committed rows
+		std::vector<size_t> slots;
+		for (size_t slot = 0; slot < _rows.size(); ++slot)
+		{
+			if (hasCommittedRow(slot))
+				slots.push_back(slot);
+		}
+
+		uint32_t rowCount = slots.size();
+		buffer.insert(buffer.end(), reinterpret_cast<const char*>(&rowCount), reinterpret_cast<const char*>(&rowCount) + sizeof(rowCount));
+
+		for (size_t slot : slots)
+			writeRow(buffer, _rows[slot]);
+
+		writeIndexes(buffer, getIndexes());
+
+		return buffer;
+	}
+
+	Table Table::deserialize(const std::vector<char>& data)
+	{
+		Reader reader{ data.data(), data.size() };
+
+		Table table = readSchema(reader);
+
+		// Read rows
+		uint32_t rowCount = static_cast<uint32_t>(reader.readInt());
+		std::vector<Row> rows;
+		rows.reserve(rowCount);
+		for (uint32_t i = 0; i < rowCount; ++i)
+			rows.push_back(readRow(reader, table.getSchema()));
+
+		if (!table.loadRows(std::move(rows)))
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Invalid row in table " + table.getName());
+
+		readIndexes(reader, table);
+
+		return table;
+	}
+
+	std::vector<char> Table::serializeSchema() const
+	{
+		std::vector<char> buffer;
+		writeSchema(buffer, _name, _schema);
+		writeIndexes(buffer, getIndexes());
+		return buffer;
+	}
+
+	Table Table::deserializeSchema(const char* data, size_t size)
+	{
+		Reader reader{ data, size };
+		Table table = readSchema(reader);
+		readIndexes(reader, table);
+		return table;
+	}
+
+	std::vector<char> Table::serializeRow(const Row& row)
+	{
+		std::vector<char> buffer;
+		writeRow(buffer, row);
+		return buffer;
+	}
+
+	Row Table::deserializeRow(const char* data, size_t size, const std::vector<ColumnDefinition>& schema)
+	{
+		Reader reader{ data, size };
+		return readRow(reader, schema);
 	}
 }
@@ -7,6 +7,7 @@ namespace Xale::Engine
             Xale::Execution::IExecutor* executor) :
         _parser(parser),
         _executor(executor),
+        _state(executor ? executor->createState() : nullptr),
         _results(nullptr),
         _lastStatementType(Xale::Query::StatementType::Unknown)
     {}
@@ -56,7 +57,7 @@ namespace Xale::Engine
             if (q.empty()) continue;
             auto parsedStmt = _parser->parse(q);
             _lastStatementType = parsedStmt->type;
-            _results = _executor->execute(parsedStmt.get());
+            _results = _executor->execute(parsedStmt.get(), *_state);
             _multiResponses.push_back(formatCurrentResult());
         }
 
@@ -98,7 +99,13 @@ namespace Xale::Engine
             case Xale::Query::StatementType::Delete:  return formatDeleteResult();
             case Xale::Query::StatementType::Create:  return formatCreateResult();
             case Xale::Query::StatementType::Drop:    return formatDropResult();
+            case Xale::Query::StatementType::CreateIndex: return "Query OK, index created";
+            case Xale::Query::StatementType::DropIndex:   return "Query OK, index dropped";
             case Xale::Query::StatementType::List:    return formatSelectResult();
+            case Xale::Query::StatementType::Explain: return formatSelectResult();
+            case Xale::Query::StatementType::Begin:   return "Query OK, transaction started";
+            case Xale::Query::StatementType::Commit:  return "Query OK, transaction committed";
+            case Xale::Query::StatementType::Rollback: return "Query OK, transaction rolled back";
             default: return "Query executed";
         }
     }
@@ -111,8 +118,13 @@ namespace Xale::Engine
         if (schema.empty() || rows.empty())
             return "Empty set";
 
-        auto valueToString = [](const Xale::DataStructure::Field& field) -> std::string {
-            if (field.type == Xale::DataStructure::FieldType::Integer)
+        // Values are positional, their column gives the display type
+        auto valueToString = [&](size_t column, const Xale::DataStructure::Row& row) -> std::string {
+            if (column >= row.values.size())
+                return "";
+
+            const Xale::DataStructure::FieldValue& value = row.values[column];
+            if (schema[column].type == Xale::DataStructure::FieldType::Integer)
             {
                 return std::visit([](auto&& arg) -> std::string {
                     using T = std::decay_t<decltype(arg)>;
@@ -124,7 +136,7 @@ namespace Xale::Engine
                         return "NULL";
                     else
                         return "0";
-                }, field.value);
+                }, value);
             }
             
             return std::visit([](auto&& arg) -> std::string {
@@ -145,26 +157,16 @@ namespace Xale::Engine
                     return arg;
                 else
                     return "UNKNOWN";
-            }, field.value);
+            }, value);
         };
 
         std::vector<size_t> columnWidths;
-        for (const auto& col : schema)
+        for (size_t i = 0; i < schema.size(); ++i)
         {
-            size_t maxWidth = col.name.length();
+            size_t maxWidth = schema[i].name.length();
             
             for (const auto& row : rows)
-            {
-                for (const auto& field : row.fields)
-                {
-                    if (field.name == col.name)
-                    {
-                        std::string valueStr = valueToString(field);
-                        maxWidth = std::max(maxWidth, valueStr.length());
-                        break;
-                    }
-                }
-            }
+                maxWidth = std::max(maxWidth, valueToString(i, row).length());
             
             columnWidths.push_back(maxWidth);
         }
@@ -195,17 +197,7 @@ namespace Xale::Engine
             result += "|";
             for (size_t i = 0; i < schema.size(); ++i)
             {
-                std::string valueStr;
-                
-                for (const auto& field : row.fields)
-                {
-                    if (field.name == schema[i].name)
-                    {
-                        valueStr = valueToString(field);
-                        break;
-                    }
-                }
-                
+                std::string valueStr = valueToString(i, row);
                 size_t padding = columnWidths[i] - valueStr.length();
                 result += " " + valueStr + std::string(padding, ' ') + " |";
             }
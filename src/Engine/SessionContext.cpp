@@ -0,0 +1,14 @@
+#include "Engine/SessionContext.h"
+
+namespace Xale::Engine
+{
+    SessionContext::SessionContext(Xale::Execution::IExecutor& executor) :
+        _parser(&_tokenizer),
+        _queryEngine(&_parser, &executor)
+    {}
+
+    QueryEngine& SessionContext::getQueryEngine()
+    {
+        return _queryEngine;
+    }
+}
@@ -0,0 +1,240 @@
+#include "Execution/Aggregate.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+
+namespace Xale::Execution
+{
+	namespace
+	{
+		/**
+		 * @brief Number of independent accumulators of the column kernels
+		 */
+		constexpr size_t LANES = 8;
+
+		template <typename Sum, typename T>
+		Sum sumValues(const T* data, size_t size)
+		{
+			Sum lanes[LANES] = {};
+			size_t i = 0;
+
+			for (; i + LANES <= size; i += LANES)
+			{
+				for (size_t k = 0; k < LANES; ++k)
+					lanes[k] += data[i + k];
+			}
+
+			Sum sum = 0;
+			for (; i < size; ++i)
+				sum += data[i];
+			for (size_t k = 0; k < LANES; ++k)
+				sum += lanes[k];
+
+			return sum;
+		}
+
+		/**
+		 * @brief Smallest or largest value of a column, NULL values being replaced by the neutral value
+		 */
+		template <bool IsMin, typename T>
+		T extremeValue(const T* data, const std::vector<uint64_t>& nulls, size_t size, bool hasNulls, T neutral)
+		{
+			T lanes[LANES];
+			std::fill(lanes, lanes + LANES, neutral);
+			size_t i = 0;
+
+			if (!hasNulls)
+			{
+				for (; i + LANES <= size; i += LANES)
+				{
+					for (size_t k = 0; k < LANES; ++k)
+						lanes[k] = IsMin ? std::min(lanes[k], data[i + k]) : std::max(lanes[k], data[i + k]);
+				}
+			}
+
+			T extreme = neutral;
+			for (; i < size; ++i)
+			{
+				const T value = (nulls[i / 64] >> (i % 64)) & 1 ? neutral : data[i];
+				extreme = IsMin ? std::min(extreme, value) : std::max(extreme, value);
+			}
+			for (size_t k = 0; k < LANES; ++k)
+				extreme = IsMin ? std::min(extreme, lanes[k]) : std::max(extreme, lanes[k]);
+
+			return extreme;
+		}
+	}
+
+	bool parseAggregateFunction(const std::string& name, AggregateFunction& out)
+	{
+		std::string upper = name;
+		std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+
+		if (upper == "COUNT") out = AggregateFunction::Count;
+		else if (upper == "SUM") out = AggregateFunction::Sum;
+		else if (upper == "AVG") out = AggregateFunction::Avg;
+		else if (upper == "MIN") out = AggregateFunction::Min;
+		else if (upper == "MAX") out = AggregateFunction::Max;
+		else return false;
+
+		return true;
+	}
+
+	const char* aggregateFunctionName(AggregateFunction function)
+	{
+		switch (function)
+		{
+			case AggregateFunction::Count: return "COUNT";
+			case AggregateFunction::Sum: return "SUM";
+			case AggregateFunction::Avg: return "AVG";
+			case AggregateFunction::Min: return "MIN";
+			default: return "MAX";
+		}
+	}
+
+	Accumulator::Accumulator(AggregateFunction function)
+		: _function(function)
+	{}
+
+	void Accumulator::add(const Xale::DataStructure::FieldValue& value)
+	{
+		if (std::holds_alternative<std::monostate>(value))
+			return;
+
+		switch (_function)
+		{
+			case AggregateFunction::Count:
+				++_count;
+				break;
+			case AggregateFunction::Sum:
+			case AggregateFunction::Avg:
+				if (std::holds_alternative<int>(value))
+				{
+					addInteger(std::get<int>(value), 1);
+				}
+				else if (std::holds_alternative<double>(value))
+				{
+					_floatSum += std::get<double>(value);
+					_hasFloat = true;
+					++_numericCount;
+				}
+				break;
+			default:
+				addExtreme(value);
+				break;
+		}
+	}
+
+	void Accumulator::addRows(size_t count)
+	{
+		_count += static_cast<int64_t>(count);
+	}
+
+	void Accumulator::addColumn(const Xale::DataStructure::ColumnVector& column)
+	{
+		using Xale::DataStructure::ColumnKind;
+
+		const size_t size = column.size();
+		const size_t values = size - column.nullCount();
+		const bool hasNulls = column.nullCount() != 0;
+		const bool isSum = _function == AggregateFunction::Sum || _function == AggregateFunction::Avg;
+		const bool isMin = _function == AggregateFunction::Min;
+
+		if (values == 0)
+			return;
+
+		if (_function == AggregateFunction::Count)
+		{
+			_count += static_cast<int64_t>(values);
+			return;
+		}
+
+		switch (column.getKind())
+		{
+			case ColumnKind::Integer: {
+				const int32_t* data = column.integers();
+				if (isSum)
+				{
+					addInteger(sumValues<int64_t>(data, size), static_cast<int64_t>(values));
+					return;
+				}
+
+				const int32_t extreme = isMin
+					? extremeValue<true>(data, column.getNullBitmap(), size, hasNulls, std::numeric_limits<int32_t>::max())
+					: extremeValue<false>(data, column.getNullBitmap(), size, hasNulls, std::numeric_limits<int32_t>::min());
+				addExtreme(static_cast<int>(extreme));
+				return;
+			}
+			case ColumnKind::Float: {
+				const double* data = column.floats();
+				if (isSum)
+				{
+					_floatSum += sumValues<double>(data, size);
+					_numericCount += static_cast<int64_t>(values);
+					_hasFloat = true;
+					return;
+				}
+
+				const double extreme = isMin
+					? extremeValue<true>(data, column.getNullBitmap(), size, hasNulls, std::numeric_limits<double>::infinity())
+					: extremeValue<false>(data, column.getNullBitmap(), size, hasNulls, -std::numeric_limits<double>::infinity());
+				addExtreme(extreme);
+				return;
+			}
+			default:
+				for (size_t i = 0; i < size; ++i)
+					add(column.valueAt(i));
+				return;
+		}
+	}
+
+	Xale::DataStructure::FieldValue Accumulator::result() const
+	{
+		switch (_function)
+		{
+			case AggregateFunction::Count:
+				return static_cast<int>(_count);
+			case AggregateFunction::Sum:
+				if (_numericCount == 0)
+					return std::monostate{};
+				if (!_hasFloat && _integerSum >= std::numeric_limits<int>::min() && _integerSum <= std::numeric_limits<int>::max())
+					return static_cast<int>(_integerSum);
+				return static_cast<double>(_integerSum) + _floatSum;
+			case AggregateFunction::Avg:
+				if (_numericCount == 0)
+					return std::monostate{};
+				return (static_cast<double>(_integerSum) + _floatSum) / static_cast<double>(_numericCount);
+			default:
+				return _extreme;
+		}
+	}
+
+	void Accumulator::addInteger(int64_t value, int64_t count)
+	{
+		// A sum which would overflow goes on as a float
+		const bool overflows = value > 0
+			? _integerSum > std::numeric_limits<int64_t>::max() - value
+			: _integerSum < std::numeric_limits<int64_t>::min() - value;
+		if (overflows)
+		{
+			_floatSum += static_cast<double>(_integerSum) + static_cast<double>(value);
+			_integerSum = 0;
+			_hasFloat = true;
+		}
+		else
+		{
+			_integerSum += value;
+		}
+		_numericCount += count;
+	}
+
+	void Accumulator::addExtreme(const Xale::DataStructure::FieldValue& value)
+	{
+		Xale::DataStructure::FieldValueLess less;
+
+		if (std::holds_alternative<std::monostate>(_extreme)
+			|| (_function == AggregateFunction::Min ? less(value, _extreme) : less(_extreme, value)))
+			_extreme = value;
+	}
+}
@@ -1,170 +1,261 @@
 #include "Execution/BasicExecutor.h"
+#include "Execution/Join.h"
+#include "Execution/QueryPlanner.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace Xale::Execution
 {
-	BasicExecutor::BasicExecutor(TableManager& tableManager)
-		: _tableManager(tableManager)
+	BasicExecutor::BasicExecutor(TableManager& tableManager, std::chrono::milliseconds lockTimeout)
+		: _tableManager(tableManager), _lockTimeout(lockTimeout)
 	{}
 
 	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::execute(Xale::Query::Statement* statement)
 	{
+		// A transaction opened here would be rolled back as soon as the statement returns
+		Transaction transaction(_tableManager, _lockTimeout);
+		return execute(statement, transaction);
+	}
+
+	std::unique_ptr<IExecutionState> BasicExecutor::createState()
+	{
+		return std::make_unique<Transaction>(_tableManager, _lockTimeout);
+	}
+
+	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::execute(Xale::Query::Statement* statement, IExecutionState& state)
+	{
+		Transaction& transaction = static_cast<Transaction&>(state);
+
+		switch (statement->type)
+		{
+			case Xale::Query::StatementType::Begin:
+				transaction.begin();
+				return std::make_unique<Xale::DataStructure::ResultSet>();
+			case Xale::Query::StatementType::Commit:
+				transaction.commit();
+				return std::make_unique<Xale::DataStructure::ResultSet>();
+			case Xale::Query::StatementType::Rollback:
+				transaction.rollback();
+				return std::make_unique<Xale::DataStructure::ResultSet>();
+			case Xale::Query::StatementType::Insert:
+			case Xale::Query::StatementType::Update:
+			case Xale::Query::StatementType::Delete: {
+				if (transaction.isActive())
+					return executeChange(statement, transaction);
+
+				// Outside of BEGIN, each change runs in its own transaction, rolled back on failure
+				Transaction own(_tableManager, _lockTimeout);
+				own.begin();
+				auto result = executeChange(statement, own);
+				own.commit();
+				return result;
+			}
+			case Xale::Query::StatementType::Select:
+			case Xale::Query::StatementType::Explain:
+			case Xale::Query::StatementType::List:
+				break;
+			default:
+				// The catalog waits for the open transactions, the one of the statement included
+				if (transaction.isActive())
+					THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Tables and indexes cannot be created or dropped inside a transaction");
+				break;
+		}
+
+		TableLocks locks = lockStatement(*statement);
+
 		switch (statement->type)
 		{
-			case Xale::Query::StatementType::Select: return executeSelect(static_cast<Xale::Query::SelectStatement*>(statement));
-			case Xale::Query::StatementType::Insert: return executeInsert(static_cast<Xale::Query::InsertStatement*>(statement));
-			case Xale::Query::StatementType::Update: return executeUpdate(static_cast<Xale::Query::UpdateStatement*>(statement));
-			case Xale::Query::StatementType::Delete: return executeDelete(static_cast<Xale::Query::DeleteStatement*>(statement));
+			case Xale::Query::StatementType::Select: return executeSelect(static_cast<Xale::Query::SelectStatement*>(statement), transaction.getSnapshot());
 			case Xale::Query::StatementType::Create: return executeCreate(static_cast<Xale::Query::CreateStatement*>(statement));
 			case Xale::Query::StatementType::Drop: return executeDrop(static_cast<Xale::Query::DropStatement*>(statement));
+			case Xale::Query::StatementType::CreateIndex: return executeCreateIndex(static_cast<Xale::Query::CreateIndexStatement*>(statement));
+			case Xale::Query::StatementType::DropIndex: return executeDropIndex(static_cast<Xale::Query::DropIndexStatement*>(statement));
             case Xale::Query::StatementType::List: return executeList(static_cast<Xale::Query::ListStatement*>(statement));
+            case Xale::Query::StatementType::Explain: return executeExplain(static_cast<Xale::Query::ExplainStatement*>(statement));
             default: THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Unsupported statement type");
 		}
 	}
 
-	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeSelect(Xale::Query::SelectStatement* stmt)
+	TableLocks BasicExecutor::lockStatement(const Xale::Query::Statement& statement)
 	{
-		auto table = _tableManager.getTable(stmt->tableName);
-		if (!table) 
-            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::Unknown, "Table does not exist");
-
-		auto resultSet = std::make_unique<Xale::DataStructure::ResultSet>();
-
-		// Helper: extract column name from "table.column" or plain "column"
-		auto colNamePart = [](const std::string& s) -> std::string {
-			auto dot = s.rfind('.');
-			return dot != std::string::npos ? s.substr(dot + 1) : s;
+		auto selectTables = [](const Xale::Query::SelectStatement& select) {
+			std::vector<std::string> tables{ select.tableName };
+			for (const auto& join : select.joins)
+				tables.push_back(join.tableName);
+			return tables;
 		};
 
-		bool isWildcard = stmt->columns.size() == 1 &&
-		                  stmt->columns[0].type == Xale::Query::ExpressionType::Wildcard;
-
-		if (stmt->joins.empty())
+		switch (statement.type)
 		{
-			// Original single-table path
-			if (isWildcard)
-				for (const auto& col : table->getSchema()) resultSet->addColumn(col);
-			else
-				for (const auto& col : stmt->columns)
-					resultSet->addColumn(Xale::DataStructure::ColumnDefinition(colNamePart(col.value), Xale::DataStructure::FieldType::String));
-			
-			for (const auto& row : table->getRows())
-			{
-				if (stmt->where && !evaluateCondition(row, stmt->where.get())) continue;
-				if (isWildcard)
-				{
-					resultSet->addRow(row);
-				}
-				else
-				{
-					Xale::DataStructure::Row projected;
-					for (const auto& col : stmt->columns)
-					{
-						std::string name = colNamePart(col.value);
-						for (const auto& field : row.fields)
-							if (field.name == name) { projected.fields.push_back(field); break; }
-					}
-					resultSet->addRow(projected);
-				}
+			case Xale::Query::StatementType::Select:
+				return _tableManager.lockTables(selectTables(static_cast<const Xale::Query::SelectStatement&>(statement)), {});
+			case Xale::Query::StatementType::Explain: {
+				const auto& explain = static_cast<const Xale::Query::ExplainStatement&>(statement);
+				return _tableManager.lockTables(explain.select ? selectTables(*explain.select) : std::vector<std::string>{}, {});
+			}
+			case Xale::Query::StatementType::List:
+				return _tableManager.lockTables({}, {});
+			default: {
+				// CREATE and DROP of tables and indexes change the catalog, or look through every table
+				TableLocks locks;
+				if (!_tableManager.lockCatalog(locks, _lockTimeout))
+					THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Lock wait timeout, tables are used by another transaction");
+				return locks;
 			}
 		}
-		else
-		{
-			// JOIN path: build merged rows via nested-loop join
-			std::vector<Xale::DataStructure::Row> mergedRows = table->getRows();
+	}
 
-			for (const auto& join : stmt->joins)
-			{
-				auto joinTable = _tableManager.getTable(join.tableName);
-				if (!joinTable)
-					THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "JOIN table does not exist: " + join.tableName);
+	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeSelect(Xale::Query::SelectStatement* stmt,
+		const Xale::DataStructure::Snapshot& snapshot)
+	{
+		QueryPlanner planner(_tableManager);
+		std::unique_ptr<PlanNode> plan = planner.planSelect(*stmt);
 
-				std::string leftCol  = colNamePart(join.leftTableCol);
-				std::string rightCol = colNamePart(join.rightTableCol);
+		auto resultSet = std::make_unique<Xale::DataStructure::ResultSet>();
+		for (const auto& column : plan->schema)
+			resultSet->addColumn(column);
 
-				std::vector<Xale::DataStructure::Row> newMerged;
-				for (const auto& leftRow : mergedRows)
-				{
-					Xale::DataStructure::FieldValue leftVal;
-					bool foundLeft = false;
-					for (const auto& f : leftRow.fields)
-						if (f.name == leftCol) { leftVal = f.value; foundLeft = true; break; }
+		// Taken once the tables are locked, the writers committing meanwhile staying invisible
+		std::unique_ptr<Operator> root = buildOperator(*plan, snapshot);
+		Xale::DataStructure::Row row;
 
-					if (!foundLeft) continue;
+		root->open();
+		while (root->next(row))
+			resultSet->addRow(row);
+		root->close();
 
-					for (const auto& rightRow : joinTable->getRows())
-					{
-						Xale::DataStructure::FieldValue rightVal;
-						bool foundRight = false;
-						for (const auto& f : rightRow.fields)
-							if (f.name == rightCol) { rightVal = f.value; foundRight = true; break; }
-
-						// Compare values with type coercion (int vs double)
-						auto valuesEqual = [](const Xale::DataStructure::FieldValue& a, const Xale::DataStructure::FieldValue& b) -> bool {
-							if (a == b) return true;
-							if (std::holds_alternative<int>(a) && std::holds_alternative<double>(b))
-								return static_cast<double>(std::get<int>(a)) == std::get<double>(b);
-							if (std::holds_alternative<double>(a) && std::holds_alternative<int>(b))
-								return std::get<double>(a) == static_cast<double>(std::get<int>(b));
-							return false;
-						};
-
-						if (foundRight && valuesEqual(leftVal, rightVal))
-						{
-							Xale::DataStructure::Row merged;
-							merged.fields = leftRow.fields;
-							for (const auto& f : rightRow.fields)
-								merged.fields.push_back(f);
-							newMerged.push_back(merged);
-						}
-					}
-				}
-				mergedRows = std::move(newMerged);
+		return resultSet;
+	}
+
+	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeExplain(Xale::Query::ExplainStatement* stmt)
+	{
+		QueryPlanner planner(_tableManager);
+		std::unique_ptr<PlanNode> plan = planner.planSelect(*stmt->select);
+
+		auto resultSet = std::make_unique<Xale::DataStructure::ResultSet>();
+		resultSet->addColumn(Xale::DataStructure::ColumnDefinition("plan", Xale::DataStructure::FieldType::String));
+
+		for (const auto& line : QueryPlanner::explain(*plan))
+		{
+			Xale::DataStructure::Row row;
+			row.values.push_back(line);
+			resultSet->addRow(row);
+		}
+
+		return resultSet;
+	}
+
+	std::unique_ptr<Operator> BasicExecutor::buildOperator(const PlanNode& node, const Xale::DataStructure::Snapshot& snapshot)
+	{
+		switch (node.type)
+		{
+			case PlanNodeType::Scan: {
+				if (node.sortKeys.empty())
+					return std::make_unique<ScanOperator>(*node.table, node.columns, snapshot);
+
+				// Rows are read in the order of the index of the sort column
+				const SortKey& key = node.sortKeys[0];
+				std::vector<size_t> slots = node.table->findSlotsInKeyOrder(node.table->getSchema()[key.column].name, snapshot);
+				if (key.descending)
+					std::reverse(slots.begin(), slots.end());
+				return std::make_unique<SlotScanOperator>(*node.table, std::move(slots), node.columns);
 			}
+			case PlanNodeType::IndexScan:
+				return std::make_unique<SlotScanOperator>(*node.table, findMatchingSlots(*node.table, node.condition, false, snapshot), node.columns);
+			case PlanNodeType::Filter: {
+				const PlanNode& input = *node.children[0];
 
-			// Build result schema
-			if (isWildcard)
-			{
-				for (const auto& col : table->getSchema()) resultSet->addColumn(col);
-				for (const auto& join : stmt->joins)
+				// Filtering a scan on a comparison reads the columnar copy of its table, unless the scan is ordered
+				if (input.type == PlanNodeType::Scan && input.sortKeys.empty() && !node.condition.matchesAll)
 				{
-					auto jt = _tableManager.getTable(join.tableName);
-					if (jt)
-						for (const auto& col : jt->getSchema()) resultSet->addColumn(col);
+					BoundCondition condition = node.condition;
+					if (condition.column != -1)
+						condition.column = static_cast<int>(input.columns[condition.column]);
+					return std::make_unique<FilteredScanOperator>(*input.table, input.columns, condition, snapshot);
 				}
+
+				return std::make_unique<FilterOperator>(buildOperator(input, snapshot), node.predicate);
 			}
-			else
-			{
-				for (const auto& col : stmt->columns)
-					resultSet->addColumn(Xale::DataStructure::ColumnDefinition(colNamePart(col.value), Xale::DataStructure::FieldType::String));
-			}
+			case PlanNodeType::Join: {
+				const PlanNode& leftInput = *node.children[0];
+				const PlanNode& rightInput = *node.children[1];
 
-			// Apply WHERE and project
-			for (const auto& row : mergedRows)
-			{
-				if (stmt->where && !evaluateCondition(row, stmt->where.get())) continue;
+				// A join on an unknown column matches nothing
+				if (node.leftColumn == -1 || node.rightColumn == -1)
+					return std::make_unique<EmptyOperator>();
 
-				if (isWildcard)
+				const size_t leftColumn = static_cast<size_t>(node.leftColumn);
+				const size_t rightColumn = static_cast<size_t>(node.rightColumn);
+
+				switch (node.strategy)
 				{
-					resultSet->addRow(row);
+					case JoinStrategy::IndexNestedLoop:
+						return std::make_unique<IndexNestedLoopJoinOperator>(
+							buildOperator(leftInput, snapshot), leftColumn,
+							*rightInput.table, rightInput.columns[rightColumn], rightInput.columns, snapshot);
+					case JoinStrategy::SortMerge:
+						// Both inputs are scans, read in the order of their index
+						return std::make_unique<SortMergeJoinOperator>(
+							*leftInput.table, leftInput.columns, leftInput.columns[leftColumn],
+							*rightInput.table, rightInput.columns, rightInput.columns[rightColumn], snapshot);
+					default:
+						return std::make_unique<HashJoinOperator>(
+							buildOperator(leftInput, snapshot), leftColumn,
+							buildOperator(rightInput, snapshot), rightColumn,
+							leftInput.estimatedRows < rightInput.estimatedRows);
 				}
-				else
+			}
+			case PlanNodeType::Limit:
+				return std::make_unique<LimitOperator>(buildOperator(*node.children[0], snapshot), node.limit, node.offset);
+			case PlanNodeType::Sort: {
+				const PlanNode& input = *node.children[0];
+				if (node.sortStrategy == SortStrategy::TopK)
+					return std::make_unique<TopKSortOperator>(buildOperator(input, snapshot), node.sortKeys, node.limit);
+				return std::make_unique<SortOperator>(buildOperator(input, snapshot), node.sortKeys, input.schema, SORT_MEMORY_BUDGET);
+			}
+			case PlanNodeType::Aggregate: {
+				const PlanNode& input = *node.children[0];
+
+				// Aggregating a whole table reads the columns of its columnar copy
+				if (node.groupColumns.empty() && input.type == PlanNodeType::Scan)
 				{
-					Xale::DataStructure::Row projected;
-					for (const auto& col : stmt->columns)
+					std::vector<AggregateSpec> aggregates = node.aggregates;
+					for (auto& aggregate : aggregates)
 					{
-						std::string name = colNamePart(col.value);
-						for (const auto& field : row.fields)
-							if (field.name == name) { projected.fields.push_back(field); break; }
+						if (aggregate.column != -1)
+							aggregate.column = static_cast<int>(input.columns[aggregate.column]);
 					}
-					resultSet->addRow(projected);
+					return std::make_unique<ColumnarAggregateOperator>(*input.table, std::move(aggregates), snapshot);
 				}
+
+				return std::make_unique<HashAggregateOperator>(buildOperator(input, snapshot), node.groupColumns, node.aggregates);
+			}
+			default: {
+				const PlanNode& input = *node.children[0];
+
+				bool isIdentity = node.projection.size() == input.schema.size();
+				for (size_t i = 0; i < node.projection.size() && isIdentity; ++i)
+					isIdentity = node.projection[i] == static_cast<int>(i);
+				if (isIdentity)
+					return buildOperator(input, snapshot);
+
+				return std::make_unique<ProjectOperator>(buildOperator(input, snapshot), node.projection);
 			}
 		}
+	}
 
-		return resultSet;
+	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeChange(Xale::Query::Statement* statement, Transaction& transaction)
+	{
+		switch (statement->type)
+		{
+			case Xale::Query::StatementType::Insert: return executeInsert(static_cast<Xale::Query::InsertStatement*>(statement), transaction);
+			case Xale::Query::StatementType::Update: return executeUpdate(static_cast<Xale::Query::UpdateStatement*>(statement), transaction);
+			default: return executeDelete(static_cast<Xale::Query::DeleteStatement*>(statement), transaction);
+		}
 	}
 
-	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeInsert(Xale::Query::InsertStatement* stmt)
+	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeInsert(Xale::Query::InsertStatement* stmt, Transaction& transaction)
 	{
 		auto table = _tableManager.getTable(stmt->tableName);
 		if (!table) 
@@ -178,18 +269,18 @@ namespace Xale::Execution
 			Xale::DataStructure::FieldValue value = evaluateExpression(expr);
 			const auto& schema = table->getSchema();
 			if (i >= schema.size()) THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Too many values");
-			newRow.fields.push_back(Xale::DataStructure::Field(schema[i].name, schema[i].type, value));
+			newRow.values.push_back(std::move(value));
 		}
 
-		table->insertRow(newRow);
-		
-		// Auto-save after inserting row
-		_tableManager.saveAllTables();
-		
+		transaction.lockTable(stmt->tableName);
+		checkIndexMemoryLimit();
+		if (!table->insertVersion(newRow, transaction.getId()))
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Row does not match the table schema, or its primary key is NULL or duplicated");
+
 		return std::make_unique<Xale::DataStructure::ResultSet>();
 	}
 
-	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeUpdate(Xale::Query::UpdateStatement* stmt)
+	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeUpdate(Xale::Query::UpdateStatement* stmt, Transaction& transaction)
 	{
 		auto table = _tableManager.getTable(stmt->tableName);
 
@@ -200,25 +291,24 @@ namespace Xale::Execution
 		for (const auto& assignment : stmt->assignments) 
             updates[assignment.first] = evaluateExpression(assignment.second);
 
-		table->updateRows("", Xale::DataStructure::FieldValue(), updates);
-
-		// Auto-save after updating rows
-		_tableManager.saveAllTables();
+		// New versions are appended, the readers of the table still seeing the old ones
+		transaction.lockTable(stmt->tableName);
+		checkIndexMemoryLimit();
+		table->updateVersionsAt(findMatchingSlots(*table, stmt->where.get(), transaction.getSnapshot()), updates, transaction.getId());
 
 		return std::make_unique<Xale::DataStructure::ResultSet>();
 	}
 
-	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeDelete(Xale::Query::DeleteStatement* stmt)
+	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeDelete(Xale::Query::DeleteStatement* stmt, Transaction& transaction)
 	{
 		auto table = _tableManager.getTable(stmt->tableName);
 
 		if (!table) 
             THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Table does not exist");
 
-		table->deleteRows("", Xale::DataStructure::FieldValue());
-
-		// Auto-save after deleting rows
-		_tableManager.saveAllTables();
+		// Versions are ended, the readers of the table still seeing them
+		transaction.lockTable(stmt->tableName);
+		table->deleteVersionsAt(findMatchingSlots(*table, stmt->where.get(), transaction.getSnapshot()), transaction.getId());
 
 		return std::make_unique<Xale::DataStructure::ResultSet>();
 	}
@@ -254,6 +344,9 @@ namespace Xale::Execution
 				));
 			}
 		}
+
+		// Auto-save once the schema is complete
+		_tableManager.saveAllTables();
 		
 		return std::make_unique<Xale::DataStructure::ResultSet>();
 	}
@@ -265,6 +358,56 @@ namespace Xale::Execution
 		return std::make_unique<Xale::DataStructure::ResultSet>();
 	}
 
+	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeCreateIndex(Xale::Query::CreateIndexStatement* stmt)
+	{
+		auto table = _tableManager.getTable(stmt->tableName);
+
+		if (!table)
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Table does not exist");
+
+		if (table->getColumnIndex(stmt->columnName) == -1)
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Column does not exist: " + stmt->columnName);
+
+		// Index names are unique across tables, so that DROP INDEX only needs the name
+		for (const auto& tableName : _tableManager.getTableNames())
+		{
+			for (const auto& index : _tableManager.getTable(tableName)->getIndexes())
+			{
+				if (index.name == stmt->indexName)
+					THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Index already exists");
+			}
+		}
+
+		table->createIndex(Xale::DataStructure::IndexDefinition(stmt->indexName, stmt->columnName));
+
+		std::size_t limit = _tableManager.getIndexMemoryLimit();
+		if (limit != 0 && _tableManager.getIndexMemoryUsage() > limit)
+		{
+			table->dropIndex(stmt->indexName);
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Index memory limit exceeded");
+		}
+
+		// Auto-save after creating index
+		_tableManager.saveAllTables();
+
+		return std::make_unique<Xale::DataStructure::ResultSet>();
+	}
+
+	std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeDropIndex(Xale::Query::DropIndexStatement* stmt)
+	{
+		for (const auto& tableName : _tableManager.getTableNames())
+		{
+			if (_tableManager.getTable(tableName)->dropIndex(stmt->indexName))
+			{
+				// Auto-save after dropping index
+				_tableManager.saveAllTables();
+				return std::make_unique<Xale::DataStructure::ResultSet>();
+			}
+		}
+
+		THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Index does not exist");
+	}
+
     std::unique_ptr<Xale::DataStructure::ResultSet> BasicExecutor::executeList(Xale::Query::ListStatement* stmt)
     {
         auto tableNames = _tableManager.getTableNames();
@@ -278,122 +421,177 @@ namespace Xale::Execution
             return result;
         
         result->addColumn(Xale::DataStructure::ColumnDefinition(colIdentifier, colType));
+        result->addColumn(Xale::DataStructure::ColumnDefinition("index_memory", Xale::DataStructure::FieldType::Float));
 
         for (const auto& tableName : tableNames)
         {
             Xale::DataStructure::Row row;
-            auto field = Xale::DataStructure::Field(colIdentifier, colType, tableName);
-            row.fields.push_back(field);
+            row.values.push_back(tableName);
+            row.values.push_back(static_cast<double>(_tableManager.getTable(tableName)->getIndexMemoryUsage()));
             result->addRow(row);
         }
 
         return result;
     }
 
+	void BasicExecutor::checkIndexMemoryLimit() const
+	{
+		std::size_t limit = _tableManager.getIndexMemoryLimit();
+		if (limit != 0 && _tableManager.getIndexMemoryUsage() >= limit)
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Index memory limit reached");
+	}
+
 	Xale::DataStructure::FieldValue BasicExecutor::evaluateExpression(const Xale::Query::Expression& expr)
 	{
-		switch (expr.type) {
-			case Xale::Query::ExpressionType::NumericLiteral:
-				try { return expr.value.find('.') != std::string::npos ? std::stod(expr.value) : std::stoi(expr.value); }
-				catch (...) { return 0; }
-			case Xale::Query::ExpressionType::StringLiteral: {
-				std::string str = expr.value;
-				if (str.length() >= 2 &&
-				    ((str.front() == '\'' && str.back() == '\'') ||
-				     (str.front() == '"'  && str.back() == '"')))
-					str = str.substr(1, str.length() - 2);
-				return str;
-			}
-			case Xale::Query::ExpressionType::Identifier: return expr.value;
-			default: return std::monostate{};
+		return QueryPlanner::evaluateLiteral(expr);
+	}
+
+	int BasicExecutor::findColumn(const std::vector<Xale::DataStructure::ColumnDefinition>& schema, const std::string& columnName)
+	{
+		// Strip optional table prefix (e.g. "users.id" -> "id")
+		auto dot = columnName.rfind('.');
+		const std::string name = dot != std::string::npos ? columnName.substr(dot + 1) : columnName;
+
+		for (size_t i = 0; i < schema.size(); ++i)
+		{
+			if (schema[i].name == name)
+				return static_cast<int>(i);
 		}
+
+		return -1;
 	}
 
-	bool BasicExecutor::evaluateCondition(const Xale::DataStructure::Row& row, const Xale::Query::WhereClause* where)
+	bool BasicExecutor::evaluateCondition(const Xale::DataStructure::Row& row, const BoundCondition& condition)
 	{
-		if (!where || !where->condition)
+		if (condition.matchesAll)
 			return true;
-		
-		const auto& condition = where->condition;
-		
-		if (condition->type == Xale::Query::ExpressionType::BinaryOp && condition->binary)
+
+		if (condition.column == -1)
+			return false;
+
+		return compareValues(row.values[condition.column], condition.op, condition.value);
+	}
+
+	std::vector<size_t> BasicExecutor::findMatchingSlots(const Xale::DataStructure::Table& table, const BoundCondition& condition, bool scanColumns,
+		const Xale::DataStructure::Snapshot& snapshot)
+	{
+		std::vector<size_t> slots;
+
+		// Index lookup: "indexed_column [OPERATOR] literal"
+		if (!condition.matchesAll && condition.column != -1)
 		{
-			const auto& binary = condition->binary;
-			
-			if (binary->left->type != Xale::Query::ExpressionType::Identifier)
-				return true;
+			const std::string& columnName = table.getSchema()[condition.column].name;
 
-			std::string columnName = binary->left->value;
-			// Strip optional table prefix (e.g. "users.id" -> "id")
+			if (table.isIndexed(columnName))
 			{
-				auto dot = columnName.rfind('.');
-				if (dot != std::string::npos) columnName = columnName.substr(dot + 1);
-			}
+				const Xale::DataStructure::FieldValue& value = condition.value;
+				const CompareOp op = condition.op;
 
-			Xale::DataStructure::FieldValue leftValue;
-			bool found = false;
-			for (const auto& field : row.fields)
-			{
-				if (field.name == columnName)
+				if (op == CompareOp::Equal)
+					return table.findSlots(columnName, value, snapshot);
+
+				if (op != CompareOp::NotEqual)
 				{
-					leftValue = field.value;
-					found = true;
-					break;
+					// Ordered comparisons only ever match numbers, the open side is bounded by infinity
+					if (!std::holds_alternative<int>(value) && !std::holds_alternative<double>(value))
+						return slots;
+
+					const Xale::DataStructure::FieldValue lowest = -std::numeric_limits<double>::infinity();
+					const Xale::DataStructure::FieldValue highest = std::numeric_limits<double>::infinity();
+					const bool isUpperBound = op == CompareOp::Less || op == CompareOp::LessEqual;
+					const bool isInclusive = op == CompareOp::LessEqual || op == CompareOp::GreaterEqual;
+
+					std::vector<size_t> candidates = isUpperBound
+						? table.findSlotsInRange(columnName, &lowest, true, &value, isInclusive, snapshot)
+						: table.findSlotsInRange(columnName, &value, isInclusive, &highest, true, snapshot);
+
+					// The index compares integers and floats by value, keep the exact semantics
+					for (size_t slot : candidates)
+					{
+						if (evaluateCondition(table.getRow(slot), condition))
+							slots.push_back(slot);
+					}
+					return slots;
 				}
 			}
-			
-			if (!found)
-				return false;
-			
-			Xale::DataStructure::FieldValue rightValue = evaluateExpression(*binary->right);
-			
-			const std::string& op = binary->op;
-			
-			try
+		}
+
+		if (scanColumns && !condition.matchesAll && condition.column != -1)
+		{
+			const auto columnar = table.getColumnar();
+			slots = ColumnFilter(condition.op, condition.value).filter(columnar->getColumn(condition.column));
+
+			if (table.hasHiddenVersions(snapshot))
 			{
-				if (op == "=")
-					return leftValue == rightValue;
-				else if (op == "!=")
-					return leftValue != rightValue;
-				else if (op == "<")
-				{
-					if (std::holds_alternative<int>(leftValue) && std::holds_alternative<int>(rightValue))
-						return std::get<int>(leftValue) < std::get<int>(rightValue);
-					if (std::holds_alternative<double>(leftValue) && std::holds_alternative<double>(rightValue))
-						return std::get<double>(leftValue) < std::get<double>(rightValue);
-					return false;
-				}
-				else if (op == ">")
-				{
-					if (std::holds_alternative<int>(leftValue) && std::holds_alternative<int>(rightValue))
-						return std::get<int>(leftValue) > std::get<int>(rightValue);
-					if (std::holds_alternative<double>(leftValue) && std::holds_alternative<double>(rightValue))
-						return std::get<double>(leftValue) > std::get<double>(rightValue);
-					return false;
-				}
-				else if (op == "<=")
-				{
-					if (std::holds_alternative<int>(leftValue) && std::holds_alternative<int>(rightValue))
-						return std::get<int>(leftValue) <= std::get<int>(rightValue);
-					if (std::holds_alternative<double>(leftValue) && std::holds_alternative<double>(rightValue))
-						return std::get<double>(leftValue) <= std::get<double>(rightValue);
-					return false;
-				}
-				else if (op == ">=")
-				{
-					if (std::holds_alternative<int>(leftValue) && std::holds_alternative<int>(rightValue))
-						return std::get<int>(leftValue) >= std::get<int>(rightValue);
-					if (std::holds_alternative<double>(leftValue) && std::holds_alternative<double>(rightValue))
-						return std::get<double>(leftValue) >= std::get<double>(rightValue);
-					return false;
-				}
+				slots.erase(std::remove_if(slots.begin(), slots.end(), [&](size_t slot) {
+					return !table.isVisible(slot, snapshot);
+				}), slots.end());
+			}
+			return slots;
+		}
+
+		const size_t count = table.getRowCount();
+		for (size_t slot = 0; slot < count; ++slot)
+		{
+			if (table.isVisible(slot, snapshot) && evaluateCondition(table.getRow(slot), condition))
+				slots.push_back(slot);
+		}
+
+		return slots;
+	}
+
+	std::vector<size_t> BasicExecutor::findMatchingSlots(const Xale::DataStructure::Table& table, const Xale::Query::WhereClause* where,
+		const Xale::DataStructure::Snapshot& snapshot)
+	{
+		if (!where || !where->condition)
+			return findMatchingSlots(table, BoundCondition(), false, snapshot);
+
+		const auto& schema = table.getSchema();
+		std::vector<const Xale::Query::Expression*> conjuncts;
+		splitConjuncts(*where->condition, conjuncts);
+
+		// A comparison on an indexed column, joined by AND, narrows the rows evaluated
+		BoundCondition access;
+		for (const auto* conjunct : conjuncts)
+		{
+			std::string name;
+			CompareOp op = CompareOp::Equal;
+			Xale::DataStructure::FieldValue value;
+
+			if (!matchComparison(*conjunct, name, op, value) || op == CompareOp::NotEqual)
+				continue;
+
+			const int column = findColumn(schema, name);
+			if (column != -1 && table.isIndexed(schema[column].name))
+			{
+				access = { false, column, op, value };
+				break;
 			}
-			catch (...)
+		}
+
+		if (!access.matchesAll && conjuncts.size() == 1)
+			return findMatchingSlots(table, access, false, snapshot);
+
+		const RowPredicate predicate = compilePredicate(*where->condition, [&](const std::string& name) { return findColumn(schema, name); });
+		std::vector<size_t> slots;
+
+		if (!access.matchesAll)
+		{
+			for (size_t slot : findMatchingSlots(table, access, false, snapshot))
 			{
-				return false;
+				if (predicate(table.getRow(slot)))
+					slots.push_back(slot);
 			}
+			return slots;
 		}
-		
-		return true;
+
+		const size_t count = table.getRowCount();
+		for (size_t slot = 0; slot < count; ++slot)
+		{
+			if (table.isVisible(slot, snapshot) && predicate(table.getRow(slot)))
+				slots.push_back(slot);
+		}
+
+		return slots;
 	}
 }
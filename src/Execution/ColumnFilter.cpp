@@ -0,0 +1,190 @@
+#include "Execution/ColumnFilter.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Xale::Execution
+{
+	namespace
+	{
+		/**
+		 * @brief Compare every value of a typed array with a literal, one byte per value
+		 */
+		template <typename T>
+		void compareBatch(const T* values, size_t count, CompareOp op, T literal, uint8_t* matches)
+		{
+			switch (op)
+			{
+				case CompareOp::Equal:
+					for (size_t i = 0; i < count; ++i) matches[i] = values[i] == literal;
+					break;
+				case CompareOp::NotEqual:
+					for (size_t i = 0; i < count; ++i) matches[i] = values[i] != literal;
+					break;
+				case CompareOp::Less:
+					for (size_t i = 0; i < count; ++i) matches[i] = values[i] < literal;
+					break;
+				case CompareOp::LessEqual:
+					for (size_t i = 0; i < count; ++i) matches[i] = values[i] <= literal;
+					break;
+				case CompareOp::Greater:
+					for (size_t i = 0; i < count; ++i) matches[i] = values[i] > literal;
+					break;
+				case CompareOp::GreaterEqual:
+					for (size_t i = 0; i < count; ++i) matches[i] = values[i] >= literal;
+					break;
+			}
+		}
+
+		/**
+		 * @brief Override the result of the NULL values of a batch
+		 */
+		void applyNulls(const Xale::DataStructure::ColumnVector& column, size_t begin, size_t count, bool nullMatches, uint8_t* matches)
+		{
+			const uint64_t* nulls = column.getNullBitmap().data();
+			const uint8_t nullResult = nullMatches ? 1 : 0;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const size_t row = begin + i;
+				const uint8_t isNull = (nulls[row / 64] >> (row % 64)) & 1;
+				matches[i] = (matches[i] & (isNull ^ 1)) | (isNull & nullResult);
+			}
+		}
+
+		/**
+		 * @brief Write the positions of the matching values to a selection vector, without branches
+		 */
+		size_t compact(const uint8_t* matches, size_t count, uint32_t* selection)
+		{
+			size_t selected = 0;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				selection[selected] = static_cast<uint32_t>(i);
+				selected += matches[i];
+			}
+
+			return selected;
+		}
+
+		template <typename T>
+		bool isOrdered(const T& a, CompareOp op, const T& b)
+		{
+			switch (op)
+			{
+				case CompareOp::Less: return a < b;
+				case CompareOp::LessEqual: return a <= b;
+				case CompareOp::Greater: return a > b;
+				case CompareOp::GreaterEqual: return a >= b;
+				default: return false;
+			}
+		}
+	}
+
+	bool parseCompareOp(const std::string& op, CompareOp& out)
+	{
+		if (op == "=") out = CompareOp::Equal;
+		else if (op == "!=") out = CompareOp::NotEqual;
+		else if (op == "<") out = CompareOp::Less;
+		else if (op == "<=") out = CompareOp::LessEqual;
+		else if (op == ">") out = CompareOp::Greater;
+		else if (op == ">=") out = CompareOp::GreaterEqual;
+		else return false;
+
+		return true;
+	}
+
+	bool compareValues(const Xale::DataStructure::FieldValue& value, CompareOp op, const Xale::DataStructure::FieldValue& literal)
+	{
+		if (op == CompareOp::Equal)
+			return value == literal;
+		if (op == CompareOp::NotEqual)
+			return value != literal;
+
+		if (std::holds_alternative<int>(value) && std::holds_alternative<int>(literal))
+			return isOrdered(std::get<int>(value), op, std::get<int>(literal));
+		if (std::holds_alternative<double>(value) && std::holds_alternative<double>(literal))
+			return isOrdered(std::get<double>(value), op, std::get<double>(literal));
+
+		return false;
+	}
+
+	ColumnFilter::ColumnFilter(CompareOp op, Xale::DataStructure::FieldValue literal)
+		:_op(op), _literal(std::move(literal))
+	{}
+
+	size_t ColumnFilter::filterBatch(const Xale::DataStructure::ColumnVector& column, size_t begin, size_t count, uint32_t* selection) const
+	{
+		using Xale::DataStructure::ColumnKind;
+
+		uint8_t matches[FILTER_BATCH_SIZE];
+
+		if (column.getKind() == ColumnKind::Mixed)
+		{
+			for (size_t i = 0; i < count; ++i)
+				matches[i] = compareValues(column.valueAt(begin + i), _op, _literal);
+			return compact(matches, count, selection);
+		}
+
+		// A literal of another type gives the same result for every non-NULL value
+		Xale::DataStructure::FieldValue sample;
+		bool typedCompare = false;
+
+		switch (column.getKind())
+		{
+			case ColumnKind::Integer:
+				if (std::holds_alternative<int>(_literal))
+				{
+					compareBatch<int32_t>(column.integers() + begin, count, _op, std::get<int>(_literal), matches);
+					typedCompare = true;
+				}
+				sample = 0;
+				break;
+			case ColumnKind::Float:
+				if (std::holds_alternative<double>(_literal))
+				{
+					compareBatch<double>(column.floats() + begin, count, _op, std::get<double>(_literal), matches);
+					typedCompare = true;
+				}
+				sample = 0.0;
+				break;
+			default:
+				if (std::holds_alternative<std::string>(_literal) && (_op == CompareOp::Equal || _op == CompareOp::NotEqual))
+				{
+					const std::string& literal = std::get<std::string>(_literal);
+					const bool equal = _op == CompareOp::Equal;
+					for (size_t i = 0; i < count; ++i)
+						matches[i] = (column.stringAt(begin + i) == literal) == equal;
+					typedCompare = true;
+				}
+				sample = std::string();
+				break;
+		}
+
+		if (!typedCompare)
+			std::memset(matches, compareValues(sample, _op, _literal) ? 1 : 0, count);
+
+		if (column.nullCount() != 0)
+			applyNulls(column, begin, count, compareValues(std::monostate{}, _op, _literal), matches);
+
+		return compact(matches, count, selection);
+	}
+
+	std::vector<size_t> ColumnFilter::filter(const Xale::DataStructure::ColumnVector& column) const
+	{
+		std::vector<size_t> result;
+		uint32_t selection[FILTER_BATCH_SIZE];
+
+		for (size_t begin = 0; begin < column.size(); begin += FILTER_BATCH_SIZE)
+		{
+			const size_t count = std::min(FILTER_BATCH_SIZE, column.size() - begin);
+			const size_t selected = filterBatch(column, begin, count, selection);
+
+			for (size_t i = 0; i < selected; ++i)
+				result.push_back(begin + selection[i]);
+		}
+
+		return result;
+	}
+}
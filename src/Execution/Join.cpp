@@ -0,0 +1,50 @@
+#include "Execution/Join.h"
+
+#include <cmath>
+#include <functional>
+#include <string>
+
+namespace Xale::Execution
+{
+	JoinStrategy chooseJoinStrategy(size_t leftRows, bool leftOrdered, size_t rightRows, bool rightIndexed)
+	{
+		const double left = static_cast<double>(leftRows);
+		const double right = static_cast<double>(rightRows);
+
+		// Rough number of key comparisons, hashing a key counting as one
+		const double hashCost = 2.0 * (left + right);
+		const double mergeCost = left + right;
+		const double lookupCost = left * std::log2(right + 2.0);
+
+		if (!rightIndexed)
+			return JoinStrategy::Hash;
+		if (lookupCost <= hashCost && (!leftOrdered || lookupCost <= mergeCost))
+			return JoinStrategy::IndexNestedLoop;
+		if (leftOrdered)
+			return JoinStrategy::SortMerge;
+		return JoinStrategy::Hash;
+	}
+
+	bool joinValuesEqual(const Xale::DataStructure::FieldValue& a, const Xale::DataStructure::FieldValue& b)
+	{
+		if (a == b)
+			return true;
+		if (std::holds_alternative<int>(a) && std::holds_alternative<double>(b))
+			return static_cast<double>(std::get<int>(a)) == std::get<double>(b);
+		if (std::holds_alternative<double>(a) && std::holds_alternative<int>(b))
+			return std::get<double>(a) == static_cast<double>(std::get<int>(b));
+		return false;
+	}
+
+	size_t JoinKeyHash::operator()(const Xale::DataStructure::FieldValue& value) const
+	{
+		// Integers hash as the equal float, and 0.0 as -0.0
+		if (std::holds_alternative<int>(value))
+			return std::hash<double>()(static_cast<double>(std::get<int>(value)) + 0.0);
+		if (std::holds_alternative<double>(value))
+			return std::hash<double>()(std::get<double>(value) + 0.0);
+		if (std::holds_alternative<std::string>(value))
+			return std::hash<std::string>()(std::get<std::string>(value));
+		return 0;
+	}
+}
@@ -0,0 +1,796 @@
+#include "Execution/Operators.h"
+#include "Core/ExceptionHandler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace Xale::Execution
+{
+	namespace
+	{
+		void readColumns(const Xale::DataStructure::Row& source, const std::vector<size_t>& columns, std::vector<Xale::DataStructure::FieldValue>& values)
+		{
+			for (size_t column : columns)
+				values.push_back(source.values[column]);
+		}
+
+		void mergeRows(const Xale::DataStructure::Row& left, const Xale::DataStructure::Row& right, Xale::DataStructure::Row& row)
+		{
+			row.values.clear();
+			row.values.reserve(left.values.size() + right.values.size());
+			row.values.insert(row.values.end(), left.values.begin(), left.values.end());
+			row.values.insert(row.values.end(), right.values.begin(), right.values.end());
+		}
+
+		bool rowLess(const std::vector<SortKey>& keys, const Xale::DataStructure::Row& a, const Xale::DataStructure::Row& b)
+		{
+			Xale::DataStructure::FieldValueLess less;
+
+			// Unknown columns are NULL in every row
+			for (const auto& key : keys)
+			{
+				if (key.column == -1)
+					continue;
+
+				const auto& x = a.values[key.column];
+				const auto& y = b.values[key.column];
+				if (less(x, y))
+					return !key.descending;
+				if (less(y, x))
+					return key.descending;
+			}
+
+			return false;
+		}
+
+		/**
+		 * @brief Approximate memory held by a row
+		 */
+		size_t rowMemory(const Xale::DataStructure::Row& row)
+		{
+			size_t size = sizeof(Xale::DataStructure::Row) + row.values.capacity() * sizeof(Xale::DataStructure::FieldValue);
+			for (const auto& value : row.values)
+			{
+				if (std::holds_alternative<std::string>(value))
+					size += std::get<std::string>(value).capacity();
+			}
+			return size;
+		}
+	}
+
+	ScanOperator::ScanOperator(const Xale::DataStructure::Table& table, std::vector<size_t> columns, Xale::DataStructure::Snapshot snapshot)
+		: _table(table), _columns(std::move(columns)), _snapshot(snapshot)
+	{}
+
+	void ScanOperator::open()
+	{
+		// Counted first, every slot counted being visible unless versions are hidden
+		_slot = 0;
+		_count = _table.getRowCount();
+		_allVisible = !_table.hasHiddenVersions(_snapshot);
+	}
+
+	bool ScanOperator::next(Xale::DataStructure::Row& row)
+	{
+		while (_slot < _count && !_allVisible && !_table.isVisible(_slot, _snapshot))
+			++_slot;
+
+		if (_slot >= _count)
+			return false;
+
+		row.values.clear();
+		readColumns(_table.getRow(_slot++), _columns, row.values);
+		return true;
+	}
+
+	void ScanOperator::close()
+	{}
+
+	SlotScanOperator::SlotScanOperator(const Xale::DataStructure::Table& table, std::vector<size_t> slots, std::vector<size_t> columns)
+		: _table(table), _slots(std::move(slots)), _columns(std::move(columns))
+	{}
+
+	void SlotScanOperator::open()
+	{
+		_position = 0;
+	}
+
+	bool SlotScanOperator::next(Xale::DataStructure::Row& row)
+	{
+		if (_position >= _slots.size())
+			return false;
+
+		row.values.clear();
+		readColumns(_table.getRow(_slots[_position++]), _columns, row.values);
+		return true;
+	}
+
+	void SlotScanOperator::close()
+	{}
+
+	FilteredScanOperator::FilteredScanOperator(const Xale::DataStructure::Table& table, std::vector<size_t> columns, const BoundCondition& condition,
+		Xale::DataStructure::Snapshot snapshot)
+		: _table(table), _columns(std::move(columns)), _column(condition.column), _filter(condition.op, condition.value), _snapshot(snapshot)
+	{}
+
+	void FilteredScanOperator::open()
+	{
+		// A condition on an unknown column matches nothing
+		_columnar = _column != -1 ? _table.getColumnar() : nullptr;
+		_values = _columnar ? &_columnar->getColumn(static_cast<size_t>(_column)) : nullptr;
+		_allVisible = !_table.hasHiddenVersions(_snapshot);
+		_selection.resize(FILTER_BATCH_SIZE);
+		_batchBegin = 0;
+		_nextBatch = 0;
+		_selected = 0;
+		_position = 0;
+	}
+
+	bool FilteredScanOperator::next(Xale::DataStructure::Row& row)
+	{
+		if (!_values)
+			return false;
+
+		while (true)
+		{
+			// Filter the next batches until one has a match
+			while (_position == _selected)
+			{
+				if (_nextBatch >= _values->size())
+					return false;
+
+				const size_t count = std::min(FILTER_BATCH_SIZE, _values->size() - _nextBatch);
+				_batchBegin = _nextBatch;
+				_nextBatch += count;
+				_selected = _filter.filterBatch(*_values, _batchBegin, count, _selection.data());
+				_position = 0;
+			}
+
+			const size_t slot = _batchBegin + _selection[_position++];
+			if (!_allVisible && !_table.isVisible(slot, _snapshot))
+				continue;
+
+			row.values.clear();
+			readColumns(_table.getRow(slot), _columns, row.values);
+			return true;
+		}
+	}
+
+	void FilteredScanOperator::close()
+	{
+		_values = nullptr;
+		_columnar.reset();
+	}
+
+	FilterOperator::FilterOperator(std::unique_ptr<Operator> input, RowPredicate predicate)
+		: _input(std::move(input)), _predicate(std::move(predicate))
+	{}
+
+	void FilterOperator::open()
+	{
+		_input->open();
+	}
+
+	bool FilterOperator::next(Xale::DataStructure::Row& row)
+	{
+		while (_input->next(row))
+		{
+			if (_predicate(row))
+				return true;
+		}
+
+		return false;
+	}
+
+	void FilterOperator::close()
+	{
+		_input->close();
+	}
+
+	ProjectOperator::ProjectOperator(std::unique_ptr<Operator> input, std::vector<int> projection)
+		: _input(std::move(input)), _projection(std::move(projection))
+	{}
+
+	void ProjectOperator::open()
+	{
+		_input->open();
+	}
+
+	bool ProjectOperator::next(Xale::DataStructure::Row& row)
+	{
+		if (!_input->next(_inputRow))
+			return false;
+
+		// Unknown columns are NULL
+		row.values.clear();
+		for (int column : _projection)
+			row.values.push_back(column == -1 ? Xale::DataStructure::FieldValue(std::monostate{}) : _inputRow.values[column]);
+		return true;
+	}
+
+	void ProjectOperator::close()
+	{
+		_input->close();
+	}
+
+	LimitOperator::LimitOperator(std::unique_ptr<Operator> input, size_t limit, size_t offset)
+		: _input(std::move(input)), _limit(limit), _offset(offset)
+	{}
+
+	void LimitOperator::open()
+	{
+		_input->open();
+		_produced = 0;
+		_skipped = false;
+	}
+
+	bool LimitOperator::next(Xale::DataStructure::Row& row)
+	{
+		if (_produced >= _limit)
+			return false;
+
+		if (!_skipped)
+		{
+			_skipped = true;
+			for (size_t i = 0; i < _offset; ++i)
+			{
+				if (!_input->next(row))
+				{
+					_produced = _limit;
+					return false;
+				}
+			}
+		}
+
+		if (!_input->next(row))
+		{
+			_produced = _limit;
+			return false;
+		}
+
+		++_produced;
+		return true;
+	}
+
+	void LimitOperator::close()
+	{
+		_input->close();
+	}
+
+	size_t GroupKeyHash::operator()(const std::vector<Xale::DataStructure::FieldValue>& key) const
+	{
+		JoinKeyHash hash;
+		size_t seed = key.size();
+		for (const auto& value : key)
+			seed ^= hash(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+		return seed;
+	}
+
+	bool GroupKeyEqual::operator()(const std::vector<Xale::DataStructure::FieldValue>& a, const std::vector<Xale::DataStructure::FieldValue>& b) const
+	{
+		if (a.size() != b.size())
+			return false;
+
+		for (size_t i = 0; i < a.size(); ++i)
+		{
+			// NULL values fall in the same group
+			const bool aNull = std::holds_alternative<std::monostate>(a[i]);
+			const bool bNull = std::holds_alternative<std::monostate>(b[i]);
+			if (aNull != bNull || (!aNull && !joinValuesEqual(a[i], b[i])))
+				return false;
+		}
+
+		return true;
+	}
+
+	HashAggregateOperator::HashAggregateOperator(std::unique_ptr<Operator> input, std::vector<int> groupColumns, std::vector<AggregateSpec> aggregates)
+		: _input(std::move(input)), _groupColumns(std::move(groupColumns)), _aggregates(std::move(aggregates))
+	{}
+
+	void HashAggregateOperator::open()
+	{
+		_input->open();
+		_position = 0;
+
+		auto newGroup = [this](std::vector<Xale::DataStructure::FieldValue> key) {
+			std::vector<Accumulator> accumulators;
+			accumulators.reserve(_aggregates.size());
+			for (const auto& aggregate : _aggregates)
+				accumulators.emplace_back(aggregate.function);
+
+			_groups.emplace(key, _keys.size());
+			_keys.push_back(std::move(key));
+			_accumulators.push_back(std::move(accumulators));
+			return _keys.size() - 1;
+		};
+
+		if (_groupColumns.empty())
+			newGroup({});
+
+		Xale::DataStructure::Row row;
+		std::vector<Xale::DataStructure::FieldValue> key;
+		while (_input->next(row))
+		{
+			key.clear();
+			for (int column : _groupColumns)
+				key.push_back(column == -1 ? Xale::DataStructure::FieldValue(std::monostate{}) : row.values[column]);
+
+			auto it = _groups.find(key);
+			const size_t group = it != _groups.end() ? it->second : newGroup(key);
+
+			auto& accumulators = _accumulators[group];
+			for (size_t a = 0; a < _aggregates.size(); ++a)
+			{
+				const AggregateSpec& aggregate = _aggregates[a];
+				if (aggregate.allRows)
+					accumulators[a].addRows(1);
+				else if (aggregate.column != -1)
+					accumulators[a].add(row.values[aggregate.column]);
+			}
+		}
+	}
+
+	bool HashAggregateOperator::next(Xale::DataStructure::Row& row)
+	{
+		if (_position >= _keys.size())
+			return false;
+
+		row.values = _keys[_position];
+		for (const auto& accumulator : _accumulators[_position])
+			row.values.push_back(accumulator.result());
+		++_position;
+		return true;
+	}
+
+	void HashAggregateOperator::close()
+	{
+		_input->close();
+		_groups.clear();
+		_keys.clear();
+		_accumulators.clear();
+	}
+
+	ColumnarAggregateOperator::ColumnarAggregateOperator(const Xale::DataStructure::Table& table, std::vector<AggregateSpec> aggregates,
+		Xale::DataStructure::Snapshot snapshot)
+		: _table(table), _aggregates(std::move(aggregates)), _snapshot(snapshot)
+	{}
+
+	void ColumnarAggregateOperator::open()
+	{
+		_produced = false;
+	}
+
+	bool ColumnarAggregateOperator::next(Xale::DataStructure::Row& row)
+	{
+		if (_produced)
+			return false;
+		_produced = true;
+
+		// Every slot of the copy is visible unless versions are hidden
+		const auto columnar = _table.getColumnar();
+		const bool allVisible = !_table.hasHiddenVersions(_snapshot);
+		std::vector<size_t> visible;
+		for (size_t slot = 0; !allVisible && slot < columnar->getRowCount(); ++slot)
+		{
+			if (_table.isVisible(slot, _snapshot))
+				visible.push_back(slot);
+		}
+
+		row.values.clear();
+		for (const auto& aggregate : _aggregates)
+		{
+			Accumulator accumulator(aggregate.function);
+			if (aggregate.allRows)
+				accumulator.addRows(allVisible ? columnar->getRowCount() : visible.size());
+			else if (aggregate.column != -1 && allVisible)
+				accumulator.addColumn(columnar->getColumn(static_cast<size_t>(aggregate.column)));
+			else if (aggregate.column != -1)
+			{
+				for (size_t slot : visible)
+					accumulator.add(_table.getRow(slot).values[aggregate.column]);
+			}
+			row.values.push_back(accumulator.result());
+		}
+		return true;
+	}
+
+	void ColumnarAggregateOperator::close()
+	{}
+
+	SortOperator::SortOperator(
+		std::unique_ptr<Operator> input,
+		std::vector<SortKey> keys,
+		std::vector<Xale::DataStructure::ColumnDefinition> schema,
+		size_t memoryBudget)
+		: _input(std::move(input)), _keys(std::move(keys)), _schema(std::move(schema)), _memoryBudget(memoryBudget)
+	{}
+
+	void SortOperator::open()
+	{
+		_input->open();
+		_rows.clear();
+		_runs.clear();
+		_heap.clear();
+		_position = 0;
+
+		Xale::DataStructure::Row row;
+		size_t memory = 0;
+		while (_input->next(row))
+		{
+			memory += rowMemory(row);
+			_rows.push_back(std::move(row));
+
+			if (memory > _memoryBudget)
+			{
+				spillRun();
+				memory = 0;
+			}
+		}
+
+		auto less = [this](const Xale::DataStructure::Row& a, const Xale::DataStructure::Row& b) { return rowLess(_keys, a, b); };
+		if (_runs.empty())
+		{
+			std::stable_sort(_rows.begin(), _rows.end(), less);
+			return;
+		}
+
+		if (!_rows.empty())
+			spillRun();
+
+		// Merge the runs, starting from their first row
+		for (size_t r = 0; r < _runs.size(); ++r)
+		{
+			if (readHead(_runs[r]))
+				_heap.push_back(r);
+		}
+		std::make_heap(_heap.begin(), _heap.end(), [this](size_t a, size_t b) { return runAfter(a, b); });
+	}
+
+	bool SortOperator::next(Xale::DataStructure::Row& row)
+	{
+		if (_runs.empty())
+		{
+			if (_position >= _rows.size())
+				return false;
+			row = std::move(_rows[_position++]);
+			return true;
+		}
+
+		if (_heap.empty())
+			return false;
+
+		auto after = [this](size_t a, size_t b) { return runAfter(a, b); };
+		std::pop_heap(_heap.begin(), _heap.end(), after);
+
+		Run& run = _runs[_heap.back()];
+		row = std::move(run.head);
+		if (readHead(run))
+			std::push_heap(_heap.begin(), _heap.end(), after);
+		else
+			_heap.pop_back();
+		return true;
+	}
+
+	void SortOperator::close()
+	{
+		_input->close();
+		_rows.clear();
+		_runs.clear();
+		_heap.clear();
+	}
+
+	size_t SortOperator::getRunCount() const
+	{
+		return _runs.size();
+	}
+
+	void SortOperator::spillRun()
+	{
+		std::stable_sort(_rows.begin(), _rows.end(), [this](const Xale::DataStructure::Row& a, const Xale::DataStructure::Row& b) {
+			return rowLess(_keys, a, b);
+		});
+
+		Run run;
+		run.file.reset(std::tmpfile());
+		if (!run.file)
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::WriteFile, "Cannot create a sort run file");
+
+		// Every row is written as its size followed by its serialized values
+		for (const auto& row : _rows)
+		{
+			const std::vector<char> data = Xale::DataStructure::Table::serializeRow(row);
+			const uint32_t size = static_cast<uint32_t>(data.size());
+
+			if (std::fwrite(&size, sizeof(size), 1, run.file.get()) != 1
+				|| (size && std::fwrite(data.data(), size, 1, run.file.get()) != 1))
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::WriteFile, "Cannot write a sort run file");
+		}
+
+		std::rewind(run.file.get());
+		_runs.push_back(std::move(run));
+		_rows.clear();
+	}
+
+	bool SortOperator::readHead(Run& run)
+	{
+		uint32_t size = 0;
+		if (std::fread(&size, sizeof(size), 1, run.file.get()) != 1)
+			return false;
+
+		std::vector<char> data(size);
+		if (size && std::fread(data.data(), size, 1, run.file.get()) != 1)
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Cannot read a sort run file");
+
+		run.head = Xale::DataStructure::Table::deserializeRow(data.data(), size, _schema);
+		return true;
+	}
+
+	bool SortOperator::runAfter(size_t a, size_t b) const
+	{
+		// Runs hold consecutive input rows, the earlier run wins ties
+		const auto& headA = _runs[a].head;
+		const auto& headB = _runs[b].head;
+		if (rowLess(_keys, headB, headA))
+			return true;
+		return !rowLess(_keys, headA, headB) && a > b;
+	}
+
+	TopKSortOperator::TopKSortOperator(std::unique_ptr<Operator> input, std::vector<SortKey> keys, size_t count)
+		: _input(std::move(input)), _keys(std::move(keys)), _count(count)
+	{}
+
+	void TopKSortOperator::open()
+	{
+		_input->open();
+		_heap.clear();
+		_position = 0;
+
+		if (_count == 0)
+			return;
+
+		auto less = [this](const Entry& a, const Entry& b) { return entryLess(a, b); };
+		Xale::DataStructure::Row row;
+		size_t sequence = 0;
+
+		while (_input->next(row))
+		{
+			// A row equal to the last one kept comes after it in the input
+			if (_heap.size() < _count)
+			{
+				_heap.push_back({ std::move(row), sequence });
+				std::push_heap(_heap.begin(), _heap.end(), less);
+			}
+			else if (rowLess(_keys, row, _heap.front().row))
+			{
+				std::pop_heap(_heap.begin(), _heap.end(), less);
+				_heap.back() = { std::move(row), sequence };
+				std::push_heap(_heap.begin(), _heap.end(), less);
+			}
+			++sequence;
+		}
+
+		std::sort_heap(_heap.begin(), _heap.end(), less);
+	}
+
+	bool TopKSortOperator::next(Xale::DataStructure::Row& row)
+	{
+		if (_position >= _heap.size())
+			return false;
+
+		row = std::move(_heap[_position++].row);
+		return true;
+	}
+
+	void TopKSortOperator::close()
+	{
+		_input->close();
+		_heap.clear();
+	}
+
+	bool TopKSortOperator::entryLess(const Entry& a, const Entry& b) const
+	{
+		if (rowLess(_keys, a.row, b.row))
+			return true;
+		return !rowLess(_keys, b.row, a.row) && a.sequence < b.sequence;
+	}
+
+	HashJoinOperator::HashJoinOperator(std::unique_ptr<Operator> left, size_t leftColumn, std::unique_ptr<Operator> right, size_t rightColumn, bool buildLeft)
+		: _left(std::move(left)), _right(std::move(right)), _leftColumn(leftColumn), _rightColumn(rightColumn), _buildLeft(buildLeft)
+	{}
+
+	void HashJoinOperator::open()
+	{
+		Operator& build = _buildLeft ? *_left : *_right;
+		const size_t buildColumn = _buildLeft ? _leftColumn : _rightColumn;
+
+		_left->open();
+		_right->open();
+
+		Xale::DataStructure::Row row;
+		while (build.next(row))
+		{
+			_table[row.values[buildColumn]].push_back(_built.size());
+			_built.push_back(std::move(row));
+		}
+
+		_matches = nullptr;
+		_position = 0;
+	}
+
+	bool HashJoinOperator::next(Xale::DataStructure::Row& row)
+	{
+		Operator& probe = _buildLeft ? *_right : *_left;
+		const size_t probeColumn = _buildLeft ? _rightColumn : _leftColumn;
+
+		while (!_matches || _position >= _matches->size())
+		{
+			if (!probe.next(_probeRow))
+				return false;
+
+			auto it = _table.find(_probeRow.values[probeColumn]);
+			_matches = it != _table.end() ? &it->second : nullptr;
+			_position = 0;
+		}
+
+		const auto& built = _built[(*_matches)[_position++]];
+		if (_buildLeft)
+			mergeRows(built, _probeRow, row);
+		else
+			mergeRows(_probeRow, built, row);
+		return true;
+	}
+
+	void HashJoinOperator::close()
+	{
+		_left->close();
+		_right->close();
+		_table.clear();
+		_built.clear();
+		_matches = nullptr;
+	}
+
+	IndexNestedLoopJoinOperator::IndexNestedLoopJoinOperator(
+		std::unique_ptr<Operator> left,
+		size_t leftColumn,
+		const Xale::DataStructure::Table& right,
+		size_t rightColumn,
+		std::vector<size_t> rightColumns,
+		Xale::DataStructure::Snapshot snapshot)
+		: _left(std::move(left)), _leftColumn(leftColumn), _right(right), _rightColumn(rightColumn), _rightColumns(std::move(rightColumns)),
+		  _snapshot(snapshot)
+	{}
+
+	void IndexNestedLoopJoinOperator::open()
+	{
+		_left->open();
+		_slots.clear();
+		_position = 0;
+	}
+
+	bool IndexNestedLoopJoinOperator::next(Xale::DataStructure::Row& row)
+	{
+		const std::string& columnName = _right.getSchema()[_rightColumn].name;
+
+		while (true)
+		{
+			while (_position >= _slots.size())
+			{
+				if (!_left->next(_leftRow))
+					return false;
+
+				// The index compares integers and floats by value, like the join
+				const Xale::DataStructure::FieldValue& key = _leftRow.values[_leftColumn];
+				_slots = _right.findSlotsInRange(columnName, &key, true, &key, true, _snapshot);
+				_position = 0;
+			}
+
+			const auto& rightRow = _right.getRow(_slots[_position++]);
+			if (!joinValuesEqual(_leftRow.values[_leftColumn], rightRow.values[_rightColumn]))
+				continue;
+
+			row.values.clear();
+			row.values.reserve(_leftRow.values.size() + _rightColumns.size());
+			row.values.insert(row.values.end(), _leftRow.values.begin(), _leftRow.values.end());
+			readColumns(rightRow, _rightColumns, row.values);
+			return true;
+		}
+	}
+
+	void IndexNestedLoopJoinOperator::close()
+	{
+		_left->close();
+		_slots.clear();
+	}
+
+	SortMergeJoinOperator::SortMergeJoinOperator(
+		const Xale::DataStructure::Table& left,
+		std::vector<size_t> leftColumns,
+		size_t leftColumn,
+		const Xale::DataStructure::Table& right,
+		std::vector<size_t> rightColumns,
+		size_t rightColumn,
+		Xale::DataStructure::Snapshot snapshot)
+		: _left(left), _leftColumns(std::move(leftColumns)), _leftColumn(leftColumn),
+		  _right(right), _rightColumns(std::move(rightColumns)), _rightColumn(rightColumn), _snapshot(snapshot)
+	{}
+
+	void SortMergeJoinOperator::open()
+	{
+		_leftOrder = _left.findSlotsInKeyOrder(_left.getSchema()[_leftColumn].name, _snapshot);
+		_rightOrder = _right.findSlotsInKeyOrder(_right.getSchema()[_rightColumn].name, _snapshot);
+		_l = _r = _leftEnd = _rightEnd = _i = _j = 0;
+	}
+
+	bool SortMergeJoinOperator::next(Xale::DataStructure::Row& row)
+	{
+		Xale::DataStructure::FieldValueLess less;
+
+		while (true)
+		{
+			// Join the rows of the current key, pair by pair
+			while (_i < _leftEnd)
+			{
+				if (_j >= _rightEnd)
+				{
+					++_i;
+					_j = _r;
+					continue;
+				}
+
+				const auto& leftRow = _left.getRow(_leftOrder[_i]);
+				const auto& rightRow = _right.getRow(_rightOrder[_j++]);
+				if (!joinValuesEqual(leftRow.values[_leftColumn], rightRow.values[_rightColumn]))
+					continue;
+
+				row.values.clear();
+				row.values.reserve(_leftColumns.size() + _rightColumns.size());
+				readColumns(leftRow, _leftColumns, row.values);
+				readColumns(rightRow, _rightColumns, row.values);
+				return true;
+			}
+
+			if (_leftEnd > _l)
+			{
+				_l = _leftEnd;
+				_r = _rightEnd;
+			}
+
+			// Find the next key held by both tables
+			while (_l < _leftOrder.size() && _r < _rightOrder.size())
+			{
+				const auto& leftKey = _left.getRow(_leftOrder[_l]).values[_leftColumn];
+				const auto& rightKey = _right.getRow(_rightOrder[_r]).values[_rightColumn];
+
+				if (less(leftKey, rightKey))
+					++_l;
+				else if (less(rightKey, leftKey))
+					++_r;
+				else
+					break;
+			}
+
+			if (_l >= _leftOrder.size() || _r >= _rightOrder.size())
+				return false;
+
+			const auto& leftKey = _left.getRow(_leftOrder[_l]).values[_leftColumn];
+			const auto& rightKey = _right.getRow(_rightOrder[_r]).values[_rightColumn];
+
+			_leftEnd = _l + 1;
+			while (_leftEnd < _leftOrder.size() && !less(leftKey, _left.getRow(_leftOrder[_leftEnd]).values[_leftColumn]))
+				++_leftEnd;
+			_rightEnd = _r + 1;
+			while (_rightEnd < _rightOrder.size() && !less(rightKey, _right.getRow(_rightOrder[_rightEnd]).values[_rightColumn]))
+				++_rightEnd;
+
+			_i = _l;
+			_j = _r;
+		}
+	}
+
+	void SortMergeJoinOperator::close()
+	{
+		_leftOrder.clear();
+		_rightOrder.clear();
+	}
+}
@@ -0,0 +1,377 @@
+#include "Execution/Predicate.h"
+#include "Execution/Join.h"
+#include "Execution/QueryPlanner.h"
+#include "Core/ExceptionHandler.h"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_set>
+
+namespace Xale::Execution
+{
+	namespace
+	{
+		using Xale::DataStructure::FieldValue;
+		using Xale::DataStructure::Row;
+		using Xale::Query::Expression;
+		using Xale::Query::ExpressionType;
+
+		/**
+		 * @brief Number of literals of an IN list from which they are looked up in a hash set
+		 */
+		constexpr size_t IN_HASH_THRESHOLD = 8;
+
+		bool isLiteral(const Expression& expr)
+		{
+			return expr.type == ExpressionType::NumericLiteral || expr.type == ExpressionType::StringLiteral;
+		}
+
+		bool isComparison(const Expression& expr, CompareOp& op)
+		{
+			return expr.type == ExpressionType::BinaryOp && expr.binary && parseCompareOp(expr.binary->op, op);
+		}
+
+		bool isLogical(const Expression& expr, const char* op)
+		{
+			return expr.type == ExpressionType::BinaryOp && expr.binary && expr.binary->op == op;
+		}
+
+		CompareOp reverse(CompareOp op)
+		{
+			switch (op)
+			{
+				case CompareOp::Less: return CompareOp::Greater;
+				case CompareOp::LessEqual: return CompareOp::GreaterEqual;
+				case CompareOp::Greater: return CompareOp::Less;
+				case CompareOp::GreaterEqual: return CompareOp::LessEqual;
+				default: return op;
+			}
+		}
+
+		RowPredicate constant(bool result)
+		{
+			return [result](const Row&) { return result; };
+		}
+
+		template <typename T, typename Compare>
+		RowPredicate compareTyped(size_t column, T literal)
+		{
+			// Values of another type never match, like compareValues()
+			return [column, literal](const Row& row) {
+				const T* value = std::get_if<T>(&row.values[column]);
+				return value && Compare()(*value, literal);
+			};
+		}
+
+		template <typename T>
+		RowPredicate compareWithLiteral(size_t column, CompareOp op, const T& literal, bool isOrdered)
+		{
+			switch (op)
+			{
+				case CompareOp::Equal:
+					return compareTyped<T, std::equal_to<T>>(column, literal);
+				case CompareOp::NotEqual:
+					return [column, literal](const Row& row) {
+						const T* value = std::get_if<T>(&row.values[column]);
+						return !value || *value != literal;
+					};
+				default:
+					break;
+			}
+
+			if (!isOrdered)
+				return constant(false);
+
+			switch (op)
+			{
+				case CompareOp::Less: return compareTyped<T, std::less<T>>(column, literal);
+				case CompareOp::LessEqual: return compareTyped<T, std::less_equal<T>>(column, literal);
+				case CompareOp::Greater: return compareTyped<T, std::greater<T>>(column, literal);
+				default: return compareTyped<T, std::greater_equal<T>>(column, literal);
+			}
+		}
+
+		/**
+		 * @brief Compare a column, or a literal, with a literal
+		 */
+		RowPredicate compareOperand(const Expression& operand, CompareOp op, const FieldValue& literal, const ColumnResolver& resolve)
+		{
+			if (isLiteral(operand))
+				return constant(compareValues(QueryPlanner::evaluateLiteral(operand), op, literal));
+			if (operand.type != ExpressionType::Identifier)
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Invalid operand in condition");
+
+			const int position = resolve(operand.value);
+			if (position == -1)
+				return constant(false);
+			const size_t column = static_cast<size_t>(position);
+
+			if (std::holds_alternative<int>(literal))
+				return compareWithLiteral(column, op, std::get<int>(literal), true);
+			if (std::holds_alternative<double>(literal))
+				return compareWithLiteral(column, op, std::get<double>(literal), true);
+			if (std::holds_alternative<std::string>(literal))
+				return compareWithLiteral(column, op, std::get<std::string>(literal), false);
+
+			return [column, op, literal](const Row& row) { return compareValues(row.values[column], op, literal); };
+		}
+
+		RowPredicate compileComparison(const Xale::Query::BinaryExpression& binary, CompareOp op, const ColumnResolver& resolve)
+		{
+			const Expression& left = *binary.left;
+			const Expression& right = *binary.right;
+
+			if (isLiteral(right))
+				return compareOperand(left, op, QueryPlanner::evaluateLiteral(right), resolve);
+			if (isLiteral(left))
+				return compareOperand(right, reverse(op), QueryPlanner::evaluateLiteral(left), resolve);
+
+			// Two columns
+			if (left.type != ExpressionType::Identifier || right.type != ExpressionType::Identifier)
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Invalid operand in condition");
+
+			const int a = resolve(left.value);
+			const int b = resolve(right.value);
+			if (a == -1 || b == -1)
+				return constant(false);
+
+			return [a, b, op](const Row& row) { return compareValues(row.values[a], op, row.values[b]); };
+		}
+
+		RowPredicate compileIn(const Expression& expr, const ColumnResolver& resolve)
+		{
+			std::vector<FieldValue> values;
+			for (const auto& item : expr.list)
+				values.push_back(QueryPlanner::evaluateLiteral(item));
+
+			const Expression& operand = *expr.argument;
+			if (isLiteral(operand))
+			{
+				const FieldValue value = QueryPlanner::evaluateLiteral(operand);
+				return constant(std::find(values.begin(), values.end(), value) != values.end());
+			}
+			if (operand.type != ExpressionType::Identifier)
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Invalid operand in condition");
+
+			const int column = resolve(operand.value);
+			if (column == -1)
+				return constant(false);
+
+			// Values are compared exactly, equal values hashing the same
+			if (values.size() >= IN_HASH_THRESHOLD)
+			{
+				std::unordered_set<FieldValue, JoinKeyHash> set(values.begin(), values.end());
+				return [column, set = std::move(set)](const Row& row) { return set.count(row.values[column]) != 0; };
+			}
+
+			return [column, values = std::move(values)](const Row& row) {
+				const FieldValue& value = row.values[column];
+				for (const auto& candidate : values)
+				{
+					if (value == candidate)
+						return true;
+				}
+				return false;
+			};
+		}
+
+		void describe(const Expression& expr, bool nested, std::ostringstream& out)
+		{
+			CompareOp op;
+
+			switch (expr.type)
+			{
+				case ExpressionType::Identifier:
+					out << expr.value;
+					return;
+				case ExpressionType::NumericLiteral:
+				case ExpressionType::StringLiteral:
+					out << formatValue(QueryPlanner::evaluateLiteral(expr));
+					return;
+				case ExpressionType::Not:
+					out << "NOT ";
+					describe(*expr.argument, true, out);
+					return;
+				case ExpressionType::In:
+					describe(*expr.argument, true, out);
+					out << " IN (";
+					for (size_t i = 0; i < expr.list.size(); ++i)
+					{
+						out << (i == 0 ? "" : ", ");
+						describe(expr.list[i], true, out);
+					}
+					out << ")";
+					return;
+				case ExpressionType::Between:
+					describe(*expr.argument, true, out);
+					out << " BETWEEN ";
+					describe(expr.list[0], true, out);
+					out << " AND ";
+					describe(expr.list[1], true, out);
+					return;
+				default:
+					break;
+			}
+
+			if (!expr.binary)
+				return;
+
+			// AND and OR operands are parenthesized, comparisons are not
+			const bool isCondition = !isComparison(expr, op);
+			if (nested && isCondition)
+				out << "(";
+			describe(*expr.binary->left, isCondition, out);
+			out << " " << expr.binary->op << " ";
+			describe(*expr.binary->right, isCondition, out);
+			if (nested && isCondition)
+				out << ")";
+		}
+	}
+
+	RowPredicate compilePredicate(const Xale::Query::Expression& expr, const ColumnResolver& resolve)
+	{
+		CompareOp op;
+
+		switch (expr.type)
+		{
+			case ExpressionType::Not: {
+				RowPredicate operand = compilePredicate(*expr.argument, resolve);
+				return [operand = std::move(operand)](const Row& row) { return !operand(row); };
+			}
+			case ExpressionType::In:
+				return compileIn(expr, resolve);
+			case ExpressionType::Between: {
+				RowPredicate lower = compareOperand(*expr.argument, CompareOp::GreaterEqual, QueryPlanner::evaluateLiteral(expr.list[0]), resolve);
+				RowPredicate upper = compareOperand(*expr.argument, CompareOp::LessEqual, QueryPlanner::evaluateLiteral(expr.list[1]), resolve);
+				return [lower = std::move(lower), upper = std::move(upper)](const Row& row) { return lower(row) && upper(row); };
+			}
+			default:
+				break;
+		}
+
+		if (isComparison(expr, op))
+			return compileComparison(*expr.binary, op, resolve);
+
+		const bool isAnd = isLogical(expr, "AND");
+		if (!isAnd && !isLogical(expr, "OR"))
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Invalid condition");
+
+		RowPredicate left = compilePredicate(*expr.binary->left, resolve);
+		RowPredicate right = compilePredicate(*expr.binary->right, resolve);
+
+		if (isAnd)
+			return [left = std::move(left), right = std::move(right)](const Row& row) { return left(row) && right(row); };
+		return [left = std::move(left), right = std::move(right)](const Row& row) { return left(row) || right(row); };
+	}
+
+	RowPredicate compileConjuncts(const std::vector<const Xale::Query::Expression*>& conjuncts, const ColumnResolver& resolve)
+	{
+		if (conjuncts.empty())
+			return constant(true);
+
+		RowPredicate predicate = compilePredicate(*conjuncts[0], resolve);
+		for (size_t i = 1; i < conjuncts.size(); ++i)
+		{
+			RowPredicate next = compilePredicate(*conjuncts[i], resolve);
+			predicate = [left = std::move(predicate), right = std::move(next)](const Row& row) { return left(row) && right(row); };
+		}
+		return predicate;
+	}
+
+	RowPredicate compileCondition(const BoundCondition& condition)
+	{
+		if (condition.matchesAll)
+			return constant(true);
+		if (condition.column == -1)
+			return constant(false);
+
+		const size_t column = static_cast<size_t>(condition.column);
+		const FieldValue& literal = condition.value;
+
+		if (std::holds_alternative<int>(literal))
+			return compareWithLiteral(column, condition.op, std::get<int>(literal), true);
+		if (std::holds_alternative<double>(literal))
+			return compareWithLiteral(column, condition.op, std::get<double>(literal), true);
+		if (std::holds_alternative<std::string>(literal))
+			return compareWithLiteral(column, condition.op, std::get<std::string>(literal), false);
+
+		return [column, op = condition.op, literal](const Row& row) { return compareValues(row.values[column], op, literal); };
+	}
+
+	bool matchComparison(const Xale::Query::Expression& expr, std::string& column, CompareOp& op, Xale::DataStructure::FieldValue& value)
+	{
+		if (!isComparison(expr, op))
+			return false;
+
+		const Expression& left = *expr.binary->left;
+		const Expression& right = *expr.binary->right;
+
+		if (left.type == ExpressionType::Identifier && isLiteral(right))
+		{
+			column = left.value;
+			value = QueryPlanner::evaluateLiteral(right);
+			return true;
+		}
+
+		if (isLiteral(left) && right.type == ExpressionType::Identifier)
+		{
+			column = right.value;
+			value = QueryPlanner::evaluateLiteral(left);
+			op = reverse(op);
+			return true;
+		}
+
+		return false;
+	}
+
+	void splitConjuncts(const Xale::Query::Expression& expr, std::vector<const Xale::Query::Expression*>& out)
+	{
+		if (isLogical(expr, "AND"))
+		{
+			splitConjuncts(*expr.binary->left, out);
+			splitConjuncts(*expr.binary->right, out);
+			return;
+		}
+
+		out.push_back(&expr);
+	}
+
+	void collectColumns(const Xale::Query::Expression& expr, std::vector<std::string>& out)
+	{
+		if (expr.type == ExpressionType::Identifier)
+			out.push_back(expr.value);
+		if (expr.argument)
+			collectColumns(*expr.argument, out);
+		if (expr.binary)
+		{
+			collectColumns(*expr.binary->left, out);
+			collectColumns(*expr.binary->right, out);
+		}
+	}
+
+	std::string describeConjuncts(const std::vector<const Xale::Query::Expression*>& conjuncts)
+	{
+		std::ostringstream out;
+		for (size_t i = 0; i < conjuncts.size(); ++i)
+		{
+			out << (i == 0 ? "" : " AND ");
+			describe(*conjuncts[i], conjuncts.size() > 1, out);
+		}
+		return out.str();
+	}
+
+	std::string formatValue(const Xale::DataStructure::FieldValue& value)
+	{
+		if (std::holds_alternative<std::string>(value))
+			return "'" + std::get<std::string>(value) + "'";
+		if (std::holds_alternative<std::monostate>(value))
+			return "NULL";
+
+		std::ostringstream out;
+		if (std::holds_alternative<int>(value))
+			out << std::get<int>(value);
+		else
+			out << std::get<double>(value);
+		return out.str();
+	}
+}
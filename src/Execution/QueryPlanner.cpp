@@ -0,0 +1,861 @@
+#include "Execution/QueryPlanner.h"
+#include "Core/ExceptionHandler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace Xale::Execution
+{
+	namespace
+	{
+		/**
+		 * @brief Estimated fraction of the rows matching a condition, when it is not on a unique column
+		 */
+		constexpr double EQUALITY_SELECTIVITY = 0.1;
+		constexpr double RANGE_SELECTIVITY = 0.3;
+		constexpr double INEQUALITY_SELECTIVITY = 0.9;
+
+		/**
+		 * @brief Estimated fraction of the rows starting a new group, when grouping on a column that is not unique
+		 */
+		constexpr double GROUP_SELECTIVITY = 0.1;
+
+		/**
+		 * @brief Column of one of the tables of the query
+		 */
+		struct ColumnRef
+		{
+			size_t relation = 0;
+			size_t column = 0;
+		};
+
+		/**
+		 * @brief Table of the query, in FROM then JOIN order
+		 */
+		struct Relation
+		{
+			const Xale::DataStructure::Table* table;
+			std::string name;
+			std::vector<bool> used; ///< Columns read by the query
+		};
+
+		/**
+		 * @brief Plan of a part of the query, with the origin of each of its columns
+		 */
+		struct SubPlan
+		{
+			std::unique_ptr<PlanNode> node;
+			std::vector<ColumnRef> origins;
+		};
+
+		std::string columnNamePart(const std::string& name)
+		{
+			auto dot = name.rfind('.');
+			return dot != std::string::npos ? name.substr(dot + 1) : name;
+		}
+
+		std::string tableNamePart(const std::string& name)
+		{
+			auto dot = name.rfind('.');
+			return dot != std::string::npos ? name.substr(0, dot) : std::string();
+		}
+
+		int findColumnByName(const std::vector<Xale::DataStructure::ColumnDefinition>& schema, const std::string& name)
+		{
+			for (size_t i = 0; i < schema.size(); ++i)
+			{
+				if (schema[i].name == name)
+					return static_cast<int>(i);
+			}
+
+			return -1;
+		}
+
+		/**
+		 * @brief Resolve "table.column" or "column" among the first relations
+		 *
+		 * A table prefix naming one of the relations selects its column, otherwise
+		 * the first relation with a column of this name is used.
+		 */
+		bool resolveColumn(const std::vector<Relation>& relations, size_t count, const std::string& name, ColumnRef& out)
+		{
+			const std::string column = columnNamePart(name);
+			auto dot = name.rfind('.');
+
+			if (dot != std::string::npos)
+			{
+				const std::string prefix = name.substr(0, dot);
+				for (size_t r = 0; r < count; ++r)
+				{
+					if (relations[r].name != prefix)
+						continue;
+
+					int position = findColumnByName(relations[r].table->getSchema(), column);
+					if (position != -1)
+					{
+						out = { r, static_cast<size_t>(position) };
+						return true;
+					}
+					break;
+				}
+			}
+
+			for (size_t r = 0; r < count; ++r)
+			{
+				int position = findColumnByName(relations[r].table->getSchema(), column);
+				if (position != -1)
+				{
+					out = { r, static_cast<size_t>(position) };
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		int positionOf(const SubPlan& plan, const ColumnRef& ref)
+		{
+			for (size_t i = 0; i < plan.origins.size(); ++i)
+			{
+				if (plan.origins[i].relation == ref.relation && plan.origins[i].column == ref.column)
+					return static_cast<int>(i);
+			}
+
+			return -1;
+		}
+
+		double selectivity(const Xale::DataStructure::Table& table, size_t column, CompareOp op)
+		{
+			switch (op)
+			{
+				case CompareOp::Equal:
+					if (static_cast<int>(column) == table.getPrimaryKeyColumn())
+						return 1.0 / std::max<double>(1.0, static_cast<double>(table.getRowCount()));
+					return EQUALITY_SELECTIVITY;
+				case CompareOp::NotEqual:
+					return INEQUALITY_SELECTIVITY;
+				default:
+					return RANGE_SELECTIVITY;
+			}
+		}
+
+		/**
+		 * @brief Estimate the fraction of the rows matching a condition, its parts being independent
+		 */
+		double conditionSelectivity(const std::vector<Relation>& relations, const Xale::Query::Expression& expr)
+		{
+			using Xale::Query::ExpressionType;
+
+			switch (expr.type)
+			{
+				case ExpressionType::Not:
+					return 1.0 - conditionSelectivity(relations, *expr.argument);
+				case ExpressionType::In:
+					return std::min(1.0, static_cast<double>(expr.list.size()) * EQUALITY_SELECTIVITY);
+				case ExpressionType::Between:
+					return RANGE_SELECTIVITY;
+				default:
+					break;
+			}
+
+			if (expr.type == ExpressionType::BinaryOp && expr.binary && (expr.binary->op == "AND" || expr.binary->op == "OR"))
+			{
+				const double left = conditionSelectivity(relations, *expr.binary->left);
+				const double right = conditionSelectivity(relations, *expr.binary->right);
+				return expr.binary->op == "AND" ? left * right : left + right - left * right;
+			}
+
+			std::string name;
+			CompareOp op = CompareOp::Equal;
+			Xale::DataStructure::FieldValue value;
+			ColumnRef ref;
+
+			if (matchComparison(expr, name, op, value) && resolveColumn(relations, relations.size(), name, ref))
+				return selectivity(*relations[ref.relation].table, ref.column, op);
+
+			return op == CompareOp::Equal ? EQUALITY_SELECTIVITY : op == CompareOp::NotEqual ? INEQUALITY_SELECTIVITY : RANGE_SELECTIVITY;
+		}
+
+		/**
+		 * @brief Number of distinct values of a column, known for the primary key only
+		 * @return Number of rows of the table for the primary key, 0 otherwise
+		 */
+		double distinctValues(const std::vector<Relation>& relations, const ColumnRef& ref)
+		{
+			const auto& table = *relations[ref.relation].table;
+			if (table.getPrimaryKeyColumn() != static_cast<int>(ref.column))
+				return 0;
+			return std::max<double>(1.0, static_cast<double>(table.getRowCount()));
+		}
+
+		/**
+		 * @brief Estimate the size of a join
+		 *
+		 * Every row matches at most one row of a side joined on its primary key,
+		 * found among the rows kept of this side.
+		 */
+		double estimateJoin(double left, double right, double leftDistinct, double rightDistinct)
+		{
+			double estimate = std::max(left, right);
+			if (rightDistinct > 0)
+				estimate = left * std::min(1.0, right / rightDistinct);
+			else if (leftDistinct > 0)
+				estimate = right * std::min(1.0, left / leftDistinct);
+			return std::min(estimate, left * right);
+		}
+
+		const char* nodeName(const PlanNode& node)
+		{
+			switch (node.type)
+			{
+				case PlanNodeType::Scan: return "Scan";
+				case PlanNodeType::IndexScan: return "IndexScan";
+				case PlanNodeType::Filter: return "Filter";
+				case PlanNodeType::Project: return "Project";
+				case PlanNodeType::Limit: return "Limit";
+				case PlanNodeType::Aggregate: return "HashAggregate";
+				case PlanNodeType::Sort:
+					switch (node.sortStrategy)
+					{
+						case SortStrategy::TopK: return "TopKSort";
+						case SortStrategy::External: return "ExternalSort";
+						default: return "Sort";
+					}
+				default:
+					switch (node.strategy)
+					{
+						case JoinStrategy::IndexNestedLoop: return "IndexNestedLoopJoin";
+						case JoinStrategy::SortMerge: return "SortMergeJoin";
+						default: return "HashJoin";
+					}
+			}
+		}
+
+		void describe(const PlanNode& node, size_t depth, std::vector<std::string>& lines)
+		{
+			std::ostringstream line;
+			line << std::string(depth * 2, ' ') << nodeName(node) << " " << node.detail
+				<< " (rows: " << std::llround(node.estimatedRows) << ")";
+			lines.push_back(line.str());
+
+			for (const auto& child : node.children)
+				describe(*child, depth + 1, lines);
+		}
+	}
+
+	QueryPlanner::QueryPlanner(TableManager& tableManager)
+		: _tableManager(tableManager)
+	{}
+
+	std::unique_ptr<PlanNode> QueryPlanner::planSelect(const Xale::Query::SelectStatement& stmt)
+	{
+		// Tables, in FROM then JOIN order
+		std::vector<Relation> relations;
+
+		auto* table = _tableManager.getTable(stmt.tableName);
+		if (!table)
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::Unknown, "Table does not exist");
+		relations.push_back({ table, stmt.tableName, {} });
+
+		for (const auto& join : stmt.joins)
+		{
+			auto* joinTable = _tableManager.getTable(join.tableName);
+			if (!joinTable)
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "JOIN table does not exist: " + join.tableName);
+			relations.push_back({ joinTable, join.tableName, {} });
+		}
+
+		for (auto& relation : relations)
+			relation.used.assign(relation.table->getColumnCount(), false);
+
+		// Join conditions: the left column refers to one of the previous tables
+		struct Edge
+		{
+			ColumnRef left;
+			ColumnRef right;
+			bool resolved;
+			std::string label;
+		};
+
+		std::vector<Edge> edges;
+		bool edgesResolved = true;
+
+		for (size_t i = 0; i < stmt.joins.size(); ++i)
+		{
+			const auto& join = stmt.joins[i];
+			Edge edge{ {}, {}, false, join.leftTableCol + " = " + join.rightTableCol };
+
+			// "JOIN b ON b.id = a.bid" names the joined table on the left side
+			std::string leftName = join.leftTableCol;
+			std::string rightName = join.rightTableCol;
+			if (tableNamePart(leftName) == relations[i + 1].name && tableNamePart(rightName) != relations[i + 1].name)
+				std::swap(leftName, rightName);
+
+			int rightColumn = findColumnByName(relations[i + 1].table->getSchema(), columnNamePart(rightName));
+			if (rightColumn != -1 && resolveColumn(relations, i + 1, leftName, edge.left))
+			{
+				edge.right = { i + 1, static_cast<size_t>(rightColumn) };
+				edge.resolved = true;
+				relations[edge.left.relation].used[edge.left.column] = true;
+				relations[edge.right.relation].used[edge.right.column] = true;
+			}
+
+			edgesResolved = edgesResolved && edge.resolved;
+			edges.push_back(edge);
+		}
+
+		// WHERE condition, split into the conditions joined by AND, each pushed down to the only table it reads
+		struct Conjunct
+		{
+			const Xale::Query::Expression* expr;
+			int relation;         ///< Table read, -1 for a condition on several tables, on none, or on unknown columns
+			bool isComparison;    ///< Comparison of a column with a literal
+			ColumnRef column;
+			CompareOp op;
+			Xale::DataStructure::FieldValue value;
+		};
+
+		std::vector<Conjunct> conjuncts;
+		if (stmt.where && stmt.where->condition)
+		{
+			std::vector<const Xale::Query::Expression*> parts;
+			splitConjuncts(*stmt.where->condition, parts);
+
+			for (const auto* part : parts)
+			{
+				Conjunct conjunct{ part, -1, false, {}, CompareOp::Equal, {} };
+				std::vector<std::string> names;
+				collectColumns(*part, names);
+
+				bool resolved = true;
+				std::vector<size_t> read;
+				for (const auto& name : names)
+				{
+					ColumnRef ref;
+					if (!resolveColumn(relations, relations.size(), name, ref))
+					{
+						resolved = false;
+						continue;
+					}
+
+					relations[ref.relation].used[ref.column] = true;
+					if (std::find(read.begin(), read.end(), ref.relation) == read.end())
+						read.push_back(ref.relation);
+				}
+
+				if (resolved && read.size() == 1)
+				{
+					std::string name;
+					conjunct.relation = static_cast<int>(read[0]);
+					conjunct.isComparison = matchComparison(*part, name, conjunct.op, conjunct.value)
+						&& resolveColumn(relations, relations.size(), name, conjunct.column);
+				}
+
+				conjuncts.push_back(conjunct);
+			}
+		}
+
+		// Output columns, unknown columns being NULL
+		const bool isWildcard = stmt.columns.size() == 1 && stmt.columns[0].type == Xale::Query::ExpressionType::Wildcard;
+		std::vector<Xale::DataStructure::ColumnDefinition> outputSchema;
+		std::vector<std::pair<bool, ColumnRef>> outputColumns;
+		std::string outputLabel;
+
+		// Aggregation: every row of the output is a group, found by the values of the GROUP BY columns
+		bool isAggregate = !stmt.groupBy.empty();
+		for (const auto& column : stmt.columns)
+			isAggregate = isAggregate || column.type == Xale::Query::ExpressionType::Aggregate;
+		for (const auto& item : stmt.orderBy)
+			isAggregate = isAggregate || item.expression.type == Xale::Query::ExpressionType::Aggregate;
+
+		if (isAggregate && isWildcard)
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "SELECT * cannot be used with GROUP BY or aggregate functions");
+
+		std::vector<std::pair<bool, ColumnRef>> groupColumns;
+		std::vector<std::pair<bool, ColumnRef>> aggregateColumns;
+		std::vector<AggregateSpec> aggregates;
+		std::vector<Xale::DataStructure::ColumnDefinition> aggregateSchema;
+		std::vector<int> aggregateProjection; ///< Position in the aggregated rows of every output column
+
+		for (const auto& name : stmt.groupBy)
+		{
+			ColumnRef ref;
+			bool resolved = resolveColumn(relations, relations.size(), name, ref);
+			auto type = resolved ? relations[ref.relation].table->getSchema()[ref.column].type : Xale::DataStructure::FieldType::String;
+
+			if (resolved)
+				relations[ref.relation].used[ref.column] = true;
+			aggregateSchema.push_back(Xale::DataStructure::ColumnDefinition(columnNamePart(name), type));
+			groupColumns.push_back({ resolved, ref });
+		}
+
+		// A column outside of an aggregate function must be one of the GROUP BY columns
+		auto findGroup = [&](const std::string& name) {
+			for (size_t g = 0; g < stmt.groupBy.size(); ++g)
+			{
+				ColumnRef ref;
+				if (stmt.groupBy[g] == name
+					|| (groupColumns[g].first && resolveColumn(relations, relations.size(), name, ref)
+						&& ref.relation == groupColumns[g].second.relation && ref.column == groupColumns[g].second.column))
+					return static_cast<int>(g);
+			}
+
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Column must appear in GROUP BY: " + name);
+		};
+
+		// Position in the aggregated rows of an aggregate function, computed once however often it is used
+		auto findAggregate = [&](const Xale::Query::Expression& expr) {
+			AggregateSpec spec;
+			parseAggregateFunction(expr.value, spec.function);
+			spec.allRows = expr.argument->type == Xale::Query::ExpressionType::Wildcard;
+			spec.name = expr.value + "(" + expr.argument->value + ")";
+
+			for (size_t a = 0; a < aggregates.size(); ++a)
+			{
+				if (aggregates[a].name == spec.name)
+					return static_cast<int>(groupColumns.size() + a);
+			}
+
+			ColumnRef ref;
+			bool resolved = !spec.allRows && resolveColumn(relations, relations.size(), expr.argument->value, ref);
+			auto type = resolved ? relations[ref.relation].table->getSchema()[ref.column].type : Xale::DataStructure::FieldType::String;
+
+			if (resolved)
+				relations[ref.relation].used[ref.column] = true;
+
+			// COUNT is always an integer and AVG a float, SUM keeps integers when the column holds them
+			if (spec.function == AggregateFunction::Count)
+				type = Xale::DataStructure::FieldType::Integer;
+			else if (spec.function == AggregateFunction::Avg
+				|| (spec.function == AggregateFunction::Sum && type != Xale::DataStructure::FieldType::Integer))
+				type = Xale::DataStructure::FieldType::Float;
+
+			aggregateSchema.push_back(Xale::DataStructure::ColumnDefinition(spec.name, type));
+			aggregateColumns.push_back({ resolved, ref });
+			aggregates.push_back(spec);
+			return static_cast<int>(aggregateSchema.size() - 1);
+		};
+
+		for (size_t i = 0; i < stmt.columns.size() && isAggregate; ++i)
+		{
+			const auto& column = stmt.columns[i];
+			const int position = column.type == Xale::Query::ExpressionType::Aggregate ? findAggregate(column) : findGroup(column.value);
+
+			outputSchema.push_back(aggregateSchema[position]);
+			aggregateProjection.push_back(position);
+			outputLabel += (i == 0 ? "" : ", ") + outputSchema.back().name;
+		}
+
+		// ORDER BY keys: columns of the tables, or columns of the aggregated rows
+		std::vector<std::pair<bool, ColumnRef>> orderColumns;
+		std::vector<SortKey> aggregateSortKeys;
+		std::string orderLabel;
+
+		for (const auto& item : stmt.orderBy)
+		{
+			const auto& key = item.expression;
+			std::string name = key.value;
+
+			if (!isAggregate)
+			{
+				ColumnRef ref;
+				bool resolved = resolveColumn(relations, relations.size(), key.value, ref);
+				if (resolved)
+					relations[ref.relation].used[ref.column] = true;
+				orderColumns.push_back({ resolved, ref });
+			}
+			else
+			{
+				const int position = key.type == Xale::Query::ExpressionType::Aggregate ? findAggregate(key) : findGroup(key.value);
+				aggregateSortKeys.push_back({ position, item.descending });
+				name = aggregateSchema[position].name;
+			}
+
+			orderLabel += (orderLabel.empty() ? "" : ", ") + name + (item.descending ? " desc" : "");
+		}
+
+		// A single table sorted on an indexed column is read in the order of its index
+		bool readsInIndexOrder = !isAggregate && relations.size() == 1 && orderColumns.size() == 1 && orderColumns[0].first
+			&& relations[0].table->isIndexed(relations[0].table->getSchema()[orderColumns[0].second.column].name);
+
+		for (size_t r = 0; r < relations.size() && isWildcard; ++r)
+		{
+			const auto& schema = relations[r].table->getSchema();
+			for (size_t c = 0; c < schema.size(); ++c)
+			{
+				relations[r].used[c] = true;
+				outputSchema.push_back(schema[c]);
+				outputColumns.push_back({ true, { r, c } });
+			}
+		}
+
+		for (size_t i = 0; i < stmt.columns.size() && !isWildcard && !isAggregate; ++i)
+		{
+			const std::string& name = stmt.columns[i].value;
+			ColumnRef ref;
+			bool resolved = resolveColumn(relations, relations.size(), name, ref);
+			auto type = resolved ? relations[ref.relation].table->getSchema()[ref.column].type : Xale::DataStructure::FieldType::String;
+
+			if (resolved)
+				relations[ref.relation].used[ref.column] = true;
+			outputSchema.push_back(Xale::DataStructure::ColumnDefinition(columnNamePart(name), type));
+			outputColumns.push_back({ resolved, ref });
+			outputLabel += (i == 0 ? "" : ", ") + name;
+		}
+
+		if (isWildcard)
+			outputLabel = "*";
+
+		// Read every table, with the condition pushed down to its table
+		auto planRelation = [&](size_t r) {
+			const Relation& relation = relations[r];
+			const auto& schema = relation.table->getSchema();
+			SubPlan plan;
+
+			auto scan = std::make_unique<PlanNode>(PlanNodeType::Scan);
+			scan->table = relation.table;
+			scan->estimatedRows = static_cast<double>(relation.table->getRowCount());
+
+			std::string columnList;
+			for (size_t c = 0; c < schema.size(); ++c)
+			{
+				if (!relation.used[c])
+					continue;
+				columnList += (scan->columns.empty() ? "" : ", ") + schema[c].name;
+				scan->columns.push_back(c);
+				scan->schema.push_back(schema[c]);
+				plan.origins.push_back({ r, c });
+			}
+			scan->detail = relation.name + " [" + columnList + "]";
+
+			// An indexed comparison is looked up in its index, the first comparison filters the columnar copy of the table
+			const Conjunct* access = nullptr;
+			for (const auto& conjunct : conjuncts)
+			{
+				if (conjunct.relation == static_cast<int>(r) && conjunct.isComparison && conjunct.op != CompareOp::NotEqual
+					&& relation.table->isIndexed(schema[conjunct.column.column].name))
+				{
+					access = &conjunct;
+					break;
+				}
+			}
+
+			const bool isIndexScan = access != nullptr;
+			for (size_t c = 0; c < conjuncts.size() && !access; ++c)
+			{
+				if (conjuncts[c].relation == static_cast<int>(r) && conjuncts[c].isComparison)
+					access = &conjuncts[c];
+			}
+
+			std::vector<const Xale::Query::Expression*> residual;
+			double residualSelectivity = 1.0;
+			for (const auto& conjunct : conjuncts)
+			{
+				if (conjunct.relation != static_cast<int>(r) || &conjunct == access)
+					continue;
+				residual.push_back(conjunct.expr);
+				residualSelectivity *= conditionSelectivity(relations, *conjunct.expr);
+			}
+
+			// An index lookup gives its rows in slot order, the rows are then sorted
+			if (readsInIndexOrder && isIndexScan)
+				readsInIndexOrder = false;
+			else if (readsInIndexOrder)
+			{
+				scan->sortKeys.push_back({ static_cast<int>(orderColumns[0].second.column), stmt.orderBy[0].descending });
+				scan->detail += " in index order of " + orderLabel;
+			}
+
+			plan.node = std::move(scan);
+
+			if (access)
+			{
+				const size_t column = access->column.column;
+				const double rows = plan.node->estimatedRows * selectivity(*relation.table, column, access->op);
+				const std::string label = describeConjuncts({ access->expr });
+
+				if (isIndexScan)
+				{
+					plan.node->type = PlanNodeType::IndexScan;
+					plan.node->condition = { false, static_cast<int>(column), access->op, access->value };
+					plan.node->estimatedRows = rows;
+					plan.node->detail += " where " + label;
+				}
+				else
+				{
+					auto filter = std::make_unique<PlanNode>(PlanNodeType::Filter);
+					filter->schema = plan.node->schema;
+					filter->condition = { false, positionOf(plan, access->column), access->op, access->value };
+					filter->predicate = compileCondition(filter->condition);
+					filter->estimatedRows = rows;
+					filter->detail = label;
+					filter->children.push_back(std::move(plan.node));
+					plan.node = std::move(filter);
+				}
+			}
+
+			if (residual.empty())
+				return plan;
+
+			// The other conditions on the table are compiled over the columns read
+			auto filter = std::make_unique<PlanNode>(PlanNodeType::Filter);
+			filter->schema = plan.node->schema;
+			filter->predicate = compileConjuncts(residual, [&](const std::string& name) {
+				ColumnRef ref;
+				return resolveColumn(relations, relations.size(), name, ref) ? positionOf(plan, ref) : -1;
+			});
+			filter->estimatedRows = plan.node->estimatedRows * residualSelectivity;
+			filter->detail = describeConjuncts(residual);
+			filter->children.push_back(std::move(plan.node));
+			plan.node = std::move(filter);
+			return plan;
+		};
+
+		auto joinPlans = [&](SubPlan left, SubPlan right, const Edge& edge, const ColumnRef& leftRef, const ColumnRef& rightRef) {
+			auto join = std::make_unique<PlanNode>(PlanNodeType::Join);
+			const PlanNode& leftNode = *left.node;
+			const PlanNode& rightNode = *right.node;
+
+			join->detail = edge.label;
+			join->schema = leftNode.schema;
+			join->schema.insert(join->schema.end(), rightNode.schema.begin(), rightNode.schema.end());
+
+			if (edge.resolved)
+			{
+				join->leftColumn = positionOf(left, leftRef);
+				join->rightColumn = positionOf(right, rightRef);
+				join->estimatedRows = estimateJoin(leftNode.estimatedRows, rightNode.estimatedRows,
+					distinctValues(relations, leftRef), distinctValues(relations, rightRef));
+
+				// Tables are read in key order through the index of their join column
+				const bool leftOrdered = leftNode.type == PlanNodeType::Scan
+					&& leftNode.table->isIndexed(leftNode.table->getSchema()[leftRef.column].name);
+				const bool rightIndexed = rightNode.type == PlanNodeType::Scan
+					&& rightNode.table->isIndexed(rightNode.table->getSchema()[rightRef.column].name);
+
+				join->strategy = chooseJoinStrategy(
+					static_cast<size_t>(leftNode.estimatedRows),
+					leftOrdered,
+					static_cast<size_t>(rightNode.estimatedRows),
+					rightIndexed);
+			}
+
+			SubPlan joined;
+			joined.origins = left.origins;
+			joined.origins.insert(joined.origins.end(), right.origins.begin(), right.origins.end());
+			join->children.push_back(std::move(left.node));
+			join->children.push_back(std::move(right.node));
+			joined.node = std::move(join);
+			return joined;
+		};
+
+		std::vector<SubPlan> leaves;
+		for (size_t r = 0; r < relations.size(); ++r)
+			leaves.push_back(planRelation(r));
+
+		SubPlan current;
+
+		if (!edgesResolved)
+		{
+			// A join on an unknown column matches nothing, keep the written order
+			current = std::move(leaves[0]);
+			for (size_t i = 0; i < edges.size(); ++i)
+				current = joinPlans(std::move(current), std::move(leaves[i + 1]), edges[i], edges[i].left, edges[i].right);
+		}
+		else
+		{
+			// Start with the smallest input, then join the table giving the smallest result
+			std::vector<bool> joined(relations.size(), false);
+			size_t start = 0;
+			for (size_t r = 1; r < leaves.size(); ++r)
+			{
+				if (leaves[r].node->estimatedRows < leaves[start].node->estimatedRows)
+					start = r;
+			}
+
+			current = std::move(leaves[start]);
+			joined[start] = true;
+
+			for (size_t step = 1; step < relations.size(); ++step)
+			{
+				const Edge* bestEdge = nullptr;
+				size_t bestRelation = 0;
+				double bestRows = 0;
+
+				for (const auto& edge : edges)
+				{
+					if (joined[edge.left.relation] == joined[edge.right.relation])
+						continue;
+
+					const ColumnRef& existing = joined[edge.left.relation] ? edge.left : edge.right;
+					const ColumnRef& added = joined[edge.left.relation] ? edge.right : edge.left;
+					double rows = estimateJoin(current.node->estimatedRows, leaves[added.relation].node->estimatedRows,
+						distinctValues(relations, existing), distinctValues(relations, added));
+
+					if (!bestEdge || rows < bestRows || (rows == bestRows && added.relation < bestRelation))
+					{
+						bestEdge = &edge;
+						bestRelation = added.relation;
+						bestRows = rows;
+					}
+				}
+
+				const bool addsRight = joined[bestEdge->left.relation];
+				current = joinPlans(std::move(current), std::move(leaves[bestRelation]), *bestEdge,
+					addsRight ? bestEdge->left : bestEdge->right,
+					addsRight ? bestEdge->right : bestEdge->left);
+				joined[bestRelation] = true;
+			}
+		}
+
+		// Conditions on several tables are evaluated on the joined rows, unknown columns matching nothing
+		std::vector<const Xale::Query::Expression*> remaining;
+		double remainingSelectivity = 1.0;
+		for (const auto& conjunct : conjuncts)
+		{
+			if (conjunct.relation != -1)
+				continue;
+			remaining.push_back(conjunct.expr);
+			remainingSelectivity *= conditionSelectivity(relations, *conjunct.expr);
+		}
+
+		if (!remaining.empty())
+		{
+			auto filter = std::make_unique<PlanNode>(PlanNodeType::Filter);
+			filter->schema = current.node->schema;
+			filter->predicate = compileConjuncts(remaining, [&](const std::string& name) {
+				ColumnRef ref;
+				return resolveColumn(relations, relations.size(), name, ref) ? positionOf(current, ref) : -1;
+			});
+			filter->estimatedRows = current.node->estimatedRows * remainingSelectivity;
+			filter->detail = describeConjuncts(remaining);
+			filter->children.push_back(std::move(current.node));
+			current.node = std::move(filter);
+		}
+
+		auto sortPlan = [&](std::unique_ptr<PlanNode> input, std::vector<SortKey> keys) {
+			auto sort = std::make_unique<PlanNode>(PlanNodeType::Sort);
+			sort->schema = input->schema;
+			sort->sortKeys = std::move(keys);
+			sort->estimatedRows = input->estimatedRows;
+			sort->detail = orderLabel;
+
+			// Only the first rows are needed with a LIMIT, and rows that do not fit in memory are sorted in runs
+			const double rowSize = static_cast<double>(sizeof(Xale::DataStructure::Row) + sort->schema.size() * sizeof(Xale::DataStructure::FieldValue));
+			if (stmt.hasLimit)
+			{
+				sort->sortStrategy = SortStrategy::TopK;
+				sort->limit = stmt.limit + stmt.offset;
+				sort->estimatedRows = std::min(sort->estimatedRows, static_cast<double>(sort->limit));
+				sort->detail += " limit " + std::to_string(sort->limit);
+			}
+			else if (sort->estimatedRows * rowSize > static_cast<double>(SORT_MEMORY_BUDGET))
+				sort->sortStrategy = SortStrategy::External;
+
+			sort->children.push_back(std::move(input));
+			return sort;
+		};
+
+		if (!stmt.orderBy.empty() && !isAggregate && !readsInIndexOrder)
+		{
+			std::vector<SortKey> keys;
+			for (size_t k = 0; k < orderColumns.size(); ++k)
+			{
+				const auto& [resolved, ref] = orderColumns[k];
+				keys.push_back({ resolved ? positionOf(current, ref) : -1, stmt.orderBy[k].descending });
+			}
+			current.node = sortPlan(std::move(current.node), std::move(keys));
+		}
+
+		auto project = std::make_unique<PlanNode>(PlanNodeType::Project);
+		project->schema = outputSchema;
+		project->detail = outputLabel;
+
+		if (isAggregate)
+		{
+			// Groups are built in a hash table, a single group without GROUP BY
+			auto aggregate = std::make_unique<PlanNode>(PlanNodeType::Aggregate);
+			aggregate->schema = aggregateSchema;
+
+			std::string groupLabel;
+			bool groupsUnique = false;
+			for (size_t g = 0; g < groupColumns.size(); ++g)
+			{
+				const auto& [resolved, ref] = groupColumns[g];
+				aggregate->groupColumns.push_back(resolved ? positionOf(current, ref) : -1);
+				groupsUnique = groupsUnique || (resolved && distinctValues(relations, ref) > 0);
+				groupLabel += (g == 0 ? "" : ", ") + stmt.groupBy[g];
+			}
+
+			std::string aggregateLabel;
+			for (size_t a = 0; a < aggregates.size(); ++a)
+			{
+				const auto& [resolved, ref] = aggregateColumns[a];
+				aggregates[a].column = resolved ? positionOf(current, ref) : -1;
+				aggregateLabel += (a == 0 ? "" : ", ") + aggregates[a].name;
+			}
+			aggregate->aggregates = aggregates;
+
+			const double inputRows = current.node->estimatedRows;
+			aggregate->estimatedRows = groupColumns.empty() ? 1.0
+				: groupsUnique ? inputRows : std::min(inputRows, std::max(1.0, inputRows * GROUP_SELECTIVITY));
+			aggregate->detail = aggregateLabel;
+			if (!groupLabel.empty())
+				aggregate->detail += (aggregateLabel.empty() ? "by " : " by ") + groupLabel;
+
+			aggregate->children.push_back(std::move(current.node));
+			project->projection = aggregateProjection;
+			project->estimatedRows = aggregate->estimatedRows;
+			project->children.push_back(aggregateSortKeys.empty() ? std::move(aggregate) : sortPlan(std::move(aggregate), aggregateSortKeys));
+		}
+		else
+		{
+			project->estimatedRows = current.node->estimatedRows;
+			for (const auto& [resolved, ref] : outputColumns)
+				project->projection.push_back(resolved ? positionOf(current, ref) : -1);
+			project->children.push_back(std::move(current.node));
+		}
+
+		if (!stmt.hasLimit)
+			return project;
+
+		// Rows stop being pulled once the limit is reached
+		auto limit = std::make_unique<PlanNode>(PlanNodeType::Limit);
+		limit->schema = project->schema;
+		limit->limit = stmt.limit;
+		limit->offset = stmt.offset;
+		limit->estimatedRows = std::min(static_cast<double>(stmt.limit),
+			std::max(0.0, project->estimatedRows - static_cast<double>(stmt.offset)));
+		limit->detail = std::to_string(stmt.limit) + (stmt.offset ? " offset " + std::to_string(stmt.offset) : "");
+		limit->children.push_back(std::move(project));
+
+		return limit;
+	}
+
+	std::vector<std::string> QueryPlanner::explain(const PlanNode& plan)
+	{
+		std::vector<std::string> lines;
+		describe(plan, 0, lines);
+		return lines;
+	}
+
+	Xale::DataStructure::FieldValue QueryPlanner::evaluateLiteral(const Xale::Query::Expression& expr)
+	{
+		switch (expr.type) {
+			case Xale::Query::ExpressionType::NumericLiteral:
+				try { return expr.value.find('.') != std::string::npos ? std::stod(expr.value) : std::stoi(expr.value); }
+				catch (...) { return 0; }
+			case Xale::Query::ExpressionType::StringLiteral: {
+				std::string str = expr.value;
+				if (str.length() >= 2 &&
+				    ((str.front() == '\'' && str.back() == '\'') ||
+				     (str.front() == '"'  && str.back() == '"')))
+					str = str.substr(1, str.length() - 2);
+				return str;
+			}
+			case Xale::Query::ExpressionType::Identifier: return expr.value;
+			default: return std::monostate{};
+		}
+	}
+}
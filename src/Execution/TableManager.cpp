@@ -1,11 +1,266 @@
 #include "Execution/TableManager.h"
 
+#include <algorithm>
+
 namespace Xale::Execution
 {
-	TableManager::TableManager(Xale::Storage::IStorageEngine& storage, Xale::Storage::IFileManager& fileManager)
-		: _storage(storage), _fileManager(fileManager)
+	namespace
+	{
+		void appendU32(std::vector<char>& buffer, uint32_t value)
+		{
+			buffer.insert(buffer.end(), reinterpret_cast<const char*>(&value), reinterpret_cast<const char*>(&value) + sizeof(value));
+		}
+
+		uint32_t readU32(const std::vector<char>& buffer, size_t& offset)
+		{
+			if (offset + sizeof(uint32_t) > buffer.size())
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Corrupted log record");
+
+			uint32_t value = 0;
+			std::memcpy(&value, buffer.data() + offset, sizeof(uint32_t));
+			offset += sizeof(uint32_t);
+			return value;
+		}
+
+		void appendName(std::vector<char>& buffer, const std::string& name)
+		{
+			appendU32(buffer, static_cast<uint32_t>(name.size()));
+			buffer.insert(buffer.end(), name.begin(), name.end());
+		}
+
+		std::string readName(const std::vector<char>& buffer, size_t& offset)
+		{
+			uint32_t length = readU32(buffer, offset);
+			if (offset + length > buffer.size())
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Corrupted log record");
+
+			std::string name(buffer.data() + offset, length);
+			offset += length;
+			return name;
+		}
+
+		/**
+		 * @brief Deserialize a stored row, an empty record being a removed row
+		 */
+		Xale::DataStructure::Row readStoredRow(const char* data, size_t size, const std::vector<Xale::DataStructure::ColumnDefinition>& schema)
+		{
+			if (size == 0)
+				return Xale::DataStructure::Row();
+			return Xale::DataStructure::Table::deserializeRow(data, size, schema);
+		}
+	}
+
+	TableManager::TableManager(
+		Xale::Storage::IStorageEngine& storage,
+		Xale::Storage::IFileManager& fileManager,
+		Xale::Storage::IFileManager* logFileManager,
+		std::uint64_t checkpointThreshold)
+		: _storage(storage), _fileManager(fileManager),
+		_bufferPool(std::make_unique<Xale::Storage::BufferPool>(fileManager)),
+		_checkpointThreshold(checkpointThreshold)
+	{
+		if (!logFileManager)
+		{
+			loadAllTables();
+			return;
+		}
+
+		// Pages may only reach the data file through a logged checkpoint
+		_wal = std::make_unique<Xale::Storage::WriteAheadLog>(*logFileManager);
+		_bufferPool->setNoSteal(true);
+
+		std::vector<Xale::Storage::LogRecord> records = _wal->recover();
+		bool isCheckpointRestored = restoreCheckpoint(records);
+
+		if (loadTables())
+		{
+			for (auto& pair : _tables)
+				pair.second->markAllDirty();
+		}
+
+		if (!isCheckpointRestored)
+			replay(records);
+
+		// Rows removed while statements still read them were saved as empty records
+		for (auto& pair : _tables)
+			pair.second->reclaimVersions();
+
+		collectChanges(nullptr);
+		checkpoint();
+	}
+
+	TableManager::~TableManager()
 	{
-		loadAllTables();
+		stopVacuum();
+	}
+
+	TableLocks TableManager::lockTables(const std::vector<std::string>& readTables, const std::vector<std::string>& writeTables)
+	{
+		TableLocks locks;
+		locks._catalog = std::shared_lock<Xale::Core::SharedMutex>(_catalogMutex);
+
+		// Ordered by name, a table both read and written being locked exclusively
+		std::map<std::string, bool> tables;
+		for (const auto& name : readTables)
+			tables.emplace(name, false);
+		for (const auto& name : writeTables)
+			tables[name] = true;
+
+		for (const auto& [name, exclusive] : tables)
+		{
+			if (!tableExists(name))
+				continue;
+
+			if (exclusive)
+				locks._writers.emplace_back(tableLock(name).writer);
+			else
+				locks._readers.emplace_back(tableLock(name).readers);
+		}
+
+		return locks;
+	}
+
+	bool TableManager::lockCatalog(TableLocks& locks, std::chrono::milliseconds timeout)
+	{
+		std::unique_lock<Xale::Core::SharedMutex> catalog(_catalogMutex, std::defer_lock);
+		if (!catalog.try_lock_for(timeout))
+			return false;
+
+		locks._catalogExclusive = std::move(catalog);
+		return true;
+	}
+
+	bool TableManager::lockWriter(TableLocks& locks, const std::string& name, std::chrono::milliseconds timeout)
+	{
+		std::unique_lock<Xale::Core::SharedMutex> writer(tableLock(name).writer, std::defer_lock);
+		if (!writer.try_lock_for(timeout))
+			return false;
+
+		locks._writers.push_back(std::move(writer));
+		return true;
+	}
+
+	TableManager::TableLock& TableManager::tableLock(const std::string& name)
+	{
+		std::lock_guard<std::mutex> lock(_tableLocksMutex);
+
+		auto& tableLock = _tableLocks[name];
+		if (!tableLock)
+			tableLock = std::make_unique<TableLock>();
+		return *tableLock;
+	}
+
+	Xale::DataStructure::Snapshot TableManager::getSnapshot(std::uint64_t transaction) const
+	{
+		return { _clock.load(), transaction };
+	}
+
+	std::uint64_t TableManager::beginTransaction()
+	{
+		return Xale::DataStructure::PENDING_VERSION | ++_lastTransaction;
+	}
+
+	void TableManager::commitTransaction(std::uint64_t transaction, const std::vector<std::string>& names)
+	{
+		{
+			// The clock moves once every version is stamped, so snapshots never see half a commit
+			std::lock_guard<std::mutex> lock(_commitMutex);
+			const std::uint64_t timestamp = _clock.load() + 1;
+
+			for (const auto& name : names)
+			{
+				if (auto* table = getTable(name))
+					table->commitVersions(transaction, timestamp);
+			}
+
+			_clock.store(timestamp);
+		}
+
+		for (const auto& name : names)
+		{
+			if (auto* table = getTable(name))
+				reclaimUnread(name, *table);
+		}
+
+		save(&names);
+	}
+
+	void TableManager::rollbackTransaction(std::uint64_t transaction, const std::vector<std::string>& names)
+	{
+		for (const auto& name : names)
+		{
+			if (auto* table = getTable(name))
+			{
+				table->rollbackVersions(transaction);
+				reclaimUnread(name, *table);
+			}
+		}
+	}
+
+	std::size_t TableManager::reclaimUnread(const std::string& name, Xale::DataStructure::Table& table)
+	{
+		std::unique_lock<std::shared_mutex> readers(tableLock(name).readers, std::try_to_lock);
+		if (!readers)
+			return 0;
+
+		return table.reclaimVersions();
+	}
+
+	std::size_t TableManager::vacuum()
+	{
+		std::shared_lock<Xale::Core::SharedMutex> catalog(_catalogMutex);
+		std::size_t reclaimed = 0;
+
+		for (const auto& [name, table] : _tables)
+		{
+			// Busy tables are left to the next run rather than waited for
+			std::unique_lock<Xale::Core::SharedMutex> writer(tableLock(name).writer, std::try_to_lock);
+			if (!writer)
+				continue;
+
+			std::size_t count = reclaimUnread(name, *table);
+			if (count == 0)
+				continue;
+
+			reclaimed += count;
+			saveTables({ name });
+		}
+
+		return reclaimed;
+	}
+
+	void TableManager::startVacuum(std::chrono::milliseconds interval)
+	{
+		stopVacuum();
+		if (interval.count() <= 0)
+			return;
+
+		_vacuumStopping = false;
+		_vacuumThread = std::thread([this, interval]() {
+			std::unique_lock<std::mutex> lock(_vacuumMutex);
+			while (!_vacuumCondition.wait_for(lock, interval, [this] { return _vacuumStopping; }))
+			{
+				lock.unlock();
+				try {
+					vacuum();
+				} catch (...) {
+					// A failed save is retried with the next run
+				}
+				lock.lock();
+			}
+		});
+	}
+
+	void TableManager::stopVacuum()
+	{
+		{
+			std::lock_guard<std::mutex> lock(_vacuumMutex);
+			_vacuumStopping = true;
+		}
+		_vacuumCondition.notify_all();
+
+		if (_vacuumThread.joinable())
+			_vacuumThread.join();
 	}
 
 	Xale::DataStructure::Table* TableManager::createTable(const std::string& name)
@@ -28,7 +283,14 @@ namespace Xale::Execution
 		
 		// Auto-save after dropping table
 		if (result)
+		{
+			{
+				std::lock_guard<std::mutex> lock(_storageMutex);
+				_pendingChanges.erase(name);
+				_droppedTables.push_back(name);
+			}
 			saveAllTables();
+		}
 		
 		return result;
 	}
@@ -58,123 +320,516 @@ namespace Xale::Execution
 		return names;
 	}
 
-	void TableManager::saveAllTables()
+	std::size_t TableManager::getIndexMemoryUsage() const
 	{
-		// Calculate total size needed
-		size_t totalSize = sizeof(uint32_t); // table count
-		
-		std::vector<std::pair<std::string, std::vector<char>>> serializedTables;
-		
+		std::size_t bytes = 0;
+
 		for (const auto& pair : _tables)
+			bytes += pair.second->getIndexMemoryUsage();
+
+		return bytes;
+	}
+
+	void TableManager::setIndexMemoryLimit(std::size_t bytes)
+	{
+		_indexMemoryLimit = bytes;
+	}
+
+	std::size_t TableManager::getIndexMemoryLimit() const
+	{
+		return _indexMemoryLimit;
+	}
+
+	void TableManager::saveTables(const std::vector<std::string>& names)
+	{
+		save(&names);
+	}
+
+	void TableManager::saveAllTables()
+	{
+		save(nullptr);
+	}
+
+	void TableManager::save(const std::vector<std::string>* names)
+	{
+		std::lock_guard<std::mutex> lock(_storageMutex);
+
+		std::vector<Xale::Storage::LogRecord> records;
+		collectChanges(_wal ? &records : nullptr, names);
+
+		if (!_wal)
 		{
-			std::vector<char> data = pair.second->serialize();
-			serializedTables.push_back({pair.first, std::move(data)});
-			
-			totalSize += sizeof(uint32_t); // name length
-			totalSize += pair.first.size(); // name
-			totalSize += sizeof(uint32_t); // data length
-			totalSize += serializedTables.back().second.size(); // data
+			writeCheckpoint();
+			return;
 		}
-		
-		// Build file data
-		std::vector<char> fileData;
-		fileData.reserve(totalSize);
-		
-		// Write table count
-		uint32_t tableCount = static_cast<uint32_t>(_tables.size());
-		fileData.insert(fileData.end(), 
-			reinterpret_cast<char*>(&tableCount), 
-			reinterpret_cast<char*>(&tableCount) + sizeof(uint32_t));
-		
-		// Write each table
-		for (const auto& [name, data] : serializedTables)
-		{
-			// Write name length
-			uint32_t nameLen = static_cast<uint32_t>(name.size());
-			fileData.insert(fileData.end(),
-				reinterpret_cast<char*>(&nameLen),
-				reinterpret_cast<char*>(&nameLen) + sizeof(uint32_t));
-			
-			// Write name
-			fileData.insert(fileData.end(), name.begin(), name.end());
-			
-			// Write data length
-			uint32_t dataLen = static_cast<uint32_t>(data.size());
-			fileData.insert(fileData.end(),
-				reinterpret_cast<char*>(&dataLen),
-				reinterpret_cast<char*>(&dataLen) + sizeof(uint32_t));
-			
-			// Write data
-			fileData.insert(fileData.end(), data.begin(), data.end());
+
+		if (!records.empty())
+			_wal->commit(records);
+
+		if (_wal->size() >= _checkpointThreshold)
+			writeCheckpoint();
+	}
+
+	void TableManager::loadAllTables()
+	{
+		bool isRewritten = loadTables();
+		if (isRewritten)
+		{
+			for (auto& pair : _tables)
+				pair.second->markAllDirty();
 		}
-		
-		// Write to file at offset 0
-		_fileManager.writeAt(0, fileData.data(), fileData.size());
-		
+
+		// Rows removed while statements still read them were saved as empty records
+		bool isCompacted = false;
+		for (auto& pair : _tables)
+			isCompacted = pair.second->reclaimVersions() > 0 || isCompacted;
+
+		if (isRewritten || isCompacted)
+		{
+			collectChanges(nullptr);
+			writeCheckpoint();
+		}
+	}
+
+	void TableManager::checkpoint()
+	{
+		std::lock_guard<std::mutex> lock(_storageMutex);
+		writeCheckpoint();
+	}
+
+	void TableManager::writeCheckpoint()
+	{
+		for (const auto& name : _pendingDrops)
+		{
+			auto it = _tableStorage.find(name);
+			if (it == _tableStorage.end())
+				continue;
+
+			_catalog->eraseRecord(it->second.catalogRecord);
+			it->second.directory->drop();
+			_tableStorage.erase(it);
+		}
+
+		// Only the copies of the changes are read, the tables may be changing meanwhile
+		for (const auto& [name, changes] : _pendingChanges)
+		{
+			auto it = _tableStorage.find(name);
+
+			if (it == _tableStorage.end())
+			{
+				TableStorage storage;
+				storage.directory = std::make_unique<Xale::Storage::PageDirectory>(
+					*_bufferPool, Xale::Storage::PageDirectory::create(*_bufferPool));
+				storage.catalogRecord = _catalog->insertRecord(
+					makeCatalogRecord(storage.directory->getRootPageId(), changes.schema));
+				it = _tableStorage.emplace(name, std::move(storage)).first;
+			}
+			else if (!changes.schema.empty())
+			{
+				it->second.catalogRecord = _catalog->updateRecord(
+					it->second.catalogRecord,
+					makeCatalogRecord(it->second.directory->getRootPageId(), changes.schema));
+			}
+
+			saveTable(it->second, changes);
+		}
+
+		_pendingDrops.clear();
+		_pendingChanges.clear();
+
+		if (_wal)
+		{
+			std::vector<Xale::Storage::LogRecord> images;
+			_bufferPool->forEachDirtyPage([&](Xale::Storage::PageId pageId, const char* data) {
+				Xale::Storage::LogRecord image{ Xale::Storage::LogRecordType::PageImage, {} };
+				image.payload.reserve(sizeof(uint32_t) + Xale::Storage::PAGE_SIZE);
+				appendU32(image.payload, pageId);
+				image.payload.insert(image.payload.end(), data, data + Xale::Storage::PAGE_SIZE);
+				images.push_back(std::move(image));
+			});
+
+			if (!images.empty())
+				_wal->writeCheckpoint(images);
+		}
+
+		_bufferPool->flushAllPages();
+
 		// Flush to ensure data is written
 		_fileManager.sync();
+
+		if (_wal)
+			_wal->reset();
 	}
 
-	void TableManager::loadAllTables()
+	Xale::Storage::WriteAheadLog* TableManager::getWriteAheadLog()
+	{
+		return _wal.get();
+	}
+
+	bool TableManager::loadTables()
+	{
+		_tables.clear();
+		_tableStorage.clear();
+
+		if (Xale::Storage::BufferPool::hasPagedLayout(_fileManager))
+		{
+			_bufferPool->open();
+			_catalog = std::make_unique<Xale::Storage::PageDirectory>(*_bufferPool, _bufferPool->getRootPageId());
+			_catalog->forEachRecord([this](Xale::Storage::RecordId rid, const std::vector<char>& record) {
+				loadTable(rid, record);
+			});
+			return false;
+		}
+
+		// Empty file or former format: (re)format the file with pages
+		loadLegacyTables();
+
+		_bufferPool->open();
+		_bufferPool->setRootPageId(Xale::Storage::PageDirectory::create(*_bufferPool));
+		_catalog = std::make_unique<Xale::Storage::PageDirectory>(*_bufferPool, _bufferPool->getRootPageId());
+
+		return true;
+	}
+
+	void TableManager::collectChanges(std::vector<Xale::Storage::LogRecord>* records, const std::vector<std::string>* names)
+	{
+		for (const auto& name : _droppedTables)
+		{
+			if (records)
+			{
+				Xale::Storage::LogRecord record{ Xale::Storage::LogRecordType::DropTable, {} };
+				appendName(record.payload, name);
+				records->push_back(std::move(record));
+			}
+			_pendingDrops.push_back(name);
+		}
+		_droppedTables.clear();
+
+		auto collect = [&](const std::string& name, Xale::DataStructure::Table& table) {
+			if (!table.isSchemaDirty() && table.getDirtySlots().empty())
+				return;
+
+			PendingChanges& changes = _pendingChanges[name];
+
+			if (table.isSchemaDirty())
+			{
+				changes.schema = table.serializeSchema();
+				if (records)
+					records->push_back({ Xale::Storage::LogRecordType::SetSchema, changes.schema });
+			}
+
+			const auto& rows = table.getRows();
+			std::vector<size_t> dirty(table.getDirtySlots().begin(), table.getDirtySlots().end());
+			std::sort(dirty.begin(), dirty.end());
+
+			if (records && !dirty.empty() && dirty.back() >= rows.size())
+			{
+				Xale::Storage::LogRecord record{ Xale::Storage::LogRecordType::TruncateRows, {} };
+				appendName(record.payload, name);
+				appendU32(record.payload, static_cast<uint32_t>(rows.size()));
+				records->push_back(std::move(record));
+			}
+
+			changes.rowCount = rows.size();
+			changes.rows.erase(changes.rows.lower_bound(rows.size()), changes.rows.end());
+
+			for (size_t slot : dirty)
+			{
+				if (slot >= rows.size())
+					continue;
+
+				// Versions not committed, or ended, are written as removed rows
+				std::vector<char> row = table.hasCommittedRow(slot)
+					? Xale::DataStructure::Table::serializeRow(rows[slot])
+					: std::vector<char>();
+
+				if (records)
+				{
+					Xale::Storage::LogRecord record{ Xale::Storage::LogRecordType::SetRow, {} };
+					appendName(record.payload, name);
+					appendU32(record.payload, static_cast<uint32_t>(slot));
+					record.payload.insert(record.payload.end(), row.begin(), row.end());
+					records->push_back(std::move(record));
+				}
+
+				changes.rows[slot] = makeRowRecord(slot, row);
+			}
+
+			table.clearChanges();
+		};
+
+		if (!names)
+		{
+			for (const auto& [name, table] : _tables)
+				collect(name, *table);
+			return;
+		}
+
+		for (const auto& name : *names)
+		{
+			auto it = _tables.find(name);
+			if (it != _tables.end())
+				collect(it->first, *it->second);
+		}
+	}
+
+	bool TableManager::restoreCheckpoint(const std::vector<Xale::Storage::LogRecord>& records)
+	{
+		auto end = std::find_if(records.begin(), records.end(), [](const Xale::Storage::LogRecord& record) {
+			return record.type == Xale::Storage::LogRecordType::CheckpointEnd;
+		});
+
+		if (end == records.end())
+			return false;
+
+		for (auto it = records.begin(); it != end; ++it)
+		{
+			if (it->type != Xale::Storage::LogRecordType::PageImage)
+				continue;
+
+			size_t offset = 0;
+			uint32_t pageId = readU32(it->payload, offset);
+			if (it->payload.size() != offset + Xale::Storage::PAGE_SIZE)
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Corrupted page image");
+
+			_fileManager.writeAt(static_cast<uint64_t>(pageId) * Xale::Storage::PAGE_SIZE, it->payload.data() + offset, Xale::Storage::PAGE_SIZE);
+		}
+
+		_fileManager.sync();
+		return true;
+	}
+
+	void TableManager::replay(const std::vector<Xale::Storage::LogRecord>& records)
+	{
+		// Only the groups closed by a Commit record are applied
+		size_t groupStart = 0;
+
+		for (size_t i = 0; i < records.size(); ++i)
+		{
+			if (records[i].type != Xale::Storage::LogRecordType::Commit)
+				continue;
+
+			for (size_t j = groupStart; j < i; ++j)
+				applyLogRecord(records[j]);
+
+			groupStart = i + 1;
+		}
+	}
+
+	void TableManager::applyLogRecord(const Xale::Storage::LogRecord& record)
+	{
+		size_t offset = 0;
+
+		switch (record.type)
+		{
+			case Xale::Storage::LogRecordType::SetSchema:
+			{
+				auto schema = Xale::DataStructure::Table::deserializeSchema(record.payload.data(), record.payload.size());
+				auto it = _tables.find(schema.getName());
+
+				if (it == _tables.end())
+				{
+					const std::string name = schema.getName();
+					_tables[name] = std::make_unique<Xale::DataStructure::Table>(std::move(schema));
+				}
+				else
+				{
+					// Columns are only ever appended
+					const auto& columns = schema.getSchema();
+					for (size_t i = it->second->getColumnCount(); i < columns.size(); ++i)
+						it->second->addColumn(columns[i]);
+
+					// Indexes are kept in sync by name
+					const auto indexes = schema.getIndexes();
+					for (const auto& index : it->second->getIndexes())
+					{
+						if (std::none_of(indexes.begin(), indexes.end(), [&](const auto& other) { return other.name == index.name; }))
+							it->second->dropIndex(index.name);
+					}
+					for (const auto& index : indexes)
+						it->second->createIndex(index);
+				}
+				break;
+			}
+			case Xale::Storage::LogRecordType::SetRow:
+			{
+				std::string name = readName(record.payload, offset);
+				uint32_t slot = readU32(record.payload, offset);
+				auto* table = getTable(name);
+
+				if (!table || !table->setRow(slot, readStoredRow(
+						record.payload.data() + offset, record.payload.size() - offset, table->getSchema())))
+					THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Cannot replay row of table " + name);
+				break;
+			}
+			case Xale::Storage::LogRecordType::TruncateRows:
+			{
+				std::string name = readName(record.payload, offset);
+				uint32_t count = readU32(record.payload, offset);
+
+				if (auto* table = getTable(name))
+					table->truncateRows(count);
+				break;
+			}
+			case Xale::Storage::LogRecordType::DropTable:
+			{
+				std::string name = readName(record.payload, offset);
+
+				if (_tables.erase(name) > 0)
+				{
+					_pendingChanges.erase(name);
+					_droppedTables.push_back(name);
+				}
+				break;
+			}
+			default:
+				break;
+		}
+	}
+
+	Xale::Storage::BufferPool& TableManager::getBufferPool()
+	{
+		return *_bufferPool;
+	}
+
+	void TableManager::loadLegacyTables()
 	{
 		// Check if file has data
 		if (_fileManager.size() < sizeof(uint32_t))
 			return; // Empty file or doesn't exist
-		
+
 		// Read table count
 		uint32_t tableCount = 0;
 		_fileManager.readAt(0, &tableCount, sizeof(uint32_t));
-		
-		if (tableCount == 0)
-			return;
-		
+
 		// Read each table
 		size_t offset = sizeof(uint32_t);
-		
+
 		for (uint32_t i = 0; i < tableCount; ++i)
 		{
 			// Read name length
 			uint32_t nameLen = 0;
 			_fileManager.readAt(offset, &nameLen, sizeof(uint32_t));
 			offset += sizeof(uint32_t);
-			
+
 			// Read name
 			std::vector<char> nameBuffer(nameLen);
-			_fileManager.readAt(offset, nameBuffer.data(), nameLen);
+			if (nameLen > 0)
+				_fileManager.readAt(offset, nameBuffer.data(), nameLen);
 			std::string tableName(nameBuffer.begin(), nameBuffer.end());
 			offset += nameLen;
-			
+
 			// Read data length
 			uint32_t dataLen = 0;
 			_fileManager.readAt(offset, &dataLen, sizeof(uint32_t));
 			offset += sizeof(uint32_t);
-			
+
 			// Read data
 			std::vector<char> dataBuffer(dataLen);
-			_fileManager.readAt(offset, dataBuffer.data(), dataLen);
+			if (dataLen > 0)
+				_fileManager.readAt(offset, dataBuffer.data(), dataLen);
 			offset += dataLen;
-			
+
 			// Deserialize and load table
-			loadTable(tableName, dataBuffer);
+			_tables[tableName] = std::make_unique<Xale::DataStructure::Table>(
+				Xale::DataStructure::Table::deserialize(dataBuffer));
 		}
 	}
 
-	void TableManager::saveTable(const Xale::DataStructure::Table& table)
+	void TableManager::loadTable(Xale::Storage::RecordId rid, const std::vector<char>& record)
 	{
-		// Serialize the table
-		std::vector<char> data = table.serialize();
-		
-		// TODO: Write to file manager at appropriate offset
-		// This would need a proper file format with table directory/metadata
+		if (record.size() < sizeof(uint32_t))
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Corrupted catalog record");
+
+		uint32_t directoryRoot = 0;
+		std::memcpy(&directoryRoot, record.data(), sizeof(uint32_t));
+
+		auto table = std::make_unique<Xale::DataStructure::Table>(
+			Xale::DataStructure::Table::deserializeSchema(
+				record.data() + sizeof(uint32_t), record.size() - sizeof(uint32_t)));
+
+		TableStorage storage;
+		storage.catalogRecord = rid;
+		storage.directory = std::make_unique<Xale::Storage::PageDirectory>(*_bufferPool, directoryRoot);
+
+		// Rows are stored in page order, put them back in slot order
+		std::vector<std::pair<uint32_t, Xale::Storage::RecordId>> slots;
+		std::unordered_map<uint32_t, Xale::DataStructure::Row> rows;
+
+		storage.directory->forEachRecord([&](Xale::Storage::RecordId rowRid, const std::vector<char>& rowRecord) {
+			if (rowRecord.size() < sizeof(uint32_t))
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Corrupted row record");
+
+			uint32_t slot = 0;
+			std::memcpy(&slot, rowRecord.data(), sizeof(uint32_t));
+			slots.push_back({ slot, rowRid });
+			rows.emplace(slot, readStoredRow(
+				rowRecord.data() + sizeof(uint32_t), rowRecord.size() - sizeof(uint32_t), table->getSchema()));
+		});
+
+		std::sort(slots.begin(), slots.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		std::vector<Xale::DataStructure::Row> orderedRows;
+		orderedRows.reserve(slots.size());
+
+		for (size_t i = 0; i < slots.size(); ++i)
+		{
+			if (slots[i].first != i)
+				THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Missing row in table " + table->getName());
+
+			orderedRows.push_back(std::move(rows[slots[i].first]));
+			storage.rowLocations.push_back(slots[i].second);
+		}
+
+		// Indexes are built bottom-up once all the rows are known
+		if (!table->loadRows(std::move(orderedRows)))
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Invalid row in table " + table->getName());
+
+		table->clearChanges();
+
+		const std::string name = table->getName();
+		_tableStorage.emplace(name, std::move(storage));
+		_tables[name] = std::move(table);
 	}
 
-	void TableManager::loadTable(const std::string& tableName, const std::vector<char>& data)
+	void TableManager::saveTable(TableStorage& storage, const PendingChanges& changes)
 	{
-		// Deserialize the table
-		auto table = std::make_unique<Xale::DataStructure::Table>(
-			Xale::DataStructure::Table::deserialize(data)
-		);
-		
-		_tables[tableName] = std::move(table);
+		auto& locations = storage.rowLocations;
+
+		// Rows past the end were removed
+		for (size_t slot = changes.rowCount; slot < locations.size(); ++slot)
+		{
+			if (locations[slot].isValid())
+				storage.directory->eraseRecord(locations[slot]);
+		}
+		locations.resize(changes.rowCount);
+
+		// Write in slot order so that appended rows stay packed in the last pages
+		for (const auto& [slot, record] : changes.rows)
+		{
+			if (locations[slot].isValid())
+				locations[slot] = storage.directory->updateRecord(locations[slot], record);
+			else
+				locations[slot] = storage.directory->insertRecord(record);
+		}
+	}
+
+	std::vector<char> TableManager::makeCatalogRecord(Xale::Storage::PageId directoryRoot, const std::vector<char>& schema)
+	{
+		std::vector<char> record(sizeof(uint32_t));
+		std::memcpy(record.data(), &directoryRoot, sizeof(uint32_t));
+		record.insert(record.end(), schema.begin(), schema.end());
+
+		return record;
+	}
+
+	std::vector<char> TableManager::makeRowRecord(std::size_t slot, const std::vector<char>& row)
+	{
+		uint32_t slot32 = static_cast<uint32_t>(slot);
+		std::vector<char> record(sizeof(uint32_t));
+		std::memcpy(record.data(), &slot32, sizeof(uint32_t));
+		record.insert(record.end(), row.begin(), row.end());
+
+		return record;
 	}
 }
@@ -0,0 +1,78 @@
+#include "Execution/Transaction.h"
+#include "Core/ExceptionHandler.h"
+
+#include <algorithm>
+
+namespace Xale::Execution
+{
+	Transaction::Transaction(TableManager& tableManager, std::chrono::milliseconds lockTimeout)
+		: _tableManager(tableManager), _lockTimeout(lockTimeout)
+	{}
+
+	Transaction::~Transaction()
+	{
+		if (isActive())
+			rollback();
+	}
+
+	bool Transaction::isActive() const
+	{
+		return _id != 0;
+	}
+
+	std::uint64_t Transaction::getId() const
+	{
+		return _id;
+	}
+
+	Xale::DataStructure::Snapshot Transaction::getSnapshot() const
+	{
+		return _tableManager.getSnapshot(_id);
+	}
+
+	void Transaction::begin()
+	{
+		if (isActive())
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "A transaction is already in progress");
+
+		_locks = _tableManager.lockTables({}, {});
+		_id = _tableManager.beginTransaction();
+	}
+
+	void Transaction::lockTable(const std::string& name)
+	{
+		if (std::find(_tables.begin(), _tables.end(), name) != _tables.end())
+			return;
+
+		if (!_tableManager.lockWriter(_locks, name, _lockTimeout))
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "Lock wait timeout, table is written by another transaction: " + name);
+		_tables.push_back(name);
+	}
+
+	void Transaction::commit()
+	{
+		if (!isActive())
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "No transaction in progress");
+
+		// A transaction which wrote nothing has nothing to save
+		if (!_tables.empty())
+			_tableManager.commitTransaction(_id, _tables);
+		end();
+	}
+
+	void Transaction::rollback()
+	{
+		if (!isActive())
+			THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ExecutionError, "No transaction in progress");
+
+		_tableManager.rollbackTransaction(_id, _tables);
+		end();
+	}
+
+	void Transaction::end()
+	{
+		_id = 0;
+		_tables.clear();
+		_locks = TableLocks();
+	}
+}
@@ -0,0 +1,95 @@
+#include "Net/Packet/FrameReader.h"
+
+#include "Core/ExceptionHandler.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Xale::Net
+{
+    FrameReader::FrameReader(uint32_t maxPayloadSize) :
+        _maxPayloadSize(maxPayloadSize)
+    {}
+
+    uint8_t* FrameReader::prepare(std::size_t size)
+    {
+        if (_buffer.size() - _end < size) {
+            // Move the unread bytes to the front before growing
+            if (_begin > 0) {
+                std::memmove(_buffer.data(), _buffer.data() + _begin, _end - _begin);
+                _end -= _begin;
+                _begin = 0;
+            }
+
+            if (_buffer.size() - _end < size)
+                _buffer.resize(std::max(_end + size, _buffer.size() * 2));
+        }
+
+        return _buffer.data() + _end;
+    }
+
+    void FrameReader::commit(std::size_t size)
+    {
+        _end = std::min(_end + size, _buffer.size());
+    }
+
+    void FrameReader::append(const uint8_t* data, std::size_t size)
+    {
+        std::memcpy(prepare(size), data, size);
+        commit(size);
+    }
+
+    bool FrameReader::next(Packet& packet)
+    {
+        const std::size_t available = _end - _begin;
+        if (available < HEADER_SIZE)
+            return false;
+
+        const std::size_t frameSize = HEADER_SIZE + payloadLength();
+        if (available < frameSize)
+            return false;
+
+        packet.deserialize(_buffer.data() + _begin, frameSize);
+
+        _begin += frameSize;
+        if (_begin == _end)
+            _begin = _end = 0;
+        return true;
+    }
+
+    std::size_t FrameReader::missingBytes() const
+    {
+        const std::size_t available = _end - _begin;
+        if (available < HEADER_SIZE)
+            return HEADER_SIZE - available;
+
+        const std::size_t frameSize = HEADER_SIZE + payloadLength();
+        return frameSize > available ? frameSize - available : 0;
+    }
+
+    std::size_t FrameReader::bufferedBytes() const
+    {
+        return _end - _begin;
+    }
+
+    void FrameReader::clear()
+    {
+        _begin = _end = 0;
+    }
+
+    uint32_t FrameReader::payloadLength() const
+    {
+        // The length cannot be trusted before the magic number
+        uint32_t magic;
+        std::memcpy(&magic, _buffer.data() + _begin, 4);
+        if (magic != MAGIC_NUMBER)
+            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::PacketError, "Invalid magic number");
+
+        uint32_t length;
+        std::memcpy(&length, _buffer.data() + _begin + 7, 4);
+        if (length > _maxPayloadSize)
+            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::PacketError, "Payload of " + std::to_string(length) + " bytes over the limit");
+
+        return length;
+    }
+}
@@ -19,6 +19,17 @@ namespace Xale::Net
     std::vector<uint8_t> Packet::serialize() const 
     {
         std::vector<uint8_t> buffer;
+        serializeTo(buffer);
+        return buffer;
+    }
+
+    /**
+     * @brief Appends the serialized packet to a buffer (no token support for now)
+     * @param buffer Buffer the header and payload are appended to
+     */
+    void Packet::serializeTo(std::vector<uint8_t>& buffer) const
+    {
+        buffer.reserve(buffer.size() + HEADER_SIZE + payload.size());
 
         // Header: MAGIC_NUMBER (4 bytes), VERSION (2 bytes), command (1 byte), length (4 bytes)
         buffer.insert(buffer.end(), reinterpret_cast<const uint8_t*>(&MAGIC_NUMBER),
@@ -34,8 +45,6 @@ namespace Xale::Net
         // Only payload (no token)
         if (!payload.empty())
             buffer.insert(buffer.end(), payload.begin(), payload.end());
-
-        return buffer;
     }
 
     /**
@@ -43,35 +52,43 @@ namespace Xale::Net
      * @param buffer Byte vector containing serialized packet
      */
     void Packet::deserialize(const std::vector<uint8_t>& buffer) 
+    {
+        deserialize(buffer.data(), buffer.size());
+    }
+
+    /**
+     * @brief Deserializes the packet from a byte range (no token support for now)
+     * @param data First byte of the serialized packet
+     * @param size Number of bytes available from data
+     */
+    void Packet::deserialize(const uint8_t* data, std::size_t size)
     {
         // Header: MAGIC_NUMBER (4 bytes), VERSION (2 bytes), command (1 byte), length (4 bytes)
-        if (buffer.size() < 11)
+        if (size < HEADER_SIZE)
             THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::PacketError, "Buffer too small for header");
 
         uint32_t magic;
-        std::memcpy(&magic, buffer.data(), 4);
+        std::memcpy(&magic, data, 4);
         if (magic != MAGIC_NUMBER)
             THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::PacketError, "Invalid magic number");
 
         uint16_t version;
-        std::memcpy(&version, buffer.data() + 4, 2);
+        std::memcpy(&version, data + 4, 2);
         if (version != VERSION)
             THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::PacketError, "Unsupported version");
 
-        command = static_cast<CommandType>(buffer[6]);
+        command = static_cast<CommandType>(data[6]);
 
         uint32_t length;
-        std::memcpy(&length, buffer.data() + 7, 4);
+        std::memcpy(&length, data + 7, 4);
 
-        if (buffer.size() < 11 + length)
+        if (size - HEADER_SIZE < length)
             THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::PacketError, "Buffer too small for payload");
 
         token.clear(); // not used
-        payload.clear();
 
-        // Only payload (no token)
-        if (length > 0)
-            payload.insert(payload.end(), buffer.begin() + 11, buffer.begin() + 11 + length);
+        // Only payload (no token), assign keeps the capacity of a reused packet
+        payload.assign(data + HEADER_SIZE, data + HEADER_SIZE + length);
     }
 
     /**
@@ -87,7 +104,7 @@ namespace Xale::Net
      * @brief Gets the payload data of the packet
      * @return Payload as vector of bytes
      */
-    const std::vector<uint8_t> Packet::getPayload() const 
+    const std::vector<uint8_t>& Packet::getPayload() const 
     {
         return payload;
     }
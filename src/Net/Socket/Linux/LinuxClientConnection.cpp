@@ -2,6 +2,8 @@
 
 #include "Net/Socket/Linux/LinuxClientConnection.h"
 
+#include <cerrno>
+
 namespace Xale::Net
 {
     LinuxClientConnection::LinuxClientConnection(int fd)
@@ -16,24 +18,54 @@ namespace Xale::Net
 
     int LinuxClientConnection::read(std::vector<uint8_t>& buffer, size_t size)
     {
-        char* tmp = new char[size];
-        int bytesRead = ::read(_fd, tmp, size);
-
+        std::vector<uint8_t> received(size);
+        int bytesRead = read(received.data(), size);
         if (bytesRead > 0)
-            buffer.assign(tmp, tmp + bytesRead);
+            buffer.assign(received.begin(), received.begin() + bytesRead);
+        return bytesRead;
+    }
+
+    int LinuxClientConnection::respond(const std::vector<uint8_t>* data, size_t size)
+    {
+        if (!data) return -1;
+        return respond(data->data(), size);
+    }
+
+    int LinuxClientConnection::read(uint8_t* buffer, size_t size)
+    {
+        int bytesRead = ::read(_fd, buffer, size);
+
+        if (bytesRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            bytesRead = WOULD_BLOCK;
         else if (bytesRead == 0)
             _logger.info("Client disconnected (clean)");
-        else
+        else if (bytesRead < 0)
             _logger.info("Client connection lost");
 
-        delete[] tmp;
         return bytesRead;
     }
 
-    int LinuxClientConnection::respond(const std::vector<uint8_t>* data, size_t size)
+    int LinuxClientConnection::respond(const uint8_t* data, size_t size)
     {
         if (_fd == -1 || !data) return -1;
-        return ::send(_fd, data->data(), size, MSG_NOSIGNAL);
+
+        int bytesSent = ::send(_fd, data, size, MSG_NOSIGNAL);
+        if (bytesSent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return WOULD_BLOCK;
+        return bytesSent;
+    }
+
+    bool LinuxClientConnection::setNonBlocking()
+    {
+        if (_fd == -1) return false;
+
+        int flags = ::fcntl(_fd, F_GETFL, 0);
+        return flags != -1 && ::fcntl(_fd, F_SETFL, flags | O_NONBLOCK) != -1;
+    }
+
+    int LinuxClientConnection::getHandle() const
+    {
+        return _fd;
     }
 
     void LinuxClientConnection::close()
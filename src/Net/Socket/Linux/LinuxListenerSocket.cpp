@@ -2,6 +2,8 @@
 
 #include "Net/Socket/Linux/LinuxListenerSocket.h"
 
+#include <cerrno>
+
 namespace Xale::Net
 {
     LinuxListenerSocket::LinuxListenerSocket()
@@ -31,7 +33,7 @@ namespace Xale::Net
             return false;
         }
 
-        if (::listen(_socket, 16) < 0) {
+        if (::listen(_socket, SOMAXCONN) < 0) {
             _logger.error("Listen failed");
             close();
             return false;
@@ -46,6 +48,9 @@ namespace Xale::Net
         socklen_t   clientLen = sizeof(clientAddr);
 
         int clientFd = ::accept(_socket, (struct sockaddr*)&clientAddr, &clientLen);
+        if (clientFd < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return nullptr;
+
         if (clientFd < 0) {
             _logger.error("Accept failed");
             return nullptr;
@@ -55,6 +60,19 @@ namespace Xale::Net
         return std::make_unique<LinuxClientConnection>(clientFd);
     }
 
+    bool LinuxListenerSocket::setNonBlocking()
+    {
+        if (_socket == -1) return false;
+
+        int flags = ::fcntl(_socket, F_GETFL, 0);
+        return flags != -1 && ::fcntl(_socket, F_SETFL, flags | O_NONBLOCK) != -1;
+    }
+
+    int LinuxListenerSocket::getHandle() const
+    {
+        return _socket;
+    }
+
     void LinuxListenerSocket::close()
     {
         if (_socket != -1) {
@@ -14,27 +14,67 @@ namespace Xale::Net
     }
 
     int LinuxSSLClientConnection::read(std::vector<uint8_t>& buffer, size_t size)
+    {
+        std::vector<uint8_t> received(size);
+        int bytesRead = read(received.data(), size);
+        if (bytesRead > 0)
+            buffer.assign(received.begin(), received.begin() + bytesRead);
+        return bytesRead;
+    }
+
+    int LinuxSSLClientConnection::respond(const std::vector<uint8_t>* data, size_t size)
+    {
+        if (!data) return -1;
+        return respond(data->data(), size);
+    }
+
+    int LinuxSSLClientConnection::read(uint8_t* buffer, size_t size)
     {
         if (!_ssl) return -1;
 
-        char* tmp = new char[size];
-        int bytesRead = SSL_read(_ssl, tmp, static_cast<int>(size));
+        int bytesRead = SSL_read(_ssl, buffer, static_cast<int>(size));
 
-        if (bytesRead > 0)
-            buffer.assign(tmp, tmp + bytesRead);
+        // The handshake and partial records need more bytes than the socket holds yet
+        int error = bytesRead <= 0 ? SSL_get_error(_ssl, bytesRead) : SSL_ERROR_NONE;
+        if (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE)
+            bytesRead = WOULD_BLOCK;
         else if (bytesRead == 0)
             _logger.info("SSL client disconnected (clean)");
-        else
+        else if (bytesRead < 0)
             _logger.info("SSL client connection lost");
 
-        delete[] tmp;
         return bytesRead;
     }
 
-    int LinuxSSLClientConnection::respond(const std::vector<uint8_t>* data, size_t size)
+    int LinuxSSLClientConnection::respond(const uint8_t* data, size_t size)
     {
         if (!_ssl || !data || size == 0) return -1;
-        return SSL_write(_ssl, data->data(), static_cast<int>(size));
+
+        int bytesSent = SSL_write(_ssl, data, static_cast<int>(size));
+        if (bytesSent <= 0)
+        {
+            int error = SSL_get_error(_ssl, bytesSent);
+            if (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE)
+                return WOULD_BLOCK;
+            return -1;
+        }
+        return bytesSent;
+    }
+
+    bool LinuxSSLClientConnection::setNonBlocking()
+    {
+        if (_fd == -1 || !_ssl) return false;
+
+        // Writes may complete part of the data, and be retried from a buffer that moved
+        SSL_set_mode(_ssl, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+        int flags = ::fcntl(_fd, F_GETFL, 0);
+        return flags != -1 && ::fcntl(_fd, F_SETFL, flags | O_NONBLOCK) != -1;
+    }
+
+    int LinuxSSLClientConnection::getHandle() const
+    {
+        return _fd;
     }
 
     void LinuxSSLClientConnection::close()
@@ -46,7 +86,8 @@ namespace Xale::Net
     {
         if (_ssl)
         {
-            SSL_shutdown(_ssl);
+            if (SSL_is_init_finished(_ssl))
+                SSL_shutdown(_ssl);
             SSL_free(_ssl);
             _ssl = nullptr;
         }
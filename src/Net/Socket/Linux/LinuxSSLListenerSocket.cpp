@@ -1,5 +1,7 @@
 #include "Net/Socket/Linux/LinuxSSLListenerSocket.h"
 
+#include <cerrno>
+
 namespace Xale::Net
 {
     LinuxSSLListenerSocket::LinuxSSLListenerSocket(std::string certFile, std::string keyFile)
@@ -54,7 +56,7 @@ namespace Xale::Net
             return false;
         }
 
-        if (::listen(_socket, 16) < 0)
+        if (::listen(_socket, SOMAXCONN) < 0)
         {
             _logger.error("Listen failed");
             close();
@@ -70,6 +72,9 @@ namespace Xale::Net
         socklen_t   clientLen = sizeof(clientAddr);
 
         int clientFd = ::accept(_socket, (struct sockaddr*)&clientAddr, &clientLen);
+        if (clientFd < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return nullptr;
+
         if (clientFd < 0)
         {
             _logger.error("Accept failed");
@@ -77,20 +82,34 @@ namespace Xale::Net
         }
 
         SSL* ssl = SSL_new(_ctx);
-        SSL_set_fd(ssl, clientFd);
-
-        if (SSL_accept(ssl) <= 0)
+        if (!ssl)
         {
-            _logger.error("SSL handshake failed");
-            SSL_free(ssl);
+            _logger.error("Unable to create SSL object");
             ::close(clientFd);
             return nullptr;
         }
 
+        // The handshake runs within the first reads of the connection
+        SSL_set_fd(ssl, clientFd);
+        SSL_set_accept_state(ssl);
+
         _logger.info("New SSL client connected");
         return std::make_unique<LinuxSSLClientConnection>(clientFd, ssl);
     }
 
+    bool LinuxSSLListenerSocket::setNonBlocking()
+    {
+        if (_socket == -1) return false;
+
+        int flags = ::fcntl(_socket, F_GETFL, 0);
+        return flags != -1 && ::fcntl(_socket, F_SETFL, flags | O_NONBLOCK) != -1;
+    }
+
+    int LinuxSSLListenerSocket::getHandle() const
+    {
+        return _socket;
+    }
+
     void LinuxSSLListenerSocket::close()
     {
         if (_ctx)
@@ -65,6 +65,24 @@ namespace Xale::Net
     }
 
     int LinuxSSLSocket::send(const std::vector<uint8_t>* data, size_t size)
+    {
+        return send(data ? data->data() : nullptr, size);
+    }
+
+    int LinuxSSLSocket::receive(std::vector<uint8_t>* buffer, size_t size)
+    {
+        if (!buffer) {
+            _logger.warning("No buffer to receive data");
+            return 0;
+        }
+
+        buffer->resize(size);
+        int bytesRead = receive(buffer->data(), size);
+        buffer->resize(bytesRead > 0 ? bytesRead : 0);
+        return bytesRead;
+    }
+
+    int LinuxSSLSocket::send(const uint8_t* data, size_t size)
     {
         if (!_ssl) {
             _logger.error("SSL connection not established");
@@ -76,7 +94,7 @@ namespace Xale::Net
             return 0;
         }
 
-        int bytesSent = SSL_write(_ssl, data->data(), static_cast<int>(size));
+        int bytesSent = SSL_write(_ssl, data, static_cast<int>(size));
         if (bytesSent <= 0) {
             _logger.error("SSL write failed");
             return -1;
@@ -85,7 +103,7 @@ namespace Xale::Net
         return bytesSent;
     }
 
-    int LinuxSSLSocket::receive(std::vector<uint8_t>* buffer, size_t size)
+    int LinuxSSLSocket::receive(uint8_t* buffer, size_t size)
     {
         if (!_ssl) {
             _logger.error("SSL connection not established");
@@ -97,15 +115,7 @@ namespace Xale::Net
             return 0;
         }
 
-        char* tempBuffer = new char[size];
-        int bytesRead = SSL_read(_ssl, tempBuffer, size);
-        
-        if (bytesRead > 0)
-            buffer->assign(tempBuffer, tempBuffer + bytesRead);
-
-        delete[] tempBuffer;
-
-        return bytesRead;
+        return SSL_read(_ssl, buffer, static_cast<int>(size));
     }
 
     void LinuxSSLSocket::close()
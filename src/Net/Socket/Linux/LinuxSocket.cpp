@@ -38,21 +38,27 @@ namespace Xale::Net
 
     int LinuxSocket::send(const std::vector<uint8_t>* data, size_t size)
     {
-        return ::send(_socket, data->data(), size, 0);
+        return send(data->data(), size);
     }
 
     int LinuxSocket::receive(std::vector<uint8_t>* buffer, size_t size)
     {
-        char* tempBuffer = new char[size];
-        int bytesRead = ::read(_socket, tempBuffer, size);
-        
-        if (bytesRead > 0)
-            buffer->assign(tempBuffer, tempBuffer + bytesRead);
-
-        delete[] tempBuffer;
+        buffer->resize(size);
+        int bytesRead = receive(buffer->data(), size);
+        buffer->resize(bytesRead > 0 ? bytesRead : 0);
         return bytesRead;
     }
 
+    int LinuxSocket::send(const uint8_t* data, size_t size)
+    {
+        return ::send(_socket, data, size, MSG_NOSIGNAL);
+    }
+
+    int LinuxSocket::receive(uint8_t* buffer, size_t size)
+    {
+        return ::read(_socket, buffer, size);
+    }
+
     void LinuxSocket::close()
     {
         ::close(_socket);
@@ -1,5 +1,7 @@
 #include "Net/TcpClient.h"
 
+#include <algorithm>
+
 namespace Xale::Net
 {
     TcpClient::TcpClient(std::unique_ptr<Xale::Net::ISocketFactory> socketFactory) : 
@@ -44,8 +46,18 @@ namespace Xale::Net
         if (!_socket)
             return -1;
 
-        std::vector<uint8_t> serializedData = data->serialize();
-        return _socket->send(&serializedData, serializedData.size());
+        _sendBuffer.clear();
+        data->serializeTo(_sendBuffer);
+
+        // A large packet may take several writes
+        std::size_t sent = 0;
+        while (sent < _sendBuffer.size()) {
+            int bytesSent = _socket->send(_sendBuffer.data() + sent, _sendBuffer.size() - sent);
+            if (bytesSent <= 0)
+                return -1;
+            sent += bytesSent;
+        }
+        return static_cast<int>(sent);
     }
 
     int TcpClient::receive(Xale::Net::Packet* buffer, size_t size)
@@ -53,12 +65,14 @@ namespace Xale::Net
         if (!_socket)
             return -1;
 
-        std::vector<uint8_t> tempBuffer;
-        int bytesRead = _socket->receive(&tempBuffer, size);
-        if (bytesRead > 0) {
-            buffer->deserialize(tempBuffer);
+        while (!_frames.next(*buffer)) {
+            const std::size_t readSize = std::max(size, _frames.missingBytes());
+            int bytesRead = _socket->receive(_frames.prepare(readSize), readSize);
+            if (bytesRead <= 0)
+                return bytesRead;
+            _frames.commit(bytesRead);
         }
-        return bytesRead;
+        return static_cast<int>(HEADER_SIZE + buffer->size());
     }
 
     void TcpClient::close()
@@ -66,6 +80,7 @@ namespace Xale::Net
         if (_socket) {
             _socket->close();
             _socket.reset();
+            _frames.clear();
         }
     }
 }
\ No newline at end of file
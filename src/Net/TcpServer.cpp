@@ -1,19 +1,39 @@
 #include "Net/TcpServer.h"
 
-#include <thread>
+#include <algorithm>
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace Xale::Net
 {
-    TcpServer::TcpServer(Xale::Engine::QueryEngine& queryEngine, std::unique_ptr<Xale::Net::ISocketFactory> socketFactory) :
+    namespace
+    {
+        /**
+         * @brief Event data of the listening socket and of the wakeup eventfd, clients being numbered from FIRST_SESSION
+         */
+        constexpr uint64_t LISTENER_EVENT = 0;
+        constexpr uint64_t WAKEUP_EVENT = 1;
+        constexpr uint64_t FIRST_SESSION = 2;
+    }
+
+    TcpServer::TcpServer(Xale::Execution::IExecutor& executor, std::unique_ptr<Xale::Net::ISocketFactory> socketFactory, TcpServerOptions options) :
         _logger(Xale::Logger::Logger<TcpServer>::getInstance()),
         _serverSocket(nullptr),
         _socketFactory(std::move(socketFactory)),
-        _queryEngine(queryEngine)
+        _executor(executor),
+        _options(options),
+        _wakeup(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+        _nextSession(FIRST_SESSION)
     {}
 
     TcpServer::~TcpServer()
     {
         stop();
+
+        if (_wakeup != -1)
+            ::close(_wakeup);
     }
 
     bool TcpServer::start(int port)
@@ -24,86 +44,309 @@ namespace Xale::Net
             return false;
         }
 
-        _logger.info("Server listening on port " + std::to_string(port) + "...");
+        _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1 || _wakeup == -1 || !_serverSocket->setNonBlocking()) {
+            _logger.error("Failed to set up the event loop");
+            shutdownLoop();
+            return false;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLET;
+        event.data.u64 = LISTENER_EVENT;
+        bool registered = ::epoll_ctl(_epoll, EPOLL_CTL_ADD, _serverSocket->getHandle(), &event) == 0;
+        event.data.u64 = WAKEUP_EVENT;
+        registered = registered && ::epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeup, &event) == 0;
 
-        while (true) {
-            auto conn = _serverSocket->acceptClient();
-            if (!conn) {
-                _logger.error("Accept failed, retrying...");
-                continue;
+        if (!registered) {
+            _logger.error("Failed to register the listener socket");
+            shutdownLoop();
+            return false;
+        }
+
+        _workers = std::make_unique<Xale::Core::ThreadPool>(_options.workerThreads);
+        _running = true;
+        _logger.info("Server listening on port " + std::to_string(port) + " with "
+            + std::to_string(_workers->getThreadCount()) + " workers...");
+
+        std::vector<epoll_event> events(std::max<std::size_t>(1, _options.maxEventsPerWait));
+        while (_running) {
+            int count = ::epoll_wait(_epoll, events.data(), static_cast<int>(events.size()), -1);
+            if (count < 0) {
+                if (errno == EINTR)
+                    continue;
+                _logger.error("Event loop wait failed");
+                break;
             }
 
-            // Spawn a detached thread per client — each thread owns its connection
-            std::thread([this, c = std::move(conn)]() mutable {
-                handleClient(std::move(c));
-            }).detach();
+            for (int i = 0; i < count; ++i) {
+                const uint64_t id = events[i].data.u64;
+
+                if (id == LISTENER_EVENT) {
+                    acceptClients();
+                    continue;
+                }
+                if (id == WAKEUP_EVENT) {
+                    handleCompletions();
+                    continue;
+                }
+
+                auto it = _sessions.find(id);
+                if (it == _sessions.end())
+                    continue;
+
+                // Edge-triggered: drain both directions on every event, the SSL handshake reading and writing alike
+                Session& session = it->second;
+                readClient(session);
+                flushClient(session);
+                updateSession(id);
+            }
         }
 
-        stop();
+        shutdownLoop();
         return true;
     }
 
-    void TcpServer::handleClient(std::unique_ptr<IClientConnection> conn)
+    void TcpServer::acceptClients()
     {
-        _logger.info("Client handler started");
+        while (auto conn = _serverSocket->acceptClient()) {
+            if (_sessions.size() >= _options.maxConnections) {
+                _logger.warning("Connection limit reached, client disconnected");
+                conn->close();
+                continue;
+            }
 
-        while (true) {
-            std::vector<uint8_t> buffer;
-            int bytesRead = conn->read(buffer, 4096);
+            if (!conn->setNonBlocking()) {
+                _logger.error("Failed to switch client to non-blocking mode");
+                continue;
+            }
 
-            if (bytesRead == 0) {
-                // Clean disconnect
-                break;
+            const uint64_t id = _nextSession++;
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+            event.data.u64 = id;
+
+            // Bytes received before the registration are reported by it
+            if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, conn->getHandle(), &event) != 0) {
+                _logger.error("Failed to register client");
+                continue;
+            }
+
+            auto session = _sessions.emplace(id, Session(_options.maxPayloadSize)).first;
+            session->second.connection = std::move(conn);
+            _connectionCount = _sessions.size();
+        }
+    }
+
+    void TcpServer::readClient(Session& session)
+    {
+        if (session.closing)
+            return;
+
+        try {
+            // A complete query waiting for its turn stops the reads, resumed by its completion
+            std::size_t missing;
+            while ((missing = session.frames.missingBytes()) > 0) {
+                const std::size_t size = std::max(_options.readChunkSize, missing);
+                int bytesRead = session.connection->read(session.frames.prepare(size), size);
+
+                if (bytesRead > 0) {
+                    session.frames.commit(bytesRead);
+                    continue;
+                }
+                if (bytesRead == IClientConnection::WOULD_BLOCK)
+                    return;
+
+                // Disconnected, the complete queries of a clean disconnect still being answered
+                session.closing = true;
+                if (bytesRead < 0) {
+                    _logger.error("Read error from client");
+                    session.frames.clear();
+                    session.output.clear();
+                    session.outputSent = 0;
+                }
+                return;
             }
-            if (bytesRead < 0) {
-                _logger.error("Read error from client");
+        } catch (const std::exception& e) {
+            rejectClient(session, std::string("Packet error: ") + e.what());
+        }
+    }
+
+    void TcpServer::flushClient(Session& session)
+    {
+        while (session.outputSent < session.output.size()) {
+            int bytesSent = session.connection->respond(session.output.data() + session.outputSent,
+                session.output.size() - session.outputSent);
+
+            if (bytesSent == IClientConnection::WOULD_BLOCK)
+                return;
+            if (bytesSent <= 0) {
+                _logger.error("Write error to client");
+                session.closing = true;
+                session.frames.clear();
                 break;
             }
 
-            // Deserialize incoming buffer to Packet
-            Xale::Net::Packet packet(Xale::Net::CommandType::UNKNOWN, {});
-            try {
-                packet.deserialize(buffer);
-            } catch (const std::exception& e) {
-                std::string errorMsg = std::string("Packet error: ") + e.what();
-                _logger.error(errorMsg);
-                Xale::Net::Packet errorPacket(Xale::Net::CommandType::RESPONSE,
-                    std::vector<uint8_t>(errorMsg.begin(), errorMsg.end()));
-                auto serialized = errorPacket.serialize();
-                conn->respond(&serialized, serialized.size());
-                continue;
+            session.outputSent += bytesSent;
+        }
+
+        session.output.clear();
+        session.outputSent = 0;
+    }
+
+    void TcpServer::dispatch(uint64_t id, Session& session)
+    {
+        session.busy = true;
+        if (!session.context)
+            session.context = std::make_unique<Xale::Engine::SessionContext>(_executor);
+
+        // The event loop leaves the request and the context alone while the session is busy
+        _workers->submit([this, id, context = session.context.get(), request = &session.request]() {
+            std::vector<uint8_t> response = handleRequest(*context, *request);
+            {
+                std::lock_guard<std::mutex> lock(_completionMutex);
+                _completions.push_back({ id, std::move(response) });
             }
 
-            std::vector<uint8_t> payload = packet.getPayload();
-            std::string query(payload.begin(), payload.end());
-            _logger.info("Received query: " + query);
+            uint64_t signal = 1;
+            if (::write(_wakeup, &signal, sizeof(signal)) < 0)
+                _logger.error("Failed to wake up the event loop");
+        });
+    }
+
+    void TcpServer::rejectClient(Session& session, const std::string& error)
+    {
+        _logger.error(error);
+
+        // The stream cannot be resynchronized past a bad header
+        session.frames.clear();
+        session.closing = true;
+
+        Xale::Net::Packet errorPacket(Xale::Net::CommandType::RESPONSE,
+            std::vector<uint8_t>(error.begin(), error.end()));
+        errorPacket.serializeTo(session.output);
+    }
+
+    void TcpServer::handleCompletions()
+    {
+        uint64_t signaled = 0;
+        while (::read(_wakeup, &signaled, sizeof(signaled)) > 0) {}
+
+        std::vector<Completion> completions;
+        {
+            std::lock_guard<std::mutex> lock(_completionMutex);
+            completions.swap(_completions);
+        }
 
-            std::string response;
+        for (auto& completion : completions) {
+            auto it = _sessions.find(completion.session);
+            if (it == _sessions.end())
+                continue;
+
+            Session& session = it->second;
+            session.busy = false;
+            if (session.output.empty())
+                session.output.swap(completion.response);
+            else
+                session.output.insert(session.output.end(), completion.response.begin(), completion.response.end());
+
+            flushClient(session);
+            updateSession(completion.session);
+        }
+    }
+
+    void TcpServer::updateSession(uint64_t id)
+    {
+        Session& session = _sessions.at(id);
+
+        if (!session.busy) {
+            bool ready = false;
             try {
-                std::lock_guard<std::mutex> lock(_queryMutex);
-                _queryEngine.run(query);
-                response = _queryEngine.getResultsToString();
+                ready = session.frames.next(session.request);
             } catch (const std::exception& e) {
-                response = std::string("Error: ") + e.what();
-                _logger.error(response);
+                rejectClient(session, std::string("Packet error: ") + e.what());
+                flushClient(session);
             }
 
-            Xale::Net::Packet responsePacket(Xale::Net::CommandType::RESPONSE,
-                std::vector<uint8_t>(response.begin(), response.end()));
-            auto serialized = responsePacket.serialize();
-            conn->respond(&serialized, serialized.size());
-            _logger.info("Response sent");
+            if (ready) {
+                dispatch(id, session);
+
+                // Reads stopped on the complete query just handed over
+                readClient(session);
+                flushClient(session);
+            }
         }
 
-        conn->close();
-        _logger.info("Client handler finished");
+        if (!session.closing || session.busy || !session.output.empty())
+            return;
+
+        ::epoll_ctl(_epoll, EPOLL_CTL_DEL, session.connection->getHandle(), nullptr);
+        session.connection->close();
+        _sessions.erase(id);
+        _connectionCount = _sessions.size();
     }
 
-    void TcpServer::stop()
+    std::vector<uint8_t> TcpServer::handleRequest(Xale::Engine::SessionContext& context, const Packet& request)
     {
+        const std::vector<uint8_t>& payload = request.getPayload();
+        std::string query(payload.begin(), payload.end());
+        _logger.info("Received query: " + (query.size() > 256 ? query.substr(0, 256) + "..." : query));
+
+        std::string response;
+        try {
+            auto& queryEngine = context.getQueryEngine();
+            queryEngine.run(query);
+            response = queryEngine.getResultsToString();
+        } catch (const std::exception& e) {
+            response = std::string("Error: ") + e.what();
+            _logger.error(response);
+        }
+
+        Xale::Net::Packet responsePacket(Xale::Net::CommandType::RESPONSE,
+            std::vector<uint8_t>(response.begin(), response.end()));
+        return responsePacket.serialize();
+    }
+
+    void TcpServer::shutdownLoop()
+    {
+        _running = false;
+
+        // Queries already handed to the workers complete first
+        _workers.reset();
+        _completions.clear();
+
+        for (auto& [id, session] : _sessions)
+            session.connection->close();
+        _sessions.clear();
+        _connectionCount = 0;
+
+        if (_epoll != -1) {
+            ::close(_epoll);
+            _epoll = -1;
+        }
+
         if (_serverSocket) {
             _serverSocket->close();
             _logger.info("Server stopped");
         }
     }
+
+    void TcpServer::stop()
+    {
+        // The event loop closes everything on its way out
+        if (_running.exchange(false)) {
+            uint64_t signal = 1;
+            if (::write(_wakeup, &signal, sizeof(signal)) < 0)
+                _logger.error("Failed to wake up the event loop");
+            return;
+        }
+
+        if (_serverSocket)
+            _serverSocket->close();
+    }
+
+    std::size_t TcpServer::getConnectionCount() const
+    {
+        return _connectionCount;
+    }
 }
@@ -2,6 +2,16 @@
 
 namespace Xale::Query
 {
+    namespace
+    {
+        std::unique_ptr<Expression> makeBinary(std::unique_ptr<Expression> left, const std::string& op, std::unique_ptr<Expression> right)
+        {
+            auto expr = std::make_unique<Expression>(ExpressionType::BinaryOp);
+            expr->binary = std::make_unique<BinaryExpression>(std::move(left), op, std::move(right));
+            return expr;
+        }
+    }
+
     BasicParser::BasicParser()
         : _tokenizer(nullptr)
     {}
@@ -72,6 +82,17 @@ namespace Xale::Query
         return upper == identifier;
     }
 
+    bool BasicParser::peekIdentifier(const std::string& identifier)
+    {
+        Token next = _tokenizer->peekToken();
+        if (next.type != TokenType::Identifier)
+            return false;
+
+        std::transform(next.lexeme.begin(), next.lexeme.end(), next.lexeme.begin(), ::toupper);
+
+        return next.lexeme == identifier;
+    }
+
     void BasicParser::expect(TokenType type, const std::string& errorMsg)
     {
         if (!match(type))
@@ -101,14 +122,18 @@ namespace Xale::Query
         else if (matchKeyword("DELETE"))
             return parseDelete();
         else if (matchKeyword("CREATE"))
-            return parseCreate();
+            return peekIdentifier("INDEX") ? std::unique_ptr<Statement>(parseCreateIndex()) : parseCreate();
         else if (matchKeyword("DROP"))
-            return parseDrop();
+            return peekIdentifier("INDEX") ? std::unique_ptr<Statement>(parseDropIndex()) : parseDrop();
         else if (matchKeyword("LIST"))
             return parseList();
+        else if (matchIdentifier("EXPLAIN"))
+            return parseExplain();
+        else if (matchIdentifier("BEGIN") || matchIdentifier("COMMIT") || matchIdentifier("ROLLBACK"))
+            return parseTransaction();
         else
         {
-            throwError("Expected SQL statement (SELECT, INSERT, UPDATE, DELETE, CREATE, DROP)");
+            throwError("Expected SQL statement (SELECT, INSERT, UPDATE, DELETE, CREATE, DROP, EXPLAIN, BEGIN, COMMIT, ROLLBACK)");
             return nullptr;
         }
     }
@@ -131,9 +156,14 @@ namespace Xale::Query
             {
                 if (match(TokenType::Identifier))
                 {
-                    stmt->columns.push_back(Expression(ExpressionType::Identifier, _currentToken.lexeme));
+                    std::string name = _currentToken.lexeme;
                     advance();
 
+                    if (match(TokenType::Operator) && _currentToken.lexeme == "(")
+                        stmt->columns.push_back(parseAggregate(name));
+                    else
+                        stmt->columns.push_back(Expression(ExpressionType::Identifier, name));
+
                     if (match(TokenType::Operator) && _currentToken.lexeme == ",")
                         advance();
                     else
@@ -165,9 +195,117 @@ namespace Xale::Query
         if (matchKeyword("WHERE"))
             stmt->where = parseWhereClause();
 
+        // Optional GROUP BY column, ...
+        if (matchKeyword("GROUP"))
+        {
+            advance();
+            expectKeyword("BY", "Expected BY keyword after GROUP");
+            advance();
+
+            do
+            {
+                expect(TokenType::Identifier, "Expected column name");
+                stmt->groupBy.push_back(_currentToken.lexeme);
+                advance();
+
+                if (!(match(TokenType::Operator) && _currentToken.lexeme == ","))
+                    break;
+                advance();
+            } while (true);
+        }
+
+        // Optional ORDER BY column [ASC|DESC], ...
+        if (matchKeyword("ORDER"))
+        {
+            advance();
+            expectKeyword("BY", "Expected BY keyword after ORDER");
+            advance();
+
+            do
+            {
+                expect(TokenType::Identifier, "Expected column name");
+                std::string name = _currentToken.lexeme;
+                advance();
+
+                OrderByItem item;
+                if (match(TokenType::Operator) && _currentToken.lexeme == "(")
+                    item.expression = parseAggregate(name);
+                else
+                    item.expression = Expression(ExpressionType::Identifier, name);
+
+                if (matchKeyword("DESC"))
+                {
+                    item.descending = true;
+                    advance();
+                }
+                else if (matchKeyword("ASC"))
+                {
+                    advance();
+                }
+                stmt->orderBy.push_back(std::move(item));
+
+                if (!(match(TokenType::Operator) && _currentToken.lexeme == ","))
+                    break;
+                advance();
+            } while (true);
+        }
+
+        // Optional LIMIT count [OFFSET count]
+        if (matchKeyword("LIMIT"))
+        {
+            advance();
+            stmt->hasLimit = true;
+            stmt->limit = parseRowCount();
+
+            if (matchKeyword("OFFSET"))
+            {
+                advance();
+                stmt->offset = parseRowCount();
+            }
+        }
+
         return stmt;
     }
 
+    Expression BasicParser::parseAggregate(const std::string& name)
+    {
+        std::string upper = name;
+        std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+        if (upper != "COUNT" && upper != "SUM" && upper != "AVG" && upper != "MIN" && upper != "MAX")
+            throwError("Unknown function: " + name);
+
+        Expression expr(ExpressionType::Aggregate, upper);
+        advance(); // '('
+
+        // Only COUNT accepts a wildcard, counting every row
+        if (upper == "COUNT" && match(TokenType::Operator) && _currentToken.lexeme == "*")
+            expr.argument = std::make_unique<Expression>(ExpressionType::Wildcard, "*");
+        else if (match(TokenType::Identifier))
+            expr.argument = std::make_unique<Expression>(ExpressionType::Identifier, _currentToken.lexeme);
+        else
+            throwError("Expected column name");
+        advance();
+
+        if (!(match(TokenType::Operator) && _currentToken.lexeme == ")"))
+            throwError("Expected ')' after function argument");
+        advance();
+
+        return expr;
+    }
+
+    size_t BasicParser::parseRowCount()
+    {
+        if (!match(TokenType::NumericLiteral) || _currentToken.lexeme.find('.') != std::string::npos)
+            throwError("Expected row count");
+
+        size_t count = 0;
+        try { count = std::stoull(_currentToken.lexeme); }
+        catch (...) { throwError("Invalid row count"); }
+        advance();
+
+        return count;
+    }
+
     std::unique_ptr<InsertStatement> BasicParser::parseInsert()
     {
         auto stmt = std::make_unique<InsertStatement>();
@@ -368,6 +506,43 @@ namespace Xale::Query
         return stmt;
     }
 
+    std::unique_ptr<CreateIndexStatement> BasicParser::parseCreateIndex()
+    {
+        auto stmt = std::make_unique<CreateIndexStatement>();
+
+        expectKeyword("CREATE", "Expected CREATE keyword");
+        advance();
+
+        if (!matchIdentifier("INDEX"))
+            throwError("Expected INDEX keyword");
+        advance();
+
+        expect(TokenType::Identifier, "Expected index name");
+        stmt->indexName = _currentToken.lexeme;
+        advance();
+
+        expectKeyword("ON", "Expected ON keyword");
+        advance();
+
+        expect(TokenType::Identifier, "Expected table name");
+        stmt->tableName = _currentToken.lexeme;
+        advance();
+
+        if (!match(TokenType::Operator) || _currentToken.lexeme != "(")
+            throwError("Expected '(' before indexed column");
+        advance();
+
+        expect(TokenType::Identifier, "Expected column name");
+        stmt->columnName = _currentToken.lexeme;
+        advance();
+
+        if (!match(TokenType::Operator) || _currentToken.lexeme != ")")
+            throwError("Expected ')' after indexed column");
+        advance();
+
+        return stmt;
+    }
+
     std::unique_ptr<DropStatement> BasicParser::parseDrop()
     {
         auto stmt = std::make_unique<DropStatement>();
@@ -391,6 +566,24 @@ namespace Xale::Query
         return stmt;
     }
 
+    std::unique_ptr<DropIndexStatement> BasicParser::parseDropIndex()
+    {
+        auto stmt = std::make_unique<DropIndexStatement>();
+
+        expectKeyword("DROP", "Expected DROP keyword");
+        advance();
+
+        if (!matchIdentifier("INDEX"))
+            throwError("Expected INDEX keyword");
+        advance();
+
+        expect(TokenType::Identifier, "Expected index name");
+        stmt->indexName = _currentToken.lexeme;
+        advance();
+
+        return stmt;
+    }
+
     std::unique_ptr<ListStatement> BasicParser::parseList()
     {
         auto stmt = std::make_unique<ListStatement>();
@@ -410,17 +603,151 @@ namespace Xale::Query
         return stmt;
     }
 
+    std::unique_ptr<ExplainStatement> BasicParser::parseExplain()
+    {
+        auto stmt = std::make_unique<ExplainStatement>();
+
+        if (!matchIdentifier("EXPLAIN"))
+            throwError("Expected EXPLAIN keyword");
+        advance();
+
+        expectKeyword("SELECT", "Expected SELECT statement after EXPLAIN");
+        stmt->select = parseSelect();
+
+        return stmt;
+    }
+
+    std::unique_ptr<TransactionStatement> BasicParser::parseTransaction()
+    {
+        std::string keyword = _currentToken.lexeme;
+        std::transform(keyword.begin(), keyword.end(), keyword.begin(), ::toupper);
+        advance();
+
+        StatementType type = StatementType::Rollback;
+        if (keyword == "BEGIN")
+            type = StatementType::Begin;
+        else if (keyword == "COMMIT")
+            type = StatementType::Commit;
+
+        // BEGIN TRANSACTION, COMMIT TRANSACTION, ROLLBACK TRANSACTION
+        if (matchIdentifier("TRANSACTION"))
+            advance();
+
+        return std::make_unique<TransactionStatement>(type);
+    }
+
     std::unique_ptr<Expression> BasicParser::parseExpression()
     {
-        return parseComparison();
+        auto left = parseAnd();
+
+        while (matchKeyword("OR"))
+        {
+            advance();
+            left = makeBinary(std::move(left), "OR", parseAnd());
+        }
+
+        return left;
+    }
+
+    std::unique_ptr<Expression> BasicParser::parseAnd()
+    {
+        auto left = parseNot();
+
+        while (matchKeyword("AND"))
+        {
+            advance();
+            left = makeBinary(std::move(left), "AND", parseNot());
+        }
+
+        return left;
+    }
+
+    std::unique_ptr<Expression> BasicParser::parseNot()
+    {
+        if (!matchKeyword("NOT"))
+            return parseComparison();
+
+        advance();
+        auto expr = std::make_unique<Expression>(ExpressionType::Not);
+        expr->argument = parseNot();
+        return expr;
     }
 
     std::unique_ptr<Expression> BasicParser::parseComparison()
     {
+        if (match(TokenType::Operator) && _currentToken.lexeme == "(")
+        {
+            advance();
+            auto expr = parseExpression();
+            if (!match(TokenType::Operator) || _currentToken.lexeme != ")")
+                throwError("Expected ')' after condition");
+            advance();
+            return expr;
+        }
+
         auto left = parsePrimary();
         if (!left)
             return nullptr;
 
+        // [NOT] IN (literal, ...) and [NOT] BETWEEN literal AND literal
+        bool negated = false;
+        if (matchKeyword("NOT"))
+        {
+            negated = true;
+            advance();
+            if (!matchKeyword("IN") && !matchKeyword("BETWEEN"))
+                throwError("Expected IN or BETWEEN after NOT");
+        }
+
+        if (matchKeyword("IN") || matchKeyword("BETWEEN"))
+        {
+            const bool isIn = matchKeyword("IN");
+            auto expr = std::make_unique<Expression>(isIn ? ExpressionType::In : ExpressionType::Between);
+            expr->argument = std::move(left);
+            advance();
+
+            auto parseLiteral = [this, &expr]() {
+                if (!match(TokenType::StringLiteral) && !match(TokenType::NumericLiteral))
+                    throwError("Expected literal");
+                expr->list.push_back(Expression(
+                    match(TokenType::StringLiteral) ? ExpressionType::StringLiteral : ExpressionType::NumericLiteral,
+                    _currentToken.lexeme));
+                advance();
+            };
+
+            if (isIn)
+            {
+                if (!match(TokenType::Operator) || _currentToken.lexeme != "(")
+                    throwError("Expected '(' after IN");
+                advance();
+
+                parseLiteral();
+                while (match(TokenType::Operator) && _currentToken.lexeme == ",")
+                {
+                    advance();
+                    parseLiteral();
+                }
+
+                if (!match(TokenType::Operator) || _currentToken.lexeme != ")")
+                    throwError("Expected ')' after IN list");
+                advance();
+            }
+            else
+            {
+                parseLiteral();
+                expectKeyword("AND", "Expected AND in BETWEEN");
+                advance();
+                parseLiteral();
+            }
+
+            if (!negated)
+                return expr;
+
+            auto notExpr = std::make_unique<Expression>(ExpressionType::Not);
+            notExpr->argument = std::move(expr);
+            return notExpr;
+        }
+
         if (match(TokenType::Operator))
         {
             std::string op = _currentToken.lexeme;
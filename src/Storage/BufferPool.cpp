@@ -0,0 +1,294 @@
+#include "Storage/BufferPool.h"
+
+#include <cstring>
+
+namespace Xale::Storage
+{
+    namespace
+    {
+        constexpr char PAGED_FILE_MAGIC[4] = { 'X', 'D', 'B', 'P' };
+        constexpr std::uint32_t PAGED_FILE_VERSION = 1;
+    }
+
+    BufferPool::BufferPool(IFileManager& fileManager, std::size_t capacity)
+        : _fileManager(fileManager),
+          _frames(capacity == 0 ? 1 : capacity)
+    {
+        std::memset(&_header, 0, sizeof(_header));
+    }
+
+    bool BufferPool::hasPagedLayout(IFileManager& fileManager)
+    {
+        if (fileManager.size() < PAGE_SIZE)
+            return false;
+
+        char magic[4] = {};
+        fileManager.readAt(0, magic, sizeof(magic));
+        return std::memcmp(magic, PAGED_FILE_MAGIC, sizeof(magic)) == 0;
+    }
+
+    bool BufferPool::open()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        _pageTable.clear();
+        for (auto& frame : _frames)
+            frame = Frame();
+
+        if (hasPagedLayout(_fileManager))
+        {
+            _fileManager.readAt(0, &_header, sizeof(_header));
+            if (_header.version != PAGED_FILE_VERSION)
+                THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Unsupported data file version");
+            _headerDirty = false;
+            return true;
+        }
+
+        std::memcpy(_header.magic, PAGED_FILE_MAGIC, sizeof(PAGED_FILE_MAGIC));
+        _header.version = PAGED_FILE_VERSION;
+        _header.pageCount = 1;
+        _header.freeListHead = INVALID_PAGE_ID;
+        _header.rootPageId = INVALID_PAGE_ID;
+        _headerDirty = true;
+        return false;
+    }
+
+    Page* BufferPool::fetchPage(PageId pageId)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return fetchPageUnlocked(pageId);
+    }
+
+    Page* BufferPool::fetchPageUnlocked(PageId pageId)
+    {
+        if (pageId == 0 || pageId >= _header.pageCount)
+            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Invalid page id " + std::to_string(pageId));
+
+        auto it = _pageTable.find(pageId);
+        if (it != _pageTable.end())
+        {
+            Frame& frame = _frames[it->second];
+            ++frame.pinCount;
+            frame.referenced = true;
+            return &frame.page;
+        }
+
+        std::size_t index = acquireFrame();
+        Frame& frame = _frames[index];
+
+        std::memset(frame.page.data(), 0, PAGE_SIZE);
+        _fileManager.readAt(static_cast<std::uint64_t>(pageId) * PAGE_SIZE, frame.page.data(), PAGE_SIZE);
+        ++_readCount;
+
+        frame.pageId = pageId;
+        frame.pinCount = 1;
+        frame.dirty = false;
+        frame.referenced = true;
+        _pageTable[pageId] = index;
+
+        return &frame.page;
+    }
+
+    void BufferPool::unpinPage(PageId pageId, bool isDirty)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _pageTable.find(pageId);
+        if (it == _pageTable.end())
+            return;
+
+        Frame& frame = _frames[it->second];
+        if (frame.pinCount > 0)
+            --frame.pinCount;
+        frame.dirty = frame.dirty || isDirty;
+    }
+
+    Page* BufferPool::newPage(PageType type, PageId& outPageId)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        Page* page = nullptr;
+
+        if (_header.freeListHead != INVALID_PAGE_ID)
+        {
+            outPageId = _header.freeListHead;
+            page = fetchPageUnlocked(outPageId);
+            _header.freeListHead = page->getNextPageId();
+        }
+        else
+        {
+            std::size_t index = acquireFrame();
+            Frame& frame = _frames[index];
+
+            outPageId = _header.pageCount++;
+            frame.pageId = outPageId;
+            frame.pinCount = 1;
+            frame.referenced = true;
+            _pageTable[outPageId] = index;
+            page = &frame.page;
+        }
+
+        _headerDirty = true;
+        page->init(type);
+        _frames[_pageTable[outPageId]].dirty = true;
+
+        return page;
+    }
+
+    void BufferPool::freePage(PageId pageId)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        Page* page = fetchPageUnlocked(pageId);
+        page->init(PageType::Free);
+        page->setNextPageId(_header.freeListHead);
+        _header.freeListHead = pageId;
+        _headerDirty = true;
+
+        Frame& frame = _frames[_pageTable[pageId]];
+        frame.dirty = true;
+        --frame.pinCount;
+    }
+
+    void BufferPool::flushPage(PageId pageId)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _pageTable.find(pageId);
+        if (it != _pageTable.end() && _frames[it->second].dirty)
+            writeFrame(_frames[it->second]);
+    }
+
+    void BufferPool::flushAllPages()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (auto& frame : _frames)
+        {
+            if (frame.pageId != INVALID_PAGE_ID && frame.dirty)
+                writeFrame(frame);
+        }
+
+        if (_headerDirty)
+            writeHeader();
+    }
+
+    void BufferPool::forEachDirtyPage(const std::function<void(PageId, const char*)>& callback)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        if (_headerDirty)
+        {
+            std::vector<char> headerPage(PAGE_SIZE, 0);
+            std::memcpy(headerPage.data(), &_header, sizeof(_header));
+            callback(0, headerPage.data());
+        }
+
+        for (const auto& frame : _frames)
+        {
+            if (frame.pageId != INVALID_PAGE_ID && frame.dirty)
+                callback(frame.pageId, frame.page.data());
+        }
+    }
+
+    void BufferPool::setNoSteal(bool noSteal)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _noSteal = noSteal;
+    }
+
+    PageId BufferPool::getRootPageId() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _header.rootPageId;
+    }
+
+    void BufferPool::setRootPageId(PageId pageId)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _header.rootPageId = pageId;
+        _headerDirty = true;
+    }
+
+    std::uint32_t BufferPool::getPageCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _header.pageCount;
+    }
+
+    std::size_t BufferPool::getCapacity() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _frames.size();
+    }
+
+    std::uint64_t BufferPool::getReadCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _readCount;
+    }
+
+    std::uint64_t BufferPool::getWriteCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _writeCount;
+    }
+
+    std::size_t BufferPool::acquireFrame()
+    {
+        // Two full turns: the first one may only clear reference bits
+        for (std::size_t i = 0; i < 2 * _frames.size(); ++i)
+        {
+            std::size_t index = _clockHand;
+            _clockHand = (_clockHand + 1) % _frames.size();
+
+            Frame& frame = _frames[index];
+            if (frame.pageId == INVALID_PAGE_ID)
+                return index;
+
+            if (frame.pinCount > 0)
+                continue;
+
+            if (frame.referenced)
+            {
+                frame.referenced = false;
+                continue;
+            }
+
+            if (frame.dirty)
+            {
+                if (_noSteal)
+                    continue;
+                writeFrame(frame);
+            }
+
+            _pageTable.erase(frame.pageId);
+            frame.pageId = INVALID_PAGE_ID;
+            return index;
+        }
+
+        if (_noSteal)
+        {
+            _frames.emplace_back();
+            return _frames.size() - 1;
+        }
+
+        THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::DataStruct, "Buffer pool exhausted, every page is pinned");
+    }
+
+    void BufferPool::writeFrame(Frame& frame)
+    {
+        _fileManager.writeAt(static_cast<std::uint64_t>(frame.pageId) * PAGE_SIZE, frame.page.data(), PAGE_SIZE);
+        frame.dirty = false;
+        ++_writeCount;
+    }
+
+    void BufferPool::writeHeader()
+    {
+        std::vector<char> headerPage(PAGE_SIZE, 0);
+        std::memcpy(headerPage.data(), &_header, sizeof(_header));
+        _fileManager.writeAt(0, headerPage.data(), PAGE_SIZE);
+        _headerDirty = false;
+        ++_writeCount;
+    }
+}
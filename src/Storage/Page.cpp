@@ -0,0 +1,248 @@
+#include "Storage/Page.h"
+
+#include <cstring>
+#include <vector>
+
+namespace Xale::Storage
+{
+    namespace
+    {
+        constexpr std::size_t SLOT_ENTRY_SIZE = 2 * sizeof(std::uint16_t);
+        constexpr std::uint16_t LENGTH_MASK = 0x7FFF;
+    }
+
+    void Page::init(PageType type)
+    {
+        std::memset(_data, 0, PAGE_SIZE);
+        PageHeader* h = header();
+        h->nextPageId = INVALID_PAGE_ID;
+        h->slotCount = 0;
+        h->freeStart = static_cast<std::uint16_t>(sizeof(PageHeader));
+        h->freeEnd = static_cast<std::uint16_t>(PAGE_SIZE);
+        h->type = static_cast<std::uint8_t>(type);
+        h->reserved = 0;
+    }
+
+    char* Page::data()
+    {
+        return _data;
+    }
+
+    const char* Page::data() const
+    {
+        return _data;
+    }
+
+    char* Page::payload()
+    {
+        return _data + sizeof(PageHeader);
+    }
+
+    const char* Page::payload() const
+    {
+        return _data + sizeof(PageHeader);
+    }
+
+    PageType Page::getType() const
+    {
+        return static_cast<PageType>(header()->type);
+    }
+
+    PageId Page::getNextPageId() const
+    {
+        return header()->nextPageId;
+    }
+
+    void Page::setNextPageId(PageId pageId)
+    {
+        header()->nextPageId = pageId;
+    }
+
+    std::uint16_t Page::getSlotCount() const
+    {
+        return header()->slotCount;
+    }
+
+    std::size_t Page::getFreeSpace() const
+    {
+        const std::size_t used = getUsedSpace();
+        if (used + SLOT_ENTRY_SIZE >= PAGE_SIZE)
+            return 0;
+
+        return PAGE_SIZE - used - SLOT_ENTRY_SIZE;
+    }
+
+    int Page::insertRecord(const char* record, std::uint16_t size, bool flag)
+    {
+        if (size > maxRecordSize())
+            return -1;
+
+        PageHeader* h = header();
+
+        int slot = -1;
+        for (std::uint16_t i = 0; i < h->slotCount; ++i)
+        {
+            if (slotEntry(i)[0] == 0)
+            {
+                slot = i;
+                break;
+            }
+        }
+
+        const std::size_t needed = size + (slot == -1 ? SLOT_ENTRY_SIZE : 0);
+        if (static_cast<std::size_t>(h->freeEnd - h->freeStart) < needed)
+        {
+            if (getUsedSpace() + needed > PAGE_SIZE)
+                return -1;
+            compact();
+        }
+
+        if (slot == -1)
+        {
+            slot = h->slotCount++;
+            h->freeStart += SLOT_ENTRY_SIZE;
+        }
+
+        h->freeEnd -= size;
+        if (size > 0)
+            std::memcpy(_data + h->freeEnd, record, size);
+
+        std::uint16_t* entry = slotEntry(static_cast<std::uint16_t>(slot));
+        entry[0] = h->freeEnd;
+        entry[1] = size | (flag ? RECORD_FLAG : 0);
+
+        return slot;
+    }
+
+    bool Page::updateRecord(std::uint16_t slot, const char* record, std::uint16_t size, bool flag)
+    {
+        PageHeader* h = header();
+        if (slot >= h->slotCount || slotEntry(slot)[0] == 0)
+            return false;
+
+        std::uint16_t* entry = slotEntry(slot);
+        const std::uint16_t oldSize = entry[1] & LENGTH_MASK;
+
+        // Shrinking or same size: overwrite in place, the hole is recovered on compaction
+        if (size <= oldSize)
+        {
+            if (size > 0)
+                std::memmove(_data + entry[0], record, size);
+            entry[1] = size | (flag ? RECORD_FLAG : 0);
+            return true;
+        }
+
+        // Not from getFreeSpace(), which rounds down to 0 a page too full for one more slot entry
+        if (getUsedSpace() - oldSize + size > PAGE_SIZE)
+            return false;
+
+        entry[0] = 0;
+        if (static_cast<std::size_t>(h->freeEnd - h->freeStart) < size)
+            compact();
+
+        h->freeEnd -= size;
+        std::memcpy(_data + h->freeEnd, record, size);
+        entry = slotEntry(slot);
+        entry[0] = h->freeEnd;
+        entry[1] = size | (flag ? RECORD_FLAG : 0);
+
+        return true;
+    }
+
+    void Page::eraseRecord(std::uint16_t slot)
+    {
+        PageHeader* h = header();
+        if (slot >= h->slotCount)
+            return;
+
+        std::uint16_t* entry = slotEntry(slot);
+        entry[0] = 0;
+        entry[1] = 0;
+
+        // Trailing empty slots can be dropped, nobody references them anymore
+        while (h->slotCount > 0 && slotEntry(h->slotCount - 1)[0] == 0)
+        {
+            --h->slotCount;
+            h->freeStart -= SLOT_ENTRY_SIZE;
+        }
+
+        if (h->slotCount == 0)
+            h->freeEnd = static_cast<std::uint16_t>(PAGE_SIZE);
+    }
+
+    const char* Page::getRecord(std::uint16_t slot, std::uint16_t& size, bool* flag) const
+    {
+        const PageHeader* h = header();
+        size = 0;
+
+        if (slot >= h->slotCount)
+            return nullptr;
+
+        const std::uint16_t* entry = slotEntry(slot);
+        if (entry[0] == 0)
+            return nullptr;
+
+        size = entry[1] & LENGTH_MASK;
+        if (flag)
+            *flag = (entry[1] & RECORD_FLAG) != 0;
+
+        return _data + entry[0];
+    }
+
+    PageHeader* Page::header()
+    {
+        return reinterpret_cast<PageHeader*>(_data);
+    }
+
+    const PageHeader* Page::header() const
+    {
+        return reinterpret_cast<const PageHeader*>(_data);
+    }
+
+    std::uint16_t* Page::slotEntry(std::uint16_t slot)
+    {
+        return reinterpret_cast<std::uint16_t*>(_data + sizeof(PageHeader) + slot * SLOT_ENTRY_SIZE);
+    }
+
+    const std::uint16_t* Page::slotEntry(std::uint16_t slot) const
+    {
+        return reinterpret_cast<const std::uint16_t*>(_data + sizeof(PageHeader) + slot * SLOT_ENTRY_SIZE);
+    }
+
+    std::size_t Page::getUsedSpace() const
+    {
+        const PageHeader* h = header();
+        std::size_t used = sizeof(PageHeader) + h->slotCount * SLOT_ENTRY_SIZE;
+
+        for (std::uint16_t i = 0; i < h->slotCount; ++i)
+        {
+            const std::uint16_t* entry = slotEntry(i);
+            if (entry[0] != 0)
+                used += entry[1] & LENGTH_MASK;
+        }
+
+        return used;
+    }
+
+    void Page::compact()
+    {
+        PageHeader* h = header();
+        std::vector<char> heap(PAGE_SIZE);
+        std::uint16_t end = static_cast<std::uint16_t>(PAGE_SIZE);
+
+        for (std::uint16_t i = 0; i < h->slotCount; ++i)
+        {
+            std::uint16_t* entry = slotEntry(i);
+            if (entry[0] == 0)
+                continue;
+
+            const std::uint16_t size = entry[1] & LENGTH_MASK;
+            end -= size;
+            std::memcpy(heap.data() + end, _data + entry[0], size);
+            entry[0] = end;
+        }
+
+        std::memcpy(_data + end, heap.data() + end, PAGE_SIZE - end);
+        h->freeEnd = end;
+    }
+}
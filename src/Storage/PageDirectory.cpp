@@ -0,0 +1,387 @@
+#include "Storage/PageDirectory.h"
+
+#include <cstring>
+
+namespace Xale::Storage
+{
+    namespace
+    {
+        /**
+         * @brief Stub stored inline for records living in overflow pages
+         */
+        struct OverflowStub
+        {
+            std::uint32_t size;
+            PageId firstPageId;
+        };
+
+        constexpr std::size_t OVERFLOW_CHUNK_SIZE = Page::payloadSize() - sizeof(std::uint32_t);
+    }
+
+    PageDirectory::PageDirectory(BufferPool& pool, PageId rootPageId)
+        : _pool(pool),
+          _rootPageId(rootPageId)
+    {
+        PageId current = rootPageId;
+        while (current != INVALID_PAGE_ID)
+        {
+            Page* page = _pool.fetchPage(current);
+            if (page->getType() != PageType::Directory)
+            {
+                _pool.unpinPage(current, false);
+                THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Corrupted page directory");
+            }
+
+            std::uint32_t count = 0;
+            std::memcpy(&count, page->payload(), sizeof(count));
+            const PageId* entries = reinterpret_cast<const PageId*>(page->payload() + sizeof(std::uint32_t));
+
+            for (std::uint32_t i = 0; i < count && i < entriesPerPage(); ++i)
+            {
+                _pagesWithSpace.insert(_dataPages.size());
+                _pageIndexes[entries[i]] = _dataPages.size();
+                _dataPages.push_back(entries[i]);
+            }
+
+            _directoryPages.push_back(current);
+            PageId next = page->getNextPageId();
+            _pool.unpinPage(current, false);
+            current = next;
+        }
+    }
+
+    PageId PageDirectory::create(BufferPool& pool)
+    {
+        PageId pageId = INVALID_PAGE_ID;
+        pool.newPage(PageType::Directory, pageId);
+        pool.unpinPage(pageId, true);
+        return pageId;
+    }
+
+    PageId PageDirectory::getRootPageId() const
+    {
+        return _rootPageId;
+    }
+
+    std::size_t PageDirectory::getDataPageCount() const
+    {
+        return _dataPages.size();
+    }
+
+    RecordId PageDirectory::insertRecord(const std::vector<char>& record)
+    {
+        if (record.size() <= Page::maxRecordSize())
+            return insertInline(record.data(), static_cast<std::uint16_t>(record.size()), false);
+
+        OverflowStub stub{ static_cast<std::uint32_t>(record.size()), writeOverflow(record) };
+        return insertInline(reinterpret_cast<const char*>(&stub), sizeof(stub), true);
+    }
+
+    RecordId PageDirectory::updateRecord(RecordId rid, const std::vector<char>& record)
+    {
+        Page* page = _pool.fetchPage(rid.pageId);
+
+        std::uint16_t oldSize = 0;
+        bool oldFlag = false;
+        const char* oldData = page->getRecord(rid.slot, oldSize, &oldFlag);
+        if (!oldData)
+        {
+            _pool.unpinPage(rid.pageId, false);
+            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Record not found");
+        }
+
+        if (oldFlag)
+        {
+            OverflowStub stub;
+            std::memcpy(&stub, oldData, sizeof(stub));
+            freeOverflow(stub.firstPageId);
+        }
+
+        bool updated = false;
+        if (record.size() <= Page::maxRecordSize())
+        {
+            updated = page->updateRecord(rid.slot, record.data(), static_cast<std::uint16_t>(record.size()));
+        }
+        else
+        {
+            OverflowStub stub{ static_cast<std::uint32_t>(record.size()), writeOverflow(record) };
+            updated = page->updateRecord(rid.slot, reinterpret_cast<const char*>(&stub), sizeof(stub), true);
+            if (!updated)
+            {
+                page->eraseRecord(rid.slot);
+                _pool.unpinPage(rid.pageId, true);
+                return insertInline(reinterpret_cast<const char*>(&stub), sizeof(stub), true);
+            }
+        }
+
+        if (updated)
+        {
+            _pool.unpinPage(rid.pageId, true);
+            return rid;
+        }
+
+        page->eraseRecord(rid.slot);
+        _pool.unpinPage(rid.pageId, true);
+
+        markHasSpace(rid.pageId);
+
+        return insertRecord(record);
+    }
+
+    void PageDirectory::eraseRecord(RecordId rid)
+    {
+        Page* page = _pool.fetchPage(rid.pageId);
+
+        std::uint16_t size = 0;
+        bool flag = false;
+        const char* data = page->getRecord(rid.slot, size, &flag);
+        if (data && flag)
+        {
+            OverflowStub stub;
+            std::memcpy(&stub, data, sizeof(stub));
+            freeOverflow(stub.firstPageId);
+        }
+
+        page->eraseRecord(rid.slot);
+        _pool.unpinPage(rid.pageId, true);
+
+        markHasSpace(rid.pageId);
+    }
+
+    std::vector<char> PageDirectory::readRecord(RecordId rid)
+    {
+        Page* page = _pool.fetchPage(rid.pageId);
+
+        std::uint16_t size = 0;
+        bool flag = false;
+        const char* data = page->getRecord(rid.slot, size, &flag);
+        if (!data)
+        {
+            _pool.unpinPage(rid.pageId, false);
+            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Record not found");
+        }
+
+        std::vector<char> record = materialize(data, size, flag);
+        _pool.unpinPage(rid.pageId, false);
+
+        return record;
+    }
+
+    void PageDirectory::forEachRecord(const std::function<void(RecordId, const std::vector<char>&)>& callback)
+    {
+        for (PageId pageId : _dataPages)
+        {
+            Page* page = _pool.fetchPage(pageId);
+
+            // Materialize the page first so the callback may use the pool freely
+            std::vector<std::pair<RecordId, std::vector<char>>> records;
+            for (std::uint16_t slot = 0; slot < page->getSlotCount(); ++slot)
+            {
+                std::uint16_t size = 0;
+                bool flag = false;
+                const char* data = page->getRecord(slot, size, &flag);
+                if (!data)
+                    continue;
+
+                records.push_back({ RecordId{ pageId, slot }, materialize(data, size, flag) });
+            }
+
+            _pool.unpinPage(pageId, false);
+
+            for (const auto& [rid, record] : records)
+                callback(rid, record);
+        }
+    }
+
+    void PageDirectory::drop()
+    {
+        for (PageId pageId : _dataPages)
+        {
+            std::vector<PageId> overflowChains;
+
+            Page* page = _pool.fetchPage(pageId);
+            for (std::uint16_t slot = 0; slot < page->getSlotCount(); ++slot)
+            {
+                std::uint16_t size = 0;
+                bool flag = false;
+                const char* data = page->getRecord(slot, size, &flag);
+                if (data && flag)
+                {
+                    OverflowStub stub;
+                    std::memcpy(&stub, data, sizeof(stub));
+                    overflowChains.push_back(stub.firstPageId);
+                }
+            }
+            _pool.unpinPage(pageId, false);
+
+            for (PageId chain : overflowChains)
+                freeOverflow(chain);
+            _pool.freePage(pageId);
+        }
+
+        for (PageId pageId : _directoryPages)
+            _pool.freePage(pageId);
+
+        _dataPages.clear();
+        _pageIndexes.clear();
+        _directoryPages.clear();
+        _pagesWithSpace.clear();
+        _rootPageId = INVALID_PAGE_ID;
+    }
+
+    PageId PageDirectory::appendDataPage()
+    {
+        PageId dataPageId = INVALID_PAGE_ID;
+        _pool.newPage(PageType::Data, dataPageId);
+        _pool.unpinPage(dataPageId, true);
+
+        const std::size_t position = _dataPages.size() % entriesPerPage();
+        if (position == 0 && !_dataPages.empty())
+        {
+            PageId newDirectoryId = INVALID_PAGE_ID;
+            _pool.newPage(PageType::Directory, newDirectoryId);
+            _pool.unpinPage(newDirectoryId, true);
+
+            Page* last = _pool.fetchPage(_directoryPages.back());
+            last->setNextPageId(newDirectoryId);
+            _pool.unpinPage(_directoryPages.back(), true);
+
+            _directoryPages.push_back(newDirectoryId);
+        }
+
+        Page* directory = _pool.fetchPage(_directoryPages.back());
+        std::uint32_t count = static_cast<std::uint32_t>(position + 1);
+        std::memcpy(directory->payload(), &count, sizeof(count));
+        std::memcpy(directory->payload() + sizeof(std::uint32_t) + position * sizeof(PageId), &dataPageId, sizeof(PageId));
+        _pool.unpinPage(_directoryPages.back(), true);
+
+        _pageIndexes[dataPageId] = _dataPages.size();
+        _dataPages.push_back(dataPageId);
+        return dataPageId;
+    }
+
+    void PageDirectory::markHasSpace(PageId pageId)
+    {
+        auto it = _pageIndexes.find(pageId);
+        if (it != _pageIndexes.end())
+            _pagesWithSpace.insert(it->second);
+    }
+
+    int PageDirectory::tryInsert(std::size_t pageIndex, const char* record, std::uint16_t size, bool flag)
+    {
+        const PageId pageId = _dataPages[pageIndex];
+        Page* page = _pool.fetchPage(pageId);
+        int slot = page->insertRecord(record, size, flag);
+        _pool.unpinPage(pageId, slot >= 0);
+        return slot;
+    }
+
+    RecordId PageDirectory::insertInline(const char* record, std::uint16_t size, bool flag)
+    {
+        // Appends usually land in the last page, try it first
+        if (!_dataPages.empty())
+        {
+            const std::size_t last = _dataPages.size() - 1;
+            int slot = tryInsert(last, record, size, flag);
+            if (slot >= 0)
+                return RecordId{ _dataPages[last], static_cast<std::uint16_t>(slot) };
+            _pagesWithSpace.erase(last);
+        }
+
+        while (!_pagesWithSpace.empty())
+        {
+            const std::size_t index = *_pagesWithSpace.begin();
+            int slot = tryInsert(index, record, size, flag);
+            if (slot >= 0)
+                return RecordId{ _dataPages[index], static_cast<std::uint16_t>(slot) };
+            _pagesWithSpace.erase(_pagesWithSpace.begin());
+        }
+
+        PageId pageId = appendDataPage();
+        int slot = tryInsert(_dataPages.size() - 1, record, size, flag);
+        if (slot < 0)
+            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::WriteFile, "Record does not fit in an empty page");
+
+        return RecordId{ pageId, static_cast<std::uint16_t>(slot) };
+    }
+
+    PageId PageDirectory::writeOverflow(const std::vector<char>& record)
+    {
+        PageId first = INVALID_PAGE_ID;
+        PageId previous = INVALID_PAGE_ID;
+        std::size_t offset = 0;
+
+        while (offset < record.size())
+        {
+            PageId pageId = INVALID_PAGE_ID;
+            Page* page = _pool.newPage(PageType::Overflow, pageId);
+
+            std::uint32_t chunk = static_cast<std::uint32_t>(std::min(OVERFLOW_CHUNK_SIZE, record.size() - offset));
+            std::memcpy(page->payload(), &chunk, sizeof(chunk));
+            std::memcpy(page->payload() + sizeof(chunk), record.data() + offset, chunk);
+            offset += chunk;
+            _pool.unpinPage(pageId, true);
+
+            if (previous == INVALID_PAGE_ID)
+            {
+                first = pageId;
+            }
+            else
+            {
+                Page* prev = _pool.fetchPage(previous);
+                prev->setNextPageId(pageId);
+                _pool.unpinPage(previous, true);
+            }
+            previous = pageId;
+        }
+
+        return first;
+    }
+
+    std::vector<char> PageDirectory::readOverflow(PageId firstPageId, std::uint32_t size)
+    {
+        std::vector<char> record;
+        record.reserve(size);
+
+        PageId current = firstPageId;
+        while (current != INVALID_PAGE_ID && record.size() < size)
+        {
+            Page* page = _pool.fetchPage(current);
+            std::uint32_t chunk = 0;
+            std::memcpy(&chunk, page->payload(), sizeof(chunk));
+            chunk = static_cast<std::uint32_t>(std::min<std::size_t>(chunk, OVERFLOW_CHUNK_SIZE));
+            record.insert(record.end(), page->payload() + sizeof(chunk), page->payload() + sizeof(chunk) + chunk);
+            PageId next = page->getNextPageId();
+            _pool.unpinPage(current, false);
+            current = next;
+        }
+
+        if (record.size() != size)
+            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Corrupted overflow chain");
+
+        return record;
+    }
+
+    void PageDirectory::freeOverflow(PageId firstPageId)
+    {
+        PageId current = firstPageId;
+        while (current != INVALID_PAGE_ID)
+        {
+            Page* page = _pool.fetchPage(current);
+            PageId next = page->getNextPageId();
+            _pool.unpinPage(current, false);
+            _pool.freePage(current);
+            current = next;
+        }
+    }
+
+    std::vector<char> PageDirectory::materialize(const char* data, std::uint16_t size, bool flag)
+    {
+        if (!flag)
+            return std::vector<char>(data, data + size);
+
+        OverflowStub stub;
+        std::memcpy(&stub, data, sizeof(stub));
+        return readOverflow(stub.firstPageId, stub.size);
+    }
+}
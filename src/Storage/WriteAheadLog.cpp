@@ -0,0 +1,247 @@
+#include "Storage/WriteAheadLog.h"
+
+#include <cstring>
+
+namespace Xale::Storage
+{
+    namespace
+    {
+        constexpr char LOG_FILE_MAGIC[4] = { 'X', 'W', 'A', 'L' };
+        constexpr std::uint32_t LOG_FILE_VERSION = 1;
+
+        struct LogFileHeader
+        {
+            char magic[4];
+            std::uint32_t version;
+            std::uint64_t epoch;
+        };
+
+        constexpr std::size_t RECORD_HEADER_SIZE = 2 * sizeof(std::uint32_t) + sizeof(std::uint8_t);
+
+        void fnv1a(std::uint32_t& hash, const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash ^= bytes[i];
+                hash *= 16777619u;
+            }
+        }
+    }
+
+    WriteAheadLog::WriteAheadLog(IFileManager& fileManager)
+        : _fileManager(fileManager)
+    {}
+
+    WriteAheadLog::~WriteAheadLog()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _flushCondition.notify_all();
+
+        if (_flusher.joinable())
+            _flusher.join();
+    }
+
+    std::vector<LogRecord> WriteAheadLog::recover()
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<LogRecord> records;
+
+        if (_running)
+            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Write-ahead log already recovered");
+
+        const std::uint64_t fileSize = _fileManager.size();
+        LogFileHeader header = {};
+
+        if (fileSize >= sizeof(header))
+            _fileManager.readAt(0, &header, sizeof(header));
+
+        if (fileSize < sizeof(header) || std::memcmp(header.magic, LOG_FILE_MAGIC, sizeof(LOG_FILE_MAGIC)) != 0)
+        {
+            _epoch = 1;
+            writeHeader();
+        }
+        else
+        {
+            if (header.version != LOG_FILE_VERSION)
+                THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::ReadFile, "Unsupported write-ahead log version");
+
+            _epoch = header.epoch;
+            _writeOffset = sizeof(header);
+
+            std::vector<char> data(fileSize - sizeof(header));
+            if (!data.empty())
+                _fileManager.readAt(sizeof(header), data.data(), data.size());
+
+            // Stop at the first torn or stale record
+            std::size_t offset = 0;
+            while (offset + RECORD_HEADER_SIZE <= data.size())
+            {
+                std::uint32_t length = 0;
+                std::uint32_t sum = 0;
+                std::memcpy(&length, data.data() + offset, sizeof(length));
+                std::memcpy(&sum, data.data() + offset + sizeof(length), sizeof(sum));
+                const auto type = static_cast<LogRecordType>(data[offset + 2 * sizeof(std::uint32_t)]);
+
+                if (length > data.size() - offset - RECORD_HEADER_SIZE)
+                    break;
+
+                const char* payload = data.data() + offset + RECORD_HEADER_SIZE;
+                if (checksum(type, payload, length) != sum)
+                    break;
+
+                records.push_back({ type, std::vector<char>(payload, payload + length) });
+                offset += RECORD_HEADER_SIZE + length;
+            }
+
+            _writeOffset += offset;
+        }
+
+        _running = true;
+        _flusher = std::thread(&WriteAheadLog::flushLoop, this);
+
+        return records;
+    }
+
+    void WriteAheadLog::commit(const std::vector<LogRecord>& records)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        if (!_running)
+            THROW_DB_EXCEPTION(Xale::Core::ExceptionCode::WriteFile, "Write-ahead log not recovered");
+
+        // Encoded under the lock, checksums depend on the current epoch
+        for (const auto& record : records)
+            encode(_pending, record.type, record.payload);
+        encode(_pending, LogRecordType::Commit, {});
+
+        const std::uint64_t commit = ++_appendedCommits;
+        _flushCondition.notify_one();
+
+        waitDurable(lock, commit);
+    }
+
+    void WriteAheadLog::writeCheckpoint(const std::vector<LogRecord>& pageImages)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        waitDurable(lock, _appendedCommits);
+
+        std::vector<char> buffer;
+        for (const auto& record : pageImages)
+            encode(buffer, record.type, record.payload);
+        encode(buffer, LogRecordType::CheckpointEnd, {});
+
+        _fileManager.writeAt(_writeOffset, buffer.data(), buffer.size());
+        _fileManager.sync();
+        _writeOffset += buffer.size();
+        ++_syncCount;
+    }
+
+    void WriteAheadLog::reset()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        waitDurable(lock, _appendedCommits);
+
+        ++_epoch;
+        writeHeader();
+    }
+
+    std::uint64_t WriteAheadLog::size() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _writeOffset - sizeof(LogFileHeader) + _pending.size();
+    }
+
+    std::uint64_t WriteAheadLog::getSyncCount() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _syncCount;
+    }
+
+    void WriteAheadLog::flushLoop()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true)
+        {
+            _flushCondition.wait(lock, [this] { return _stopping || !_pending.empty(); });
+
+            if (_pending.empty())
+                return;
+
+            // Everything committed so far goes in the same write and sync
+            std::vector<char> batch;
+            batch.swap(_pending);
+            const std::uint64_t target = _appendedCommits;
+            const std::uint64_t offset = _writeOffset;
+            _writeOffset += batch.size();
+
+            lock.unlock();
+            try
+            {
+                _fileManager.writeAt(offset, batch.data(), batch.size());
+                _fileManager.sync();
+            }
+            catch (...)
+            {
+                lock.lock();
+                _error = std::current_exception();
+                _durableCondition.notify_all();
+                return;
+            }
+            lock.lock();
+
+            ++_syncCount;
+            _durableCommits = target;
+            _durableCondition.notify_all();
+        }
+    }
+
+    void WriteAheadLog::waitDurable(std::unique_lock<std::mutex>& lock, std::uint64_t commit)
+    {
+        _durableCondition.wait(lock, [&] { return _durableCommits >= commit || _error; });
+
+        if (_error)
+            std::rethrow_exception(_error);
+    }
+
+    void WriteAheadLog::writeHeader()
+    {
+        LogFileHeader header = {};
+        std::memcpy(header.magic, LOG_FILE_MAGIC, sizeof(LOG_FILE_MAGIC));
+        header.version = LOG_FILE_VERSION;
+        header.epoch = _epoch;
+
+        _fileManager.writeAt(0, &header, sizeof(header));
+        _fileManager.sync();
+        _writeOffset = sizeof(header);
+        ++_syncCount;
+    }
+
+    void WriteAheadLog::encode(std::vector<char>& buffer, LogRecordType type, const std::vector<char>& payload) const
+    {
+        const std::uint32_t length = static_cast<std::uint32_t>(payload.size());
+        const std::uint32_t sum = checksum(type, payload.data(), payload.size());
+        const std::uint8_t typeByte = static_cast<std::uint8_t>(type);
+
+        buffer.insert(buffer.end(), reinterpret_cast<const char*>(&length), reinterpret_cast<const char*>(&length) + sizeof(length));
+        buffer.insert(buffer.end(), reinterpret_cast<const char*>(&sum), reinterpret_cast<const char*>(&sum) + sizeof(sum));
+        buffer.push_back(static_cast<char>(typeByte));
+        buffer.insert(buffer.end(), payload.begin(), payload.end());
+    }
+
+    std::uint32_t WriteAheadLog::checksum(LogRecordType type, const char* payload, std::size_t size) const
+    {
+        std::uint32_t hash = 2166136261u;
+        const std::uint8_t typeByte = static_cast<std::uint8_t>(type);
+
+        fnv1a(hash, &_epoch, sizeof(_epoch));
+        fnv1a(hash, &typeByte, sizeof(typeByte));
+        fnv1a(hash, payload, size);
+
+        return hash;
+    }
+}
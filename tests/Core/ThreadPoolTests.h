@@ -0,0 +1,45 @@
+#ifndef THREAD_POOL_TESTS_H
+#define THREAD_POOL_TESTS_H
+
+#include "TestsHelper.h"
+#include "Core/ThreadPool.h"
+
+#include <atomic>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+#define DECLARE_THREAD_POOL_TEST(name) DECLARE_TEST(CORE, thread_pool_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_THREAD_POOL_TEST(runs_every_task)
+    {
+        std::atomic<int> sum{ 0 };
+        std::mutex threadsMutex;
+        std::set<std::thread::id> threads;
+
+        {
+            Xale::Core::ThreadPool pool(4);
+            if (pool.getThreadCount() != 4)
+                return false;
+
+            // A failing task leaves its thread running the next ones
+            pool.submit([]() { throw std::runtime_error("task failure"); });
+            for (int i = 1; i <= 1000; ++i)
+            {
+                pool.submit([&, i]() {
+                    sum += i;
+                    std::lock_guard<std::mutex> lock(threadsMutex);
+                    threads.insert(std::this_thread::get_id());
+                });
+            }
+        }
+
+        // The destructor waits for the queued tasks
+        return sum == 500500 && !threads.empty() && threads.size() <= 4
+            && Xale::Core::ThreadPool(0).getThreadCount() >= 1;
+    }
+}
+
+#endif // THREAD_POOL_TESTS_H
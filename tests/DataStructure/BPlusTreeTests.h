@@ -3,6 +3,13 @@
 
 #include "TestsHelper.h"
 #include "DataStructure/BPlusTree.h"
+#include "DataStructure/DataTypes.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
 
 #define DECLARE_B_PLUS_TREE_TEST(name) DECLARE_TEST(DATA_STRUCT, b_plus_tree_##name)
 
@@ -126,6 +133,253 @@ namespace Xale::Tests
         return tree.search(1) == nullptr
             && tree.search(2) == nullptr;
     }
+
+    DECLARE_B_PLUS_TREE_TEST(insert_duplicate_key)
+    {
+        Xale::DataStructure::BPlusTree<int, int> tree(2);
+        int v1 = 10, v2 = 20;
+
+        bool isFirstInserted = tree.insert(1, &v1);
+        bool isDuplicateInserted = tree.insert(1, &v2);
+
+        return isFirstInserted && !isDuplicateInserted
+            && *tree.search(1) == 10
+            && tree.size() == 1;
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(insert_remove_many_keys)
+    {
+        Xale::DataStructure::BPlusTree<int, int> tree(2);
+        std::vector<int> keys(1000);
+        for (int i = 0; i < 1000; ++i)
+            keys[i] = i;
+
+        std::mt19937 random(42);
+        std::shuffle(keys.begin(), keys.end(), random);
+        for (int key : keys)
+        {
+            int value = key * 10;
+            if (!tree.insert(key, &value))
+                return false;
+        }
+
+        // Remove the even keys, in another random order
+        std::shuffle(keys.begin(), keys.end(), random);
+        for (int key : keys)
+            if (key % 2 == 0 && !tree.remove(key))
+                return false;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            int* value = tree.search(i);
+            if (i % 2 == 0 ? value != nullptr : (value == nullptr || *value != i * 10))
+                return false;
+        }
+
+        return tree.size() == 500 && !tree.remove(0);
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(field_value_keys)
+    {
+        Xale::DataStructure::BPlusTree<Xale::DataStructure::FieldValue, size_t, Xale::DataStructure::FieldValueLess> tree(2);
+        size_t v1 = 1, v2 = 2, v3 = 3;
+
+        tree.insert(std::string("bob"), &v1);
+        tree.insert(42, &v2);
+        tree.insert(std::string("alice"), &v3);
+
+        // Integers and doubles holding the same number are the same key
+        size_t* number = tree.search(42.0);
+        size_t* text = tree.search(std::string("alice"));
+
+        return number != nullptr && *number == 2
+            && text != nullptr && *text == 3
+            && tree.search(std::string("carol")) == nullptr;
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(iterate_in_key_order)
+    {
+        Xale::DataStructure::BPlusTree<int, int> tree(2);
+        std::vector<int> keys(300);
+        for (int i = 0; i < 300; ++i)
+            keys[i] = i;
+
+        std::mt19937 rng(7);
+        std::shuffle(keys.begin(), keys.end(), rng);
+        for (int key : keys)
+        {
+            int value = key * 10;
+            tree.insert(key, &value);
+        }
+        for (int key = 0; key < 300; key += 3)
+            tree.remove(key);
+
+        int expected = 1;
+        for (auto it = tree.begin(); it != tree.end(); ++it)
+        {
+            if (it.key() != expected || it.value() != expected * 10)
+                return false;
+            expected += (expected % 3 == 1) ? 1 : 2;
+        }
+
+        return expected == 301;
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(lower_and_upper_bound)
+    {
+        Xale::DataStructure::BPlusTree<int, int> tree(2);
+        for (int key = 0; key < 100; key += 2)
+            tree.insert(key, &key);
+
+        auto lower = tree.lowerBound(40);
+        auto upper = tree.upperBound(40);
+        auto between = tree.lowerBound(41);
+        auto past = tree.upperBound(98);
+
+        int count = 0;
+        for (auto it = tree.lowerBound(10); it != tree.upperBound(20); ++it)
+            ++count;
+
+        return lower.key() == 40
+            && upper.key() == 42
+            && between.key() == 42
+            && past == tree.end()
+            && tree.lowerBound(-5).key() == 0
+            && count == 6;
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(iterate_empty_tree)
+    {
+        Xale::DataStructure::BPlusTree<int, int> tree(2);
+        return tree.begin() == tree.end() && tree.lowerBound(1) == tree.end();
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(search_integer_keys_in_wide_nodes)
+    {
+        // Nodes of up to 255 keys, searched by vectors, halving and a scalar tail
+        Xale::DataStructure::BPlusTree<int, int> tree(128);
+        int min = std::numeric_limits<int>::min();
+        int max = std::numeric_limits<int>::max();
+
+        for (int key = -3000; key < 3000; key += 3)
+            tree.insert(key, &key);
+        tree.insert(min, &min);
+        tree.insert(max, &max);
+
+        for (int key = -3000; key < 3000; ++key)
+        {
+            bool isStored = (key % 3) == 0;
+            if ((tree.search(key) != nullptr) != isStored)
+                return false;
+        }
+
+        auto upper = tree.upperBound(-3000);
+        auto lower = tree.lowerBound(2999);
+
+        return tree.search(min) && *tree.search(min) == min
+            && tree.search(max) && *tree.search(max) == max
+            && tree.begin().key() == min
+            && upper.key() == -2997
+            && lower.key() == max
+            && tree.upperBound(max) == tree.end()
+            && tree.size() == 2002;
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(bulk_load_sorted_entries)
+    {
+        for (double fillFactor : { 0.5, 0.9, 1.0 })
+        {
+            std::vector<std::pair<int, int>> entries;
+            for (int key = 0; key < 2000; ++key)
+                entries.push_back({ key * 2, key });
+
+            Xale::DataStructure::BPlusTree<int, int> tree(3);
+            if (!tree.bulkLoad(entries.begin(), entries.end(), fillFactor) || tree.size() != 2000)
+                return false;
+
+            int expected = 0;
+            for (auto it = tree.begin(); it != tree.end(); ++it, ++expected)
+            {
+                if (it.key() != expected * 2 || it.value() != expected)
+                    return false;
+            }
+            if (expected != 2000)
+                return false;
+
+            // The loaded tree keeps splitting and merging as usual
+            for (int key = 1; key < 4000; key += 2)
+                tree.insert(key, &key);
+            for (int key = 0; key < 4000; key += 3)
+                tree.remove(key);
+
+            for (int key = 0; key < 4000; ++key)
+            {
+                if ((tree.search(key) != nullptr) != (key % 3 != 0))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(bulk_load_rejects_unsorted_or_non_empty)
+    {
+        std::vector<std::pair<int, int>> unsorted{ { 1, 1 }, { 3, 3 }, { 2, 2 } };
+        std::vector<std::pair<int, int>> duplicated{ { 1, 1 }, { 1, 2 } };
+        std::vector<std::pair<int, int>> sorted{ { 1, 1 }, { 2, 2 } };
+
+        Xale::DataStructure::BPlusTree<int, int> tree(2);
+        bool rejected = !tree.bulkLoad(unsorted.begin(), unsorted.end())
+            && !tree.bulkLoad(duplicated.begin(), duplicated.end())
+            && tree.size() == 0;
+
+        bool loaded = tree.bulkLoad(sorted.begin(), sorted.end());
+
+        return rejected && loaded
+            && !tree.bulkLoad(sorted.begin(), sorted.end())
+            && tree.size() == 2
+            && *tree.search(2) == 2;
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(clear_releases_nodes)
+    {
+        Xale::DataStructure::BPlusTree<int, std::string> tree(2);
+        for (int key = 0; key < 1000; ++key)
+        {
+            std::string value = "value-" + std::to_string(key);
+            tree.insert(key, &value);
+        }
+
+        size_t filledUsage = tree.memoryUsage();
+        tree.clear();
+        bool cleared = tree.size() == 0 && tree.memoryUsage() == 0 && tree.search(10) == nullptr && tree.begin() == tree.end();
+
+        std::string value = "again";
+        tree.insert(10, &value);
+
+        return filledUsage > 0 && cleared && *tree.search(10) == "again" && tree.memoryUsage() > 0;
+    }
+
+    DECLARE_B_PLUS_TREE_TEST(move_transfers_nodes)
+    {
+        Xale::DataStructure::BPlusTree<int, int> tree(2);
+        for (int key = 0; key < 100; ++key)
+            tree.insert(key, &key);
+
+        Xale::DataStructure::BPlusTree<int, int> moved(std::move(tree));
+
+        Xale::DataStructure::BPlusTree<int, int> assigned(4);
+        int value = 7;
+        assigned.insert(1000, &value);
+        assigned = std::move(moved);
+
+        // Moved-from trees are empty but usable
+        tree.insert(5, &value);
+
+        return assigned.size() == 100 && *assigned.search(99) == 99 && assigned.search(1000) == nullptr
+            && moved.size() == 0 && moved.search(1) == nullptr && moved.memoryUsage() == 0
+            && tree.size() == 1 && *tree.search(5) == 7;
+    }
 }
 
 #endif // B_PLUS_TREE_TESTS_H
@@ -0,0 +1,115 @@
+#ifndef COLUMNAR_TABLE_TESTS_H
+#define COLUMNAR_TABLE_TESTS_H
+
+#include "TestsHelper.h"
+#include "DataStructure/ColumnarTable.h"
+#include "DataStructure/Table.h"
+
+#include <string>
+#include <vector>
+
+#define DECLARE_COLUMNAR_TABLE_TEST(name) DECLARE_TEST(DATA_STRUCT, columnar_table_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_COLUMNAR_TABLE_TEST(typed_columns)
+    {
+        using Xale::DataStructure::ColumnKind;
+
+        auto table = makeScoresTable(100);
+        Xale::DataStructure::ColumnarTable columnar(table);
+
+        const auto& ids = columnar.getColumn(0);
+        const auto& scores = columnar.getColumn(1);
+        const auto& names = columnar.getColumn(2);
+
+        if (ids.getKind() != ColumnKind::Integer || scores.getKind() != ColumnKind::Float || names.getKind() != ColumnKind::String)
+            return false;
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            if (ids.integers()[i] != static_cast<int>(i) || scores.floats()[i] != i * 0.5)
+                return false;
+            if (names.isNull(i) != (i % 10 == 0) || (!names.isNull(i) && names.stringAt(i) != "n" + std::to_string(i)))
+                return false;
+        }
+
+        return columnar.getRowCount() == 100
+            && names.nullCount() == 10
+            && ids.nullCount() == 0
+            && !columnar.isMutable();
+    }
+
+    DECLARE_COLUMNAR_TABLE_TEST(rows_round_trip)
+    {
+        auto table = makeScoresTable(100);
+        Xale::DataStructure::ColumnarTable columnar(table);
+
+        const auto& rows = columnar.getRows();
+        if (rows.size() != table.getRowCount())
+            return false;
+
+        for (size_t i = 0; i < rows.size(); ++i)
+        {
+            if (rows[i].values != table.getRows()[i].values)
+                return false;
+        }
+
+        return true;
+    }
+
+    DECLARE_COLUMNAR_TABLE_TEST(column_kind_follows_values)
+    {
+        using Xale::DataStructure::ColumnKind;
+        using Xale::DataStructure::FieldValue;
+
+        // Leading NULLs do not fix the kind, a value of another type makes the column mixed
+        Xale::DataStructure::ColumnVector column(ColumnKind::Integer);
+        column.append(std::monostate{});
+        column.append(1.5);
+        column.append(2.5);
+
+        bool floatKind = column.getKind() == ColumnKind::Float && column.isNull(0) && column.floats()[2] == 2.5;
+
+        column.append(std::string("text"));
+
+        return floatKind
+            && column.getKind() == ColumnKind::Mixed
+            && column.size() == 4
+            && std::holds_alternative<std::monostate>(column.valueAt(0))
+            && column.valueAt(1) == FieldValue(1.5)
+            && column.valueAt(3) == FieldValue(std::string("text"));
+    }
+
+    DECLARE_COLUMNAR_TABLE_TEST(table_keeps_columns_in_sync)
+    {
+        using Xale::DataStructure::FieldValue;
+
+        auto table = makeScoresTable(100);
+
+        // A copy already returned is left as it is, the next call seeing the insertion
+        auto held = table.getColumnar();
+        table.insertRow(makeScoreRow(100, 50.0, std::string("last")));
+        if (held->getRowCount() != 100 || table.getColumnar()->getRowCount() != 101 || table.getColumnar()->getColumn(2).stringAt(100) != "last")
+            return false;
+        held.reset();
+
+        // Other changes rebuild them
+        table.updateRows("id", FieldValue(3), { { "score", FieldValue(-1.0) } });
+        table.deleteRows("id", FieldValue(0));
+
+        const auto columnar = table.getColumnar();
+        if (columnar->getRowCount() != table.getRowCount())
+            return false;
+
+        for (size_t i = 0; i < columnar->getRowCount(); ++i)
+        {
+            if (columnar->getRow(i).values != table.getRows()[i].values)
+                return false;
+        }
+
+        return true;
+    }
+}
+
+#endif // COLUMNAR_TABLE_TESTS_H
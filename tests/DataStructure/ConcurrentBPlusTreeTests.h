@@ -0,0 +1,147 @@
+#ifndef CONCURRENT_B_PLUS_TREE_TESTS_H
+#define CONCURRENT_B_PLUS_TREE_TESTS_H
+
+#include "TestsHelper.h"
+#include "DataStructure/ConcurrentBPlusTree.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#define DECLARE_CONCURRENT_B_PLUS_TREE_TEST(name) DECLARE_TEST(DATA_STRUCT, concurrent_b_plus_tree_##name)
+
+namespace Xale::Tests
+{
+    // Small nodes, so that the threads keep splitting nodes under each other
+    using SmallConcurrentTree = Xale::DataStructure::ConcurrentBPlusTree<int, int, std::less<int>, 4>;
+
+    DECLARE_CONCURRENT_B_PLUS_TREE_TEST(insert_search_remove)
+    {
+        SmallConcurrentTree tree;
+        std::vector<int> keys(500);
+        for (int i = 0; i < 500; ++i)
+            keys[i] = i;
+
+        std::mt19937 rng(11);
+        std::shuffle(keys.begin(), keys.end(), rng);
+        for (int key : keys)
+        {
+            if (!tree.insert(key, key * 10))
+                return false;
+        }
+
+        int value = 0;
+        bool duplicateRejected = !tree.insert(42, 0) && tree.search(42, value) && value == 420;
+
+        for (int key = 0; key < 500; key += 2)
+        {
+            if (!tree.remove(key))
+                return false;
+        }
+
+        for (int key = 0; key < 500; ++key)
+        {
+            bool found = tree.search(key, value);
+            if (found != (key % 2 == 1) || (found && value != key * 10))
+                return false;
+        }
+
+        return duplicateRejected && !tree.remove(0) && tree.size() == 250;
+    }
+
+    DECLARE_CONCURRENT_B_PLUS_TREE_TEST(concurrent_inserts)
+    {
+        SmallConcurrentTree tree;
+        const int threadCount = 8;
+        const int keysPerThread = 5000;
+        std::atomic<bool> failed{ false };
+        std::vector<std::thread> threads;
+
+        // Interleaved keys, every thread inserts in all the leaves
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < keysPerThread; ++i)
+                {
+                    int key = i * threadCount + t;
+                    if (!tree.insert(key, -key))
+                        failed = true;
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        if (failed || tree.size() != static_cast<size_t>(threadCount * keysPerThread))
+            return false;
+
+        for (int key = 0; key < threadCount * keysPerThread; ++key)
+        {
+            int value = 0;
+            if (!tree.search(key, value) || value != -key)
+                return false;
+        }
+
+        return true;
+    }
+
+    DECLARE_CONCURRENT_B_PLUS_TREE_TEST(readers_during_writes)
+    {
+        SmallConcurrentTree tree;
+        const int stableKeys = 2000;
+
+        // Even keys stay in the tree, writers insert and remove the odd ones
+        for (int key = 0; key < 2 * stableKeys; key += 2)
+            tree.insert(key, key + 1);
+
+        std::atomic<bool> failed{ false };
+        std::atomic<bool> done{ false };
+        std::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&, t]() {
+                std::mt19937 rng(t);
+                while (!done)
+                {
+                    int key = static_cast<int>(rng() % stableKeys) * 2;
+                    int value = 0;
+                    if (!tree.search(key, value) || value != key + 1)
+                        failed = true;
+                }
+            });
+        }
+
+        std::vector<std::thread> writers;
+        for (int t = 0; t < 4; ++t)
+        {
+            writers.emplace_back([&, t]() {
+                for (int round = 0; round < 3; ++round)
+                {
+                    for (int key = 2 * t + 1; key < 2 * stableKeys; key += 8)
+                    {
+                        if (!tree.insert(key, key + 1))
+                            failed = true;
+                    }
+                    for (int key = 2 * t + 1; key < 2 * stableKeys; key += 8)
+                    {
+                        if (!tree.remove(key))
+                            failed = true;
+                    }
+                }
+            });
+        }
+
+        for (auto& writer : writers)
+            writer.join();
+        done = true;
+        for (auto& thread : threads)
+            thread.join();
+
+        return !failed && tree.size() == static_cast<size_t>(stableKeys);
+    }
+}
+
+#endif // CONCURRENT_B_PLUS_TREE_TESTS_H
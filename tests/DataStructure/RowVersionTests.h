@@ -0,0 +1,137 @@
+#ifndef ROW_VERSION_TESTS_H
+#define ROW_VERSION_TESTS_H
+
+#include "TestsHelper.h"
+#include "DataStructure/RowVersion.h"
+#include "DataStructure/Table.h"
+#include "Core/ExceptionHandler.h"
+
+#include <string>
+#include <vector>
+
+#define DECLARE_ROW_VERSION_TEST(name) DECLARE_TEST(DATA_STRUCT, row_version_##name)
+
+namespace Xale::Tests
+{
+    /**
+     * @brief Scores of the rows of a makeScoresTable() table a snapshot sees, in slot order
+     */
+    inline std::vector<double> visibleScores(const Xale::DataStructure::Table& table, const Xale::DataStructure::Snapshot& snapshot)
+    {
+        std::vector<double> scores;
+        const size_t count = table.getRowCount();
+        for (size_t slot = 0; slot < count; ++slot)
+        {
+            if (table.isVisible(slot, snapshot))
+                scores.push_back(std::get<double>(table.getRow(slot).values[1]));
+        }
+        return scores;
+    }
+
+    DECLARE_ROW_VERSION_TEST(snapshot_isolation)
+    {
+        using Xale::DataStructure::FieldValue;
+        using Xale::DataStructure::PENDING_VERSION;
+        using Xale::DataStructure::Snapshot;
+
+        auto table = makeScoresTable(3);
+        const uint64_t transaction = PENDING_VERSION | 1;
+        const Snapshot before{ 0, 0 };
+        const Snapshot own{ 0, transaction };
+
+        table.updateVersionsAt({ 1 }, { { "score", FieldValue(11.0) } }, transaction);
+        table.deleteVersionsAt({ 2 }, transaction);
+        if (!table.insertVersion(makeScoreRow(3, 30.0, "n3"), transaction))
+            return false;
+
+        // Pending changes are only seen by their own transaction
+        bool pending = visibleScores(table, before) == std::vector<double>{ 0.0, 0.5, 1.0 } &&
+                       visibleScores(table, own) == std::vector<double>{ 0.0, 11.0, 30.0 } &&
+                       table.hasHiddenVersions(before) &&
+                       table.findSlots("id", FieldValue(3), before).empty() &&
+                       table.findSlots("id", FieldValue(3), own).size() == 1;
+
+        table.commitVersions(transaction, 1);
+
+        size_t oldSlot = 0, newSlot = 0;
+        bool committed = visibleScores(table, before) == std::vector<double>{ 0.0, 0.5, 1.0 } &&
+                         visibleScores(table, Snapshot{ 1, 0 }) == std::vector<double>{ 0.0, 11.0, 30.0 } &&
+                         table.findSlotByPrimaryKey(FieldValue(1), oldSlot, before) &&
+                         table.findSlotByPrimaryKey(FieldValue(1), newSlot) &&
+                         oldSlot == 1 && newSlot == 3 &&
+                         !table.findSlotByPrimaryKey(FieldValue(2), oldSlot) &&
+                         table.getDeadVersionCount() == 2;
+
+        // Reclaiming keeps the remaining rows in order
+        bool reclaimed = table.reclaimVersions() == 2 &&
+                         table.getRowCount() == 3 &&
+                         visibleScores(table, Snapshot()) == std::vector<double>{ 0.0, 11.0, 30.0 } &&
+                         !table.hasHiddenVersions(Snapshot()) &&
+                         table.findSlotByPrimaryKey(FieldValue(3), newSlot) && newSlot == 2;
+
+        return pending && committed && reclaimed;
+    }
+
+    DECLARE_ROW_VERSION_TEST(rollback)
+    {
+        using Xale::DataStructure::FieldValue;
+        using Xale::DataStructure::PENDING_VERSION;
+        using Xale::DataStructure::Snapshot;
+
+        auto table = makeScoresTable(3);
+        const uint64_t transaction = PENDING_VERSION | 1;
+
+        table.updateVersionsAt({ 0 }, { { "score", FieldValue(1.0) } }, transaction);
+        table.deleteVersionsAt({ 1 }, transaction);
+        table.insertVersion(makeScoreRow(3, 30.0, "n3"), transaction);
+        table.rollbackVersions(transaction);
+
+        size_t slot = 0;
+        bool rolledBack = visibleScores(table, Snapshot()) == std::vector<double>{ 0.0, 0.5, 1.0 } &&
+                          table.getDeadVersionCount() == 2 &&
+                          table.reclaimVersions() == 2 &&
+                          table.getRowCount() == 3 &&
+                          table.findSlotByPrimaryKey(FieldValue(0), slot) && slot == 0 &&
+                          !table.findSlotByPrimaryKey(FieldValue(3), slot);
+
+        // The primary key of the rolled back insert is free again
+        const uint64_t next = PENDING_VERSION | 2;
+        bool reinserted = table.insertVersion(makeScoreRow(3, 31.0, "n3"), next);
+        table.commitVersions(next, 1);
+
+        return rolledBack && reinserted && visibleScores(table, Snapshot()) == std::vector<double>{ 0.0, 0.5, 1.0, 31.0 };
+    }
+
+    DECLARE_ROW_VERSION_TEST(primary_key_conflicts)
+    {
+        using Xale::DataStructure::FieldValue;
+        using Xale::DataStructure::PENDING_VERSION;
+        using Xale::DataStructure::Snapshot;
+
+        auto table = makeScoresTable(3);
+        const uint64_t transaction = PENDING_VERSION | 1;
+
+        // A live key is refused, a key the transaction deleted is free to it
+        bool liveRefused = !table.insertVersion(makeScoreRow(1, 0.0, "n1"), transaction);
+        table.deleteVersionsAt({ 1 }, transaction);
+        bool deletedReused = table.insertVersion(makeScoreRow(1, 12.0, "n1"), transaction);
+
+        bool updateRefused = false;
+        try
+        {
+            table.updateVersionsAt({ 0 }, { { "id", FieldValue(2) } }, transaction);
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            updateRefused = true;
+        }
+
+        table.commitVersions(transaction, 1);
+        table.reclaimVersions();
+
+        return liveRefused && deletedReused && updateRefused &&
+               visibleScores(table, Snapshot()) == std::vector<double>{ 0.0, 12.0, 1.0 };
+    }
+}
+
+#endif // ROW_VERSION_TESTS_H
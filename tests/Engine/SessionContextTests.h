@@ -0,0 +1,113 @@
+#ifndef SESSION_CONTEXT_TESTS_H
+#define SESSION_CONTEXT_TESTS_H
+
+#include "TestsHelper.h"
+#include "Engine/SessionContext.h"
+#include "Execution/BasicExecutor.h"
+#include "Execution/TableManager.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define DECLARE_SESSION_CONTEXT_TEST(name) DECLARE_TEST(ENGINE, session_context_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_SESSION_CONTEXT_TEST(concurrent_statements)
+    {
+        const std::string dataFileName = "test-session-context-concurrent-data.bin";
+        const std::string logFileName = "test-session-context-concurrent-log.bin";
+        std::filesystem::remove(dataFileName);
+        std::filesystem::remove(logFileName);
+
+        const std::vector<std::string> tables = { "users", "orders" };
+        const int rowsPerTable = 200;
+        std::atomic<int> failures{ 0 };
+        std::atomic<int> selects{ 0 };
+
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::BinaryFileManager logFm;
+            Xale::Storage::FileStorageEngine storage(fm, dataFileName);
+            storage.startup();
+            logFm.open(logFileName);
+
+            Xale::Execution::TableManager manager(storage, fm, &logFm);
+            Xale::Execution::BasicExecutor executor(manager);
+            {
+                Xale::Engine::SessionContext admin(executor);
+                for (const auto& table : tables)
+                    admin.getQueryEngine().run("CREATE TABLE " + table + " (id INT PRIMARY KEY, amount INT)");
+            }
+
+            // Each thread runs its statements through its own session, sharing the executor
+            std::atomic<int> writersDone{ 0 };
+            std::vector<std::thread> threads;
+            for (const auto& table : tables)
+            {
+                threads.emplace_back([&, table]() {
+                    Xale::Engine::SessionContext session(executor);
+                    for (int i = 0; i < rowsPerTable; ++i)
+                    {
+                        try {
+                            session.getQueryEngine().run("INSERT INTO " + table + " VALUES ("
+                                + std::to_string(i) + ", " + std::to_string(i % 10) + ")");
+                            if (session.getQueryEngine().getResultsToString().find("1 row") == std::string::npos)
+                                ++failures;
+                        } catch (...) {
+                            ++failures;
+                        }
+                    }
+                    ++writersDone;
+                });
+            }
+            for (int reader = 0; reader < 3; ++reader)
+            {
+                threads.emplace_back([&, reader]() {
+                    Xale::Engine::SessionContext session(executor);
+                    const std::string& table = tables[reader % tables.size()];
+                    while (writersDone < static_cast<int>(tables.size()))
+                    {
+                        try {
+                            session.getQueryEngine().run("SELECT COUNT(*), SUM(amount) FROM " + table + " WHERE amount > 4");
+                            session.getQueryEngine().run("SELECT * FROM users JOIN orders ON users.id = orders.id");
+                            ++selects;
+                        } catch (...) {
+                            ++failures;
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads)
+                thread.join();
+
+            manager.checkpoint();
+            storage.shutdown();
+        }
+
+        // Every committed row is found again after a restart
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::BinaryFileManager logFm;
+        Xale::Storage::FileStorageEngine storage(fm, dataFileName);
+        storage.startup();
+        logFm.open(logFileName);
+
+        Xale::Execution::TableManager manager(storage, fm, &logFm);
+        bool result = failures == 0 && selects > 0;
+        for (const auto& table : tables)
+        {
+            auto* reloaded = manager.getTable(table);
+            result = result && reloaded != nullptr && reloaded->getRowCount() == rowsPerTable;
+        }
+
+        storage.shutdown();
+        return result;
+    }
+}
+
+#endif // SESSION_CONTEXT_TESTS_H
@@ -0,0 +1,176 @@
+#ifndef AGGREGATE_TESTS_H
+#define AGGREGATE_TESTS_H
+
+#include "TestsHelper.h"
+#include "Execution/Aggregate.h"
+#include "Execution/BasicExecutor.h"
+#include "Execution/TableManager.h"
+#include "DataStructure/ColumnVector.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+#include "Core/ExceptionHandler.h"
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#define DECLARE_AGGREGATE_TEST(name) DECLARE_TEST(EXECUTION, aggregate_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_AGGREGATE_TEST(accumulator_semantics)
+    {
+        using Xale::DataStructure::FieldValue;
+        using Xale::Execution::AggregateFunction;
+        using Xale::Execution::Accumulator;
+
+        auto aggregate = [](AggregateFunction function, const std::vector<FieldValue>& values) {
+            Accumulator accumulator(function);
+            for (const auto& value : values)
+                accumulator.add(value);
+            return accumulator.result();
+        };
+
+        const std::vector<FieldValue> values = { FieldValue(3), FieldValue(std::monostate{}), FieldValue(5), FieldValue("text") };
+        const std::vector<FieldValue> mixed = { FieldValue(1), FieldValue(2.5) };
+        const std::vector<FieldValue> none = { FieldValue(std::monostate{}) };
+        const std::vector<FieldValue> large = { FieldValue(std::numeric_limits<int>::max()), FieldValue(1) };
+
+        // NULL values are ignored, SUM and AVG also ignore strings, MIN and MAX order numbers before strings
+        return std::get<int>(aggregate(AggregateFunction::Count, values)) == 3
+            && std::get<int>(aggregate(AggregateFunction::Sum, values)) == 8
+            && std::get<double>(aggregate(AggregateFunction::Avg, values)) == 4.0
+            && std::get<int>(aggregate(AggregateFunction::Min, values)) == 3
+            && std::get<std::string>(aggregate(AggregateFunction::Max, values)) == "text"
+            && std::get<double>(aggregate(AggregateFunction::Sum, mixed)) == 3.5
+            && std::get<int>(aggregate(AggregateFunction::Count, none)) == 0
+            && std::holds_alternative<std::monostate>(aggregate(AggregateFunction::Sum, none))
+            && std::holds_alternative<std::monostate>(aggregate(AggregateFunction::Min, none))
+            && std::get<double>(aggregate(AggregateFunction::Sum, large)) == 2147483648.0;
+    }
+
+    DECLARE_AGGREGATE_TEST(columns_match_values)
+    {
+        using Xale::DataStructure::ColumnKind;
+        using Xale::DataStructure::ColumnVector;
+        using Xale::DataStructure::FieldValue;
+        using Xale::Execution::Accumulator;
+        using Xale::Execution::AggregateFunction;
+
+        std::mt19937 rng(18);
+        std::uniform_int_distribution<int> number(-1000, 1000);
+
+        // Sizes around the lane count, floats being halves so that every sum is exact
+        for (size_t size : { 0, 1, 7, 8, 9, 37, 1003 })
+        {
+            for (bool withNulls : { false, true })
+            {
+                ColumnVector integers(ColumnKind::Integer);
+                ColumnVector floats(ColumnKind::Float);
+                std::vector<FieldValue> integerValues;
+                std::vector<FieldValue> floatValues;
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    const bool isNull = withNulls && number(rng) % 4 == 0;
+                    const int value = number(rng);
+                    integerValues.push_back(isNull ? FieldValue(std::monostate{}) : FieldValue(value));
+                    floatValues.push_back(isNull ? FieldValue(std::monostate{}) : FieldValue(value / 2.0));
+                    integers.append(integerValues.back());
+                    floats.append(floatValues.back());
+                }
+
+                for (auto function : { AggregateFunction::Count, AggregateFunction::Sum, AggregateFunction::Avg, AggregateFunction::Min, AggregateFunction::Max })
+                {
+                    Accumulator integerColumn(function);
+                    Accumulator floatColumn(function);
+                    integerColumn.addColumn(integers);
+                    floatColumn.addColumn(floats);
+
+                    // Same result as adding the values one by one
+                    Accumulator integerRows(function);
+                    Accumulator floatRows(function);
+                    for (size_t i = 0; i < integerValues.size(); ++i)
+                    {
+                        integerRows.add(integerValues[i]);
+                        floatRows.add(floatValues[i]);
+                    }
+
+                    if (integerColumn.result() != integerRows.result() || floatColumn.result() != floatRows.result())
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    DECLARE_AGGREGATE_TEST(group_by)
+    {
+        try
+        {
+            using Xale::DataStructure::FieldValue;
+            using Xale::Execution::PlanNodeType;
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-aggregate-group_by.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            createUsersAndOrders(manager);
+            Xale::Execution::BasicExecutor executor(manager);
+
+            // Every user has 10 orders, user u holding the orders u, u + 100, ..., u + 900
+            auto stmt = parseQuery("SELECT COUNT(*), user_id, SUM(id), MAX(product) FROM orders GROUP BY user_id");
+            auto groups = executor.execute(stmt.get());
+            bool success = groups->getRowCount() == 100 && groups->getColumnCount() == 4;
+
+            for (const auto& row : groups->getRows())
+            {
+                const double user = std::get<double>(row.values[1]);
+                success = success
+                    && std::get<int>(row.values[0]) == 10
+                    && std::get<double>(row.values[2]) == 10 * user + 4500
+                    && std::get<std::string>(row.values[3]) == "product" + std::to_string(900 + static_cast<int>(user));
+            }
+
+            // Without GROUP BY, a whole table is aggregated over its columns
+            auto whole = planQuery(manager, "SELECT COUNT(*), AVG(age), MIN(name) FROM users");
+            success = success
+                && whole->children[0]->type == PlanNodeType::Aggregate
+                && whole->children[0]->children[0]->type == PlanNodeType::Scan;
+
+            stmt = parseQuery("SELECT COUNT(*), AVG(age), MIN(name) FROM users");
+            auto totals = executor.execute(stmt.get());
+            const auto& total = totals->getRows()[0];
+            success = success
+                && totals->getRowCount() == 1
+                && std::get<int>(total.values[0]) == 100
+                && std::get<double>(total.values[1]) == 44.5
+                && std::get<std::string>(total.values[2]) == "user0";
+
+            // A single group comes out of no rows
+            stmt = parseQuery("SELECT COUNT(*), SUM(age) FROM users WHERE age > 1000");
+            auto empty = executor.execute(stmt.get());
+            success = success
+                && empty->getRowCount() == 1
+                && std::get<int>(empty->getRows()[0].values[0]) == 0
+                && std::holds_alternative<std::monostate>(empty->getRows()[0].values[1]);
+
+            // Other columns must be grouped
+            bool rejected = false;
+            try { planQuery(manager, "SELECT name, COUNT(*) FROM users GROUP BY age"); }
+            catch (const Xale::Core::DbException&) { rejected = true; }
+
+            storage.shutdown();
+            return success && rejected;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+}
+
+#endif // AGGREGATE_TESTS_H
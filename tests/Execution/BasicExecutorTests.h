@@ -10,10 +10,51 @@
 #include "DataStructure/DataTypes.h"
 #include "Core/ExceptionHandler.h"
 
+#include <filesystem>
+#include <memory>
+#include <string>
+
 #define DECLARE_EXECUTOR_TEST(name) DECLARE_TEST(EXECUTION, basic_executor_##name)
 
 namespace Xale::Tests
 {
+    /**
+     * @brief WHERE clause comparing a column to a numeric literal
+     */
+    inline std::unique_ptr<Xale::Query::WhereClause> makeWhere(const std::string& column, const std::string& op, const std::string& value)
+    {
+        auto cond = std::make_unique<Xale::Query::Expression>(Xale::Query::ExpressionType::BinaryOp);
+        cond->binary = std::make_unique<Xale::Query::BinaryExpression>(
+            std::make_unique<Xale::Query::Expression>(Xale::Query::ExpressionType::Identifier, column),
+            op,
+            std::make_unique<Xale::Query::Expression>(Xale::Query::ExpressionType::NumericLiteral, value)
+        );
+        return std::make_unique<Xale::Query::WhereClause>(std::move(cond));
+    }
+
+    /**
+     * @brief Create accounts(id PRIMARY KEY, balance) through the executor, account i holding i * 100
+     */
+    inline void createAccounts(Xale::Execution::TableManager& manager, Xale::Execution::BasicExecutor& executor, int rowCount)
+    {
+        auto createStmt = std::make_unique<Xale::Query::CreateStatement>();
+        createStmt->tableName = "accounts";
+        executor.execute(createStmt.get());
+
+        auto* table = manager.getTable("accounts");
+        table->addColumn(Xale::DataStructure::ColumnDefinition("id", Xale::DataStructure::FieldType::Integer, true));
+        table->addColumn(Xale::DataStructure::ColumnDefinition("balance", Xale::DataStructure::FieldType::Integer));
+
+        for (int i = 1; i <= rowCount; ++i)
+        {
+            auto insert = std::make_unique<Xale::Query::InsertStatement>();
+            insert->tableName = "accounts";
+            insert->values.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::NumericLiteral, std::to_string(i)));
+            insert->values.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::NumericLiteral, std::to_string(i * 100)));
+            executor.execute(insert.get());
+        }
+    }
+
     DECLARE_EXECUTOR_TEST(create_table)
     {
         try
@@ -507,6 +548,405 @@ namespace Xale::Tests
             return false;
         }
     }
+
+    DECLARE_EXECUTOR_TEST(insert_duplicate_primary_key)
+    {
+        std::filesystem::remove("test-executor-insert_duplicate_pk.bin");
+
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-executor-insert_duplicate_pk.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager);
+        createAccounts(manager, executor, 3);
+
+        bool isThrown = false;
+        try
+        {
+            auto insert = std::make_unique<Xale::Query::InsertStatement>();
+            insert->tableName = "accounts";
+            insert->values.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::NumericLiteral, "2"));
+            insert->values.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::NumericLiteral, "0"));
+            executor.execute(insert.get());
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            isThrown = true;
+        }
+
+        bool success = isThrown && manager.getTable("accounts")->getRowCount() == 3;
+
+        storage.shutdown();
+        return success;
+    }
+
+    DECLARE_EXECUTOR_TEST(update_where)
+    {
+        try
+        {
+            std::filesystem::remove("test-executor-update_where.bin");
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-executor-update_where.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            Xale::Execution::BasicExecutor executor(manager);
+            createAccounts(manager, executor, 5);
+
+            // UPDATE accounts SET balance = 0 WHERE balance > 250
+            auto updateStmt = std::make_unique<Xale::Query::UpdateStatement>();
+            updateStmt->tableName = "accounts";
+            updateStmt->assignments.emplace_back("balance", Xale::Query::Expression(Xale::Query::ExpressionType::NumericLiteral, "0"));
+            updateStmt->where = makeWhere("balance", ">", "250");
+            executor.execute(updateStmt.get());
+
+            auto countWhere = [&](const std::string& value) {
+                auto selectStmt = std::make_unique<Xale::Query::SelectStatement>();
+                selectStmt->tableName = "accounts";
+                selectStmt->columns.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::Wildcard, "*"));
+                selectStmt->where = makeWhere("balance", "=", value);
+                return executor.execute(selectStmt.get())->getRowCount();
+            };
+
+            bool success = countWhere("0") == 3 && countWhere("200") == 1;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_EXECUTOR_TEST(delete_where_primary_key)
+    {
+        try
+        {
+            std::filesystem::remove("test-executor-delete_where_pk.bin");
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-executor-delete_where_pk.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            Xale::Execution::BasicExecutor executor(manager);
+            createAccounts(manager, executor, 5);
+
+            // DELETE FROM accounts WHERE id = 2, the last row moves into its slot
+            auto deleteStmt = std::make_unique<Xale::Query::DeleteStatement>();
+            deleteStmt->tableName = "accounts";
+            deleteStmt->where = makeWhere("id", "=", "2");
+            executor.execute(deleteStmt.get());
+
+            // The moved row is still found through the primary key index
+            auto selectStmt = std::make_unique<Xale::Query::SelectStatement>();
+            selectStmt->tableName = "accounts";
+            selectStmt->columns.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::Wildcard, "*"));
+            selectStmt->where = makeWhere("id", "=", "5");
+            auto result = executor.execute(selectStmt.get());
+
+            auto* table = manager.getTable("accounts");
+            bool success = table->getRowCount() == 4 &&
+                           table->findRows("id", 2).empty() &&
+                           result->getRowCount() == 1;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_EXECUTOR_TEST(secondary_index_maintained)
+    {
+        try
+        {
+            std::filesystem::remove("test-executor-secondary_index.bin");
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-executor-secondary_index.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            Xale::Execution::BasicExecutor executor(manager);
+            createAccounts(manager, executor, 5);
+
+            // CREATE INDEX idx_balance ON accounts(balance)
+            auto createIndex = std::make_unique<Xale::Query::CreateIndexStatement>();
+            createIndex->indexName = "idx_balance";
+            createIndex->tableName = "accounts";
+            createIndex->columnName = "balance";
+            executor.execute(createIndex.get());
+
+            // UPDATE accounts SET balance = 100 WHERE id = 3
+            auto updateStmt = std::make_unique<Xale::Query::UpdateStatement>();
+            updateStmt->tableName = "accounts";
+            updateStmt->assignments.emplace_back("balance", Xale::Query::Expression(Xale::Query::ExpressionType::NumericLiteral, "100"));
+            updateStmt->where = makeWhere("id", "=", "3");
+            executor.execute(updateStmt.get());
+
+            // DELETE FROM accounts WHERE balance = 200, the last row moves into its slot
+            auto deleteStmt = std::make_unique<Xale::Query::DeleteStatement>();
+            deleteStmt->tableName = "accounts";
+            deleteStmt->where = makeWhere("balance", "=", "200");
+            executor.execute(deleteStmt.get());
+
+            auto countWhere = [&](const std::string& value) {
+                auto selectStmt = std::make_unique<Xale::Query::SelectStatement>();
+                selectStmt->tableName = "accounts";
+                selectStmt->columns.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::Wildcard, "*"));
+                selectStmt->where = makeWhere("balance", "=", value);
+                return executor.execute(selectStmt.get())->getRowCount();
+            };
+
+            auto* table = manager.getTable("accounts");
+            bool success = table->isIndexed("balance") &&
+                           countWhere("100") == 2 &&
+                           countWhere("200") == 0 &&
+                           countWhere("300") == 0 &&
+                           countWhere("500") == 1;
+
+            // DROP INDEX idx_balance
+            auto dropIndex = std::make_unique<Xale::Query::DropIndexStatement>();
+            dropIndex->indexName = "idx_balance";
+            executor.execute(dropIndex.get());
+
+            success = success && !table->isIndexed("balance") && countWhere("100") == 2;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_EXECUTOR_TEST(range_on_indexed_columns)
+    {
+        try
+        {
+            std::filesystem::remove("test-executor-range_indexed.bin");
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-executor-range_indexed.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            Xale::Execution::BasicExecutor executor(manager);
+            createAccounts(manager, executor, 20);
+            manager.getTable("accounts")->createIndex(Xale::DataStructure::IndexDefinition("idx_balance", "balance"));
+
+            auto countWhere = [&](const std::string& column, const std::string& op, const std::string& value) {
+                auto selectStmt = std::make_unique<Xale::Query::SelectStatement>();
+                selectStmt->tableName = "accounts";
+                selectStmt->columns.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::Wildcard, "*"));
+                selectStmt->where = makeWhere(column, op, value);
+                return executor.execute(selectStmt.get())->getRowCount();
+            };
+
+            // Primary key index, then secondary index
+            bool success = countWhere("id", "<", "5") == 4 &&
+                           countWhere("id", "<=", "5") == 5 &&
+                           countWhere("id", ">", "15") == 5 &&
+                           countWhere("id", ">=", "15") == 6 &&
+                           countWhere("balance", ">", "1000") == 10 &&
+                           countWhere("balance", "<=", "250") == 2 &&
+                           countWhere("balance", "!=", "100") == 19;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_EXECUTOR_TEST(secondary_index_persisted)
+    {
+        try
+        {
+            const std::string fileName = "test-executor-secondary_index_persisted.bin";
+            std::filesystem::remove(fileName);
+
+            {
+                Xale::Storage::BinaryFileManager fm;
+                Xale::Storage::FileStorageEngine storage(fm, fileName);
+                storage.startup();
+
+                Xale::Execution::TableManager manager(storage, fm);
+                Xale::Execution::BasicExecutor executor(manager);
+                createAccounts(manager, executor, 5);
+
+                auto createIndex = std::make_unique<Xale::Query::CreateIndexStatement>();
+                createIndex->indexName = "idx_balance";
+                createIndex->tableName = "accounts";
+                createIndex->columnName = "balance";
+                executor.execute(createIndex.get());
+
+                storage.shutdown();
+            }
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, fileName);
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            auto* table = manager.getTable("accounts");
+
+            bool success = table != nullptr &&
+                           table->getIndexes().size() == 1 &&
+                           table->getIndexes()[0].name == "idx_balance" &&
+                           table->isIndexed("balance") &&
+                           table->findSlots("balance", 400.0).size() == 1;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_EXECUTOR_TEST(index_memory_limit)
+    {
+        try
+        {
+            std::filesystem::remove("test-executor-index_memory.bin");
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-executor-index_memory.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            Xale::Execution::BasicExecutor executor(manager);
+            createAccounts(manager, executor, 5);
+
+            // The primary key index alone already exceeds the limit
+            size_t usage = manager.getIndexMemoryUsage();
+            manager.setIndexMemoryLimit(usage);
+
+            auto createIndex = std::make_unique<Xale::Query::CreateIndexStatement>();
+            createIndex->indexName = "idx_balance";
+            createIndex->tableName = "accounts";
+            createIndex->columnName = "balance";
+
+            bool rejected = false;
+            try
+            {
+                executor.execute(createIndex.get());
+            }
+            catch (const Xale::Core::DbException&)
+            {
+                rejected = true;
+            }
+
+            bool success = usage > 0
+                && rejected
+                && !manager.getTable("accounts")->isIndexed("balance")
+                && manager.getIndexMemoryUsage() == usage;
+
+            manager.setIndexMemoryLimit(0);
+            executor.execute(createIndex.get());
+            success = success && manager.getIndexMemoryUsage() > usage;
+
+            // Once the limit is reached, the changes growing the indexes are refused
+            manager.setIndexMemoryLimit(manager.getIndexMemoryUsage());
+
+            auto insert = std::make_unique<Xale::Query::InsertStatement>();
+            insert->tableName = "accounts";
+            insert->values.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::NumericLiteral, "6"));
+            insert->values.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::NumericLiteral, "600"));
+
+            auto update = std::make_unique<Xale::Query::UpdateStatement>();
+            update->tableName = "accounts";
+            update->assignments.emplace_back("balance", Xale::Query::Expression(Xale::Query::ExpressionType::NumericLiteral, "0"));
+
+            size_t refused = 0;
+            for (auto* statement : std::vector<Xale::Query::Statement*>{ insert.get(), update.get() })
+            {
+                try
+                {
+                    executor.execute(statement);
+                }
+                catch (const Xale::Core::DbException&)
+                {
+                    ++refused;
+                }
+            }
+
+            success = success && refused == 2
+                && manager.getTable("accounts")->findSlots("balance", 0.0).empty()
+                && manager.getTable("accounts")->findSlots("id", 6.0).empty();
+
+            // LIST reports the memory of the indexes of each table
+            Xale::Query::ListStatement list;
+            auto listed = executor.execute(&list);
+            success = success && listed->getSchema().size() == 2
+                && listed->getRow(0).values[1] == Xale::DataStructure::FieldValue(static_cast<double>(manager.getIndexMemoryUsage()));
+
+            manager.setIndexMemoryLimit(0);
+            executor.execute(insert.get());
+            success = success && manager.getIndexMemoryUsage() > 0;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_EXECUTOR_TEST(select_projection_is_positional)
+    {
+        try
+        {
+            std::filesystem::remove("test-executor-projection.bin");
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-executor-projection.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            Xale::Execution::BasicExecutor executor(manager);
+            createAccounts(manager, executor, 3);
+
+            // SELECT balance, accounts.id, missing FROM accounts WHERE id = 2
+            auto selectStmt = std::make_unique<Xale::Query::SelectStatement>();
+            selectStmt->tableName = "accounts";
+            selectStmt->columns.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::Identifier, "balance"));
+            selectStmt->columns.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::Identifier, "accounts.id"));
+            selectStmt->columns.push_back(Xale::Query::Expression(Xale::Query::ExpressionType::Identifier, "missing"));
+            selectStmt->where = makeWhere("id", "=", "2");
+
+            auto result = executor.execute(selectStmt.get());
+            const auto& schema = result->getSchema();
+            const auto& values = result->getRow(0).values;
+
+            bool success = result->getRowCount() == 1
+                && schema.size() == 3 && schema[0].name == "balance" && schema[1].name == "id"
+                && schema[1].type == Xale::DataStructure::FieldType::Integer
+                && values.size() == 3
+                && values[0] == Xale::DataStructure::FieldValue(200.0)
+                && values[1] == Xale::DataStructure::FieldValue(2.0)
+                && std::holds_alternative<std::monostate>(values[2]);
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
 }
 
 #endif // BASIC_EXECUTOR_TESTS_H
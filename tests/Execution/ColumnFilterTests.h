@@ -0,0 +1,103 @@
+#ifndef COLUMN_FILTER_TESTS_H
+#define COLUMN_FILTER_TESTS_H
+
+#include "TestsHelper.h"
+#include "Execution/ColumnFilter.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#define DECLARE_COLUMN_FILTER_TEST(name) DECLARE_TEST(EXECUTION, column_filter_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_COLUMN_FILTER_TEST(parse_operators)
+    {
+        using Xale::Execution::CompareOp;
+
+        CompareOp op = CompareOp::Equal;
+        bool parsed = Xale::Execution::parseCompareOp("<=", op) && op == CompareOp::LessEqual
+            && Xale::Execution::parseCompareOp("!=", op) && op == CompareOp::NotEqual;
+
+        return parsed && !Xale::Execution::parseCompareOp("LIKE", op);
+    }
+
+    DECLARE_COLUMN_FILTER_TEST(compare_values)
+    {
+        using Xale::Execution::CompareOp;
+        using Xale::DataStructure::FieldValue;
+
+        // Exact equality, ordered comparisons between numbers of the same type only
+        return Xale::Execution::compareValues(FieldValue(2.0), CompareOp::Equal, FieldValue(2.0))
+            && !Xale::Execution::compareValues(FieldValue(2), CompareOp::Equal, FieldValue(2.0))
+            && Xale::Execution::compareValues(FieldValue(std::monostate{}), CompareOp::NotEqual, FieldValue(2.0))
+            && Xale::Execution::compareValues(FieldValue(1), CompareOp::Less, FieldValue(2))
+            && !Xale::Execution::compareValues(FieldValue(1), CompareOp::Less, FieldValue(2.0))
+            && !Xale::Execution::compareValues(FieldValue(std::string("a")), CompareOp::Less, FieldValue(std::string("b")));
+    }
+
+    DECLARE_COLUMN_FILTER_TEST(batches_match_row_evaluation)
+    {
+        using Xale::Execution::CompareOp;
+        using Xale::DataStructure::FieldValue;
+
+        const CompareOp ops[] = { CompareOp::Equal, CompareOp::NotEqual, CompareOp::Less,
+                                  CompareOp::LessEqual, CompareOp::Greater, CompareOp::GreaterEqual };
+        std::mt19937 rng(7);
+
+        auto randomValue = [&rng](int type) -> FieldValue {
+            switch (type)
+            {
+                case 0: return static_cast<int>(rng() % 20);
+                case 1: return static_cast<double>(rng() % 20);
+                case 2: return std::string(1, static_cast<char>('a' + rng() % 20));
+                default: return std::monostate{};
+            }
+        };
+
+        // Columns of every kind, with and without NULLs, spanning several batches
+        for (int columnType = 0; columnType < 4; ++columnType)
+        {
+            for (int nullEvery : { 0, 3 })
+            {
+                std::vector<FieldValue> values;
+                const size_t count = 2 * Xale::Execution::FILTER_BATCH_SIZE + 100;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    int type = columnType == 3 ? static_cast<int>(rng() % 3) : columnType;
+                    if (nullEvery != 0 && i % nullEvery == 1)
+                        type = 3;
+                    values.push_back(randomValue(type));
+                }
+
+                Xale::DataStructure::ColumnVector column(Xale::DataStructure::ColumnVector::kindOf(values.front()));
+                for (const auto& value : values)
+                    column.append(value);
+
+                // The filter matches the same values as compareValues()
+                for (CompareOp op : ops)
+                {
+                    for (int literalType = 0; literalType < 4; ++literalType)
+                    {
+                        const FieldValue literal = randomValue(literalType);
+
+                        std::vector<size_t> expected;
+                        for (size_t i = 0; i < values.size(); ++i)
+                        {
+                            if (Xale::Execution::compareValues(values[i], op, literal))
+                                expected.push_back(i);
+                        }
+
+                        if (Xale::Execution::ColumnFilter(op, literal).filter(column) != expected)
+                            return false;
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+#endif // COLUMN_FILTER_TESTS_H
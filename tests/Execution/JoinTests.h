@@ -0,0 +1,148 @@
+#ifndef JOIN_TESTS_H
+#define JOIN_TESTS_H
+
+#include "TestsHelper.h"
+#include "Execution/Join.h"
+#include "Execution/Operators.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#define DECLARE_JOIN_TEST(name) DECLARE_TEST(EXECUTION, join_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_JOIN_TEST(values_equal_with_coercion)
+    {
+        using Xale::DataStructure::FieldValue;
+        Xale::Execution::JoinKeyHash hash;
+
+        return Xale::Execution::joinValuesEqual(FieldValue(2), FieldValue(2.0))
+            && hash(FieldValue(2)) == hash(FieldValue(2.0))
+            && hash(FieldValue(0.0)) == hash(FieldValue(-0.0))
+            && !Xale::Execution::joinValuesEqual(FieldValue(2), FieldValue(std::string("2")))
+            && !Xale::Execution::joinValuesEqual(FieldValue(2), FieldValue(2.5));
+    }
+
+    DECLARE_JOIN_TEST(hash_join_matches_nested_loop)
+    {
+        std::mt19937 rng(3);
+        size_t pulled = 0;
+
+        // Build on the right side, then on the left side
+        for (auto sizes : { std::pair<size_t, size_t>{ 300, 50 }, std::pair<size_t, size_t>{ 50, 300 } })
+        {
+            auto left = makeKeyedRows(rng, sizes.first, 40);
+            auto right = makeKeyedRows(rng, sizes.second, 40);
+
+            auto expected = nestedLoopJoin(left, 0, right, 0);
+            Xale::Execution::HashJoinOperator join(
+                std::make_unique<RowsOperator>(left, pulled), 0,
+                std::make_unique<RowsOperator>(right, pulled), 0,
+                sizes.first < sizes.second);
+
+            if (expected.empty() || !sameRows(sortByPositions(drainOperator(join)), expected))
+                return false;
+        }
+
+        Xale::Execution::HashJoinOperator empty(
+            std::make_unique<RowsOperator>(std::vector<Xale::DataStructure::Row>(), pulled), 0,
+            std::make_unique<RowsOperator>(makeKeyedRows(rng, 10, 5), pulled), 0,
+            true);
+        return drainOperator(empty).empty();
+    }
+
+    DECLARE_JOIN_TEST(choose_strategy)
+    {
+        using Xale::Execution::JoinStrategy;
+        using Xale::Execution::chooseJoinStrategy;
+
+        // Few rows looked up in a large indexed table, similar sizes, ordered inputs, no index
+        return chooseJoinStrategy(100, false, 1000000, true) == JoinStrategy::IndexNestedLoop
+            && chooseJoinStrategy(100000, false, 100000, true) == JoinStrategy::Hash
+            && chooseJoinStrategy(100000, true, 100000, true) == JoinStrategy::SortMerge
+            && chooseJoinStrategy(100, true, 1000000, true) == JoinStrategy::IndexNestedLoop
+            && chooseJoinStrategy(100, false, 1000000, false) == JoinStrategy::Hash;
+    }
+
+    DECLARE_JOIN_TEST(slots_in_key_order)
+    {
+        std::mt19937 rng(5);
+        auto rows = makeKeyedRows(rng, 200, 30);
+        auto indexed = makeKeyedTable("indexed", rows);
+
+        // Without index the slots are sorted, with the same order
+        Xale::DataStructure::Table plain("plain");
+        plain.addColumn(Xale::DataStructure::ColumnDefinition("key", Xale::DataStructure::FieldType::Integer));
+        plain.addColumn(Xale::DataStructure::ColumnDefinition("position", Xale::DataStructure::FieldType::Integer));
+        for (const auto& row : rows)
+            plain.insertRow(row);
+
+        auto order = indexed.findSlotsInKeyOrder("key");
+        Xale::DataStructure::FieldValueLess less;
+        for (size_t i = 1; i < order.size(); ++i)
+        {
+            const auto& previous = rows[order[i - 1]].values[0];
+            const auto& current = rows[order[i]].values[0];
+            if (less(current, previous) || (!less(previous, current) && order[i - 1] > order[i]))
+                return false;
+        }
+
+        return order.size() == rows.size()
+            && plain.findSlotsInKeyOrder("key") == order
+            && indexed.findSlotsInKeyOrder("missing").empty();
+    }
+
+    DECLARE_JOIN_TEST(index_nested_loop_matches_nested_loop)
+    {
+        using Xale::DataStructure::Snapshot;
+
+        std::mt19937 rng(8);
+        auto left = makeKeyedRows(rng, 60, 40);
+        auto right = makeKeyedTable("right", makeKeyedRows(rng, 400, 40));
+        size_t pulled = 0;
+
+        auto expected = nestedLoopJoin(left, 0, right.getRows(), 0);
+        Xale::Execution::IndexNestedLoopJoinOperator join(std::make_unique<RowsOperator>(left, pulled), 0, right, 0, { 0, 1 });
+        bool success = !expected.empty() && sameRows(drainOperator(join), expected);
+
+        // Rows deleted by a pending transaction are joined by the other snapshots only
+        const uint64_t transaction = Xale::DataStructure::PENDING_VERSION | 1;
+        std::vector<size_t> deleted;
+        for (size_t slot = 0; slot < right.getRowCount(); slot += 3)
+            deleted.push_back(slot);
+        right.deleteVersionsAt(deleted, transaction);
+
+        std::vector<Xale::DataStructure::Row> visible;
+        for (size_t slot = 0; slot < right.getRowCount(); ++slot)
+        {
+            if (slot % 3 != 0)
+                visible.push_back(right.getRow(slot));
+        }
+
+        Xale::Execution::IndexNestedLoopJoinOperator before(
+            std::make_unique<RowsOperator>(left, pulled), 0, right, 0, { 0, 1 }, Snapshot{ 0, 0 });
+        Xale::Execution::IndexNestedLoopJoinOperator own(
+            std::make_unique<RowsOperator>(left, pulled), 0, right, 0, { 0, 1 }, Snapshot{ 0, transaction });
+
+        return success
+            && sameRows(drainOperator(before), expected)
+            && sameRows(drainOperator(own), nestedLoopJoin(left, 0, visible, 0));
+    }
+
+    DECLARE_JOIN_TEST(sort_merge_matches_nested_loop)
+    {
+        std::mt19937 rng(9);
+        auto left = makeKeyedTable("left", makeKeyedRows(rng, 300, 40));
+        auto right = makeKeyedTable("right", makeKeyedRows(rng, 200, 40));
+
+        auto expected = nestedLoopJoin(left.getRows(), 0, right.getRows(), 0);
+        Xale::Execution::SortMergeJoinOperator join(left, { 0, 1 }, 0, right, { 0, 1 }, 0);
+
+        return !expected.empty() && sameRows(sortByPositions(drainOperator(join)), sortByPositions(expected));
+    }
+}
+
+#endif // JOIN_TESTS_H
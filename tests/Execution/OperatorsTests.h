@@ -0,0 +1,97 @@
+#ifndef OPERATORS_TESTS_H
+#define OPERATORS_TESTS_H
+
+#include "TestsHelper.h"
+#include "Execution/Operators.h"
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#define DECLARE_OPERATORS_TEST(name) DECLARE_TEST(EXECUTION, operators_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_OPERATORS_TEST(limit_stops_pulling)
+    {
+        using Xale::DataStructure::FieldValue;
+        using Xale::DataStructure::Row;
+
+        std::vector<Row> rows;
+        for (int i = 0; i < 100; ++i)
+            rows.push_back(Row({ FieldValue(i) }));
+
+        size_t pulled = 0;
+        Xale::Execution::LimitOperator limit(std::make_unique<RowsOperator>(rows, pulled), 5, 3);
+        auto limited = drainOperator(limit);
+
+        size_t emptyPulled = 0;
+        Xale::Execution::LimitOperator pastEnd(std::make_unique<RowsOperator>(rows, emptyPulled), 5, 200);
+
+        return limited.size() == 5
+            && std::get<int>(limited.front().values[0]) == 3
+            && std::get<int>(limited.back().values[0]) == 7
+            && pulled == 8
+            && drainOperator(pastEnd).empty();
+    }
+
+    DECLARE_OPERATORS_TEST(filtered_scan_matches_row_filter)
+    {
+        using Xale::Execution::CompareOp;
+
+        std::mt19937 rng(11);
+        auto table = makeKeyedTable("filtered", makeKeyedRows(rng, 5000, 40));
+
+        // Batches without any match are skipped
+        for (auto op : { CompareOp::Equal, CompareOp::Greater })
+        {
+            Xale::Execution::BoundCondition condition{ false, 0, op, Xale::DataStructure::FieldValue(30.0) };
+            Xale::Execution::FilteredScanOperator scan(table, { 1 }, condition);
+
+            std::vector<Xale::DataStructure::Row> expected;
+            for (const auto& row : table.getRows())
+            {
+                if (Xale::Execution::compareValues(row.values[0], op, condition.value))
+                    expected.push_back(Xale::DataStructure::Row({ row.values[1] }));
+            }
+
+            if (expected.empty() || !sameRows(drainOperator(scan), expected))
+                return false;
+        }
+
+        Xale::Execution::BoundCondition none{ false, 0, CompareOp::Equal, Xale::DataStructure::FieldValue(1000.0) };
+        Xale::Execution::FilteredScanOperator empty(table, { 0, 1 }, none);
+        return drainOperator(empty).empty();
+    }
+
+    DECLARE_OPERATORS_TEST(joins_match_nested_loop)
+    {
+        std::mt19937 rng(12);
+        auto left = makeKeyedTable("left", makeKeyedRows(rng, 200, 40));
+        auto right = makeKeyedTable("right", makeKeyedRows(rng, 300, 40));
+        auto expected = nestedLoopJoin(left.getRows(), 0, right.getRows(), 0);
+        size_t pulled = 0;
+
+        // Hash joins follow the order of the streamed input
+        for (bool buildLeft : { false, true })
+        {
+            Xale::Execution::HashJoinOperator hash(
+                std::make_unique<Xale::Execution::ScanOperator>(left, std::vector<size_t>{ 0, 1 }), 0,
+                std::make_unique<Xale::Execution::ScanOperator>(right, std::vector<size_t>{ 0, 1 }), 0,
+                buildLeft);
+            auto joined = sortByPositions(drainOperator(hash));
+            if (expected.empty() || !sameRows(joined, expected))
+                return false;
+        }
+
+        Xale::Execution::IndexNestedLoopJoinOperator lookup(
+            std::make_unique<RowsOperator>(left.getRows(), pulled), 0, right, 0, { 0, 1 });
+        Xale::Execution::SortMergeJoinOperator merge(left, { 0, 1 }, 0, right, { 0, 1 }, 0);
+
+        return sameRows(drainOperator(lookup), expected)
+            && sameRows(sortByPositions(drainOperator(merge)), expected);
+    }
+}
+
+#endif // OPERATORS_TESTS_H
@@ -0,0 +1,172 @@
+#ifndef PREDICATE_TESTS_H
+#define PREDICATE_TESTS_H
+
+#include "TestsHelper.h"
+#include "Execution/BasicExecutor.h"
+#include "Execution/Predicate.h"
+#include "Execution/TableManager.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+#include "Core/ExceptionHandler.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#define DECLARE_PREDICATE_TEST(name) DECLARE_TEST(EXECUTION, predicate_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_PREDICATE_TEST(compiled_conditions)
+    {
+        try
+        {
+            using Xale::DataStructure::FieldValue;
+            using Xale::DataStructure::Row;
+
+            // Rows (a, b, s), a counting from 0, b scrambling it and s cycling through 'x', 'y' and NULL
+            std::vector<Row> rows;
+            for (int i = 0; i < 30; ++i)
+            {
+                const FieldValue s = i % 3 == 0 ? FieldValue("x") : i % 3 == 1 ? FieldValue("y") : FieldValue(std::monostate{});
+                rows.push_back(Row({ FieldValue(static_cast<double>(i)), FieldValue(static_cast<double>(i * 7 % 10)), s }));
+            }
+
+            // The WHERE clause of a query selects the same rows as the expected condition
+            auto matches = [&rows](const std::string& condition, const std::function<bool(double, double, const FieldValue&)>& expected) {
+                auto stmt = parseQuery("SELECT a FROM t WHERE " + condition);
+                const auto& select = *static_cast<Xale::Query::SelectStatement*>(stmt.get());
+
+                const auto predicate = Xale::Execution::compilePredicate(*select.where->condition, [](const std::string& name) {
+                    return name == "a" ? 0 : name == "b" ? 1 : name == "s" ? 2 : -1;
+                });
+
+                for (const auto& row : rows)
+                {
+                    if (predicate(row) != expected(std::get<double>(row.values[0]), std::get<double>(row.values[1]), row.values[2]))
+                        return false;
+                }
+                return true;
+            };
+
+            const FieldValue x("x");
+            const FieldValue y("y");
+
+            // AND binds tighter than OR, NOT applies to the condition that follows
+            return matches("a > 3 AND b < 5 OR s = 'x'", [&](double a, double b, const FieldValue& s) { return (a > 3 && b < 5) || s == x; })
+                && matches("(a = 1 OR a = 2) AND NOT s = 'y'", [&](double a, double, const FieldValue& s) { return (a == 1 || a == 2) && s != y; })
+                && matches("NOT a BETWEEN 2 AND 20", [](double a, double, const FieldValue&) { return !(a >= 2 && a <= 20); })
+                && matches("b NOT BETWEEN 3 AND 6 AND a <= 12", [](double a, double b, const FieldValue&) { return !(b >= 3 && b <= 6) && a <= 12; })
+                && matches("a IN (1, 4, 9)", [](double a, double, const FieldValue&) { return a == 1 || a == 4 || a == 9; })
+                && matches("a IN (0, 2, 4, 6, 8, 10, 12, 14, 16, 18)", [](double a, double, const FieldValue&) { return a <= 18 && static_cast<int>(a) % 2 == 0; })
+                && matches("s NOT IN ('y', 'z')", [&](double, double, const FieldValue& s) { return s != y; })
+                && matches("5 > a OR 8 <= b", [](double a, double b, const FieldValue&) { return a < 5 || b >= 8; })
+                && matches("s > 'a'", [](double, double, const FieldValue&) { return false; })
+                && matches("s != 'x'", [&](double, double, const FieldValue& s) { return s != x; })
+                && matches("a = b", [](double a, double b, const FieldValue&) { return a == b; })
+                && matches("missing = 1 OR a = 1", [](double a, double, const FieldValue&) { return a == 1; })
+                && matches("1 = 1 AND NOT (a < 10 OR b >= 5)", [](double a, double b, const FieldValue&) { return !(a < 10 || b >= 5); });
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_PREDICATE_TEST(where_pushdown)
+    {
+        try
+        {
+            using Xale::Execution::PlanNodeType;
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-predicate-where_pushdown.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            createUsersAndOrders(manager);
+            Xale::Execution::BasicExecutor executor(manager);
+
+            // The indexed comparison is looked up, the rest of the condition filters its rows
+            const std::string lookup = "SELECT name FROM users WHERE age > 25 AND id = 7";
+            auto indexed = planQuery(manager, lookup);
+            const auto& residual = *indexed->children[0];
+            bool success = residual.type == PlanNodeType::Filter
+                && residual.detail == "age > 25"
+                && residual.children[0]->type == PlanNodeType::IndexScan
+                && residual.children[0]->detail == "users [id, name, age] where id = 7";
+
+            auto stmt = parseQuery(lookup);
+            auto one = executor.execute(stmt.get());
+            success = success && one->getRowCount() == 1 && std::get<std::string>(one->getRows()[0].values[0]) == "user7";
+
+            // Conditions on one table are pushed down to it, conditions on both are evaluated on the joined rows
+            const std::string join = "SELECT users.name, orders.product FROM users JOIN orders ON users.id = orders.user_id"
+                " WHERE users.id BETWEEN 10 AND 12 AND orders.id < 300 AND orders.id > users.id";
+            auto joined = planQuery(manager, join);
+            const auto& top = *joined->children[0];
+            success = success
+                && top.type == PlanNodeType::Filter
+                && top.detail == "orders.id > users.id"
+                && top.children[0]->type == PlanNodeType::Join;
+
+            stmt = parseQuery(join);
+            auto pairs = executor.execute(stmt.get());
+            success = success && pairs->getRowCount() == 6 && ordersMatchUsers(pairs->getRows());
+
+            // Ages 30 to 32 for users 10 to 12 and 60 to 62, and the users from 95
+            stmt = parseQuery("SELECT id FROM users WHERE age BETWEEN 30 AND 32 OR NOT id < 95");
+            auto either = executor.execute(stmt.get());
+            success = success && either->getRowCount() == 11;
+
+            stmt = parseQuery("SELECT id FROM users WHERE id IN (3, 5, 500) AND name NOT IN ('user5')");
+            auto listed = executor.execute(stmt.get());
+            success = success && listed->getRowCount() == 1 && std::get<double>(listed->getRows()[0].values[0]) == 3.0;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_PREDICATE_TEST(update_delete)
+    {
+        try
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-predicate-update_delete.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            createUsersAndOrders(manager);
+            Xale::Execution::BasicExecutor executor(manager);
+
+            // Users 6 to 9 are found through the primary key, then filtered on their age
+            auto stmt = parseQuery("UPDATE users SET name = 'renamed' WHERE id < 10 AND age > 25");
+            executor.execute(stmt.get());
+
+            stmt = parseQuery("SELECT COUNT(*) FROM users WHERE name = 'renamed'");
+            auto renamed = executor.execute(stmt.get());
+            bool success = std::get<int>(renamed->getRows()[0].values[0]) == 4;
+
+            // Users 1 to 3, and users 49 and 99 aged 69
+            stmt = parseQuery("DELETE FROM users WHERE id IN (1, 2, 3) OR age = 69");
+            executor.execute(stmt.get());
+
+            const auto* users = manager.getTable("users");
+            success = success && users->getRowCount() == 95;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+}
+
+#endif // PREDICATE_TESTS_H
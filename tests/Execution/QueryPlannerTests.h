@@ -0,0 +1,233 @@
+#ifndef QUERY_PLANNER_TESTS_H
+#define QUERY_PLANNER_TESTS_H
+
+#include "TestsHelper.h"
+#include "Execution/BasicExecutor.h"
+#include "Execution/QueryPlanner.h"
+#include "Execution/TableManager.h"
+#include "Query/BasicParser.h"
+#include "Query/BasicTokenizer.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+#include "Core/ExceptionHandler.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#define DECLARE_QUERY_PLANNER_TEST(name) DECLARE_TEST(EXECUTION, query_planner_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_QUERY_PLANNER_TEST(pushes_condition_down)
+    {
+        try
+        {
+            using Xale::Execution::PlanNodeType;
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-planner-pushes_condition_down.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            createUsersAndOrders(manager);
+
+            // An indexed column is looked up, only the columns read are produced
+            auto indexed = planQuery(manager, "SELECT name FROM users WHERE id = 7");
+            const auto& indexScan = *indexed->children[0];
+            bool success = indexed->type == PlanNodeType::Project
+                && indexed->projection == std::vector<int>({ 1 })
+                && indexScan.type == PlanNodeType::IndexScan
+                && indexScan.columns == std::vector<size_t>({ 0, 1 })
+                && indexScan.condition.column == 0
+                && indexScan.estimatedRows == 1;
+
+            // Other columns filter a scan, the condition referring to the scanned columns
+            auto filtered = planQuery(manager, "SELECT name FROM users WHERE age > 60");
+            const auto& filter = *filtered->children[0];
+            success = success
+                && filter.type == PlanNodeType::Filter
+                && filter.condition.column == 1
+                && filter.children[0]->type == PlanNodeType::Scan
+                && filter.children[0]->columns == std::vector<size_t>({ 1, 2 });
+
+            Xale::Execution::BasicExecutor executor(manager);
+            auto stmt = parseQuery("SELECT name FROM users WHERE age > 60");
+            auto result = executor.execute(stmt.get());
+            success = success && result->getRowCount() == 18 && result->getColumnCount() == 1;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_QUERY_PLANNER_TEST(reorders_joins)
+    {
+        try
+        {
+            using Xale::Execution::JoinStrategy;
+            using Xale::Execution::PlanNodeType;
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-planner-reorders_joins.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            createUsersAndOrders(manager);
+            Xale::Execution::BasicExecutor executor(manager);
+
+            // The smaller table is read first, and hashed
+            const std::string query = "SELECT users.name, orders.product FROM orders JOIN users ON orders.user_id = users.id";
+            auto hashed = planQuery(manager, query);
+            const auto& hashJoin = *hashed->children[0];
+            bool success = hashJoin.type == PlanNodeType::Join
+                && hashJoin.strategy == JoinStrategy::Hash
+                && hashJoin.children[0]->table == manager.getTable("users")
+                && hashJoin.estimatedRows == 1000;
+
+            auto stmt = parseQuery(query);
+            auto all = executor.execute(stmt.get());
+            success = success
+                && all->getRowCount() == 1000
+                && ordersMatchUsers(all->getRows());
+
+            // A single user looks its orders up in their index
+            manager.getTable("orders")->createIndex(Xale::DataStructure::IndexDefinition("orders_user_id", "user_id"));
+            const std::string lookup = query + " WHERE users.id = 3";
+            auto indexed = planQuery(manager, lookup);
+            const auto& indexJoin = *indexed->children[0];
+            success = success
+                && indexJoin.strategy == JoinStrategy::IndexNestedLoop
+                && indexJoin.children[0]->type == PlanNodeType::IndexScan
+                && indexJoin.estimatedRows == 10;
+
+            stmt = parseQuery(lookup);
+            auto some = executor.execute(stmt.get());
+            success = success
+                && some->getRowCount() == 10
+                && ordersMatchUsers(some->getRows())
+                && std::get<std::string>(some->getRows()[0].values[0]) == "user3";
+
+            // The joined table may be named on either side of the condition
+            stmt = parseQuery("SELECT users.name, orders.product FROM orders JOIN users ON users.id = orders.user_id");
+            auto reversed = executor.execute(stmt.get());
+            success = success
+                && reversed->getRowCount() == 1000
+                && ordersMatchUsers(reversed->getRows());
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_QUERY_PLANNER_TEST(explain)
+    {
+        try
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-planner-explain.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            createUsersAndOrders(manager);
+            Xale::Execution::BasicExecutor executor(manager);
+
+            auto stmt = parseQuery("EXPLAIN SELECT name FROM users WHERE id = 7");
+            auto result = executor.execute(stmt.get());
+
+            const auto& rows = result->getRows();
+            bool success = result->getColumnCount() == 1
+                && result->getSchema()[0].name == "plan"
+                && rows.size() == 2
+                && std::get<std::string>(rows[0].values[0]) == "Project name (rows: 1)"
+                && std::get<std::string>(rows[1].values[0]) == "  IndexScan users [id, name] where id = 7 (rows: 1)";
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_QUERY_PLANNER_TEST(limit)
+    {
+        try
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-planner-limit.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            createUsersAndOrders(manager);
+            Xale::Execution::BasicExecutor executor(manager);
+
+            auto limited = planQuery(manager, "SELECT name FROM users LIMIT 5 OFFSET 10");
+            bool success = limited->type == Xale::Execution::PlanNodeType::Limit
+                && Xale::Execution::QueryPlanner::explain(*limited)[0] == "Limit 5 offset 10 (rows: 5)";
+
+            auto stmt = parseQuery("SELECT name FROM users LIMIT 5 OFFSET 10");
+            auto result = executor.execute(stmt.get());
+            const auto& rows = result->getRows();
+            success = success
+                && rows.size() == 5
+                && std::get<std::string>(rows.front().values[0]) == "user10"
+                && std::get<std::string>(rows.back().values[0]) == "user14";
+
+            stmt = parseQuery("SELECT * FROM orders JOIN users ON orders.user_id = users.id LIMIT 3");
+            success = success && executor.execute(stmt.get())->getRowCount() == 3;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_QUERY_PLANNER_TEST(unknown_columns)
+    {
+        try
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-planner-unknown_columns.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            createUsersAndOrders(manager);
+            Xale::Execution::BasicExecutor executor(manager);
+
+            // Unknown selected columns are NULL
+            auto stmt = parseQuery("SELECT name, missing FROM users WHERE id = 1");
+            auto selected = executor.execute(stmt.get());
+            bool success = selected->getRowCount() == 1
+                && std::holds_alternative<std::monostate>(selected->getRows()[0].values[1]);
+
+            // Unknown condition or join columns match nothing
+            stmt = parseQuery("SELECT name FROM users WHERE missing = 1");
+            success = success && executor.execute(stmt.get())->getRowCount() == 0;
+
+            stmt = parseQuery("SELECT * FROM users JOIN orders ON users.missing = orders.user_id");
+            success = success && executor.execute(stmt.get())->getRowCount() == 0;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+}
+
+#endif // QUERY_PLANNER_TESTS_H
@@ -0,0 +1,137 @@
+#ifndef SORT_TESTS_H
+#define SORT_TESTS_H
+
+#include "TestsHelper.h"
+#include "Execution/BasicExecutor.h"
+#include "Execution/Operators.h"
+#include "Execution/TableManager.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+#include "Core/ExceptionHandler.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#define DECLARE_SORT_TEST(name) DECLARE_TEST(EXECUTION, sort_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_SORT_TEST(strategies_match_stable_sort)
+    {
+        using Xale::DataStructure::ColumnDefinition;
+        using Xale::DataStructure::FieldType;
+        using Xale::DataStructure::Row;
+        using Xale::Execution::SortKey;
+
+        std::mt19937 rng(19);
+        const auto rows = makeKeyedRows(rng, 3000, 200);
+        const std::vector<ColumnDefinition> schema = { ColumnDefinition("key", FieldType::Integer), ColumnDefinition("position", FieldType::Integer) };
+        size_t pulled = 0;
+
+        for (bool descending : { false, true })
+        {
+            // Stably sorted on the key, mixing integers, floats and strings
+            auto expected = rows;
+            Xale::DataStructure::FieldValueLess less;
+            std::stable_sort(expected.begin(), expected.end(), [&](const Row& a, const Row& b) {
+                return descending ? less(b.values[0], a.values[0]) : less(a.values[0], b.values[0]);
+            });
+            const std::vector<SortKey> keys = { { 0, descending } };
+
+            // A budget of a few rows spills many runs, merged back in order
+            Xale::Execution::SortOperator inMemory(std::make_unique<RowsOperator>(rows, pulled), keys, schema);
+            Xale::Execution::SortOperator external(std::make_unique<RowsOperator>(rows, pulled), keys, schema, 4096);
+            Xale::Execution::TopKSortOperator topK(std::make_unique<RowsOperator>(rows, pulled), keys, 25);
+
+            if (!sameRows(drainOperator(inMemory), expected))
+                return false;
+
+            external.open();
+            const size_t runs = external.getRunCount();
+            std::vector<Row> merged;
+            Row row;
+            while (external.next(row))
+                merged.push_back(row);
+            external.close();
+
+            if (runs < 10 || !sameRows(merged, expected))
+                return false;
+
+            if (!sameRows(drainOperator(topK), std::vector<Row>(expected.begin(), expected.begin() + 25)))
+                return false;
+        }
+
+        Xale::Execution::TopKSortOperator none(std::make_unique<RowsOperator>(rows, pulled), { { 0, false } }, 0);
+        return drainOperator(none).empty();
+    }
+
+    DECLARE_SORT_TEST(order_by)
+    {
+        try
+        {
+            using Xale::Execution::PlanNodeType;
+            using Xale::Execution::SortStrategy;
+
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, "test-sort-order_by.bin");
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            createUsersAndOrders(manager);
+            Xale::Execution::BasicExecutor executor(manager);
+
+            // Sorting on the primary key reads its index
+            auto byId = planQuery(manager, "SELECT name FROM users WHERE age > 30 ORDER BY id DESC");
+            const auto& filter = *byId->children[0];
+            bool success = filter.type == PlanNodeType::Filter
+                && filter.children[0]->type == PlanNodeType::Scan
+                && filter.children[0]->sortKeys.size() == 1;
+
+            auto stmt = parseQuery("SELECT name FROM users WHERE age > 30 ORDER BY id DESC");
+            auto descending = executor.execute(stmt.get());
+            success = success
+                && descending->getRowCount() == 78
+                && std::get<std::string>(descending->getRows().front().values[0]) == "user99"
+                && std::get<std::string>(descending->getRows().back().values[0]) == "user11";
+
+            // Other columns are sorted, keeping only the first rows under a LIMIT
+            const std::string query = "SELECT name, age FROM users ORDER BY age DESC, name LIMIT 3 OFFSET 1";
+            auto topK = planQuery(manager, query);
+            const auto& sort = *topK->children[0]->children[0];
+            success = success
+                && sort.type == PlanNodeType::Sort
+                && sort.sortStrategy == SortStrategy::TopK
+                && sort.limit == 4;
+
+            stmt = parseQuery(query);
+            auto oldest = executor.execute(stmt.get());
+            success = success
+                && oldest->getRowCount() == 3
+                && std::get<std::string>(oldest->getRows()[0].values[0]) == "user99"
+                && std::get<std::string>(oldest->getRows()[1].values[0]) == "user48"
+                && std::get<std::string>(oldest->getRows()[2].values[0]) == "user98";
+
+            // Groups are sorted on their aggregates, computed even when not selected
+            stmt = parseQuery("SELECT age FROM users WHERE id < 60 GROUP BY age ORDER BY COUNT(*) DESC, age");
+            auto groups = executor.execute(stmt.get());
+            success = success
+                && groups->getRowCount() == 50
+                && groups->getColumnCount() == 1
+                && std::get<double>(groups->getRows()[0].values[0]) == 20.0
+                && std::get<double>(groups->getRows()[9].values[0]) == 29.0
+                && std::get<double>(groups->getRows()[10].values[0]) == 30.0;
+
+            storage.shutdown();
+            return success;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+}
+
+#endif // SORT_TESTS_H
@@ -8,10 +8,47 @@
 #include "DataStructure/DataTypes.h"
 #include "Core/ExceptionHandler.h"
 
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+
 #define DECLARE_TABLE_MANAGER_TEST(name) DECLARE_TEST(EXECUTION, table_manager_##name)
 
 namespace Xale::Tests
 {
+    /**
+     * @brief Create users(id PRIMARY KEY, name) holding (1, "alice") and (2, "bob"), saved
+     */
+    inline Xale::DataStructure::Table* createUsersTable(Xale::Execution::TableManager& manager)
+    {
+        using Xale::DataStructure::ColumnDefinition;
+        using Xale::DataStructure::FieldType;
+        using Xale::DataStructure::FieldValue;
+
+        auto* table = manager.createTable("users");
+        table->addColumn(ColumnDefinition("id", FieldType::Integer, true, false));
+        table->addColumn(ColumnDefinition("name", FieldType::String));
+        table->insertRow(Xale::DataStructure::Row({ FieldValue(1), FieldValue("alice") }));
+        table->insertRow(Xale::DataStructure::Row({ FieldValue(2), FieldValue("bob") }));
+        manager.saveAllTables();
+        return table;
+    }
+
+    /**
+     * @brief Delete the user of id 1 in a committed transaction
+     */
+    inline void deleteFirstUser(Xale::Execution::TableManager& manager, Xale::DataStructure::Table& table)
+    {
+        auto locks = manager.lockTables({}, { "users" });
+        const auto transaction = manager.beginTransaction();
+
+        size_t slot = 0;
+        if (table.findSlotByPrimaryKey(Xale::DataStructure::FieldValue(1), slot, manager.getSnapshot(transaction)))
+            table.deleteVersionsAt({ slot }, transaction);
+        manager.commitTransaction(transaction, { "users" });
+    }
+
     DECLARE_TABLE_MANAGER_TEST(create_table)
     {
         try
@@ -219,6 +256,158 @@ namespace Xale::Tests
             return false;
         }
     }
+
+    DECLARE_TABLE_MANAGER_TEST(lock_tables)
+    {
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-table-manager-lock_tables.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        manager.createTable("users");
+        manager.createTable("orders");
+
+        std::atomic<bool> writerIn{ false };
+        std::atomic<bool> otherWriterIn{ false };
+        std::thread otherWriter;
+        bool readersShared = false;
+        bool otherWriterWaited = false;
+        {
+            auto reader1 = manager.lockTables({ "users" }, {});
+            auto reader2 = manager.lockTables({ "users", "missing" }, {});
+            readersShared = true;
+
+            // Writers do not wait for the readers, which read the versions of their snapshot
+            std::thread writer([&]() {
+                auto locks = manager.lockTables({}, { "users" });
+                writerIn = true;
+            });
+            writer.join();
+
+            // But a writer waits for the other writer of its table
+            auto writerLocks = manager.lockTables({}, { "users" });
+            otherWriter = std::thread([&]() {
+                auto locks = manager.lockTables({ "orders" }, { "users" });
+                otherWriterIn = true;
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            otherWriterWaited = !otherWriterIn;
+        }
+        otherWriter.join();
+
+        storage.shutdown();
+        return readersShared && writerIn && otherWriterWaited && otherWriterIn;
+    }
+
+    DECLARE_TABLE_MANAGER_TEST(lock_catalog)
+    {
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-table-manager-lock_catalog.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        manager.createTable("users");
+
+        std::atomic<bool> catalogLocked{ false };
+        std::thread ddl;
+        bool ddlWaited = false;
+        bool ddlGaveUp = false;
+        {
+            auto statement = manager.lockTables({ "users" }, {});
+            Xale::Execution::TableLocks refused;
+            ddlGaveUp = !manager.lockCatalog(refused, std::chrono::milliseconds(10));
+
+            ddl = std::thread([&]() {
+                Xale::Execution::TableLocks locks;
+                catalogLocked = manager.lockCatalog(locks, std::chrono::seconds(10));
+            });
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            ddlWaited = !catalogLocked;
+        }
+        ddl.join();
+
+        storage.shutdown();
+        return ddlGaveUp && ddlWaited && catalogLocked;
+    }
+
+    DECLARE_TABLE_MANAGER_TEST(vacuum)
+    {
+        using Xale::DataStructure::FieldValue;
+
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-table-manager-vacuum.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        auto* table = createUsersTable(manager);
+
+        bool readerSeesOld = false;
+        bool kept = false;
+        {
+            auto reader = manager.lockTables({ "users" }, {});
+            const auto snapshot = manager.getSnapshot();
+            deleteFirstUser(manager, *table);
+
+            // The deleted version stays for the reader which still sees it
+            size_t slot = 0;
+            readerSeesOld = table->findSlotByPrimaryKey(FieldValue(1), slot, snapshot) &&
+                            !table->findSlotByPrimaryKey(FieldValue(1), slot, manager.getSnapshot());
+            kept = table->getDeadVersionCount() == 1 && manager.vacuum() == 0;
+        }
+
+        bool reclaimed = manager.vacuum() == 1 &&
+                         table->getDeadVersionCount() == 0 &&
+                         table->getRowCount() == 1 &&
+                         manager.vacuum() == 0;
+
+        storage.shutdown();
+        return readerSeesOld && kept && reclaimed;
+    }
+
+    DECLARE_TABLE_MANAGER_TEST(reload_removed_rows)
+    {
+        using Xale::DataStructure::FieldValue;
+
+        const std::string fileName = "test-table-manager-reload_removed_rows.bin";
+        std::filesystem::remove(fileName);
+
+        bool savedDead = false;
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, fileName);
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            auto* table = createUsersTable(manager);
+            {
+                // Saved on commit while still read, the deleted row is written as removed
+                auto reader = manager.lockTables({ "users" }, {});
+                deleteFirstUser(manager, *table);
+                savedDead = table->getDeadVersionCount() == 1;
+            }
+
+            storage.shutdown();
+        }
+
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, fileName);
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        auto* table = manager.getTable("users");
+
+        size_t slot = 0;
+        bool reloaded = table != nullptr &&
+                        table->getRowCount() == 1 &&
+                        table->getDeadVersionCount() == 0 &&
+                        !table->findSlotByPrimaryKey(FieldValue(1), slot) &&
+                        table->findSlotByPrimaryKey(FieldValue(2), slot) && slot == 0;
+
+        storage.shutdown();
+        return savedDead && reloaded;
+    }
 }
 
 #endif // TABLE_MANAGER_TESTS_H
@@ -0,0 +1,213 @@
+#ifndef TRANSACTION_TESTS_H
+#define TRANSACTION_TESTS_H
+
+#include "TestsHelper.h"
+#include "Engine/SessionContext.h"
+#include "Execution/BasicExecutor.h"
+#include "Execution/TableManager.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+#include "Core/ExceptionHandler.h"
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#define DECLARE_TRANSACTION_TEST(name) DECLARE_TEST(EXECUTION, transaction_##name)
+
+namespace Xale::Tests
+{
+    /**
+     * @brief Run a query in a session, returning its response or its error
+     */
+    inline std::string runSessionQuery(Xale::Engine::SessionContext& session, const std::string& query)
+    {
+        try
+        {
+            session.getQueryEngine().run(query);
+            return session.getQueryEngine().getResultsToString();
+        }
+        catch (const Xale::Core::DbException& e)
+        {
+            return std::string("Error: ") + e.what();
+        }
+    }
+
+    inline bool sessionQueryFails(Xale::Engine::SessionContext& session, const std::string& query)
+    {
+        return runSessionQuery(session, query).rfind("Error: ", 0) == 0;
+    }
+
+    /**
+     * @brief Create accounts(id PRIMARY KEY, balance) holding (1, 10) through a session
+     */
+    inline void createSessionAccounts(Xale::Engine::SessionContext& session)
+    {
+        session.getQueryEngine().run("CREATE TABLE accounts (id INT PRIMARY KEY, balance INT)");
+        session.getQueryEngine().run("INSERT INTO accounts VALUES (1, 10)");
+    }
+
+    /**
+     * @brief Balances of the accounts a session sees, by id
+     */
+    inline std::vector<int> sessionBalances(Xale::Engine::SessionContext& session)
+    {
+        std::vector<int> result;
+        session.getQueryEngine().run("SELECT balance FROM accounts ORDER BY id");
+        auto results = session.getQueryEngine().getResults();
+        for (const auto& row : results->getRows())
+        {
+            // Numeric literals are inserted as FLOAT values
+            const auto& value = row.values[0];
+            result.push_back(std::holds_alternative<int>(value) ? std::get<int>(value) : static_cast<int>(std::get<double>(value)));
+        }
+        return result;
+    }
+
+    DECLARE_TRANSACTION_TEST(commit)
+    {
+        const std::string fileName = "test-transaction-commit.bin";
+        std::filesystem::remove(fileName);
+
+        bool isolated = false;
+        bool committed = false;
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, fileName);
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            Xale::Execution::BasicExecutor executor(manager);
+            Xale::Engine::SessionContext writer(executor);
+            Xale::Engine::SessionContext reader(executor);
+            createSessionAccounts(writer);
+
+            runSessionQuery(writer, "BEGIN");
+            runSessionQuery(writer, "INSERT INTO accounts VALUES (2, 20)");
+            runSessionQuery(writer, "UPDATE accounts SET balance = 11 WHERE id = 1");
+
+            // Each statement of the transaction sees its previous changes, the other clients none
+            isolated = sessionBalances(writer) == std::vector<int>{ 11, 20 } &&
+                       sessionBalances(reader) == std::vector<int>{ 10 } &&
+                       runSessionQuery(writer, "DELETE FROM accounts WHERE balance = 20").find("Error") == std::string::npos &&
+                       sessionBalances(writer) == std::vector<int>{ 11 };
+
+            committed = runSessionQuery(writer, "COMMIT") == "Query OK, transaction committed" &&
+                        sessionBalances(reader) == std::vector<int>{ 11 };
+
+            storage.shutdown();
+        }
+
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, fileName);
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager);
+        Xale::Engine::SessionContext session(executor);
+        bool persisted = sessionBalances(session) == std::vector<int>{ 11 };
+
+        storage.shutdown();
+        return isolated && committed && persisted;
+    }
+
+    DECLARE_TRANSACTION_TEST(rollback)
+    {
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-transaction-rollback.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager, std::chrono::milliseconds(100));
+        Xale::Engine::SessionContext session(executor);
+        createSessionAccounts(session);
+
+        runSessionQuery(session, "BEGIN TRANSACTION");
+        runSessionQuery(session, "DELETE FROM accounts");
+        runSessionQuery(session, "INSERT INTO accounts VALUES (1, 30)");
+        bool rolledBack = runSessionQuery(session, "ROLLBACK") == "Query OK, transaction rolled back" &&
+                          sessionBalances(session) == std::vector<int>{ 10 };
+
+        // A client leaving with its transaction open rolls it back and releases its tables
+        {
+            Xale::Engine::SessionContext leaving(executor);
+            runSessionQuery(leaving, "BEGIN");
+            runSessionQuery(leaving, "INSERT INTO accounts VALUES (2, 20)");
+        }
+        bool released = !sessionQueryFails(session, "INSERT INTO accounts VALUES (3, 30)") &&
+                        sessionBalances(session) == std::vector<int>{ 10, 30 };
+
+        storage.shutdown();
+        return rolledBack && released;
+    }
+
+    DECLARE_TRANSACTION_TEST(errors)
+    {
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-transaction-errors.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager);
+        Xale::Engine::SessionContext session(executor);
+        createSessionAccounts(session);
+
+        bool outside = sessionQueryFails(session, "COMMIT") && sessionQueryFails(session, "ROLLBACK");
+
+        runSessionQuery(session, "BEGIN");
+        bool inside = sessionQueryFails(session, "BEGIN") &&
+                      sessionQueryFails(session, "CREATE TABLE other (id INT)") &&
+                      !sessionQueryFails(session, "INSERT INTO accounts VALUES (2, 20)");
+
+        // A failed statement leaves the transaction open with its previous changes
+        bool kept = sessionQueryFails(session, "INSERT INTO accounts VALUES (1, 0)") &&
+                    !sessionQueryFails(session, "COMMIT") &&
+                    sessionBalances(session) == std::vector<int>{ 10, 20 } &&
+                    !sessionQueryFails(session, "CREATE TABLE other (id INT)");
+
+        storage.shutdown();
+        return outside && inside && kept;
+    }
+
+    DECLARE_TRANSACTION_TEST(lock_timeout)
+    {
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-transaction-lock_timeout.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager, std::chrono::milliseconds(50));
+        Xale::Engine::SessionContext first(executor);
+        Xale::Engine::SessionContext second(executor);
+        Xale::Engine::SessionContext ddl(executor);
+        createSessionAccounts(first);
+        runSessionQuery(first, "CREATE TABLE logs (id INT PRIMARY KEY)");
+
+        runSessionQuery(first, "BEGIN");
+        runSessionQuery(first, "INSERT INTO accounts VALUES (2, 20)");
+        runSessionQuery(second, "BEGIN");
+        runSessionQuery(second, "INSERT INTO logs VALUES (1)");
+
+        // Each waits for the table of the other: the wait gives up instead of a deadlock
+        bool timedOut = sessionQueryFails(first, "INSERT INTO logs VALUES (2)") &&
+                        sessionQueryFails(second, "UPDATE accounts SET balance = 0");
+
+        // Tables are not created while transactions are open, nor waited for without end
+        timedOut = timedOut &&
+                   runSessionQuery(ddl, "CREATE TABLE other (id INT)").find("Lock wait timeout") != std::string::npos;
+
+        bool resumed = !sessionQueryFails(second, "COMMIT") &&
+                       !sessionQueryFails(first, "INSERT INTO logs VALUES (2)") &&
+                       !sessionQueryFails(first, "COMMIT") &&
+                       sessionBalances(second) == std::vector<int>{ 10, 20 } &&
+                       manager.getTable("logs")->getRowCount() == 2 &&
+                       !sessionQueryFails(ddl, "CREATE TABLE other (id INT)");
+
+        storage.shutdown();
+        return timedOut && resumed;
+    }
+}
+
+#endif // TRANSACTION_TESTS_H
@@ -0,0 +1,126 @@
+#ifndef FRAME_READER_TESTS_H
+#define FRAME_READER_TESTS_H
+
+#include "TestsHelper.h"
+#include "Net/Packet/FrameReader.h"
+#include "Core/ExceptionHandler.h"
+
+#include <cstdint>
+#include <vector>
+
+#define DECLARE_FRAME_READER_TEST(name) DECLARE_TEST(NET, frame_reader_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_FRAME_READER_TEST(partial_reads)
+    {
+        Xale::Net::Packet packet(Xale::Net::CommandType::QUERY, { 1, 2, 3, 4, 5, 6, 7, 8 });
+        std::vector<uint8_t> data = packet.serialize();
+
+        Xale::Net::FrameReader reader;
+        Xale::Net::Packet received(Xale::Net::CommandType::UNKNOWN, {});
+
+        // One byte at a time, the header then the payload being awaited
+        for (std::size_t i = 0; i + 1 < data.size(); ++i)
+        {
+            const std::size_t expected = i < Xale::Net::HEADER_SIZE ? Xale::Net::HEADER_SIZE - i : data.size() - i;
+            if (reader.missingBytes() != expected)
+                return false;
+
+            reader.append(&data[i], 1);
+            if (reader.next(received))
+                return false;
+        }
+
+        reader.append(&data.back(), 1);
+        return reader.next(received) && received.getPayload() == packet.getPayload()
+            && reader.bufferedBytes() == 0 && reader.missingBytes() == Xale::Net::HEADER_SIZE;
+    }
+
+    DECLARE_FRAME_READER_TEST(multiple_frames_per_read)
+    {
+        std::vector<uint8_t> data;
+        for (uint8_t i = 0; i < 3; ++i)
+            Xale::Net::Packet(Xale::Net::CommandType::QUERY, std::vector<uint8_t>(i, i)).serializeTo(data);
+
+        // The next packet started in the same read
+        Xale::Net::Packet(Xale::Net::CommandType::QUERY, { 9, 9 }).serializeTo(data);
+        data.resize(data.size() - 1);
+
+        Xale::Net::FrameReader reader;
+        reader.append(data.data(), data.size());
+
+        Xale::Net::Packet received(Xale::Net::CommandType::UNKNOWN, {});
+        for (uint8_t i = 0; i < 3; ++i)
+        {
+            if (!reader.next(received) || received.getPayload() != std::vector<uint8_t>(i, i))
+                return false;
+        }
+
+        return !reader.next(received) && reader.missingBytes() == 1;
+    }
+
+    DECLARE_FRAME_READER_TEST(large_payloads_reuse_buffer)
+    {
+        std::vector<uint8_t> payload(8 * 1024 * 1024);
+        for (std::size_t i = 0; i < payload.size(); ++i)
+            payload[i] = static_cast<uint8_t>(i * 31);
+        std::vector<uint8_t> data = Xale::Net::Packet(Xale::Net::CommandType::QUERY, payload).serialize();
+
+        Xale::Net::FrameReader reader;
+        Xale::Net::Packet received(Xale::Net::CommandType::UNKNOWN, {});
+        const uint8_t* grownBuffer = nullptr;
+
+        for (int round = 0; round < 2; ++round)
+        {
+            // Received in socket-sized reads, the buffer growing to the announced length once
+            for (std::size_t offset = 0; offset < data.size(); offset += 65536)
+            {
+                const std::size_t size = std::min<std::size_t>(65536, data.size() - offset);
+                uint8_t* space = reader.prepare(std::max(size, reader.missingBytes()));
+                if (round == 1 && space != grownBuffer + offset)
+                    return false;
+
+                std::copy(data.begin() + offset, data.begin() + offset + size, space);
+                reader.commit(size);
+            }
+
+            if (!reader.next(received) || received.getPayload() != payload)
+                return false;
+            grownBuffer = reader.prepare(0);
+        }
+
+        return reader.bufferedBytes() == 0;
+    }
+
+    DECLARE_FRAME_READER_TEST(rejects_invalid_headers)
+    {
+        Xale::Net::Packet received(Xale::Net::CommandType::UNKNOWN, {});
+
+        std::vector<uint8_t> garbage(Xale::Net::HEADER_SIZE, 0x42);
+        Xale::Net::FrameReader corrupted;
+        corrupted.append(garbage.data(), garbage.size());
+
+        bool magicRejected = false;
+        try {
+            corrupted.next(received);
+        } catch (const Xale::Core::DbException&) {
+            magicRejected = true;
+        }
+
+        std::vector<uint8_t> data = Xale::Net::Packet(Xale::Net::CommandType::QUERY, std::vector<uint8_t>(2048)).serialize();
+        Xale::Net::FrameReader limited(1024);
+        limited.append(data.data(), Xale::Net::HEADER_SIZE);
+
+        bool lengthRejected = false;
+        try {
+            limited.missingBytes();
+        } catch (const Xale::Core::DbException&) {
+            lengthRejected = true;
+        }
+
+        return magicRejected && lengthRejected;
+    }
+}
+
+#endif // FRAME_READER_TESTS_H
@@ -0,0 +1,238 @@
+#ifndef TCP_SERVER_TESTS_H
+#define TCP_SERVER_TESTS_H
+
+#include "TestsHelper.h"
+#include "Execution/BasicExecutor.h"
+#include "Execution/TableManager.h"
+#include "Net/TcpClient.h"
+#include "Net/TcpServer.h"
+#include "Net/Socket/BasicSocketFactory.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define DECLARE_TCP_SERVER_TEST(name) DECLARE_TEST(NET, tcp_server_##name)
+
+namespace Xale::Tests
+{
+    constexpr int TEST_SERVER_PORT = 46767;
+
+    /**
+     * @brief Client connected to a test server on TEST_SERVER_PORT, nullptr if it never listens
+     */
+    inline std::unique_ptr<Xale::Net::TcpClient> connectTestClient()
+    {
+        auto client = std::make_unique<Xale::Net::TcpClient>(std::make_unique<Xale::Net::BasicSocketFactory>());
+
+        // The server may not listen yet
+        for (int attempt = 0; attempt < 100; ++attempt)
+        {
+            if (client->connect("127.0.0.1", TEST_SERVER_PORT))
+                return client;
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Send a query packet and wait for its response, empty if the connection is closed
+     */
+    inline std::string sendClientQuery(Xale::Net::TcpClient& client, const std::string& sql)
+    {
+        Xale::Net::Packet request(Xale::Net::CommandType::QUERY, std::vector<uint8_t>(sql.begin(), sql.end()));
+        if (client.send(&request, 0) <= 0)
+            return "";
+
+        Xale::Net::Packet response(Xale::Net::CommandType::UNKNOWN, {});
+        if (client.receive(&response, 4096) <= 0)
+            return "";
+
+        auto payload = response.getPayload();
+        return std::string(payload.begin(), payload.end());
+    }
+
+    /**
+     * @brief Poll a predicate for up to 5 seconds
+     */
+    template <typename Predicate>
+    inline bool waitUntil(Predicate predicate)
+    {
+        for (int attempt = 0; attempt < 250 && !predicate(); ++attempt)
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return predicate();
+    }
+
+    DECLARE_TCP_SERVER_TEST(serves_many_connections)
+    {
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-tcp_server-serves_many_connections.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager);
+
+        Xale::Net::TcpServerOptions options;
+        options.workerThreads = 4;
+        options.maxConnections = 200;
+        Xale::Net::TcpServer server(executor, std::make_unique<Xale::Net::BasicSocketFactory>(), options);
+        std::thread loop([&]() { server.start(TEST_SERVER_PORT); });
+
+        bool success = true;
+        auto admin = connectTestClient();
+        if (admin)
+        {
+            sendClientQuery(*admin, "CREATE TABLE items (id INT PRIMARY KEY, name STRING)");
+            for (int i = 0; i < 20; ++i)
+                sendClientQuery(*admin, "INSERT INTO items VALUES (" + std::to_string(i) + ", 'item" + std::to_string(i) + "')");
+        }
+        success = admin != nullptr;
+
+        // Idle clients hold no thread of the server
+        std::vector<std::unique_ptr<Xale::Net::TcpClient>> idle;
+        for (int i = 0; i < 150 && success; ++i)
+        {
+            idle.push_back(connectTestClient());
+            success = idle.back() != nullptr;
+        }
+        success = success && waitUntil([&]() { return server.getConnectionCount() == 151; });
+
+        // Active clients are served concurrently by the workers
+        std::atomic<int> answered{ 0 };
+        std::vector<std::thread> clients;
+        for (int c = 0; c < 8 && success; ++c)
+        {
+            clients.emplace_back([&, c]() {
+                auto client = connectTestClient();
+                for (int i = 0; client && i < 20; ++i)
+                {
+                    const int id = (c + i) % 20;
+                    if (sendClientQuery(*client, "SELECT name FROM items WHERE id = " + std::to_string(id)).find("item" + std::to_string(id)) != std::string::npos)
+                        ++answered;
+                }
+            });
+        }
+        for (auto& client : clients)
+            client.join();
+        success = success && answered == 160;
+
+        // Closed clients are released
+        idle.clear();
+        success = success && waitUntil([&]() { return server.getConnectionCount() == 1; });
+
+        server.stop();
+        loop.join();
+        storage.shutdown();
+        return success && server.getConnectionCount() == 0;
+    }
+
+    DECLARE_TCP_SERVER_TEST(large_and_pipelined_queries)
+    {
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-tcp_server-large_and_pipelined_queries.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager);
+
+        Xale::Net::TcpServerOptions options;
+        options.workerThreads = 2;
+        Xale::Net::TcpServer server(executor, std::make_unique<Xale::Net::BasicSocketFactory>(), options);
+        std::thread loop([&]() { server.start(TEST_SERVER_PORT); });
+
+        bool success = false;
+        auto client = connectTestClient();
+        if (client)
+        {
+            // Queries and results of several megabytes span many reads
+            const std::string text(3 * 1024 * 1024, 'x');
+            sendClientQuery(*client, "CREATE TABLE documents (id INT PRIMARY KEY, body STRING)");
+            success = sendClientQuery(*client, "INSERT INTO documents VALUES (1, '" + text + "')").find("1 row") != std::string::npos
+                && sendClientQuery(*client, "SELECT body FROM documents WHERE id = 1").find(text) != std::string::npos;
+
+            // Several queries sent back to back are answered in order
+            for (int i = 0; i < 3; ++i)
+            {
+                const std::string sql = "SELECT id FROM documents WHERE id = " + std::to_string(i);
+                Xale::Net::Packet request(Xale::Net::CommandType::QUERY, std::vector<uint8_t>(sql.begin(), sql.end()));
+                success = success && client->send(&request, 0) > 0;
+            }
+            for (int i = 0; i < 3; ++i)
+            {
+                Xale::Net::Packet response(Xale::Net::CommandType::UNKNOWN, {});
+                success = success && client->receive(&response, 4096) > 0
+                    && (std::string(response.getPayload().begin(), response.getPayload().end()) == "Empty set") == (i != 1);
+            }
+        }
+
+        server.stop();
+        loop.join();
+        storage.shutdown();
+        return success;
+    }
+
+    DECLARE_TCP_SERVER_TEST(payload_limit)
+    {
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-tcp_server-payload_limit.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager);
+
+        Xale::Net::TcpServerOptions options;
+        options.workerThreads = 1;
+        options.maxPayloadSize = 1024;
+        Xale::Net::TcpServer server(executor, std::make_unique<Xale::Net::BasicSocketFactory>(), options);
+        std::thread loop([&]() { server.start(TEST_SERVER_PORT); });
+
+        // An oversized query is refused from its header, then the client is disconnected
+        auto client = connectTestClient();
+        bool success = client
+            && sendClientQuery(*client, "LIST TABLE " + std::string(2048, ' ')).find("Packet error") == 0
+            && sendClientQuery(*client, "LIST TABLE").empty();
+
+        server.stop();
+        loop.join();
+        storage.shutdown();
+        return success;
+    }
+
+    DECLARE_TCP_SERVER_TEST(connection_limit)
+    {
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, "test-tcp_server-connection_limit.bin");
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        Xale::Execution::BasicExecutor executor(manager);
+
+        Xale::Net::TcpServerOptions options;
+        options.workerThreads = 1;
+        options.maxConnections = 2;
+        Xale::Net::TcpServer server(executor, std::make_unique<Xale::Net::BasicSocketFactory>(), options);
+        std::thread loop([&]() { server.start(TEST_SERVER_PORT); });
+
+        auto first = connectTestClient();
+        auto second = connectTestClient();
+        bool success = first && second
+            && waitUntil([&]() { return server.getConnectionCount() == 2; });
+
+        // Past the limit, a client is disconnected without an answer
+        auto third = connectTestClient();
+        success = success && third && sendClientQuery(*third, "LIST TABLE").empty()
+            && sendClientQuery(*first, "LIST TABLE") != "";
+
+        server.stop();
+        loop.join();
+        storage.shutdown();
+        return success;
+    }
+}
+
+#endif // TCP_SERVER_TESTS_H
@@ -242,6 +242,225 @@ namespace Xale::Tests
         }
     }
 
+    DECLARE_PARSER_TEST(parse_create_index)
+    {
+        try
+        {
+            Xale::Query::BasicTokenizer tokenizer;
+            Xale::Query::BasicParser parser(&tokenizer);
+            
+            auto stmt = parser.parse("CREATE INDEX idx_status ON orders(status)");
+            
+            if (!stmt || stmt->type != Xale::Query::StatementType::CreateIndex)
+                return false;
+            
+            auto createStmt = dynamic_cast<Xale::Query::CreateIndexStatement*>(stmt.get());
+            if (!createStmt)
+                return false;
+            
+            return createStmt->indexName == "idx_status" &&
+                   createStmt->tableName == "orders" &&
+                   createStmt->columnName == "status";
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_PARSER_TEST(parse_drop_index)
+    {
+        try
+        {
+            Xale::Query::BasicTokenizer tokenizer;
+            Xale::Query::BasicParser parser(&tokenizer);
+            
+            auto stmt = parser.parse("DROP INDEX idx_status");
+            
+            if (!stmt || stmt->type != Xale::Query::StatementType::DropIndex)
+                return false;
+            
+            auto dropStmt = dynamic_cast<Xale::Query::DropIndexStatement*>(stmt.get());
+            if (!dropStmt)
+                return false;
+            
+            return dropStmt->indexName == "idx_status";
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_PARSER_TEST(parse_explain)
+    {
+        try
+        {
+            Xale::Query::BasicTokenizer tokenizer;
+            Xale::Query::BasicParser parser(&tokenizer);
+
+            auto stmt = parser.parse("EXPLAIN SELECT name FROM users WHERE id = 1");
+
+            if (!stmt || stmt->type != Xale::Query::StatementType::Explain)
+                return false;
+
+            auto explainStmt = dynamic_cast<Xale::Query::ExplainStatement*>(stmt.get());
+            if (!explainStmt || !explainStmt->select)
+                return false;
+
+            return explainStmt->select->tableName == "users" &&
+                   explainStmt->select->columns.size() == 1 &&
+                   explainStmt->select->where != nullptr;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_PARSER_TEST(parse_transaction)
+    {
+        try
+        {
+            Xale::Query::BasicTokenizer tokenizer;
+            Xale::Query::BasicParser parser(&tokenizer);
+
+            return parser.parse("BEGIN")->type == Xale::Query::StatementType::Begin &&
+                   parser.parse("begin transaction;")->type == Xale::Query::StatementType::Begin &&
+                   parser.parse("COMMIT")->type == Xale::Query::StatementType::Commit &&
+                   parser.parse("ROLLBACK TRANSACTION")->type == Xale::Query::StatementType::Rollback;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_PARSER_TEST(parse_select_limit)
+    {
+        try
+        {
+            Xale::Query::BasicTokenizer tokenizer;
+            Xale::Query::BasicParser parser(&tokenizer);
+
+            auto stmt = parser.parse("SELECT * FROM users WHERE age > 30 LIMIT 50 OFFSET 100");
+            auto selectStmt = dynamic_cast<Xale::Query::SelectStatement*>(stmt.get());
+            if (!selectStmt || !selectStmt->where || !selectStmt->hasLimit)
+                return false;
+
+            bool noLimit = !dynamic_cast<Xale::Query::SelectStatement*>(parser.parse("SELECT * FROM users").get())->hasLimit;
+
+            // The count must be a non-negative integer
+            bool rejected = false;
+            try { parser.parse("SELECT * FROM users LIMIT 2.5"); }
+            catch (const Xale::Core::DbException&) { rejected = true; }
+
+            return selectStmt->limit == 50 && selectStmt->offset == 100 && noLimit && rejected;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_PARSER_TEST(parse_select_aggregate)
+    {
+        try
+        {
+            Xale::Query::BasicTokenizer tokenizer;
+            Xale::Query::BasicParser parser(&tokenizer);
+
+            auto stmt = parser.parse("SELECT city, count(*), SUM(amount) FROM orders WHERE amount > 10 GROUP BY city, country");
+            auto selectStmt = dynamic_cast<Xale::Query::SelectStatement*>(stmt.get());
+            if (!selectStmt || selectStmt->columns.size() != 3 || !selectStmt->where)
+                return false;
+
+            const auto& count = selectStmt->columns[1];
+            const auto& sum = selectStmt->columns[2];
+
+            // Only COUNT takes a wildcard
+            bool rejected = false;
+            try { parser.parse("SELECT SUM(*) FROM orders"); }
+            catch (const Xale::Core::DbException&) { rejected = true; }
+
+            return selectStmt->columns[0].type == Xale::Query::ExpressionType::Identifier
+                && count.type == Xale::Query::ExpressionType::Aggregate && count.value == "COUNT"
+                && count.argument->type == Xale::Query::ExpressionType::Wildcard
+                && sum.value == "SUM" && sum.argument->value == "amount"
+                && selectStmt->groupBy == std::vector<std::string>({ "city", "country" })
+                && rejected;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_PARSER_TEST(parse_select_order_by)
+    {
+        try
+        {
+            Xale::Query::BasicTokenizer tokenizer;
+            Xale::Query::BasicParser parser(&tokenizer);
+
+            auto stmt = parser.parse("SELECT name FROM users WHERE age > 30 ORDER BY age DESC, users.name ASC, id LIMIT 5");
+            auto selectStmt = dynamic_cast<Xale::Query::SelectStatement*>(stmt.get());
+            if (!selectStmt || selectStmt->orderBy.size() != 3 || !selectStmt->hasLimit)
+                return false;
+
+            const auto& keys = selectStmt->orderBy;
+            return keys[0].expression.value == "age" && keys[0].descending
+                && keys[1].expression.value == "users.name" && !keys[1].descending
+                && keys[2].expression.value == "id" && !keys[2].descending
+                && selectStmt->limit == 5;
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
+    DECLARE_PARSER_TEST(parse_where_boolean)
+    {
+        try
+        {
+            using Xale::Query::ExpressionType;
+
+            Xale::Query::BasicTokenizer tokenizer;
+            Xale::Query::BasicParser parser(&tokenizer);
+
+            // a = 1 OR ((NOT b IN (2, 3)) AND (c BETWEEN 4 AND 5))
+            auto stmt = parser.parse("SELECT * FROM t WHERE a = 1 OR b NOT IN (2, 3) AND (c BETWEEN 4 AND 5)");
+            auto selectStmt = dynamic_cast<Xale::Query::SelectStatement*>(stmt.get());
+            if (!selectStmt || !selectStmt->where || !selectStmt->where->condition)
+                return false;
+
+            const auto& root = *selectStmt->where->condition;
+            if (root.type != ExpressionType::BinaryOp || root.binary->op != "OR")
+                return false;
+
+            const auto& both = *root.binary->right;
+            if (both.type != ExpressionType::BinaryOp || both.binary->op != "AND")
+                return false;
+
+            const auto& notIn = *both.binary->left;
+            const auto& between = *both.binary->right;
+            return root.binary->left->binary->op == "="
+                && notIn.type == ExpressionType::Not
+                && notIn.argument->type == ExpressionType::In
+                && notIn.argument->argument->value == "b"
+                && notIn.argument->list.size() == 2
+                && between.type == ExpressionType::Between
+                && between.argument->value == "c"
+                && between.list.size() == 2
+                && between.list[1].value == "5";
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            return false;
+        }
+    }
+
     DECLARE_PARSER_TEST(parse_error_invalid_statement)
     {
         try
@@ -0,0 +1,271 @@
+#ifndef BUFFER_POOL_TESTS_H
+#define BUFFER_POOL_TESTS_H
+
+#include "TestsHelper.h"
+#include "Storage/Page.h"
+#include "Storage/BufferPool.h"
+#include "Storage/PageDirectory.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+#include "Execution/TableManager.h"
+#include "DataStructure/DataTypes.h"
+#include "Core/ExceptionHandler.h"
+
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#define DECLARE_BUFFER_POOL_TEST(name) DECLARE_TEST(STORAGE, buffer_pool_##name)
+
+namespace Xale::Tests
+{
+    DECLARE_BUFFER_POOL_TEST(page_insert_update_erase)
+    {
+        Xale::Storage::Page page;
+        page.init(Xale::Storage::PageType::Data);
+
+        const std::string first = "first record";
+        const std::string second = "second";
+        int slot1 = page.insertRecord(first.data(), static_cast<std::uint16_t>(first.size()));
+        int slot2 = page.insertRecord(second.data(), static_cast<std::uint16_t>(second.size()));
+
+        const std::string updated = "first record, now longer than before";
+        bool isUpdated = page.updateRecord(static_cast<std::uint16_t>(slot1), updated.data(), static_cast<std::uint16_t>(updated.size()));
+
+        std::uint16_t size = 0;
+        const char* record = page.getRecord(static_cast<std::uint16_t>(slot1), size);
+        bool isUpdateRead = record && std::string(record, size) == updated;
+
+        page.eraseRecord(static_cast<std::uint16_t>(slot2));
+        bool isErased = page.getRecord(static_cast<std::uint16_t>(slot2), size) == nullptr;
+
+        // Fill the page, erased space must be reused
+        const std::string filler(100, 'x');
+        int inserted = 0;
+        while (page.insertRecord(filler.data(), static_cast<std::uint16_t>(filler.size())) != -1)
+            ++inserted;
+
+        return slot1 == 0 && slot2 == 1 && isUpdated && isUpdateRead && isErased && inserted > 30;
+    }
+
+    DECLARE_BUFFER_POOL_TEST(page_update_fills_page_exactly)
+    {
+        Xale::Storage::Page page;
+        page.init(Xale::Storage::PageType::Data);
+
+        // 2 bytes left, less than a slot entry
+        const std::size_t header = sizeof(Xale::Storage::PageHeader) + 2 * sizeof(std::uint16_t);
+        const std::string record(Xale::Storage::PAGE_SIZE - header - 2, 'a');
+        int slot = page.insertRecord(record.data(), static_cast<std::uint16_t>(record.size()));
+
+        const std::string tooLarge(Xale::Storage::PAGE_SIZE - header + 1, 'b');
+        bool isRefused = !page.updateRecord(0, tooLarge.data(), static_cast<std::uint16_t>(tooLarge.size()));
+
+        const std::string filling(Xale::Storage::PAGE_SIZE - header, 'c');
+        bool isUpdated = page.updateRecord(0, filling.data(), static_cast<std::uint16_t>(filling.size()));
+
+        std::uint16_t size = 0;
+        const char* read = page.getRecord(0, size);
+        return slot == 0 && isRefused && isUpdated && read && std::string(read, size) == filling &&
+               page.getFreeSpace() == 0;
+    }
+
+    DECLARE_BUFFER_POOL_TEST(eviction_writes_back_dirty_pages)
+    {
+        const std::string fileName = "test-buffer-pool-eviction.bin";
+        std::filesystem::remove(fileName);
+
+        Xale::Storage::BinaryFileManager fm;
+        fm.open(fileName);
+
+        Xale::Storage::BufferPool pool(fm, 2);
+        pool.open();
+
+        std::vector<Xale::Storage::PageId> pageIds;
+        for (int i = 0; i < 8; ++i)
+        {
+            Xale::Storage::PageId pageId;
+            Xale::Storage::Page* page = pool.newPage(Xale::Storage::PageType::Data, pageId);
+            const std::string value = "page " + std::to_string(i);
+            page->insertRecord(value.data(), static_cast<std::uint16_t>(value.size()));
+            pool.unpinPage(pageId, true);
+            pageIds.push_back(pageId);
+        }
+
+        bool isContentKept = true;
+        for (int i = 0; i < 8; ++i)
+        {
+            Xale::Storage::Page* page = pool.fetchPage(pageIds[i]);
+            std::uint16_t size = 0;
+            const char* record = page->getRecord(0, size);
+            isContentKept = isContentKept && record && std::string(record, size) == "page " + std::to_string(i);
+            pool.unpinPage(pageIds[i], false);
+        }
+
+        bool isExhaustedThrown = false;
+        Xale::Storage::Page* pinned1 = pool.fetchPage(pageIds[0]);
+        Xale::Storage::Page* pinned2 = pool.fetchPage(pageIds[1]);
+        try
+        {
+            pool.fetchPage(pageIds[2]);
+        }
+        catch (const Xale::Core::DbException&)
+        {
+            isExhaustedThrown = true;
+        }
+        pool.unpinPage(pageIds[0], false);
+        pool.unpinPage(pageIds[1], false);
+
+        fm.close();
+
+        return isContentKept && pinned1 && pinned2 && isExhaustedThrown && pool.getReadCount() > 0;
+    }
+
+    DECLARE_BUFFER_POOL_TEST(page_directory_overflow_record)
+    {
+        const std::string fileName = "test-buffer-pool-overflow.bin";
+        std::filesystem::remove(fileName);
+
+        Xale::Storage::BinaryFileManager fm;
+        fm.open(fileName);
+
+        Xale::Storage::BufferPool pool(fm, 4);
+        pool.open();
+
+        Xale::Storage::PageDirectory directory(pool, Xale::Storage::PageDirectory::create(pool));
+
+        std::vector<char> large(3 * Xale::Storage::PAGE_SIZE + 17);
+        for (size_t i = 0; i < large.size(); ++i)
+            large[i] = static_cast<char>(i % 251);
+
+        Xale::Storage::RecordId rid = directory.insertRecord(large);
+        bool isLargeRead = directory.readRecord(rid) == large;
+
+        std::vector<char> small = { 'a', 'b', 'c' };
+        rid = directory.updateRecord(rid, small);
+        bool isSmallRead = directory.readRecord(rid) == small;
+
+        size_t count = 0;
+        directory.forEachRecord([&](Xale::Storage::RecordId, const std::vector<char>&) { ++count; });
+
+        fm.close();
+
+        return isLargeRead && isSmallRead && count == 1;
+    }
+
+    DECLARE_BUFFER_POOL_TEST(table_manager_reload)
+    {
+        const std::string fileName = "test-buffer-pool-reload.bin";
+        std::filesystem::remove(fileName);
+
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::FileStorageEngine storage(fm, fileName);
+            storage.startup();
+
+            Xale::Execution::TableManager manager(storage, fm);
+            auto* table = manager.createTable("users");
+            table->addColumn(Xale::DataStructure::ColumnDefinition("id", Xale::DataStructure::FieldType::Integer));
+            table->addColumn(Xale::DataStructure::ColumnDefinition("name", Xale::DataStructure::FieldType::String));
+            for (int i = 0; i < 500; ++i)
+                table->insertRow(Xale::DataStructure::Row({ Xale::DataStructure::FieldValue(i), Xale::DataStructure::FieldValue("user" + std::to_string(i)) }));
+            table->deleteRows("id", 3);
+
+            manager.saveAllTables();
+            storage.shutdown();
+        }
+
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, fileName);
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        auto* table = manager.getTable("users");
+
+        bool result = table != nullptr &&
+                      table->getColumnCount() == 2 &&
+                      table->getRowCount() == 499 &&
+                      table->findRows("id", 3).empty() &&
+                      table->findRows("id", 499).size() == 1 &&
+                      std::get<std::string>(table->findRows("id", 42)[0].values[1]) == "user42";
+
+        storage.shutdown();
+        return result;
+    }
+
+    DECLARE_BUFFER_POOL_TEST(table_manager_writes_only_dirty_pages)
+    {
+        const std::string fileName = "test-buffer-pool-dirty-pages.bin";
+        std::filesystem::remove(fileName);
+
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, fileName);
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        auto* table = manager.createTable("users");
+        table->addColumn(Xale::DataStructure::ColumnDefinition("id", Xale::DataStructure::FieldType::Integer));
+        table->addColumn(Xale::DataStructure::ColumnDefinition("name", Xale::DataStructure::FieldType::String));
+        for (int i = 0; i < 2000; ++i)
+            table->insertRow(Xale::DataStructure::Row({ Xale::DataStructure::FieldValue(i), Xale::DataStructure::FieldValue("user" + std::to_string(i)) }));
+        manager.saveAllTables();
+
+        const std::uint64_t writesBefore = manager.getBufferPool().getWriteCount();
+        table->updateRows("id", 1000, { { "name", std::string("renamed") } });
+        manager.saveAllTables();
+        const std::uint64_t writes = manager.getBufferPool().getWriteCount() - writesBefore;
+
+        storage.shutdown();
+
+        // A single data page holds the updated row
+        return writes == 1;
+    }
+
+    DECLARE_BUFFER_POOL_TEST(table_manager_migrates_legacy_file)
+    {
+        const std::string fileName = "test-buffer-pool-legacy.bin";
+        std::filesystem::remove(fileName);
+
+        Xale::DataStructure::Table legacy("users");
+        legacy.addColumn(Xale::DataStructure::ColumnDefinition("id", Xale::DataStructure::FieldType::Integer));
+        legacy.addColumn(Xale::DataStructure::ColumnDefinition("name", Xale::DataStructure::FieldType::String));
+        legacy.insertRow(Xale::DataStructure::Row({ Xale::DataStructure::FieldValue(1), Xale::DataStructure::FieldValue("alice") }));
+        legacy.insertRow(Xale::DataStructure::Row({ Xale::DataStructure::FieldValue(2), Xale::DataStructure::FieldValue("bob") }));
+
+        {
+            std::vector<char> data = legacy.serialize();
+            std::vector<char> file;
+            auto writeU32 = [&](std::uint32_t value) {
+                file.insert(file.end(), reinterpret_cast<char*>(&value), reinterpret_cast<char*>(&value) + sizeof(value));
+            };
+            writeU32(1);
+            writeU32(5);
+            file.insert(file.end(), { 'u', 's', 'e', 'r', 's' });
+            writeU32(static_cast<std::uint32_t>(data.size()));
+            file.insert(file.end(), data.begin(), data.end());
+
+            Xale::Storage::BinaryFileManager fm;
+            fm.open(fileName);
+            fm.writeAt(0, file.data(), file.size());
+            fm.close();
+        }
+
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, fileName);
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        auto* table = manager.getTable("users");
+
+        bool result = Xale::Storage::BufferPool::hasPagedLayout(fm) &&
+                      table != nullptr &&
+                      table->getRowCount() == 2 &&
+                      table->findRows("name", std::string("bob")).size() == 1;
+
+        storage.shutdown();
+        return result;
+    }
+}
+
+#endif // BUFFER_POOL_TESTS_H
@@ -0,0 +1,271 @@
+#ifndef WRITE_AHEAD_LOG_TESTS_H
+#define WRITE_AHEAD_LOG_TESTS_H
+
+#include "TestsHelper.h"
+#include "Storage/WriteAheadLog.h"
+#include "Storage/BinaryFileManager.h"
+#include "Storage/FileStorageEngine.h"
+#include "Execution/TableManager.h"
+#include "DataStructure/DataTypes.h"
+#include "Core/ExceptionHandler.h"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define DECLARE_WAL_TEST(name) DECLARE_TEST(STORAGE, write_ahead_log_##name)
+
+namespace Xale::Tests
+{
+    /**
+     * @brief File manager with a slow sync, so that committers pile up behind it
+     */
+    class SlowSyncFileManager : public Xale::Storage::BinaryFileManager
+    {
+        public:
+            bool sync() override
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                return Xale::Storage::BinaryFileManager::sync();
+            }
+    };
+
+    inline Xale::Storage::LogRecord makeLogRecord(const std::string& value)
+    {
+        return { Xale::Storage::LogRecordType::SetRow, std::vector<char>(value.begin(), value.end()) };
+    }
+
+    inline size_t countCommitRecords(const std::vector<Xale::Storage::LogRecord>& records)
+    {
+        size_t count = 0;
+        for (const auto& record : records)
+            if (record.type == Xale::Storage::LogRecordType::Commit)
+                ++count;
+        return count;
+    }
+
+    DECLARE_WAL_TEST(recover_committed_records)
+    {
+        const std::string fileName = "test-wal-recover.bin";
+        std::filesystem::remove(fileName);
+
+        {
+            Xale::Storage::BinaryFileManager fm;
+            fm.open(fileName);
+            Xale::Storage::WriteAheadLog wal(fm);
+            wal.recover();
+            wal.commit({ makeLogRecord("a"), makeLogRecord("b") });
+            wal.commit({ makeLogRecord("c") });
+        }
+
+        Xale::Storage::BinaryFileManager fm;
+        fm.open(fileName);
+        Xale::Storage::WriteAheadLog wal(fm);
+        auto records = wal.recover();
+
+        return records.size() == 5 &&
+               std::string(records[1].payload.begin(), records[1].payload.end()) == "b" &&
+               records[2].type == Xale::Storage::LogRecordType::Commit &&
+               countCommitRecords(records) == 2;
+    }
+
+    DECLARE_WAL_TEST(recover_stops_at_torn_record)
+    {
+        const std::string fileName = "test-wal-torn.bin";
+        std::filesystem::remove(fileName);
+
+        std::uint64_t validSize = 0;
+        {
+            Xale::Storage::BinaryFileManager fm;
+            fm.open(fileName);
+            Xale::Storage::WriteAheadLog wal(fm);
+            wal.recover();
+            wal.commit({ makeLogRecord("kept") });
+            validSize = fm.size();
+
+            // Partial record, as left by a crash in the middle of a write
+            const char torn[] = { 40, 0, 0, 0, 1, 2, 3, 4, 2, 'x' };
+            fm.writeAt(validSize, torn, sizeof(torn));
+            fm.sync();
+        }
+
+        Xale::Storage::BinaryFileManager fm;
+        fm.open(fileName);
+        Xale::Storage::WriteAheadLog wal(fm);
+        auto records = wal.recover();
+
+        // New commits overwrite the torn record
+        wal.commit({ makeLogRecord("next") });
+
+        Xale::Storage::BinaryFileManager fm2;
+        fm2.open(fileName);
+        Xale::Storage::WriteAheadLog wal2(fm2);
+        auto recordsAfter = wal2.recover();
+
+        return records.size() == 2 &&
+               countCommitRecords(recordsAfter) == 2;
+    }
+
+    DECLARE_WAL_TEST(reset_discards_records)
+    {
+        const std::string fileName = "test-wal-reset.bin";
+        std::filesystem::remove(fileName);
+
+        {
+            Xale::Storage::BinaryFileManager fm;
+            fm.open(fileName);
+            Xale::Storage::WriteAheadLog wal(fm);
+            wal.recover();
+            wal.commit({ makeLogRecord("old"), makeLogRecord("old") });
+            wal.reset();
+            wal.commit({ makeLogRecord("new") });
+        }
+
+        Xale::Storage::BinaryFileManager fm;
+        fm.open(fileName);
+        Xale::Storage::WriteAheadLog wal(fm);
+        auto records = wal.recover();
+
+        return records.size() == 2 &&
+               std::string(records[0].payload.begin(), records[0].payload.end()) == "new";
+    }
+
+    DECLARE_WAL_TEST(group_commit_shares_syncs)
+    {
+        const std::string fileName = "test-wal-group-commit.bin";
+        std::filesystem::remove(fileName);
+
+        const int threadCount = 8;
+        const int commitsPerThread = 20;
+
+        SlowSyncFileManager fm;
+        fm.open(fileName);
+
+        std::uint64_t syncs = 0;
+        {
+            Xale::Storage::WriteAheadLog wal(fm);
+            wal.recover();
+            const std::uint64_t syncsBefore = wal.getSyncCount();
+
+            std::vector<std::thread> threads;
+            for (int t = 0; t < threadCount; ++t)
+            {
+                threads.emplace_back([&wal, t]() {
+                    for (int i = 0; i < commitsPerThread; ++i)
+                        wal.commit({ makeLogRecord(std::to_string(t) + ":" + std::to_string(i)) });
+                });
+            }
+            for (auto& thread : threads)
+                thread.join();
+
+            syncs = wal.getSyncCount() - syncsBefore;
+        }
+
+        Xale::Storage::BinaryFileManager reader;
+        reader.open(fileName);
+        Xale::Storage::WriteAheadLog wal(reader);
+        auto records = wal.recover();
+
+        return countCommitRecords(records) == threadCount * commitsPerThread &&
+               syncs < static_cast<std::uint64_t>(threadCount * commitsPerThread);
+    }
+
+    DECLARE_WAL_TEST(table_manager_replays_log)
+    {
+        const std::string dataFileName = "test-wal-replay-data.bin";
+        const std::string logFileName = "test-wal-replay-log.bin";
+        std::filesystem::remove(dataFileName);
+        std::filesystem::remove(logFileName);
+
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::BinaryFileManager logFm;
+            Xale::Storage::FileStorageEngine storage(fm, dataFileName);
+            storage.startup();
+            logFm.open(logFileName);
+
+            Xale::Execution::TableManager manager(storage, fm, &logFm);
+            auto* table = manager.createTable("users");
+            table->addColumn(Xale::DataStructure::ColumnDefinition("id", Xale::DataStructure::FieldType::Integer));
+            for (int i = 0; i < 100; ++i)
+            {
+                table->insertRow(Xale::DataStructure::Row({
+                    Xale::DataStructure::FieldValue(i) }));
+                manager.saveAllTables();
+            }
+            table->deleteRows("id", 7);
+            manager.saveAllTables();
+
+            // No checkpoint: the data file only holds the formatted catalog
+            storage.shutdown();
+        }
+
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::BinaryFileManager logFm;
+        Xale::Storage::FileStorageEngine storage(fm, dataFileName);
+        storage.startup();
+        logFm.open(logFileName);
+
+        Xale::Execution::TableManager manager(storage, fm, &logFm);
+        auto* table = manager.getTable("users");
+
+        bool result = table != nullptr &&
+                      table->getRowCount() == 99 &&
+                      table->findRows("id", 7).empty() &&
+                      table->findRows("id", 99).size() == 1 &&
+                      manager.getWriteAheadLog()->size() == 0;
+
+        storage.shutdown();
+        return result;
+    }
+
+    DECLARE_WAL_TEST(table_manager_checkpoint)
+    {
+        const std::string dataFileName = "test-wal-checkpoint-data.bin";
+        const std::string logFileName = "test-wal-checkpoint-log.bin";
+        std::filesystem::remove(dataFileName);
+        std::filesystem::remove(logFileName);
+
+        std::uint64_t writesBeforeCheckpoint = 0;
+        {
+            Xale::Storage::BinaryFileManager fm;
+            Xale::Storage::BinaryFileManager logFm;
+            Xale::Storage::FileStorageEngine storage(fm, dataFileName);
+            storage.startup();
+            logFm.open(logFileName);
+
+            Xale::Execution::TableManager manager(storage, fm, &logFm);
+            writesBeforeCheckpoint = manager.getBufferPool().getWriteCount();
+
+            auto* table = manager.createTable("items");
+            table->addColumn(Xale::DataStructure::ColumnDefinition("name", Xale::DataStructure::FieldType::String));
+            table->insertRow(Xale::DataStructure::Row({
+                Xale::DataStructure::FieldValue(std::string("pen")) }));
+            manager.saveAllTables();
+
+            // Commits only touch the log
+            if (manager.getBufferPool().getWriteCount() != writesBeforeCheckpoint)
+                return false;
+
+            manager.checkpoint();
+            storage.shutdown();
+        }
+
+        // The data file is complete without the log
+        Xale::Storage::BinaryFileManager fm;
+        Xale::Storage::FileStorageEngine storage(fm, dataFileName);
+        storage.startup();
+
+        Xale::Execution::TableManager manager(storage, fm);
+        auto* table = manager.getTable("items");
+
+        bool result = table != nullptr && table->findRows("name", std::string("pen")).size() == 1;
+
+        storage.shutdown();
+        return result;
+    }
+}
+
+#endif // WRITE_AHEAD_LOG_TESTS_H
@@ -2,7 +2,18 @@
 #define TESTS_HELPER_H
 
 #include "Core/ConfigurationPath.h"
+#include "DataStructure/Table.h"
+#include "Execution/Join.h"
+#include "Execution/Operators.h"
+#include "Execution/QueryPlanner.h"
+#include "Execution/TableManager.h"
+#include "Query/BasicParser.h"
+#include "Query/BasicTokenizer.h"
+#include "Query/Statement.h"
 
+#include <algorithm>
+#include <memory>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -29,6 +40,226 @@ namespace Xale::Tests
     bool test_##name(); \
     static TestRegistrar registrar_##name(#category, #name, test_##name); \
     bool test_##name()
+
+    /**
+     * @brief Row of a table made by makeScoresTable()
+     */
+    inline Xale::DataStructure::Row makeScoreRow(Xale::DataStructure::FieldValue id, Xale::DataStructure::FieldValue score,
+        Xale::DataStructure::FieldValue name)
+    {
+        return Xale::DataStructure::Row({ std::move(id), std::move(score), std::move(name) });
+    }
+
+    /**
+     * @brief Table scores(id PRIMARY KEY NOT NULL, score FLOAT, name STRING) of rows (i, i * 0.5, "n<i>"), every tenth name being NULL
+     */
+    inline Xale::DataStructure::Table makeScoresTable(int rowCount)
+    {
+        using Xale::DataStructure::ColumnDefinition;
+        using Xale::DataStructure::FieldType;
+        using Xale::DataStructure::FieldValue;
+
+        Xale::DataStructure::Table table("scores");
+        table.addColumn(ColumnDefinition("id", FieldType::Integer, true, false));
+        table.addColumn(ColumnDefinition("score", FieldType::Float));
+        table.addColumn(ColumnDefinition("name", FieldType::String));
+
+        for (int i = 0; i < rowCount; ++i)
+        {
+            FieldValue name = i % 10 == 0 ? FieldValue(std::monostate{}) : FieldValue("n" + std::to_string(i));
+            table.insertRow(makeScoreRow(i, i * 0.5, name));
+        }
+
+        return table;
+    }
+
+    /**
+     * @brief Rows of (key, position), keys being integers, floats or strings
+     */
+    inline std::vector<Xale::DataStructure::Row> makeKeyedRows(std::mt19937& rng, size_t count, int keyRange)
+    {
+        using Xale::DataStructure::FieldValue;
+
+        std::vector<Xale::DataStructure::Row> rows;
+        for (size_t i = 0; i < count; ++i)
+        {
+            int key = static_cast<int>(rng() % keyRange);
+            FieldValue value;
+            switch (rng() % 3)
+            {
+                case 0: value = key; break;
+                case 1: value = static_cast<double>(key); break;
+                default: value = std::to_string(key); break;
+            }
+            rows.push_back(Xale::DataStructure::Row({ value, FieldValue(static_cast<int>(i)) }));
+        }
+        return rows;
+    }
+
+    /**
+     * @brief Table of (key, position) rows, with an index on the key
+     */
+    inline Xale::DataStructure::Table makeKeyedTable(const std::string& name, const std::vector<Xale::DataStructure::Row>& rows)
+    {
+        using Xale::DataStructure::ColumnDefinition;
+        using Xale::DataStructure::FieldType;
+
+        Xale::DataStructure::Table table(name);
+        table.addColumn(ColumnDefinition("key", FieldType::Integer));
+        table.addColumn(ColumnDefinition("position", FieldType::Integer, true));
+        table.createIndex(Xale::DataStructure::IndexDefinition(name + "_key", "key"));
+        for (const auto& row : rows)
+            table.insertRow(row);
+        return table;
+    }
+
+    /**
+     * @brief Reference join of two row sets, comparing every pair
+     */
+    inline std::vector<Xale::DataStructure::Row> nestedLoopJoin(const std::vector<Xale::DataStructure::Row>& left, size_t leftColumn,
+        const std::vector<Xale::DataStructure::Row>& right, size_t rightColumn)
+    {
+        std::vector<Xale::DataStructure::Row> joined;
+        for (const auto& leftRow : left)
+        {
+            for (const auto& rightRow : right)
+            {
+                if (!Xale::Execution::joinValuesEqual(leftRow.values[leftColumn], rightRow.values[rightColumn]))
+                    continue;
+                Xale::DataStructure::Row merged(leftRow.values);
+                merged.values.insert(merged.values.end(), rightRow.values.begin(), rightRow.values.end());
+                joined.push_back(std::move(merged));
+            }
+        }
+        return joined;
+    }
+
+    /**
+     * @brief Order joined (key, position, key, position) rows by left then right position
+     */
+    inline std::vector<Xale::DataStructure::Row> sortByPositions(std::vector<Xale::DataStructure::Row> rows)
+    {
+        std::sort(rows.begin(), rows.end(), [](const Xale::DataStructure::Row& a, const Xale::DataStructure::Row& b) {
+            return std::make_pair(std::get<int>(a.values[1]), std::get<int>(a.values[3]))
+                < std::make_pair(std::get<int>(b.values[1]), std::get<int>(b.values[3]));
+        });
+        return rows;
+    }
+
+    inline bool sameRows(const std::vector<Xale::DataStructure::Row>& a, const std::vector<Xale::DataStructure::Row>& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (a[i].values != b[i].values)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Parse a single SQL statement
+     */
+    inline std::unique_ptr<Xale::Query::Statement> parseQuery(const std::string& query)
+    {
+        Xale::Query::BasicTokenizer tokenizer;
+        Xale::Query::BasicParser parser(&tokenizer);
+        return parser.parse(query);
+    }
+
+    /**
+     * @brief Plan of a SELECT query over the tables of a manager
+     */
+    inline std::unique_ptr<Xale::Execution::PlanNode> planQuery(Xale::Execution::TableManager& manager, const std::string& query)
+    {
+        auto stmt = parseQuery(query);
+        Xale::Execution::QueryPlanner planner(manager);
+        return planner.planSelect(*static_cast<Xale::Query::SelectStatement*>(stmt.get()));
+    }
+
+    /**
+     * @brief Fill users(id, name, age) with 100 users and orders(id, user_id, product) with 10 orders per user
+     *
+     * Numbers are floats, as numeric literals of INSERT statements are.
+     */
+    inline void createUsersAndOrders(Xale::Execution::TableManager& manager)
+    {
+        using Xale::DataStructure::ColumnDefinition;
+        using Xale::DataStructure::FieldType;
+        using Xale::DataStructure::FieldValue;
+        using Xale::DataStructure::Row;
+
+        auto* users = manager.createTable("users");
+        users->addColumn(ColumnDefinition("id", FieldType::Integer, true));
+        users->addColumn(ColumnDefinition("name", FieldType::String));
+        users->addColumn(ColumnDefinition("age", FieldType::Integer));
+        for (int i = 0; i < 100; ++i)
+            users->insertRow(Row({ FieldValue(static_cast<double>(i)), FieldValue("user" + std::to_string(i)), FieldValue(20.0 + i % 50) }));
+
+        auto* orders = manager.createTable("orders");
+        orders->addColumn(ColumnDefinition("id", FieldType::Integer, true));
+        orders->addColumn(ColumnDefinition("user_id", FieldType::Integer));
+        orders->addColumn(ColumnDefinition("product", FieldType::String));
+        for (int i = 0; i < 1000; ++i)
+            orders->insertRow(Row({ FieldValue(static_cast<double>(i)), FieldValue(static_cast<double>(i % 100)), FieldValue("product" + std::to_string(i)) }));
+    }
+
+    /**
+     * @brief Check that every joined (name, product) row of createUsersAndOrders() tables pairs an order with its user
+     */
+    inline bool ordersMatchUsers(const std::vector<Xale::DataStructure::Row>& rows)
+    {
+        for (const auto& row : rows)
+        {
+            int order = std::stoi(std::get<std::string>(row.values[1]).substr(7));
+            if (std::get<std::string>(row.values[0]) != "user" + std::to_string(order % 100))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Operator producing given rows, counting the rows pulled
+     */
+    class RowsOperator : public Xale::Execution::Operator
+    {
+        public:
+            RowsOperator(std::vector<Xale::DataStructure::Row> rows, size_t& pulled) : _rows(std::move(rows)), _pulled(pulled) {}
+
+            void open() override { _position = 0; }
+            void close() override {}
+
+            bool next(Xale::DataStructure::Row& row) override
+            {
+                if (_position >= _rows.size())
+                    return false;
+                ++_pulled;
+                row = _rows[_position++];
+                return true;
+            }
+
+        private:
+            std::vector<Xale::DataStructure::Row> _rows;
+            size_t& _pulled;
+            size_t _position = 0;
+    };
+
+    /**
+     * @brief Every row of an operator, from open() to close()
+     */
+    inline std::vector<Xale::DataStructure::Row> drainOperator(Xale::Execution::Operator& op)
+    {
+        std::vector<Xale::DataStructure::Row> rows;
+        Xale::DataStructure::Row row;
+
+        op.open();
+        while (op.next(row))
+            rows.push_back(row);
+        op.close();
+
+        return rows;
+    }
 }
 
 #endif // TESTS_HELPER_H
\ No newline at end of file
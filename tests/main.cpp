@@ -8,12 +8,29 @@
 // Include all test files here
 #include "Storage/StorageEngineTests.h"
 #include "Storage/FileManagerTests.h"
+#include "Storage/BufferPoolTests.h"
+#include "Storage/WriteAheadLogTests.h"
 #include "DataStructure/BPlusTreeTests.h"
+#include "DataStructure/ConcurrentBPlusTreeTests.h"
+#include "DataStructure/ColumnarTableTests.h"
+#include "DataStructure/RowVersionTests.h"
 #include "Query/BasicTokenizerTests.h"
 #include "Query/BasicParserTests.h"
 #include "Execution/TableManagerTests.h"
 #include "Execution/BasicExecutorTests.h"
+#include "Execution/ColumnFilterTests.h"
+#include "Execution/JoinTests.h"
+#include "Execution/QueryPlannerTests.h"
+#include "Execution/OperatorsTests.h"
+#include "Execution/AggregateTests.h"
+#include "Execution/SortTests.h"
+#include "Execution/PredicateTests.h"
+#include "Execution/TransactionTests.h"
+#include "Engine/SessionContextTests.h"
 #include "Net/PacketTests.h"
+#include "Net/FrameReaderTests.h"
+#include "Net/TcpServerTests.h"
+#include "Core/ThreadPoolTests.h"
 // ---
 
 const std::string RED_COLOR = "\033[31m";